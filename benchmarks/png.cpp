@@ -0,0 +1,145 @@
+#include "benchmark/benchmark_api.h"
+#include "osdcore.h"
+#include "corefile.h"
+#include "png.h"
+
+#include <string>
+#include <vector>
+
+// run from the top of the tree so the artwork can be found
+static const char *const artwork_files[] =
+{
+	"artwork/aperture-grille.png",
+	"artwork/monochrome-chessboard.png",
+	"artwork/monochrome-matrix.png",
+	"artwork/shadow-mask.png",
+	"artwork/slot-mask-aligned.png",
+	"artwork/slot-mask.png",
+	"artwork/white.png"
+};
+
+static const char *const scratch_file = "png_benchmark.png";
+
+static bool load_file(const char *filename, std::vector<UINT8> &data)
+{
+	util::core_file::ptr file;
+	if (util::core_file::open(filename, OPEN_FLAG_READ, file) != osd_file::error::NONE)
+		return false;
+	data.resize(file->size());
+	return file->read(&data[0], data.size()) == data.size();
+}
+
+// something like a game screen: flat tiles, a few sprites and a score line
+static void make_screenshot(bitmap_rgb32 &bitmap, int width, int height)
+{
+	static const rgb_t colors[] =
+	{
+		rgb_t(0x00, 0x00, 0x00), rgb_t(0x20, 0x40, 0xc0), rgb_t(0x60, 0x30, 0x10), rgb_t(0x10, 0xa0, 0x20),
+		rgb_t(0xf0, 0xd0, 0x40), rgb_t(0xe0, 0x20, 0x20), rgb_t(0xff, 0xff, 0xff), rgb_t(0x80, 0x80, 0x80)
+	};
+
+	bitmap.allocate(width, height);
+	for (int y = 0; y < height; y++)
+		for (int x = 0; x < width; x++)
+		{
+			int const tile = ((x >> 4) * 7 + (y >> 4) * 3 + ((x >> 4) * (y >> 4))) & 7;
+			int const pattern = ((x ^ y) & 8) ? 1 : 0;
+			bitmap.pix32(y, x) = colors[(tile < 5) ? 0 : ((tile + pattern) & 7)];
+		}
+	for (int sprite = 0; sprite < 24; sprite++)
+	{
+		int const sx = (sprite * 97) % (width - 32);
+		int const sy = (sprite * 61) % (height - 32);
+		for (int y = 0; y < 32; y++)
+			for (int x = 0; x < 32; x++)
+				if (((x - 16) * (x - 16) + (y - 16) * (y - 16)) < 200)
+					bitmap.pix32(sy + y, sx + x) = colors[4 + ((x + y + sprite) & 3)];
+	}
+	for (int y = 4; y < 12; y++)
+		for (int x = 8; x < width / 3; x++)
+			if ((x / 2 + y) % 3)
+				bitmap.pix32(y, x) = colors[6];
+}
+
+static bool write_screenshot(bitmap_rgb32 &bitmap, int filter)
+{
+	util::core_file::ptr file;
+	if (util::core_file::open(scratch_file, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE, file) != osd_file::error::NONE)
+		return false;
+	return png_write_bitmap(*file, nullptr, bitmap, 0, nullptr, PNG_LEVEL_DEFAULT, filter) == PNGERR_NONE;
+}
+
+static void BM_png_read_artwork(benchmark::State& state) {
+	std::vector<std::vector<UINT8>> files;
+	for (const char *filename : artwork_files)
+	{
+		std::vector<UINT8> data;
+		if (load_file(filename, data))
+			files.push_back(std::move(data));
+	}
+	if (files.empty())
+		state.SetLabel("artwork not found");
+
+	UINT64 bytes = 0;
+	bitmap_argb32 bitmap;
+	while (state.KeepRunning()) {
+		for (auto &data : files)
+		{
+			util::core_file::ptr file;
+			util::core_file::open_ram(&data[0], data.size(), OPEN_FLAG_READ, file);
+			png_read_bitmap(*file, bitmap);
+			bytes += UINT64(bitmap.width()) * bitmap.height() * 4;
+		}
+	}
+	state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_png_read_artwork);
+
+// arguments are the screen width and the filter the file was written with
+static void BM_png_read_screenshot(benchmark::State& state) {
+	int const width = state.range_x();
+	bitmap_rgb32 screen;
+	make_screenshot(screen, width, width * 3 / 4);
+
+	std::vector<UINT8> data;
+	if (!write_screenshot(screen, state.range_y()) || !load_file(scratch_file, data))
+	{
+		state.SetLabel("can't write scratch file");
+		return;
+	}
+	osd_file::remove(scratch_file);
+
+	UINT64 bytes = 0;
+	bitmap_argb32 bitmap;
+	while (state.KeepRunning()) {
+		util::core_file::ptr file;
+		util::core_file::open_ram(&data[0], data.size(), OPEN_FLAG_READ, file);
+		png_read_bitmap(*file, bitmap);
+		bytes += UINT64(bitmap.width()) * bitmap.height() * 4;
+	}
+	state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_png_read_screenshot)->ArgPair(640, PNG_PF_None)->ArgPair(640, PNG_PF_Sub)->ArgPair(640, PNG_PF_Up)
+		->ArgPair(640, PNG_PF_Average)->ArgPair(640, PNG_PF_Paeth)->ArgPair(640, PNG_PF_Adaptive)
+		->ArgPair(1920, PNG_PF_None)->ArgPair(1920, PNG_PF_Adaptive);
+
+// arguments are the screen width and the row filter
+static void BM_png_write_screenshot(benchmark::State& state) {
+	int const width = state.range_x();
+	bitmap_rgb32 screen;
+	make_screenshot(screen, width, width * 3 / 4);
+
+	UINT64 bytes = 0;
+	while (state.KeepRunning()) {
+		if (!write_screenshot(screen, state.range_y()))
+		{
+			state.SetLabel("can't write scratch file");
+			break;
+		}
+		bytes += UINT64(screen.width()) * screen.height() * 4;
+	}
+	osd_file::remove(scratch_file);
+	state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_png_write_screenshot)->ArgPair(640, PNG_PF_None)->ArgPair(640, PNG_PF_Up)->ArgPair(640, PNG_PF_Adaptive)
+		->ArgPair(1920, PNG_PF_None)->ArgPair(1920, PNG_PF_Up)->ArgPair(1920, PNG_PF_Adaptive);
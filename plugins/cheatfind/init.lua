@@ -3,7 +3,7 @@
 -- This includes a library of functions to be used at the Lua console as cf.getspaces() etc...
 local exports = {}
 exports.name = "cheatfind"
-exports.version = "0.0.1"
+exports.version = "0.0.2"
 exports.description = "Cheat finder helper library"
 exports.license = "The BSD 3-Clause License"
 exports.author = { name = "Carl" }
@@ -42,174 +42,78 @@ function cheatfind.startplugin()
 
 	-- save data block
 	function cheat.save(space, start, size)
-		local data = { block = "", start = start, size = size, space = space }
+		local data = { start = start, size = size, space = space }
 		if space.shortname then
 			if space:shortname() == "ram" then
-				data.block = emu.item(space.items["0/m_pointer"]):read_block(start, size)
-				if not data.block then
-					return nil
-				end
+				data.snap = emu.item(space.items["0/m_pointer"]):snapshot(start, size)
 			end
 		else
-			local block = ""
-			local temp = {}
-			local j = 1
-			for i = start, start + size do
-				if j < 65536 then
-					temp[j] = string.pack("B", space:read_u8(i))
-					j = j + 1
-				else
-					block = block .. table.concat(temp) .. string.pack("B", space:read_u8(i))
-					temp = {}
-					j = 1
-				end
-			end
-			block = block .. table.concat(temp)
-			data.block = block
+			data.snap = space:snapshot(start, size)
+		end
+		if not data.snap then
+			return nil
 		end
 		return data
 	end
 
-	-- compare two data blocks, format is as lua string.unpack, bne and beq val is table of masks
-	function cheat.comp(newdata, olddata, oper, format, val, bcd)
-		local ret = {}
-		local ref = {} -- this is a helper for comparing two match lists
-		local bitmask = nil
-
-		local cfoper = { 
-			lt = function(a, b, val) return (a < b and val == 0) or (val > 0 and (a + val) == b) end,
-			gt = function(a, b, val) return (a > b and val == 0) or (val > 0 and (a - val) == b) end,
-			eq = function(a, b, val) return a == b end,
-			ne = function(a, b, val) return (a ~= b and val == 0) or
-				(val > 0 and ((a - val) == b or (a + val) == b)) end,
-			ltv = function(a, b, val) return a < val end,
-			gtv = function(a, b, val) return a > val end,
-			eqv = function(a, b, val) return a == val end,
-			nev = function(a, b, val) return a ~= val end }
-
-		function cfoper.bne(a, b, val, addr)
-			if type(val) ~= "table" then
-				bitmask = a ~ b
-				return bitmask ~= 0
-			elseif not val[addr] then
-				return false
-			else
-				bitmask = (a ~ b) & val[addr]
-				return bitmask ~= 0
-			end
+	-- wrap a native match list so it can be used like a table of matches; entries are
+	-- only turned into tables when looked at, and are kept so they can hold menu state
+	local function wrap_matches(raw)
+		local list = { raw = raw }
+		local meta = {}
+		function meta.__len(t)
+			return t.raw and t.raw.count or 0
 		end
-
-		function cfoper.beq(a, b, val, addr)
-			if type(val) ~= "table" then
-				bitmask = ~a ~ b
-				return bitmask ~= 0
-			elseif not val[addr] then
-				return false
-			else
-				bitmask = (~a ~ b) & val[addr]
-				return bitmask ~= 0
+		function meta.__index(t, i)
+			if type(i) == "number" and t.raw then
+				local match = t.raw:get(i)
+				rawset(t, i, match)
+				return match
 			end
 		end
-
-
-		local function check_bcd(val)
-			local a = val + 0x0666666666666666
-			a = a ~ val
-			return (a & 0x1111111111111110) == 0
+		function meta.__pairs(t)
+			return function(t, i)
+				i = i + 1
+				if i <= #t then
+					return i, t[i]
+				end
+			end, t, 0
 		end
+		return setmetatable(list, meta)
+	end
 
-		local function frombcd(val)
-			local result = 0
-			local mul = 1
-			while val ~= 0 do
-				result = result + ((val % 16) * mul)
-				val = val >> 4
-				mul = mul * 10
-			end
-			return result
-		end
+	-- compare two data blocks, format is as lua string.unpack, bne and beq bitmasks are kept
+	-- from the previous matches when given; the comparison itself runs natively
+	function cheat.comp(newdata, olddata, oper, format, val, bcd, oldmatch)
+		local opers = { lt = true, gt = true, eq = true, ne = true, beq = true, bne = true,
+			ltv = true, gtv = true, eqv = true, nev = true }
 
 		if not newdata and oper:sub(3, 3) == "v" then
 			newdata = olddata
 		end
-		if olddata.start ~= newdata.start or olddata.size ~= newdata.size or not cfoper[oper] then
-			return {} 
-		end
-		if not val then
-			val = 0
+		if not newdata or not olddata or olddata.start ~= newdata.start or olddata.size ~= newdata.size or not opers[oper] then
+			return wrap_matches(nil)
 		end
-
-		for i = 1, olddata.size do
-			local old = string.unpack(format, olddata.block, i)
-			local new = string.unpack(format, newdata.block, i)
-			local oldc, newc = old, new
-			local comp = false
-			local addr = olddata.start + i - 1
-			if not bcd or (check_bcd(old) and check_bcd(new)) then
-				if bcd then
-					oldc = frombcd(old)
-					newc = frombcd(new)
-				end
-				if cfoper[oper](newc, oldc, val, addr) then
-					ret[#ret + 1] = { addr = addr,
-					oldval = old,
-					newval = new,
-					bitmask = bitmask }
-					ref[ret[#ret].addr] = #ret
-				end
-			end
-		end
-		return ret, ref
-	end
-
-	local function check_val(oper, val, matches)
-		if oper ~= "beq" and oper ~= "bne" then
-			return val
-		elseif not matches or not matches[1].bitmask then
-			return nil
-		end
-		local masks = {}
-		for num, match in pairs(matches) do
-			masks[match.addr] = match.bitmask
-		end
-		return masks
+		return wrap_matches(newdata.snap:compare(olddata.snap, oper, format, val or 0, bcd, oldmatch and oldmatch.raw))
 	end
 
 	-- compare two blocks and filter by table of previous matches
 	function cheat.compnext(newdata, olddata, oldmatch, oper, format, val, bcd)
-		local matches, refs = cheat.comp(newdata, olddata, oper, format, check_val(oper, val, oldmatch), bcd)
-		local nonmatch = {}
-		local oldrefs = {}
-		for num, match in pairs(oldmatch) do
-			oldrefs[match.addr] = num
-		end
-		for addr, ref in pairs(refs) do
-			if not oldrefs[addr] then
-				nonmatch[ref] = true
-				refs[addr] = nil
-			else
-				matches[ref].oldval = oldmatch[oldrefs[addr]].oldval
-			end
-		end
-		local resort = {}
-		for num, match in pairs(matches) do
-			if not nonmatch[num] then
-				resort[#resort + 1] = match
-			end
+		if not oldmatch.raw then
+			return wrap_matches(nil)
 		end
-		return resort 
+		return cheat.comp(newdata, olddata, oper, format, val, bcd, oldmatch)
 	end
-			 
 
 	-- compare a data block to the current state
 	function cheat.compcur(olddata, oper, format, val, bcd)
-		local newdata = cheat.save(olddata.space, olddata.start, olddata.size, olddata.space)
+		local newdata = cheat.save(olddata.space, olddata.start, olddata.size)
 		return cheat.comp(newdata, olddata, oper, format, val, bcd)
 	end
 
 	-- compare a data block to the current state and filter
 	function cheat.compcurnext(olddata, oldmatch, oper, format, val, bcd)
-		local newdata = cheat.save(olddata.space, olddata.start, olddata.size, olddata.space)
+		local newdata = cheat.save(olddata.space, olddata.start, olddata.size)
 		return cheat.compnext(newdata, olddata, oldmatch, oper, format, val, bcd)
 	end
 
@@ -49,13 +49,20 @@ function hiscore.startplugin()
 		  emu.print_verbose("hiscore: " .. space .. " space not found")
 		  return nil;
 		end
-		_table[ #_table + 1 ] = {
+		local row = {
 		  mem = mem,
 		  addr = tonumber(offs, 16),
 		  size = tonumber(len, 16),
 		  c_start = tonumber(chk_st, 16),
 		  c_end = tonumber(chk_ed, 16),
+		  addrs = {},
+		  values = {},
 		};
+		-- the whole row is read with one read_batch call every frame
+		for i=0,row["size"]-1 do
+		  row["addrs"][i+1] = row["addr"] + i;
+		end
+		_table[ #_table + 1 ] = row;
 	  end
 	  return _table;
 	end
@@ -141,10 +148,7 @@ function hiscore.startplugin()
 	  emu.print_verbose("hiscore: write_scores output")
 	  if output then
 		for ri,row in ipairs(posdata) do
-		  t = {};
-		  for i=0,row["size"]-1 do
-			t[i+1] = row["mem"]:read_u8(row["addr"] + i)
-		  end
+		  local t = row["mem"]:read_batch(row["addrs"], "u8");
 		  output:write(string.char(table.unpack(t)));
 		end
 		output:close();
@@ -173,9 +177,10 @@ function hiscore.startplugin()
 	local function check_scores ( posdata )
 	  local r = 0;
 	  for ri,row in ipairs(posdata) do
-	    for i=0,row["size"]-1 do
-		r = r + row["mem"]:read_u8( row["addr"] + i );
-	    end
+		row["mem"]:read_batch(row["addrs"], "u8", row["values"]);
+		for i,v in ipairs(row["values"]) do
+		  r = r + v;
+		end
 	  end
 	  return r;
 	end
@@ -59,16 +59,23 @@ project("benchmarks")
 
 	links {
 		"benchmark",
+		"utils",
+		ext_lib("expat"),
+		ext_lib("zlib"),
+		"ocore_" .. _OPTIONS["osd"],
 	}
 
 	includedirs {
 		MAME_DIR .. "3rdparty/benchmark/include",
 		MAME_DIR .. "src/osd",
+		MAME_DIR .. "src/lib/util",
+		ext_includedir("zlib"),
 	}
 
 	files {
 		MAME_DIR .. "benchmarks/main.cpp",
 		MAME_DIR .. "benchmarks/eminline_native.cpp",
 		MAME_DIR .. "benchmarks/eminline_noasm.cpp",
+		MAME_DIR .. "benchmarks/png.cpp",
 	}
 
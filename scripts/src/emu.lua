@@ -47,6 +47,8 @@ files {
 	MAME_DIR .. "src/emu/attotime.h",
 	MAME_DIR .. "src/emu/bookkeeping.cpp",
 	MAME_DIR .. "src/emu/bookkeeping.h",
+	MAME_DIR .. "src/emu/capture.cpp",
+	MAME_DIR .. "src/emu/capture.h",
 	MAME_DIR .. "src/emu/config.cpp",
 	MAME_DIR .. "src/emu/config.h",
 	MAME_DIR .. "src/emu/crsshair.cpp",
@@ -156,6 +158,8 @@ files {
 	MAME_DIR .. "src/emu/schedule.h",
 	MAME_DIR .. "src/emu/screen.cpp",
 	MAME_DIR .. "src/emu/screen.h",
+	MAME_DIR .. "src/emu/sndlog.cpp",
+	MAME_DIR .. "src/emu/sndlog.h",
 	MAME_DIR .. "src/emu/softlist.cpp",
 	MAME_DIR .. "src/emu/softlist.h",
 	MAME_DIR .. "src/emu/sound.cpp",
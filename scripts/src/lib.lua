@@ -81,6 +81,8 @@ project "utils"
 		MAME_DIR .. "src/lib/util/sha1.h",
 		MAME_DIR .. "src/lib/util/strformat.h",
 		MAME_DIR .. "src/lib/util/tagmap.h",
+		MAME_DIR .. "src/lib/util/trigram.cpp",
+		MAME_DIR .. "src/lib/util/trigram.h",
 		MAME_DIR .. "src/lib/util/unicode.cpp",
 		MAME_DIR .. "src/lib/util/unicode.h",
 		MAME_DIR .. "src/lib/util/unzip.cpp",
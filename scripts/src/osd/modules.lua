@@ -74,6 +74,7 @@ function osdmodulesbuild()
 		MAME_DIR .. "src/osd/modules/sound/coreaudio_sound.cpp",
 		MAME_DIR .. "src/osd/modules/sound/sdl_sound.cpp",
 		MAME_DIR .. "src/osd/modules/sound/xaudio2_sound.cpp",
+		MAME_DIR .. "src/osd/modules/sound/file_sound.cpp",
 		MAME_DIR .. "src/osd/modules/sound/none.cpp",
 		MAME_DIR .. "src/osd/modules/input/input_module.h",
 		MAME_DIR .. "src/osd/modules/input/input_common.cpp",
@@ -113,6 +114,7 @@ function osdmodulesbuild()
 	}
 	includedirs {
 		ext_includedir("uv"),
+		ext_includedir("flac"),
 	}
 
 	if _OPTIONS["targetos"]=="windows" then
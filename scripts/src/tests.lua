@@ -79,6 +79,7 @@ project("mametests")
 	files {
 		MAME_DIR .. "tests/main.cpp",
 		MAME_DIR .. "tests/lib/util/corestr.cpp",
+		MAME_DIR .. "tests/lib/util/trigram.cpp",
 		MAME_DIR .. "tests/emu/attotime.cpp",
 	}
 
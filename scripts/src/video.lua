@@ -542,18 +542,6 @@ if (VIDEOS["PCD8544"]~=null) then
 	}
 end
 
---------------------------------------------------
---
---@src/devices/video/polylgcy.h,VIDEOS["POLY"] = true
---------------------------------------------------
-
-if (VIDEOS["POLY"]~=null) then
-	files {
-		MAME_DIR .. "src/devices/video/polylgcy.cpp",
-		MAME_DIR .. "src/devices/video/polylgcy.h",
-	}
-end
-
 --------------------------------------------------
 --
 --@src/devices/video/psx.h,VIDEOS["PSX"] = true
@@ -0,0 +1,74 @@
+-- license:BSD-3-Clause
+-- copyright-holders:MAMEdev Team
+
+---------------------------------------------------------------------------
+--
+--   sndreplay.lua
+--
+--   Sound register log replay systems (see src/mame/drivers/sndreplay.cpp)
+--   Use make SUBTARGET=sndreplay to build
+--
+---------------------------------------------------------------------------
+
+
+--------------------------------------------------
+-- Specify all the sound cores necessary for the
+-- drivers referenced in sndreplay.lst.
+--------------------------------------------------
+
+SOUNDS["AY8910"] = true
+SOUNDS["YM2151"] = true
+SOUNDS["YM2203"] = true
+SOUNDS["YM2608"] = true
+SOUNDS["YM2610"] = true
+SOUNDS["YM2610B"] = true
+SOUNDS["YMF262"] = true
+SOUNDS["YM3526"] = true
+SOUNDS["YM3812"] = true
+SOUNDS["Y8950"] = true
+SOUNDS["YMF271"] = true
+SOUNDS["ES5505"] = true
+SOUNDS["ES5506"] = true
+
+--------------------------------------------------
+-- specify available bus cores
+--------------------------------------------------
+
+-- not needed by sndreplay.lua but build system wants at least one bus
+BUSES["CENTRONICS"] = true
+
+--------------------------------------------------
+-- This is the list of files that are necessary
+-- for building all of the drivers referenced
+-- in sndreplay.lst
+--------------------------------------------------
+
+function createProjects_mame_sndreplay(_target, _subtarget)
+	project ("mame_sndreplay")
+	targetsubdir(_target .."_" .. _subtarget)
+	kind (LIBTYPE)
+	uuid (os.uuid("drv-mame-sndreplay"))
+	addprojectflags()
+	precompiledheaders()
+
+	includedirs {
+		MAME_DIR .. "src/osd",
+		MAME_DIR .. "src/emu",
+		MAME_DIR .. "src/devices",
+		MAME_DIR .. "src/mame",
+		MAME_DIR .. "src/lib",
+		MAME_DIR .. "src/lib/util",
+		MAME_DIR .. "3rdparty",
+		GEN_DIR  .. "mame/layout",
+	}
+
+files{
+	MAME_DIR .. "src/mame/drivers/sndreplay.cpp",
+}
+end
+
+function linkProjects_mame_sndreplay(_target, _subtarget)
+	links {
+		"mame_sndreplay",
+	}
+end
@@ -55,6 +55,8 @@ READ8_MEMBER( ym2151_device::read )
 
 WRITE8_MEMBER( ym2151_device::write )
 {
+	log_register_write(offset, data, mem_mask);
+
 	if (offset & 1)
 	{
 		m_stream->update();
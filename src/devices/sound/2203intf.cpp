@@ -163,6 +163,8 @@ READ8_MEMBER( ym2203_device::read )
 
 WRITE8_MEMBER( ym2203_device::write )
 {
+	log_register_write(offset, data, mem_mask);
+
 	ym2203_write(m_chip, offset & 1, data);
 }
 
@@ -180,6 +180,8 @@ READ8_MEMBER( ym2608_device::read )
 
 WRITE8_MEMBER( ym2608_device::write )
 {
+	log_register_write(offset, data, mem_mask);
+
 	ym2608_write(m_chip, offset & 3, data);
 }
 
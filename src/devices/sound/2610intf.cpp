@@ -15,6 +15,7 @@
 
 #include "2610intf.h"
 #include "fm.h"
+#include "sndlog.h"
 
 const char* YM2610_TAG = "ymsnd";
 const char* YM2610_DELTAT_TAG = "ymsnd.deltat";
@@ -137,6 +138,21 @@ void ym2610_device::device_post_load()
 }
 
 
+//-------------------------------------------------
+//  sound_log_memory - add the ADPCM-A ROM, and the
+//  ADPCM-B ROM if it is separate, to a register log
+//-------------------------------------------------
+
+void ym2610_device::sound_log_memory(sound_log_writer &log)
+{
+	log.add_memory(0, *m_region);
+
+	std::string name = tag() + std::string(".deltat");
+	memory_region *deltat_region = machine().root_device().memregion(name.c_str());
+	if (deltat_region != nullptr && deltat_region->base() != nullptr && deltat_region->bytes() != 0)
+		log.add_memory(1, *deltat_region);
+}
+
 //-------------------------------------------------
 //  device_start - device-specific startup
 //-------------------------------------------------
@@ -203,6 +219,8 @@ READ8_MEMBER( ym2610_device::read )
 
 WRITE8_MEMBER( ym2610_device::write )
 {
+	log_register_write(offset, data, mem_mask);
+
 	ym2610_write(m_chip, offset & 3, data);
 }
 
@@ -132,6 +132,8 @@ READ8_MEMBER( ymf262_device::read )
 
 WRITE8_MEMBER( ymf262_device::write )
 {
+	log_register_write(offset, data, mem_mask);
+
 	ymf262_write(m_chip, offset & 3, data);
 }
 
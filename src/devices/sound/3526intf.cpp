@@ -143,6 +143,8 @@ READ8_MEMBER( ym3526_device::read )
 
 WRITE8_MEMBER( ym3526_device::write )
 {
+	log_register_write(offset, data, mem_mask);
+
 	ym3526_write(m_chip, offset & 1, data);
 }
 
@@ -141,6 +141,8 @@ READ8_MEMBER( ym3812_device::read )
 
 WRITE8_MEMBER( ym3812_device::write )
 {
+	log_register_write(offset, data, mem_mask);
+
 	ym3812_write(m_chip, offset & 1, data);
 }
 
@@ -20,6 +20,7 @@
 ******************************************************************************/
 #include "8950intf.h"
 #include "fmopl.h"
+#include "sndlog.h"
 
 
 static void IRQHandler(void *param,int irq)
@@ -131,6 +132,16 @@ void y8950_device::_y8950_update_request()
 }
 
 
+//-------------------------------------------------
+//  sound_log_memory - add the ADPCM ROM to a
+//  register log
+//-------------------------------------------------
+
+void y8950_device::sound_log_memory(sound_log_writer &log)
+{
+	log.add_memory(0, *m_region);
+}
+
 //-------------------------------------------------
 //  device_start - device-specific startup
 //-------------------------------------------------
@@ -192,6 +203,8 @@ READ8_MEMBER( y8950_device::read )
 
 WRITE8_MEMBER( y8950_device::write )
 {
+	log_register_write(offset, data, mem_mask);
+
 	y8950_write(m_chip, offset & 1, data);
 }
 
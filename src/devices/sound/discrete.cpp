@@ -40,6 +40,8 @@
 #include "discrete.h"
 #include <atomic>
 #include <iostream>
+#include <numeric>
+#include <thread>
 
 /* for_each collides with c++ standard libraries - include it here */
 #define for_each(_T, _e, _l) for (_T _e = (_l)->begin_ptr() ;  _e <= (_l)->end_ptr(); _e++)
@@ -82,6 +84,15 @@ const device_type DISCRETE = &device_creator<discrete_sound_device>;
 
 #define USE_DISCRETE_TASKS          (1)
 
+/*
+ * Drivers without DISCRETE_TASK_START/END get their node graph
+ * partitioned automatically: independent sub-circuits run as
+ * parallel tasks feeding one task with the shared tail (mixers,
+ * outputs).
+ */
+
+#define USE_DISCRETE_AUTO_TASKS     (1)
+
 /*************************************
  *
  *  Internal classes
@@ -96,11 +107,16 @@ struct output_buffer
 	int                         node_num;
 };
 
+class discrete_task;
+
 struct input_buffer
 {
 	volatile const double       *ptr;               /* pointer into linked_outbuf.nodebuf */
 	output_buffer *             linked_outbuf;      /* what output are we connected to ? */
+	discrete_task *             linked_task;        /* task owning linked_outbuf */
+	int                         linked_index;       /* index of linked_outbuf in its m_buffers */
 	double                      buffer;             /* input[] will point here */
+	const double **             input;              /* the input slot to point at buffer */
 };
 
 class discrete_task
@@ -304,14 +320,12 @@ void discrete_task::check(discrete_task *dest_task)
 					{
 						input_buffer source;
 						int i, found = -1;
-						output_buffer *pbuf = nullptr;
 
 						for (i = 0; i < m_buffers.count(); i++)
 //                          if (m_buffers[i].node->block_node() == inputnode_num)
 							if (m_buffers[i].node_num == inputnode_num)
 							{
 								found = i;
-								pbuf = &m_buffers[i];
 								break;
 							}
 
@@ -325,8 +339,8 @@ void discrete_task::check(discrete_task *dest_task)
 							buf.source = dest_node->m_input[inputnum];
 							buf.node_num = inputnode_num;
 							//buf.node = device->discrete_find_node(inputnode);
-							m_buffers.count();
-							pbuf = m_buffers.add(buf);
+							found = m_buffers.count();
+							m_buffers.add(buf);
 						}
 						m_device.discrete_log("dso_task_start - buffering %d(%d) in task %p group %d referenced by %d group %d", NODE_INDEX(inputnode_num), NODE_CHILD_NODE_NUM(inputnode_num), this, task_group, dest_node->index(), dest_task->task_group);
 
@@ -334,9 +348,13 @@ void discrete_task::check(discrete_task *dest_task)
 						//source = auto_alloc(device->machine(), discrete_source_node);
 						//source.task = this;
 						//source.output_node = i;
-						source.linked_outbuf = pbuf;
+						/* m_buffers may still grow, so the pointer is only set once all tasks are checked */
+						source.linked_outbuf = nullptr;
+						source.linked_task = this;
+						source.linked_index = found;
 						source.buffer = 0.0; /* please compiler */
 						source.ptr = nullptr;
+						source.input = &dest_node->m_input[inputnum];
 						dest_task->source_list.add(source);
 
 						/* point the input to a buffered location */
@@ -455,6 +473,10 @@ const double *discrete_device::node_output_ptr(int onode)
 	const discrete_base_node *node;
 	node = discrete_find_node(onode);
 
+	/* remember the reference so auto_tasks keeps both nodes together */
+	if (m_starting_node != nullptr)
+		m_hidden_inputs.emplace_back(m_starting_node, onode);
+
 	if (node != nullptr)
 	{
 		return &(node->m_output[NODE_CHILD_NODE_NUM(onode)]);
@@ -659,12 +681,15 @@ void discrete_device::display_profiling(void)
 				util::stream_format(std::cout, "%3d: %20s %8.2f %10.2f\n", (*node)->index(), (*node)->module_name(), double(step->run_time) / double(total) * 100.0, double(step->run_time) / double(m_total_samples));
 	}
 
-	/* Task information */
+	/* Task information; DISCRETE_PROFILING=2 also lists every node with its task */
 	for_each(discrete_task **, task, &task_list)
 	{
 		tt =  step_list_run_time((*task)->step_list);
 
-		util::stream_format(std::cout, "Task(%d): %8.2f %15.2f\n", (*task)->task_group, tt / double(total) * 100.0, tt / double(m_total_samples));
+		util::stream_format(std::cout, "Task(%d)%s: %3d nodes %8.2f %15.2f\n", (*task)->task_group, m_auto_tasks ? " auto" : "", (*task)->step_list.count(), tt / double(total) * 100.0, tt / double(m_total_samples));
+		if (m_profiling >= 2)
+			for_each(discrete_step_interface **, step, &(*task)->step_list)
+				util::stream_format(std::cout, "    %3d: %20s %8.2f %10.2f\n", (*step)->self->index(), (*step)->self->module_name(), double((*step)->run_time) / double(total) * 100.0, double((*step)->run_time) / double(m_total_samples));
 	}
 
 	util::stream_format(std::cout, "Average samples/double->update: %8.2f\n", double(m_total_samples) / double(m_total_stream_updates));
@@ -698,10 +723,12 @@ void discrete_device::init_nodes(const sound_block_list_t &block_list)
 	{
 		/* make sure we have one simple task
 		 * No need to create a node since there are no dependencies.
+		 * auto_tasks may split it up once all nodes have started.
 		 */
 		task = auto_alloc_clear(machine(), <discrete_task>(*this));
 		task_list.add(task);
 	}
+	m_auto_tasks = USE_DISCRETE_TASKS && USE_DISCRETE_AUTO_TASKS && !has_tasks;
 
 	/* loop over all nodes */
 	for (int i = 0; i < block_list.count(); i++)
@@ -794,6 +821,191 @@ void discrete_device::init_nodes(const sound_block_list_t &block_list)
 }
 
 
+/*************************************
+ *
+ *  Automatic task partitioning
+ *
+ *************************************/
+
+/*
+ * The stepping nodes run in list order, so a node reading an earlier
+ * node sees this sample's value and one reading a later node (or
+ * itself) sees the previous sample's. The second kind, and references
+ * taken with node_output_ptr() in start(), pin both nodes to the same
+ * task; everything else is a forward edge. All noise generators are
+ * pinned together as well, since they share the machine's random
+ * number generator.
+ *
+ * The list is then cut into a head and a tail. The tail is a suffix
+ * of the list plus anything the suffix feeds, and runs as the last
+ * task; the head falls apart into independent sub-circuits which are
+ * packed onto the worker threads. Every cut is tried and the one with
+ * the shortest critical path (in nodes) wins. Only edges from the head
+ * into the tail need buffering, which check() sets up as for manual
+ * tasks.
+ */
+
+void discrete_device::auto_tasks(void)
+{
+	discrete_task *single = task_list[0];
+	int const count = single->step_list.count();
+	if (count < 2)
+		return;
+
+	int const workers = MAX(1, MIN(int(std::thread::hardware_concurrency()), WORK_MAX_THREADS));
+
+	std::vector<discrete_step_interface *> steps(single->step_list.begin_ptr(), single->step_list.begin_ptr() + count);
+	std::vector<int> position(DISCRETE_MAX_NODES, -1);
+	for (int i = 0; i < count; i++)
+		position[NODE_INDEX(steps[i]->self->block_node())] = i;
+
+	/* union-find over list positions */
+	auto find = [](std::vector<int> &set, int n) { while (set[n] != n) n = set[n] = set[set[n]]; return n; };
+	auto join = [&find](std::vector<int> &set, int a, int b) { a = find(set, a); b = find(set, b); if (a != b) set[MAX(a, b)] = MIN(a, b); };
+
+	/* forward edges become predecessors, everything else must share a task */
+	std::vector<int> pinned(count);
+	std::iota(pinned.begin(), pinned.end(), 0);
+	std::vector<std::vector<int>> preds(count);
+	for (int i = 0; i < count; i++)
+	{
+		discrete_base_node *node = steps[i]->self;
+		for (int inputnum = 0; inputnum < node->active_inputs(); inputnum++)
+		{
+			int const inputnode = node->input_node(inputnum);
+			if (!IS_VALUE_A_NODE(inputnode) || position[NODE_INDEX(inputnode)] < 0)
+				continue;
+			int const p = position[NODE_INDEX(inputnode)];
+			if (p < i)
+				preds[i].push_back(p);
+			else
+				join(pinned, p, i);
+		}
+	}
+	for (auto &hidden : m_hidden_inputs)
+	{
+		int const c = position[NODE_INDEX(hidden.first->block_node())];
+		int const p = (hidden.second >= NODE_START && hidden.second <= NODE_END) ? position[NODE_INDEX(hidden.second)] : -1;
+		if (c >= 0 && p >= 0)
+			join(pinned, p, c);
+	}
+
+	/* noise nodes draw from the shared machine().rand(); keeping them in one
+	 * task keeps the sequence, and so the output, deterministic */
+	int firstnoise = -1;
+	for (int i = 0; i < count; i++)
+		if (dynamic_cast<DISCRETE_CLASS_NAME(dss_noise) *>(steps[i]->self) != nullptr)
+		{
+			if (firstnoise < 0)
+				firstnoise = i;
+			else
+				join(pinned, firstnoise, i);
+		}
+
+	/* try every cut */
+	int best_cost = count, best_cut = -1;
+	std::vector<bool> best_tail;
+	std::vector<int> best_component;
+	for (int cut = 1; cut <= count; cut++)
+	{
+		/* the suffix, whole pinned groups of it, and everything downstream */
+		std::vector<bool> grouptail(count, false), tail(count, false);
+		for (int i = cut; i < count; i++)
+			grouptail[find(pinned, i)] = true;
+		for (bool changed = true; changed; )
+		{
+			changed = false;
+			for (int i = 0; i < count; i++)
+			{
+				int const root = find(pinned, i);
+				if (!grouptail[root])
+					for (int p : preds[i])
+						if (grouptail[find(pinned, p)])
+						{
+							grouptail[root] = changed = true;
+							break;
+						}
+			}
+		}
+		int tailsize = 0;
+		for (int i = 0; i < count; i++)
+			if ((tail[i] = grouptail[find(pinned, i)]))
+				tailsize++;
+
+		/* sub-circuits of the head */
+		std::vector<int> component(pinned);
+		for (int i = 0; i < count; i++)
+			if (!tail[i])
+				for (int p : preds[i])
+					join(component, p, i);
+		std::vector<int> sizes(count, 0);
+		for (int i = 0; i < count; i++)
+			if (!tail[i])
+				sizes[find(component, i)]++;
+		std::sort(sizes.begin(), sizes.end(), std::greater<int>());
+		if (sizes.size() < 2 || sizes[1] == 0)
+			continue;
+
+		/* longest-first onto the least loaded worker */
+		std::vector<int> load(workers, 0);
+		for (int size : sizes)
+			*std::min_element(load.begin(), load.end()) += size;
+		int const cost = *std::max_element(load.begin(), load.end()) + tailsize;
+		if (cost < best_cost)
+		{
+			best_cost = cost;
+			best_cut = cut;
+			best_tail = tail;
+			best_component = component;
+		}
+	}
+
+	/* not worth the buffering unless it takes a real bite out of the serial time */
+	if (best_cut < 0 || best_cost * 4 > count * 3)
+		return;
+
+	/* one task per sub-circuit, packed the same way as above, then the tail */
+	std::vector<int> sizes(count, 0);
+	for (int i = 0; i < count; i++)
+		if (!best_tail[i])
+			sizes[find(best_component, i)]++;
+	std::vector<int> roots;
+	for (int i = 0; i < count; i++)
+		if (sizes[i] != 0)
+			roots.push_back(i);
+	std::sort(roots.begin(), roots.end(), [&sizes](int a, int b) { return sizes[a] > sizes[b]; });
+
+	std::vector<discrete_task *> bins(MIN(workers, int(roots.size())), nullptr);
+	std::vector<int> load(bins.size(), 0);
+	std::vector<discrete_task *> task_of(count, single);
+	for (int root : roots)
+	{
+		int const bin = std::min_element(load.begin(), load.end()) - load.begin();
+		if (bins[bin] == nullptr)
+			bins[bin] = auto_alloc_clear(machine(), <discrete_task>(*this));
+		load[bin] += sizes[root];
+		task_of[root] = bins[bin];
+	}
+
+	single->step_list.clear();
+	single->task_group = 1;
+	for (int i = 0; i < count; i++)
+		if (best_tail[i])
+			single->step_list.add(steps[i]);
+		else
+			task_of[find(best_component, i)]->step_list.add(steps[i]);
+
+	task_list.clear();
+	for (discrete_task *task : bins)
+		task_list.add(task);
+	if (single->step_list.count() != 0)
+		task_list.add(single);
+
+	discrete_log("auto_tasks - %d nodes split into %d parallel tasks and a tail of %d, critical path %d",
+			count, int(bins.size()), single->step_list.count(), best_cost);
+}
+
+
 /*************************************
  *
  *  node_description implementation
@@ -842,6 +1054,8 @@ discrete_device::discrete_device(const machine_config &mconfig, device_type type
 		m_sample_time(0),
 		m_neg_sample_time(0),
 		m_indexed_node(nullptr),
+		m_auto_tasks(false),
+		m_starting_node(nullptr),
 		m_disclogfile(nullptr),
 		m_queue(nullptr),
 		m_profiling(0),
@@ -920,8 +1134,14 @@ void discrete_device::device_start()
 	/* Process nodes which have a start func */
 	for_each(discrete_base_node **, node, &m_node_list)
 	{
+		m_starting_node = *node;
 		(*node)->start();
 	}
+	m_starting_node = nullptr;
+
+	/* split up drivers that didn't do it themselves */
+	if (m_auto_tasks)
+		auto_tasks();
 
 	/* Now set up tasks */
 	for_each(discrete_task **, task, &task_list)
@@ -932,6 +1152,14 @@ void discrete_device::device_start()
 				(*dest_task)->check((*task));
 		}
 	}
+
+	/* source_list and m_buffers may have moved while they grew, so only now link them up */
+	for_each(discrete_task **, task, &task_list)
+		for_each(input_buffer *, sn, &(*task)->source_list)
+		{
+			*sn->input = &sn->buffer;
+			sn->linked_outbuf = &sn->linked_task->m_buffers[sn->linked_index];
+		}
 }
 
 void discrete_device::device_stop()
@@ -4345,12 +4345,18 @@ private:
 	void discrete_sanity_check(const sound_block_list_t &block_list);
 	void display_profiling(void);
 	void init_nodes(const sound_block_list_t &block_list);
+	void auto_tasks(void);
 
 	/* internal node tracking */
 	discrete_base_node **   m_indexed_node;
 
 	/* tasks */
 	task_list_t             task_list;      /* discrete_task_context * */
+	bool                    m_auto_tasks;   /* no DISCRETE_TASK_START, partition automatically */
+
+	/* node_output_ptr() references taken in start(), invisible to the input lists */
+	discrete_base_node *    m_starting_node;
+	std::vector<std::pair<discrete_base_node *, int>> m_hidden_inputs;
 
 	/* debugging statistics */
 	FILE *                  m_disclogfile;
@@ -84,6 +84,7 @@ Ensoniq OTIS - ES5505                                            Ensoniq OTTO -
 
 #include "emu.h"
 #include "es5506.h"
+#include "sndlog.h"
 
 
 /**********************************************************************************************
@@ -177,6 +178,24 @@ void es550x_device::device_start()
 {
 }
 
+//-------------------------------------------------
+//  sound_log_memory - add the sample ROMs to a
+//  register log
+//-------------------------------------------------
+
+void es550x_device::sound_log_memory(sound_log_writer &log)
+{
+	const char *const regions[4] = { m_region0, m_region1, m_region2, m_region3 };
+
+	for (int i = 0; i < 4; i++)
+		if (regions[i] != nullptr)
+		{
+			memory_region *region = machine().root_device().memregion(regions[i]);
+			if (region != nullptr)
+				log.add_memory(i, *region);
+		}
+}
+
 void es5506_device::device_start()
 {
 	int j;
@@ -1410,6 +1429,8 @@ inline void es5506_device::reg_write_test(es550x_voice *voice, offs_t offset, UI
 
 WRITE8_MEMBER( es5506_device::write )
 {
+	log_register_write(offset, data, mem_mask);
+
 	es550x_voice *voice = &m_voice[m_current_page & 0x1f];
 	int shift = 8 * (offset & 3);
 
@@ -1964,6 +1985,8 @@ inline void es5505_device::reg_write_test(es550x_voice *voice, offs_t offset, UI
 
 WRITE16_MEMBER( es5505_device::write )
 {
+	log_register_write(offset, data, mem_mask);
+
 	es550x_voice *voice = &m_voice[m_current_page & 0x1f];
 
 //  logerror("%s:ES5505 write %02x/%02x = %04x & %04x\n", machine().describe_context(), m_current_page, offset, data, mem_mask);
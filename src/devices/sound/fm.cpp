@@ -162,6 +162,12 @@
 #define EG_REL          1
 #define EG_OFF          0
 
+#if FM_INTERNAL_TIMER
+#define OPN_BLOCK_SAMPLES   1   /* timer A can key on channels (CSM) after any sample */
+#else
+#define OPN_BLOCK_SAMPLES   64  /* samples rendered channel by channel in one go */
+#endif
+
 #define SIN_BITS        10
 #define SIN_LEN         (1<<SIN_BITS)
 #define SIN_MASK        (SIN_LEN-1)
@@ -1109,7 +1115,7 @@ static inline void advance_lfo(FM_OPN *OPN)
 }
 
 /* changed from static inline to static here to work around gcc 4.2.1 codegen bug */
-static void advance_eg_channel(FM_OPN *OPN, FM_SLOT *SLOT)
+static void advance_eg_channel(UINT32 eg_cnt, FM_SLOT *SLOT)
 {
 	unsigned int out;
 	unsigned int swap_flag;
@@ -1125,10 +1131,10 @@ static void advance_eg_channel(FM_OPN *OPN, FM_SLOT *SLOT)
 		switch(SLOT->state)
 		{
 		case EG_ATT:        /* attack phase */
-			if ( !(OPN->eg_cnt & ((1<<SLOT->eg_sh_ar)-1) ) )
+			if ( !(eg_cnt & ((1<<SLOT->eg_sh_ar)-1) ) )
 			{
 				SLOT->volume += (~SLOT->volume *
-									(eg_inc[SLOT->eg_sel_ar + ((OPN->eg_cnt>>SLOT->eg_sh_ar)&7)])
+									(eg_inc[SLOT->eg_sel_ar + ((eg_cnt>>SLOT->eg_sh_ar)&7)])
 								) >>4;
 
 				if (SLOT->volume <= MIN_ATT_INDEX)
@@ -1143,9 +1149,9 @@ static void advance_eg_channel(FM_OPN *OPN, FM_SLOT *SLOT)
 			{
 				if (SLOT->ssg&0x08) /* SSG EG type envelope selected */
 				{
-					if ( !(OPN->eg_cnt & ((1<<SLOT->eg_sh_d1r)-1) ) )
+					if ( !(eg_cnt & ((1<<SLOT->eg_sh_d1r)-1) ) )
 					{
-						SLOT->volume += 4 * eg_inc[SLOT->eg_sel_d1r + ((OPN->eg_cnt>>SLOT->eg_sh_d1r)&7)];
+						SLOT->volume += 4 * eg_inc[SLOT->eg_sel_d1r + ((eg_cnt>>SLOT->eg_sh_d1r)&7)];
 
 						if ( SLOT->volume >= (INT32)(SLOT->sl) )
 							SLOT->state = EG_SUS;
@@ -1153,9 +1159,9 @@ static void advance_eg_channel(FM_OPN *OPN, FM_SLOT *SLOT)
 				}
 				else
 				{
-					if ( !(OPN->eg_cnt & ((1<<SLOT->eg_sh_d1r)-1) ) )
+					if ( !(eg_cnt & ((1<<SLOT->eg_sh_d1r)-1) ) )
 					{
-						SLOT->volume += eg_inc[SLOT->eg_sel_d1r + ((OPN->eg_cnt>>SLOT->eg_sh_d1r)&7)];
+						SLOT->volume += eg_inc[SLOT->eg_sel_d1r + ((eg_cnt>>SLOT->eg_sh_d1r)&7)];
 
 						if ( SLOT->volume >= (INT32)(SLOT->sl) )
 							SLOT->state = EG_SUS;
@@ -1167,9 +1173,9 @@ static void advance_eg_channel(FM_OPN *OPN, FM_SLOT *SLOT)
 		case EG_SUS:    /* sustain phase */
 			if (SLOT->ssg&0x08) /* SSG EG type envelope selected */
 			{
-				if ( !(OPN->eg_cnt & ((1<<SLOT->eg_sh_d2r)-1) ) )
+				if ( !(eg_cnt & ((1<<SLOT->eg_sh_d2r)-1) ) )
 				{
-					SLOT->volume += 4 * eg_inc[SLOT->eg_sel_d2r + ((OPN->eg_cnt>>SLOT->eg_sh_d2r)&7)];
+					SLOT->volume += 4 * eg_inc[SLOT->eg_sel_d2r + ((eg_cnt>>SLOT->eg_sh_d2r)&7)];
 
 					if ( SLOT->volume >= ENV_QUIET )
 					{
@@ -1205,9 +1211,9 @@ static void advance_eg_channel(FM_OPN *OPN, FM_SLOT *SLOT)
 			}
 			else
 			{
-				if ( !(OPN->eg_cnt & ((1<<SLOT->eg_sh_d2r)-1) ) )
+				if ( !(eg_cnt & ((1<<SLOT->eg_sh_d2r)-1) ) )
 				{
-					SLOT->volume += eg_inc[SLOT->eg_sel_d2r + ((OPN->eg_cnt>>SLOT->eg_sh_d2r)&7)];
+					SLOT->volume += eg_inc[SLOT->eg_sel_d2r + ((eg_cnt>>SLOT->eg_sh_d2r)&7)];
 
 					if ( SLOT->volume >= MAX_ATT_INDEX )
 					{
@@ -1220,10 +1226,10 @@ static void advance_eg_channel(FM_OPN *OPN, FM_SLOT *SLOT)
 		break;
 
 		case EG_REL:    /* release phase */
-				if ( !(OPN->eg_cnt & ((1<<SLOT->eg_sh_rr)-1) ) )
+				if ( !(eg_cnt & ((1<<SLOT->eg_sh_rr)-1) ) )
 				{
 					/* SSG-EG affects Release phase also (Nemesis) */
-					SLOT->volume += eg_inc[SLOT->eg_sel_rr + ((OPN->eg_cnt>>SLOT->eg_sh_rr)&7)];
+					SLOT->volume += eg_inc[SLOT->eg_sel_rr + ((eg_cnt>>SLOT->eg_sh_rr)&7)];
 
 					if ( SLOT->volume >= MAX_ATT_INDEX )
 					{
@@ -1419,6 +1425,109 @@ static inline void chan_calc(FM_OPN *OPN, FM_CH *CH, int chnum)
 	}
 }
 
+/* mask of channels that may produce output in the next block; a channel whose slots are all keyed off and fully released, with
+   its feedback and MEM history drained, adds exactly zero until it is keyed
+   on again, and key on resets the phase counters chan_calc() would advance */
+static inline UINT32 OPN_active_channels(FM_OPN *OPN, FM_CH **cch, int count)
+{
+#if FM_INTERNAL_TIMER
+	/* CSM mode can key a channel on from inside the update loop */
+	if (OPN->ST.mode & 0x80)
+		return (1 << count) - 1;
+#endif
+
+	UINT32 active = 0;
+	for (int c = 0; c < count; c++)
+	{
+		const FM_CH *CH = cch[c];
+		bool silent = (CH->op1_out[0] == 0) && (CH->op1_out[1] == 0) && (CH->mem_value == 0);
+		for (int s = 0; silent && s < 4; s++)
+			silent = (CH->SLOT[s].state == EG_OFF) && !CH->SLOT[s].key && (CH->SLOT[s].vol_out >= ENV_QUIET);
+		if (!silent)
+			active |= 1 << c;
+	}
+	return active;
+}
+
+/* chip-wide generator values for each sample of a block, and the FM output
+   of each channel; the envelope counter is given before each sample's
+   ticks, plus the final count */
+struct OPN_BLOCK
+{
+	int     length;
+	UINT32  eg_cnt[OPN_BLOCK_SAMPLES+1];
+	UINT32  LFO_AM[OPN_BLOCK_SAMPLES];
+	INT32   LFO_PM[OPN_BLOCK_SAMPLES];
+	INT32   out_fm[6][OPN_BLOCK_SAMPLES];
+};
+
+/* run a channel's envelopes through the ticks of sample i of a block */
+static inline void OPN_advance_eg(const OPN_BLOCK *blk, FM_CH *CH, int i)
+{
+	for (UINT32 cnt = blk->eg_cnt[i]; cnt != blk->eg_cnt[i+1]; )
+		advance_eg_channel(++cnt, &CH->SLOT[SLOT1]);
+}
+
+/* render the FM channels for a block into blk->out_fm, one channel at a
+   time; eg_first says whether the envelopes tick before or after each
+   sample's output, which differs between the chips */
+static void OPN_render_block(FM_OPN *OPN, OPN_BLOCK *blk, FM_CH **cch, const UINT8 *chnum, int count, bool lfo, bool eg_first)
+{
+	UINT32 active = OPN_active_channels(OPN, cch, count);
+	UINT32 eg_cnt = OPN->eg_cnt;
+
+	for (int i = 0; i < blk->length; i++)
+	{
+		if (lfo)
+			advance_lfo(OPN);
+		blk->LFO_AM[i] = OPN->LFO_AM;
+		blk->LFO_PM[i] = OPN->LFO_PM;
+
+		blk->eg_cnt[i] = eg_cnt;
+		OPN->eg_timer += OPN->eg_timer_add;
+		while (OPN->eg_timer >= OPN->eg_timer_overflow)
+		{
+			OPN->eg_timer -= OPN->eg_timer_overflow;
+			eg_cnt++;
+		}
+	}
+	blk->eg_cnt[blk->length] = eg_cnt;
+	OPN->eg_cnt = eg_cnt;
+
+	for (int c = 0; c < count; c++)
+	{
+		FM_CH *CH = cch[c];
+		INT32 *out = blk->out_fm[chnum[c]];
+
+		if (active & (1 << c))
+		{
+			for (int i = 0; i < blk->length; i++)
+			{
+				if (eg_first)
+					OPN_advance_eg(blk, CH, i);
+
+				OPN->LFO_AM = blk->LFO_AM[i];
+				OPN->LFO_PM = blk->LFO_PM[i];
+				OPN->out_fm[chnum[c]] = 0;
+				chan_calc(OPN, CH, chnum[c]);
+				out[i] = OPN->out_fm[chnum[c]];
+
+				if (!eg_first)
+					OPN_advance_eg(blk, CH, i);
+			}
+		}
+		else
+		{
+			/* a silent channel's phases restart at key on */
+			memset(out, 0, sizeof(out[0]) * blk->length);
+			for (UINT32 cnt = blk->eg_cnt[0]; cnt != blk->eg_cnt[blk->length]; )
+				advance_eg_channel(++cnt, &CH->SLOT[SLOT1]);
+		}
+	}
+	OPN->LFO_AM = blk->LFO_AM[blk->length-1];
+	OPN->LFO_PM = blk->LFO_PM[blk->length-1];
+}
+
 /* update phase increment and envelope generator */
 static inline void refresh_fc_eg_slot(FM_OPN *OPN, FM_SLOT *SLOT , int fc , int kc )
 {
@@ -2132,50 +2241,41 @@ void ym2203_update_one(void *chip, FMSAMPLE *buffer, int length)
 	OPN->LFO_PM = 0;
 
 	/* buffering */
-	for (i=0; i < length ; i++)
+	OPN_BLOCK blk;
+	static const UINT8 chnum[3] = { 0, 1, 2 };
+	for (int done = 0; done < length; done += blk.length)
 	{
-		/* clear outputs */
-		OPN->out_fm[0] = 0;
-		OPN->out_fm[1] = 0;
-		OPN->out_fm[2] = 0;
+		blk.length = std::min(length - done, OPN_BLOCK_SAMPLES);
+		OPN_render_block(OPN, &blk, cch, chnum, 3, false, true);
 
-		/* advance envelope generator */
-		OPN->eg_timer += OPN->eg_timer_add;
-		while (OPN->eg_timer >= OPN->eg_timer_overflow)
+		for (i = 0; i < blk.length; i++)
 		{
-			OPN->eg_timer -= OPN->eg_timer_overflow;
-			OPN->eg_cnt++;
+			/* FM outputs */
+			OPN->out_fm[0] = blk.out_fm[0][i];
+			OPN->out_fm[1] = blk.out_fm[1][i];
+			OPN->out_fm[2] = blk.out_fm[2][i];
 
-			advance_eg_channel(OPN, &cch[0]->SLOT[SLOT1]);
-			advance_eg_channel(OPN, &cch[1]->SLOT[SLOT1]);
-			advance_eg_channel(OPN, &cch[2]->SLOT[SLOT1]);
-		}
-
-		/* calculate FM */
-		chan_calc(OPN, cch[0], 0 );
-		chan_calc(OPN, cch[1], 1 );
-		chan_calc(OPN, cch[2], 2 );
+			/* buffering */
+			{
+				int lt;
 
-		/* buffering */
-		{
-			int lt;
+				lt = OPN->out_fm[0] + OPN->out_fm[1] + OPN->out_fm[2];
 
-			lt = OPN->out_fm[0] + OPN->out_fm[1] + OPN->out_fm[2];
+				lt >>= FINAL_SH;
 
-			lt >>= FINAL_SH;
+				Limit( lt , MAXOUT, MINOUT );
 
-			Limit( lt , MAXOUT, MINOUT );
+				#ifdef SAVE_SAMPLE
+					SAVE_ALL_CHANNELS
+				#endif
 
-			#ifdef SAVE_SAMPLE
-				SAVE_ALL_CHANNELS
-			#endif
+				/* buffering */
+				buf[done + i] = lt;
+			}
 
-			/* buffering */
-			buf[i] = lt;
+			/* timer A control */
+			INTERNAL_TIMER_A( &F2203->OPN.ST , cch[2] )
 		}
-
-		/* timer A control */
-		INTERNAL_TIMER_A( &F2203->OPN.ST , cch[2] )
 	}
 	INTERNAL_TIMER_B(&F2203->OPN.ST,length)
 }
@@ -2764,93 +2864,76 @@ void ym2608_update_one(void *chip, FMSAMPLE **buffer, int length)
 
 
 	/* buffering */
-	for(i=0; i < length ; i++)
-	{
-		advance_lfo(OPN);
-
-		/* clear output acc. */
-		OPN->out_adpcm[OUTD_LEFT] = OPN->out_adpcm[OUTD_RIGHT] = OPN->out_adpcm[OUTD_CENTER] = 0;
-		OPN->out_delta[OUTD_LEFT] = OPN->out_delta[OUTD_RIGHT] = OPN->out_delta[OUTD_CENTER] = 0;
-		/* clear outputs */
-		out_fm[0] = 0;
-		out_fm[1] = 0;
-		out_fm[2] = 0;
-		out_fm[3] = 0;
-		out_fm[4] = 0;
-		out_fm[5] = 0;
-
-		/* calculate FM */
-		chan_calc(OPN, cch[0], 0 );
-		chan_calc(OPN, cch[1], 1 );
-		chan_calc(OPN, cch[2], 2 );
-		chan_calc(OPN, cch[3], 3 );
-		chan_calc(OPN, cch[4], 4 );
-		chan_calc(OPN, cch[5], 5 );
-
-		/* deltaT ADPCM */
-		if( DELTAT->portstate&0x80 )
-			YM_DELTAT_ADPCM_CALC(DELTAT);
-
-		/* ADPCMA */
-		for( j = 0; j < 6; j++ )
-		{
-			if( F2608->adpcm[j].flag )
-				ADPCMA_calc_chan( F2608, &F2608->adpcm[j]);
-		}
+	OPN_BLOCK blk;
+	static const UINT8 chnum[6] = { 0, 1, 2, 3, 4, 5 };
+	for (int done = 0; done < length; done += blk.length)
+	{
+		blk.length = std::min(length - done, OPN_BLOCK_SAMPLES);
+		OPN_render_block(OPN, &blk, cch, chnum, 6, true, false);
 
-		/* advance envelope generator */
-		OPN->eg_timer += OPN->eg_timer_add;
-		while (OPN->eg_timer >= OPN->eg_timer_overflow)
+		for (i = 0; i < blk.length; i++)
 		{
-			OPN->eg_timer -= OPN->eg_timer_overflow;
-			OPN->eg_cnt++;
-
-			advance_eg_channel(OPN, &cch[0]->SLOT[SLOT1]);
-			advance_eg_channel(OPN, &cch[1]->SLOT[SLOT1]);
-			advance_eg_channel(OPN, &cch[2]->SLOT[SLOT1]);
-			advance_eg_channel(OPN, &cch[3]->SLOT[SLOT1]);
-			advance_eg_channel(OPN, &cch[4]->SLOT[SLOT1]);
-			advance_eg_channel(OPN, &cch[5]->SLOT[SLOT1]);
-		}
+			/* clear output acc. */
+			OPN->out_adpcm[OUTD_LEFT] = OPN->out_adpcm[OUTD_RIGHT] = OPN->out_adpcm[OUTD_CENTER] = 0;
+			OPN->out_delta[OUTD_LEFT] = OPN->out_delta[OUTD_RIGHT] = OPN->out_delta[OUTD_CENTER] = 0;
+			/* FM outputs */
+			out_fm[0] = blk.out_fm[0][i];
+			out_fm[1] = blk.out_fm[1][i];
+			out_fm[2] = blk.out_fm[2][i];
+			out_fm[3] = blk.out_fm[3][i];
+			out_fm[4] = blk.out_fm[4][i];
+			out_fm[5] = blk.out_fm[5][i];
+
+			/* deltaT ADPCM */
+			if( DELTAT->portstate&0x80 )
+				YM_DELTAT_ADPCM_CALC(DELTAT);
+
+			/* ADPCMA */
+			for( j = 0; j < 6; j++ )
+			{
+				if( F2608->adpcm[j].flag )
+					ADPCMA_calc_chan( F2608, &F2608->adpcm[j]);
+			}
 
-		/* buffering */
-		{
-			int lt,rt;
-
-			lt =  OPN->out_adpcm[OUTD_LEFT]  + OPN->out_adpcm[OUTD_CENTER];
-			rt =  OPN->out_adpcm[OUTD_RIGHT] + OPN->out_adpcm[OUTD_CENTER];
-			lt += (OPN->out_delta[OUTD_LEFT]  + OPN->out_delta[OUTD_CENTER])>>9;
-			rt += (OPN->out_delta[OUTD_RIGHT] + OPN->out_delta[OUTD_CENTER])>>9;
-			lt += ((out_fm[0]>>1) & OPN->pan[0]);   /* shift right verified on real YM2608 */
-			rt += ((out_fm[0]>>1) & OPN->pan[1]);
-			lt += ((out_fm[1]>>1) & OPN->pan[2]);
-			rt += ((out_fm[1]>>1) & OPN->pan[3]);
-			lt += ((out_fm[2]>>1) & OPN->pan[4]);
-			rt += ((out_fm[2]>>1) & OPN->pan[5]);
-			lt += ((out_fm[3]>>1) & OPN->pan[6]);
-			rt += ((out_fm[3]>>1) & OPN->pan[7]);
-			lt += ((out_fm[4]>>1) & OPN->pan[8]);
-			rt += ((out_fm[4]>>1) & OPN->pan[9]);
-			lt += ((out_fm[5]>>1) & OPN->pan[10]);
-			rt += ((out_fm[5]>>1) & OPN->pan[11]);
-
-			lt >>= FINAL_SH;
-			rt >>= FINAL_SH;
-
-			Limit( lt, MAXOUT, MINOUT );
-			Limit( rt, MAXOUT, MINOUT );
 			/* buffering */
-			bufL[i] = lt;
-			bufR[i] = rt;
+			{
+				int lt,rt;
+
+				lt =  OPN->out_adpcm[OUTD_LEFT]  + OPN->out_adpcm[OUTD_CENTER];
+				rt =  OPN->out_adpcm[OUTD_RIGHT] + OPN->out_adpcm[OUTD_CENTER];
+				lt += (OPN->out_delta[OUTD_LEFT]  + OPN->out_delta[OUTD_CENTER])>>9;
+				rt += (OPN->out_delta[OUTD_RIGHT] + OPN->out_delta[OUTD_CENTER])>>9;
+				lt += ((out_fm[0]>>1) & OPN->pan[0]);   /* shift right verified on real YM2608 */
+				rt += ((out_fm[0]>>1) & OPN->pan[1]);
+				lt += ((out_fm[1]>>1) & OPN->pan[2]);
+				rt += ((out_fm[1]>>1) & OPN->pan[3]);
+				lt += ((out_fm[2]>>1) & OPN->pan[4]);
+				rt += ((out_fm[2]>>1) & OPN->pan[5]);
+				lt += ((out_fm[3]>>1) & OPN->pan[6]);
+				rt += ((out_fm[3]>>1) & OPN->pan[7]);
+				lt += ((out_fm[4]>>1) & OPN->pan[8]);
+				rt += ((out_fm[4]>>1) & OPN->pan[9]);
+				lt += ((out_fm[5]>>1) & OPN->pan[10]);
+				rt += ((out_fm[5]>>1) & OPN->pan[11]);
+
+				lt >>= FINAL_SH;
+				rt >>= FINAL_SH;
+
+				Limit( lt, MAXOUT, MINOUT );
+				Limit( rt, MAXOUT, MINOUT );
+				/* buffering */
+				bufL[done + i] = lt;
+				bufR[done + i] = rt;
+
+				#ifdef SAVE_SAMPLE
+					SAVE_ALL_CHANNELS
+				#endif
 
-			#ifdef SAVE_SAMPLE
-				SAVE_ALL_CHANNELS
-			#endif
+			}
 
+			/* timer A control */
+			INTERNAL_TIMER_A( &OPN->ST , cch[2] )
 		}
-
-		/* timer A control */
-		INTERNAL_TIMER_A( &OPN->ST , cch[2] )
 	}
 	INTERNAL_TIMER_B(&OPN->ST,length)
 
@@ -3310,87 +3393,72 @@ void ym2610_update_one(void *chip, FMSAMPLE **buffer, int length)
 	refresh_fc_eg_chan( OPN, cch[3] );
 
 	/* buffering */
-	for(i=0; i < length ; i++)
+	OPN_BLOCK blk;
+	static const UINT8 chnum[4] = { 1, 2, 4, 5 };
+	for (int done = 0; done < length; done += blk.length)
 	{
-		advance_lfo(OPN);
-
-		/* clear output acc. */
-		OPN->out_adpcm[OUTD_LEFT] = OPN->out_adpcm[OUTD_RIGHT] = OPN->out_adpcm[OUTD_CENTER] = 0;
-		OPN->out_delta[OUTD_LEFT] = OPN->out_delta[OUTD_RIGHT] = OPN->out_delta[OUTD_CENTER] = 0;
-		/* clear outputs */
-		out_fm[1] = 0;
-		out_fm[2] = 0;
-		out_fm[4] = 0;
-		out_fm[5] = 0;
-
-		/* advance envelope generator */
-		OPN->eg_timer += OPN->eg_timer_add;
-		while (OPN->eg_timer >= OPN->eg_timer_overflow)
-		{
-			OPN->eg_timer -= OPN->eg_timer_overflow;
-			OPN->eg_cnt++;
-
-			advance_eg_channel(OPN, &cch[0]->SLOT[SLOT1]);
-			advance_eg_channel(OPN, &cch[1]->SLOT[SLOT1]);
-			advance_eg_channel(OPN, &cch[2]->SLOT[SLOT1]);
-			advance_eg_channel(OPN, &cch[3]->SLOT[SLOT1]);
-		}
-
-		/* calculate FM */
-		chan_calc(OPN, cch[0], 1 ); /*remapped to 1*/
-		chan_calc(OPN, cch[1], 2 ); /*remapped to 2*/
-		chan_calc(OPN, cch[2], 4 ); /*remapped to 4*/
-		chan_calc(OPN, cch[3], 5 ); /*remapped to 5*/
+		blk.length = std::min(length - done, OPN_BLOCK_SAMPLES);
+		OPN_render_block(OPN, &blk, cch, chnum, 4, true, true);
 
-		/* deltaT ADPCM */
-		if( DELTAT->portstate&0x80 )
-			YM_DELTAT_ADPCM_CALC(DELTAT);
-
-		/* ADPCMA */
-		for( j = 0; j < 6; j++ )
-		{
-			if( F2610->adpcm[j].flag )
-				ADPCMA_calc_chan( F2610, &F2610->adpcm[j]);
-		}
-
-		/* buffering */
+		for (i = 0; i < blk.length; i++)
 		{
-			int lt,rt;
+			/* clear output acc. */
+			OPN->out_adpcm[OUTD_LEFT] = OPN->out_adpcm[OUTD_RIGHT] = OPN->out_adpcm[OUTD_CENTER] = 0;
+			OPN->out_delta[OUTD_LEFT] = OPN->out_delta[OUTD_RIGHT] = OPN->out_delta[OUTD_CENTER] = 0;
+			/* FM outputs */
+			out_fm[1] = blk.out_fm[1][i];
+			out_fm[2] = blk.out_fm[2][i];
+			out_fm[4] = blk.out_fm[4][i];
+			out_fm[5] = blk.out_fm[5][i];
+
+			/* deltaT ADPCM */
+			if( DELTAT->portstate&0x80 )
+				YM_DELTAT_ADPCM_CALC(DELTAT);
+
+			/* ADPCMA */
+			for( j = 0; j < 6; j++ )
+			{
+				if( F2610->adpcm[j].flag )
+					ADPCMA_calc_chan( F2610, &F2610->adpcm[j]);
+			}
 
-			lt =  OPN->out_adpcm[OUTD_LEFT]  + OPN->out_adpcm[OUTD_CENTER];
-			rt =  OPN->out_adpcm[OUTD_RIGHT] + OPN->out_adpcm[OUTD_CENTER];
-			lt += (OPN->out_delta[OUTD_LEFT]  + OPN->out_delta[OUTD_CENTER])>>9;
-			rt += (OPN->out_delta[OUTD_RIGHT] + OPN->out_delta[OUTD_CENTER])>>9;
+			/* buffering */
+			{
+				int lt,rt;
 
+				lt =  OPN->out_adpcm[OUTD_LEFT]  + OPN->out_adpcm[OUTD_CENTER];
+				rt =  OPN->out_adpcm[OUTD_RIGHT] + OPN->out_adpcm[OUTD_CENTER];
+				lt += (OPN->out_delta[OUTD_LEFT]  + OPN->out_delta[OUTD_CENTER])>>9;
+				rt += (OPN->out_delta[OUTD_RIGHT] + OPN->out_delta[OUTD_CENTER])>>9;
 
-			lt += ((out_fm[1]>>1) & OPN->pan[2]);   /* the shift right was verified on real chip */
-			rt += ((out_fm[1]>>1) & OPN->pan[3]);
-			lt += ((out_fm[2]>>1) & OPN->pan[4]);
-			rt += ((out_fm[2]>>1) & OPN->pan[5]);
+				lt += ((out_fm[1]>>1) & OPN->pan[2]);   /* the shift right was verified on real chip */
+				rt += ((out_fm[1]>>1) & OPN->pan[3]);
+				lt += ((out_fm[2]>>1) & OPN->pan[4]);
+				rt += ((out_fm[2]>>1) & OPN->pan[5]);
 
-			lt += ((out_fm[4]>>1) & OPN->pan[8]);
-			rt += ((out_fm[4]>>1) & OPN->pan[9]);
-			lt += ((out_fm[5]>>1) & OPN->pan[10]);
-			rt += ((out_fm[5]>>1) & OPN->pan[11]);
+				lt += ((out_fm[4]>>1) & OPN->pan[8]);
+				rt += ((out_fm[4]>>1) & OPN->pan[9]);
+				lt += ((out_fm[5]>>1) & OPN->pan[10]);
+				rt += ((out_fm[5]>>1) & OPN->pan[11]);
 
+				lt >>= FINAL_SH;
+				rt >>= FINAL_SH;
 
-			lt >>= FINAL_SH;
-			rt >>= FINAL_SH;
+				Limit( lt, MAXOUT, MINOUT );
+				Limit( rt, MAXOUT, MINOUT );
 
-			Limit( lt, MAXOUT, MINOUT );
-			Limit( rt, MAXOUT, MINOUT );
+				#ifdef SAVE_SAMPLE
+					SAVE_ALL_CHANNELS
+				#endif
 
-			#ifdef SAVE_SAMPLE
-				SAVE_ALL_CHANNELS
-			#endif
+				/* buffering */
+				bufL[done + i] = lt;
+				bufR[done + i] = rt;
+			}
 
-			/* buffering */
-			bufL[i] = lt;
-			bufR[i] = rt;
+			/* timer A control */
+			INTERNAL_TIMER_A( &OPN->ST , cch[1] )
 		}
-
-		/* timer A control */
-		INTERNAL_TIMER_A( &OPN->ST , cch[1] )
 	}
 	INTERNAL_TIMER_B(&OPN->ST,length)
 
@@ -3440,95 +3508,77 @@ void ym2610b_update_one(void *chip, FMSAMPLE **buffer, int length)
 	refresh_fc_eg_chan( OPN, cch[5] );
 
 	/* buffering */
-	for(i=0; i < length ; i++)
-	{
-		advance_lfo(OPN);
-
-		/* clear output acc. */
-		OPN->out_adpcm[OUTD_LEFT] = OPN->out_adpcm[OUTD_RIGHT] = OPN->out_adpcm[OUTD_CENTER] = 0;
-		OPN->out_delta[OUTD_LEFT] = OPN->out_delta[OUTD_RIGHT] = OPN->out_delta[OUTD_CENTER] = 0;
-		/* clear outputs */
-		out_fm[0] = 0;
-		out_fm[1] = 0;
-		out_fm[2] = 0;
-		out_fm[3] = 0;
-		out_fm[4] = 0;
-		out_fm[5] = 0;
-
-		/* advance envelope generator */
-		OPN->eg_timer += OPN->eg_timer_add;
-		while (OPN->eg_timer >= OPN->eg_timer_overflow)
-		{
-			OPN->eg_timer -= OPN->eg_timer_overflow;
-			OPN->eg_cnt++;
-
-			advance_eg_channel(OPN, &cch[0]->SLOT[SLOT1]);
-			advance_eg_channel(OPN, &cch[1]->SLOT[SLOT1]);
-			advance_eg_channel(OPN, &cch[2]->SLOT[SLOT1]);
-			advance_eg_channel(OPN, &cch[3]->SLOT[SLOT1]);
-			advance_eg_channel(OPN, &cch[4]->SLOT[SLOT1]);
-			advance_eg_channel(OPN, &cch[5]->SLOT[SLOT1]);
-		}
-
-		/* calculate FM */
-		chan_calc(OPN, cch[0], 0 );
-		chan_calc(OPN, cch[1], 1 );
-		chan_calc(OPN, cch[2], 2 );
-		chan_calc(OPN, cch[3], 3 );
-		chan_calc(OPN, cch[4], 4 );
-		chan_calc(OPN, cch[5], 5 );
-
-		/* deltaT ADPCM */
-		if( DELTAT->portstate&0x80 )
-			YM_DELTAT_ADPCM_CALC(DELTAT);
-
-		/* ADPCMA */
-		for( j = 0; j < 6; j++ )
-		{
-			if( F2610->adpcm[j].flag )
-				ADPCMA_calc_chan( F2610, &F2610->adpcm[j]);
-		}
+	OPN_BLOCK blk;
+	static const UINT8 chnum[6] = { 0, 1, 2, 3, 4, 5 };
+	for (int done = 0; done < length; done += blk.length)
+	{
+		blk.length = std::min(length - done, OPN_BLOCK_SAMPLES);
+		OPN_render_block(OPN, &blk, cch, chnum, 6, true, true);
 
-		/* buffering */
+		for (i = 0; i < blk.length; i++)
 		{
-			int lt,rt;
-
-			lt =  OPN->out_adpcm[OUTD_LEFT]  + OPN->out_adpcm[OUTD_CENTER];
-			rt =  OPN->out_adpcm[OUTD_RIGHT] + OPN->out_adpcm[OUTD_CENTER];
-			lt += (OPN->out_delta[OUTD_LEFT]  + OPN->out_delta[OUTD_CENTER])>>9;
-			rt += (OPN->out_delta[OUTD_RIGHT] + OPN->out_delta[OUTD_CENTER])>>9;
-
-			lt += ((out_fm[0]>>1) & OPN->pan[0]);   /* the shift right is verified on YM2610 */
-			rt += ((out_fm[0]>>1) & OPN->pan[1]);
-			lt += ((out_fm[1]>>1) & OPN->pan[2]);
-			rt += ((out_fm[1]>>1) & OPN->pan[3]);
-			lt += ((out_fm[2]>>1) & OPN->pan[4]);
-			rt += ((out_fm[2]>>1) & OPN->pan[5]);
-			lt += ((out_fm[3]>>1) & OPN->pan[6]);
-			rt += ((out_fm[3]>>1) & OPN->pan[7]);
-			lt += ((out_fm[4]>>1) & OPN->pan[8]);
-			rt += ((out_fm[4]>>1) & OPN->pan[9]);
-			lt += ((out_fm[5]>>1) & OPN->pan[10]);
-			rt += ((out_fm[5]>>1) & OPN->pan[11]);
-
-
-			lt >>= FINAL_SH;
-			rt >>= FINAL_SH;
-
-			Limit( lt, MAXOUT, MINOUT );
-			Limit( rt, MAXOUT, MINOUT );
-
-			#ifdef SAVE_SAMPLE
-				SAVE_ALL_CHANNELS
-			#endif
+			/* clear output acc. */
+			OPN->out_adpcm[OUTD_LEFT] = OPN->out_adpcm[OUTD_RIGHT] = OPN->out_adpcm[OUTD_CENTER] = 0;
+			OPN->out_delta[OUTD_LEFT] = OPN->out_delta[OUTD_RIGHT] = OPN->out_delta[OUTD_CENTER] = 0;
+			/* FM outputs */
+			out_fm[0] = blk.out_fm[0][i];
+			out_fm[1] = blk.out_fm[1][i];
+			out_fm[2] = blk.out_fm[2][i];
+			out_fm[3] = blk.out_fm[3][i];
+			out_fm[4] = blk.out_fm[4][i];
+			out_fm[5] = blk.out_fm[5][i];
+
+			/* deltaT ADPCM */
+			if( DELTAT->portstate&0x80 )
+				YM_DELTAT_ADPCM_CALC(DELTAT);
+
+			/* ADPCMA */
+			for( j = 0; j < 6; j++ )
+			{
+				if( F2610->adpcm[j].flag )
+					ADPCMA_calc_chan( F2610, &F2610->adpcm[j]);
+			}
 
 			/* buffering */
-			bufL[i] = lt;
-			bufR[i] = rt;
-		}
+			{
+				int lt,rt;
+
+				lt =  OPN->out_adpcm[OUTD_LEFT]  + OPN->out_adpcm[OUTD_CENTER];
+				rt =  OPN->out_adpcm[OUTD_RIGHT] + OPN->out_adpcm[OUTD_CENTER];
+				lt += (OPN->out_delta[OUTD_LEFT]  + OPN->out_delta[OUTD_CENTER])>>9;
+				rt += (OPN->out_delta[OUTD_RIGHT] + OPN->out_delta[OUTD_CENTER])>>9;
+
+				lt += ((out_fm[0]>>1) & OPN->pan[0]);   /* the shift right is verified on YM2610 */
+				rt += ((out_fm[0]>>1) & OPN->pan[1]);
+				lt += ((out_fm[1]>>1) & OPN->pan[2]);
+				rt += ((out_fm[1]>>1) & OPN->pan[3]);
+				lt += ((out_fm[2]>>1) & OPN->pan[4]);
+				rt += ((out_fm[2]>>1) & OPN->pan[5]);
+				lt += ((out_fm[3]>>1) & OPN->pan[6]);
+				rt += ((out_fm[3]>>1) & OPN->pan[7]);
+				lt += ((out_fm[4]>>1) & OPN->pan[8]);
+				rt += ((out_fm[4]>>1) & OPN->pan[9]);
+				lt += ((out_fm[5]>>1) & OPN->pan[10]);
+				rt += ((out_fm[5]>>1) & OPN->pan[11]);
+
+				lt >>= FINAL_SH;
+				rt >>= FINAL_SH;
+
+				Limit( lt, MAXOUT, MINOUT );
+				Limit( rt, MAXOUT, MINOUT );
+
+				#ifdef SAVE_SAMPLE
+					SAVE_ALL_CHANNELS
+				#endif
+
+				/* buffering */
+				bufL[done + i] = lt;
+				bufR[done + i] = rt;
+			}
 
-		/* timer A control */
-		INTERNAL_TIMER_A( &OPN->ST , cch[2] )
+			/* timer A control */
+			INTERNAL_TIMER_A( &OPN->ST , cch[2] )
+		}
 	}
 	INTERNAL_TIMER_B(&OPN->ST,length)
 
@@ -123,6 +123,11 @@ Revision History:
 #define EG_REL          1
 #define EG_OFF          0
 
+/* samples rendered channel by channel in one go; the envelope generators
+   still tick at the chip's own rate inside the block, and the operators stay
+   scalar code since each sample's feedback needs the previous one's output */
+#define OPL_BLOCK_SAMPLES   64
+
 
 /* save output as raw 16-bit sample */
 
@@ -724,131 +729,115 @@ static inline void advance_lfo(FM_OPL *OPL)
 	OPL->LFO_PM = ((OPL->lfo_pm_cnt>>LFO_SH) & 7) | OPL->lfo_pm_depth_range;
 }
 
-/* advance to next sample */
-static inline void advance(FM_OPL *OPL)
+/* advance an operator's envelope by one tick of the envelope generator */
+static inline void advance_eg(OPL_SLOT *op, UINT32 eg_cnt)
 {
-	OPL_CH *CH;
-	OPL_SLOT *op;
-	int i;
-
-	OPL->eg_timer += OPL->eg_timer_add;
-
-	while (OPL->eg_timer >= OPL->eg_timer_overflow)
+	switch(op->state)
 	{
-		OPL->eg_timer -= OPL->eg_timer_overflow;
-
-		OPL->eg_cnt++;
-
-		for (i=0; i<9*2; i++)
+	case EG_ATT:        /* attack phase */
+		if ( !(eg_cnt & ((1<<op->eg_sh_ar)-1) ) )
 		{
-			CH  = &OPL->P_CH[i/2];
-			op  = &CH->SLOT[i&1];
+			op->volume += (~op->volume *
+										(eg_inc[op->eg_sel_ar + ((eg_cnt>>op->eg_sh_ar)&7)])
+										) >>3;
 
-			/* Envelope Generator */
-			switch(op->state)
+			if (op->volume <= MIN_ATT_INDEX)
 			{
-			case EG_ATT:        /* attack phase */
-				if ( !(OPL->eg_cnt & ((1<<op->eg_sh_ar)-1) ) )
-				{
-					op->volume += (~op->volume *
-												(eg_inc[op->eg_sel_ar + ((OPL->eg_cnt>>op->eg_sh_ar)&7)])
-												) >>3;
-
-					if (op->volume <= MIN_ATT_INDEX)
-					{
-						op->volume = MIN_ATT_INDEX;
-						op->state = EG_DEC;
-					}
-
-				}
-			break;
+				op->volume = MIN_ATT_INDEX;
+				op->state = EG_DEC;
+			}
 
-			case EG_DEC:    /* decay phase */
-				if ( !(OPL->eg_cnt & ((1<<op->eg_sh_dr)-1) ) )
-				{
-					op->volume += eg_inc[op->eg_sel_dr + ((OPL->eg_cnt>>op->eg_sh_dr)&7)];
+		}
+	break;
 
-					if ( op->volume >= op->sl )
-						op->state = EG_SUS;
+	case EG_DEC:    /* decay phase */
+		if ( !(eg_cnt & ((1<<op->eg_sh_dr)-1) ) )
+		{
+			op->volume += eg_inc[op->eg_sel_dr + ((eg_cnt>>op->eg_sh_dr)&7)];
 
-				}
-			break;
+			if ( op->volume >= op->sl )
+				op->state = EG_SUS;
 
-			case EG_SUS:    /* sustain phase */
+		}
+	break;
 
-				/* this is important behaviour:
-				one can change percusive/non-percussive modes on the fly and
-				the chip will remain in sustain phase - verified on real YM3812 */
+	case EG_SUS:    /* sustain phase */
 
-				if(op->eg_type)     /* non-percussive mode */
-				{
-									/* do nothing */
-				}
-				else                /* percussive mode */
-				{
-					/* during sustain phase chip adds Release Rate (in percussive mode) */
-					if ( !(OPL->eg_cnt & ((1<<op->eg_sh_rr)-1) ) )
-					{
-						op->volume += eg_inc[op->eg_sel_rr + ((OPL->eg_cnt>>op->eg_sh_rr)&7)];
-
-						if ( op->volume >= MAX_ATT_INDEX )
-							op->volume = MAX_ATT_INDEX;
-					}
-					/* else do nothing in sustain phase */
-				}
-			break;
+		/* this is important behaviour:
+		one can change percusive/non-percussive modes on the fly and
+		the chip will remain in sustain phase - verified on real YM3812 */
 
-			case EG_REL:    /* release phase */
-				if ( !(OPL->eg_cnt & ((1<<op->eg_sh_rr)-1) ) )
-				{
-					op->volume += eg_inc[op->eg_sel_rr + ((OPL->eg_cnt>>op->eg_sh_rr)&7)];
+		if(op->eg_type)     /* non-percussive mode */
+		{
+							/* do nothing */
+		}
+		else                /* percussive mode */
+		{
+			/* during sustain phase chip adds Release Rate (in percussive mode) */
+			if ( !(eg_cnt & ((1<<op->eg_sh_rr)-1) ) )
+			{
+				op->volume += eg_inc[op->eg_sel_rr + ((eg_cnt>>op->eg_sh_rr)&7)];
 
-					if ( op->volume >= MAX_ATT_INDEX )
-					{
-						op->volume = MAX_ATT_INDEX;
-						op->state = EG_OFF;
-					}
+				if ( op->volume >= MAX_ATT_INDEX )
+					op->volume = MAX_ATT_INDEX;
+			}
+			/* else do nothing in sustain phase */
+		}
+	break;
 
-				}
-			break;
+	case EG_REL:    /* release phase */
+		if ( !(eg_cnt & ((1<<op->eg_sh_rr)-1) ) )
+		{
+			op->volume += eg_inc[op->eg_sel_rr + ((eg_cnt>>op->eg_sh_rr)&7)];
 
-			default:
-			break;
+			if ( op->volume >= MAX_ATT_INDEX )
+			{
+				op->volume = MAX_ATT_INDEX;
+				op->state = EG_OFF;
 			}
+
 		}
+	break;
+
+	default:
+	break;
 	}
+}
 
-	for (i=0; i<9*2; i++)
+/* advance an operator's phase by one sample */
+static inline void advance_phase(FM_OPL *OPL, OPL_CH *CH, OPL_SLOT *op, INT32 lfo_pm)
+{
+	/* Phase Generator */
+	if(op->vib)
 	{
-		CH  = &OPL->P_CH[i/2];
-		op  = &CH->SLOT[i&1];
-
-		/* Phase Generator */
-		if(op->vib)
-		{
-			UINT8 block;
-			unsigned int block_fnum = CH->block_fnum;
+		UINT8 block;
+		unsigned int block_fnum = CH->block_fnum;
 
-			unsigned int fnum_lfo   = (block_fnum&0x0380) >> 7;
+		unsigned int fnum_lfo   = (block_fnum&0x0380) >> 7;
 
-			signed int lfo_fn_table_index_offset = lfo_pm_table[OPL->LFO_PM + 16*fnum_lfo ];
+		signed int lfo_fn_table_index_offset = lfo_pm_table[lfo_pm + 16*fnum_lfo ];
 
-			if (lfo_fn_table_index_offset)  /* LFO phase modulation active */
-			{
-				block_fnum += lfo_fn_table_index_offset;
-				block = (block_fnum&0x1c00) >> 10;
-				op->Cnt += (OPL->fn_tab[block_fnum&0x03ff] >> (7-block)) * op->mul;
-			}
-			else    /* LFO phase modulation  = zero */
-			{
-				op->Cnt += op->Incr;
-			}
+		if (lfo_fn_table_index_offset)  /* LFO phase modulation active */
+		{
+			block_fnum += lfo_fn_table_index_offset;
+			block = (block_fnum&0x1c00) >> 10;
+			op->Cnt += (OPL->fn_tab[block_fnum&0x03ff] >> (7-block)) * op->mul;
 		}
-		else    /* LFO phase modulation disabled for this operator */
+		else    /* LFO phase modulation  = zero */
 		{
 			op->Cnt += op->Incr;
 		}
 	}
+	else    /* LFO phase modulation disabled for this operator */
+	{
+		op->Cnt += op->Incr;
+	}
+}
+
+/* advance the noise generator by one sample */
+static inline void advance_noise(FM_OPL *OPL)
+{
+	int i;
 
 	/*  The Noise Generator of the YM3812 is 23-bit shift register.
 	*   Period is equal to 2^23-2 samples.
@@ -913,34 +902,24 @@ static inline signed int op_calc1(UINT32 phase, unsigned int env, signed int pm,
 
 #define volume_calc(OP) ((OP)->TLL + ((UINT32)(OP)->volume) + (OPL->LFO_AM & (OP)->AMmask))
 
-/* calculate output */
-static inline void OPL_CALC_CH( FM_OPL *OPL, OPL_CH *CH )
+/* a channel whose slots have both finished releasing, and whose feedback
+   history has drained, adds exactly nothing until its next key on; each
+   block skips such channels, advancing only their phases */
+static inline UINT32 OPL_active_channels(FM_OPL *OPL)
 {
-	OPL_SLOT *SLOT;
-	unsigned int env;
-	signed int out;
+	UINT32 active = 0;
 
-	OPL->phase_modulation = 0;
-
-	/* SLOT 1 */
-	SLOT = &CH->SLOT[SLOT1];
-	env  = volume_calc(SLOT);
-	out  = SLOT->op1_out[0] + SLOT->op1_out[1];
-	SLOT->op1_out[0] = SLOT->op1_out[1];
-	*SLOT->connect1 += SLOT->op1_out[0];
-	SLOT->op1_out[1] = 0;
-	if( env < ENV_QUIET )
+	for (int ch = 0; ch < 9; ch++)
 	{
-		if (!SLOT->FB)
-			out = 0;
-		SLOT->op1_out[1] = op_calc1(SLOT->Cnt, env, (out<<SLOT->FB), SLOT->wavetable );
-	}
+		const OPL_CH *CH = &OPL->P_CH[ch];
+		const OPL_SLOT *SLOT1P = &CH->SLOT[SLOT1];
+		const OPL_SLOT *SLOT2P = &CH->SLOT[SLOT2];
 
-	/* SLOT 2 */
-	SLOT++;
-	env = volume_calc(SLOT);
-	if( env < ENV_QUIET )
-		OPL->output[0] += op_calc(SLOT->Cnt, env, OPL->phase_modulation, SLOT->wavetable);
+		if (SLOT1P->state != EG_OFF || SLOT1P->volume < ENV_QUIET || SLOT1P->op1_out[0] != 0 || SLOT1P->op1_out[1] != 0 ||
+			SLOT2P->state != EG_OFF || SLOT2P->volume < ENV_QUIET)
+			active |= 1 << ch;
+	}
+	return active;
 }
 
 /*
@@ -1144,6 +1123,175 @@ static inline void OPL_CALC_RH( FM_OPL *OPL, OPL_CH *CH, unsigned int noise )
 }
 
 
+/* chip-wide generator values for each sample of a block; the envelope
+   counter is given before each sample's ticks, plus the final count */
+struct OPL_BLOCK
+{
+	int     length;
+	UINT32  eg_cnt[OPL_BLOCK_SAMPLES+1];
+	UINT32  LFO_AM[OPL_BLOCK_SAMPLES];
+	INT32   LFO_PM[OPL_BLOCK_SAMPLES];
+	UINT8   noise[OPL_BLOCK_SAMPLES];
+	INT32   output[OPL_BLOCK_SAMPLES];
+};
+
+/* run the LFO, envelope timer and noise generator through a block */
+static inline void OPL_advance_block(FM_OPL *OPL, OPL_BLOCK *blk)
+{
+	UINT32 eg_cnt = OPL->eg_cnt;
+
+	for (int i = 0; i < blk->length; i++)
+	{
+		advance_lfo(OPL);
+		blk->LFO_AM[i] = OPL->LFO_AM;
+		blk->LFO_PM[i] = OPL->LFO_PM;
+		blk->noise[i] = OPL->noise_rng & 1;
+		blk->eg_cnt[i] = eg_cnt;
+
+		OPL->eg_timer += OPL->eg_timer_add;
+		while (OPL->eg_timer >= OPL->eg_timer_overflow)
+		{
+			OPL->eg_timer -= OPL->eg_timer_overflow;
+			eg_cnt++;
+		}
+
+		advance_noise(OPL);
+	}
+	blk->eg_cnt[blk->length] = eg_cnt;
+	OPL->eg_cnt = eg_cnt;
+}
+
+/* advance an operator past sample i of a block */
+static inline void OPL_advance_slot(FM_OPL *OPL, OPL_CH *CH, OPL_SLOT *op, const OPL_BLOCK *blk, int i)
+{
+	for (UINT32 eg_cnt = blk->eg_cnt[i]; eg_cnt != blk->eg_cnt[i+1]; )
+		advance_eg(op, ++eg_cnt);
+	advance_phase(OPL, CH, op, blk->LFO_PM[i]);
+}
+
+/* add a two-operator channel's output for a block; working on copies of
+   the slots lets the compiler keep their state in registers */
+static void OPL_render_channel(FM_OPL *OPL, OPL_CH *CH, OPL_BLOCK *blk)
+{
+	OPL_SLOT SLOT1P = CH->SLOT[SLOT1];
+	OPL_SLOT SLOT2P = CH->SLOT[SLOT2];
+	INT32 *output = blk->output;
+
+	for (int i = 0; i < blk->length; i++)
+	{
+		unsigned int env;
+		signed int out, phase_modulation = 0;
+
+		/* SLOT 1 */
+		env  = SLOT1P.TLL + (UINT32)SLOT1P.volume + (blk->LFO_AM[i] & SLOT1P.AMmask);
+		out  = SLOT1P.op1_out[0] + SLOT1P.op1_out[1];
+		SLOT1P.op1_out[0] = SLOT1P.op1_out[1];
+		if (SLOT1P.CON)
+			output[i] += SLOT1P.op1_out[0];
+		else
+			phase_modulation = SLOT1P.op1_out[0];
+		SLOT1P.op1_out[1] = 0;
+		if( env < ENV_QUIET )
+		{
+			if (!SLOT1P.FB)
+				out = 0;
+			SLOT1P.op1_out[1] = op_calc1(SLOT1P.Cnt, env, (out<<SLOT1P.FB), SLOT1P.wavetable );
+		}
+
+		/* SLOT 2 */
+		env = SLOT2P.TLL + (UINT32)SLOT2P.volume + (blk->LFO_AM[i] & SLOT2P.AMmask);
+		if( env < ENV_QUIET )
+			output[i] += op_calc(SLOT2P.Cnt, env, phase_modulation, SLOT2P.wavetable);
+
+		OPL_advance_slot(OPL, CH, &SLOT1P, blk, i);
+		OPL_advance_slot(OPL, CH, &SLOT2P, blk, i);
+	}
+
+	CH->SLOT[SLOT1] = SLOT1P;
+	CH->SLOT[SLOT2] = SLOT2P;
+}
+
+/* advance a silent channel through a block; its envelopes are off and stay
+   that way until a key on, so only the phases move */
+static void OPL_skip_channel(FM_OPL *OPL, OPL_CH *CH, OPL_BLOCK *blk)
+{
+	for (int slot = 0; slot < 2; slot++)
+	{
+		OPL_SLOT *op = &CH->SLOT[slot];
+		if (op->vib)
+		{
+			for (int i = 0; i < blk->length; i++)
+				advance_phase(OPL, CH, op, blk->LFO_PM[i]);
+		}
+		else
+			op->Cnt += op->Incr * blk->length;
+	}
+}
+
+/* render a block of FM output into blk->output, one channel at a time;
+   the rhythm channels depend on each other and are rendered together */
+static void OPL_render_block(FM_OPL *OPL, OPL_BLOCK *blk)
+{
+	UINT8 rhythm = OPL->rhythm&0x20;
+	UINT32 active = OPL_active_channels(OPL);
+
+	memset(blk->output, 0, sizeof(blk->output[0]) * blk->length);
+	OPL_advance_block(OPL, blk);
+
+	for (int ch = 0; ch < (rhythm ? 6 : 9); ch++)
+	{
+		if (active & (1 << ch))
+			OPL_render_channel(OPL, &OPL->P_CH[ch], blk);
+		else
+			OPL_skip_channel(OPL, &OPL->P_CH[ch], blk);
+	}
+
+	if (rhythm)
+	{
+		for (int i = 0; i < blk->length; i++)
+		{
+			OPL->LFO_AM = blk->LFO_AM[i];
+			OPL->output[0] = 0;
+			OPL_CALC_RH(OPL, &OPL->P_CH[0], blk->noise[i]);
+			blk->output[i] += OPL->output[0];
+
+			for (int ch = 6; ch < 9; ch++)
+			{
+				OPL_advance_slot(OPL, &OPL->P_CH[ch], &OPL->P_CH[ch].SLOT[SLOT1], blk, i);
+				OPL_advance_slot(OPL, &OPL->P_CH[ch], &OPL->P_CH[ch].SLOT[SLOT2], blk, i);
+			}
+		}
+	}
+	OPL->LFO_AM = blk->LFO_AM[blk->length-1];
+}
+
+/* scale, clip and store a rendered block, adding Y8950 ADPCM if present */
+static void OPL_store_block(const OPL_BLOCK *blk, const INT32 *deltat, OPLSAMPLE *buf)
+{
+	for (int i = 0; i < blk->length; i++)
+	{
+		int lt = blk->output[i];
+		if (deltat)
+			lt += deltat[i]>>11;
+
+		lt >>= FINAL_SH;
+
+		/* limit check */
+		lt = limit( lt , MAXOUT, MINOUT );
+
+		#ifdef SAVE_SAMPLE
+		if (which==0)
+		{
+			SAVE_ALL_CHANNELS
+		}
+		#endif
+
+		/* store to sound buffer */
+		buf[i] = lt;
+	}
+}
+
+
 /* generic table initialize */
 static int init_tables(void)
 {
@@ -2223,57 +2371,14 @@ void ym3812_set_update_handler(void *chip,OPL_UPDATEHANDLER UpdateHandler,void *
 void ym3812_update_one(void *chip, OPLSAMPLE *buffer, int length)
 {
 	FM_OPL      *OPL = (FM_OPL *)chip;
-	UINT8       rhythm = OPL->rhythm&0x20;
-	OPLSAMPLE   *buf = buffer;
-	int i;
+	OPL_BLOCK   blk;
 
-	for( i=0; i < length ; i++ )
+	for (int done = 0; done < length; done += blk.length)
 	{
-		int lt;
-
-		OPL->output[0] = 0;
-
-		advance_lfo(OPL);
-
-		/* FM part */
-		OPL_CALC_CH(OPL, &OPL->P_CH[0]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[1]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[2]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[3]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[4]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[5]);
-
-		if(!rhythm)
-		{
-			OPL_CALC_CH(OPL, &OPL->P_CH[6]);
-			OPL_CALC_CH(OPL, &OPL->P_CH[7]);
-			OPL_CALC_CH(OPL, &OPL->P_CH[8]);
-		}
-		else        /* Rhythm part */
-		{
-			OPL_CALC_RH(OPL, &OPL->P_CH[0], (OPL->noise_rng>>0)&1 );
-		}
-
-		lt = OPL->output[0];
-
-		lt >>= FINAL_SH;
-
-		/* limit check */
-		lt = limit( lt , MAXOUT, MINOUT );
-
-		#ifdef SAVE_SAMPLE
-		if (which==0)
-		{
-			SAVE_ALL_CHANNELS
-		}
-		#endif
-
-		/* store to sound buffer */
-		buf[i] = lt;
-
-		advance(OPL);
+		blk.length = std::min(length - done, OPL_BLOCK_SAMPLES);
+		OPL_render_block(OPL, &blk);
+		OPL_store_block(&blk, nullptr, buffer + done);
 	}
-
 }
 #endif /* BUILD_YM3812 */
 
@@ -2350,57 +2455,14 @@ void ym3526_set_update_handler(void *chip,OPL_UPDATEHANDLER UpdateHandler,void *
 void ym3526_update_one(void *chip, OPLSAMPLE *buffer, int length)
 {
 	FM_OPL      *OPL = (FM_OPL *)chip;
-	UINT8       rhythm = OPL->rhythm&0x20;
-	OPLSAMPLE   *buf = buffer;
-	int i;
+	OPL_BLOCK   blk;
 
-	for( i=0; i < length ; i++ )
+	for (int done = 0; done < length; done += blk.length)
 	{
-		int lt;
-
-		OPL->output[0] = 0;
-
-		advance_lfo(OPL);
-
-		/* FM part */
-		OPL_CALC_CH(OPL, &OPL->P_CH[0]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[1]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[2]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[3]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[4]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[5]);
-
-		if(!rhythm)
-		{
-			OPL_CALC_CH(OPL, &OPL->P_CH[6]);
-			OPL_CALC_CH(OPL, &OPL->P_CH[7]);
-			OPL_CALC_CH(OPL, &OPL->P_CH[8]);
-		}
-		else        /* Rhythm part */
-		{
-			OPL_CALC_RH(OPL, &OPL->P_CH[0], (OPL->noise_rng>>0)&1 );
-		}
-
-		lt = OPL->output[0];
-
-		lt >>= FINAL_SH;
-
-		/* limit check */
-		lt = limit( lt , MAXOUT, MINOUT );
-
-		#ifdef SAVE_SAMPLE
-		if (which==0)
-		{
-			SAVE_ALL_CHANNELS
-		}
-		#endif
-
-		/* store to sound buffer */
-		buf[i] = lt;
-
-		advance(OPL);
+		blk.length = std::min(length - done, OPL_BLOCK_SAMPLES);
+		OPL_render_block(OPL, &blk);
+		OPL_store_block(&blk, nullptr, buffer + done);
 	}
-
 }
 #endif /* BUILD_YM3526 */
 
@@ -2503,64 +2565,27 @@ void y8950_set_delta_t_memory(void *chip, void * deltat_mem_ptr, int deltat_mem_
 */
 void y8950_update_one(void *chip, OPLSAMPLE *buffer, int length)
 {
-	int i;
 	FM_OPL      *OPL = (FM_OPL *)chip;
-	UINT8       rhythm  = OPL->rhythm&0x20;
 	YM_DELTAT   *DELTAT = OPL->deltat;
-	OPLSAMPLE   *buf    = buffer;
+	OPL_BLOCK   blk;
+	INT32       deltat[OPL_BLOCK_SAMPLES];
 
-	for( i=0; i < length ; i++ )
+	for (int done = 0; done < length; done += blk.length)
 	{
-		int lt;
-
-		OPL->output[0] = 0;
-		OPL->output_deltat[0] = 0;
-
-		advance_lfo(OPL);
+		blk.length = std::min(length - done, OPL_BLOCK_SAMPLES);
 
 		/* deltaT ADPCM */
-		if( DELTAT->portstate&0x80 )
-			YM_DELTAT_ADPCM_CALC(DELTAT);
-
-		/* FM part */
-		OPL_CALC_CH(OPL, &OPL->P_CH[0]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[1]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[2]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[3]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[4]);
-		OPL_CALC_CH(OPL, &OPL->P_CH[5]);
-
-		if(!rhythm)
-		{
-			OPL_CALC_CH(OPL, &OPL->P_CH[6]);
-			OPL_CALC_CH(OPL, &OPL->P_CH[7]);
-			OPL_CALC_CH(OPL, &OPL->P_CH[8]);
-		}
-		else        /* Rhythm part */
-		{
-			OPL_CALC_RH(OPL, &OPL->P_CH[0], (OPL->noise_rng>>0)&1 );
-		}
-
-		lt = OPL->output[0] + (OPL->output_deltat[0]>>11);
-
-		lt >>= FINAL_SH;
-
-		/* limit check */
-		lt = limit( lt , MAXOUT, MINOUT );
-
-		#ifdef SAVE_SAMPLE
-		if (which==0)
+		for (int i = 0; i < blk.length; i++)
 		{
-			SAVE_ALL_CHANNELS
+			OPL->output_deltat[0] = 0;
+			if( DELTAT->portstate&0x80 )
+				YM_DELTAT_ADPCM_CALC(DELTAT);
+			deltat[i] = OPL->output_deltat[0];
 		}
-		#endif
 
-		/* store to sound buffer */
-		buf[i] = lt;
-
-		advance(OPL);
+		OPL_render_block(OPL, &blk);
+		OPL_store_block(&blk, deltat, buffer + done);
 	}
-
 }
 
 void y8950_set_port_handler(void *chip,OPL_PORTHANDLER_W PortHandler_w,OPL_PORTHANDLER_R PortHandler_r,void * param)
@@ -193,6 +193,9 @@ struct YM2151
 #define EG_REL          1
 #define EG_OFF          0
 
+/* samples rendered channel by channel in one go */
+#define YM2151_BLOCK_SAMPLES    64
+
 #define SIN_BITS        10
 #define SIN_LEN         (1<<SIN_BITS)
 #define SIN_MASK        (SIN_LEN-1)
@@ -1737,7 +1740,38 @@ static inline void chan_calc(YM2151 *PSG, unsigned int chan)
 	op->mem_value = PSG->mem;
 }
 
-static inline void chan7_calc(YM2151 *PSG)
+/* a channel whose operators have all finished releasing, and whose
+   feedback and MEM history has drained, adds exactly nothing until its
+   next key on (the noise output needs the same 0x3ff floor); each block
+   skips such channels, advancing only their phases */
+static inline UINT32 active_channels(YM2151 *PSG)
+{
+	/* a pending CSM request keys everything on inside advance_csm() */
+#ifdef USE_MAME_TIMERS
+	if (PSG->csm_req)
+#else
+	if (PSG->csm_req || (PSG->irq_enable & 0x80))
+#endif
+		return 0xff;
+
+	UINT32 active = 0;
+	for (int chan = 0; chan < 8; chan++)
+	{
+		const YM2151Operator *op = &PSG->oper[chan*4];
+		if (op->fb_out_prev != 0 || op->fb_out_curr != 0 || op->mem_value != 0)
+			active |= 1 << chan;
+		else
+			for (int opnum = 0; opnum < 4; opnum++)
+				if (op[opnum].state != EG_OFF || op[opnum].volume < 0x3ff)
+				{
+					active |= 1 << chan;
+					break;
+				}
+	}
+	return active;
+}
+
+static inline void chan7_calc(YM2151 *PSG, UINT32 noise_rng)
 {
 	YM2151Operator *op;
 	unsigned int env;
@@ -1787,7 +1821,7 @@ static inline void chan7_calc(YM2151 *PSG)
 		noiseout = 0;
 		if (env < 0x3ff)
 			noiseout = (env ^ 0x3ff) * 2;   /* range of the YM2151 noise output is -2044 to 2040 */
-		PSG->chanout[7] += ((PSG->noise_rng&0x10000) ? noiseout: -noiseout); /* bit 16 -> output */
+		PSG->chanout[7] += ((noise_rng&0x10000) ? noiseout: -noiseout); /* bit 16 -> output */
 	}
 	else
 	{
@@ -2007,93 +2041,71 @@ rate 11 1         |
                                  --
 */
 
-static inline void advance_eg(YM2151 *PSG)
+static inline void advance_eg(YM2151Operator *op, UINT32 eg_cnt)
 {
-	YM2151Operator *op;
-	unsigned int i;
-
-
-
-	PSG->eg_timer += PSG->eg_timer_add;
-
-	while (PSG->eg_timer >= PSG->eg_timer_overflow)
+	switch(op->state)
 	{
-		PSG->eg_timer -= PSG->eg_timer_overflow;
-
-		PSG->eg_cnt++;
-
-		/* envelope generator */
-		op = &PSG->oper[0]; /* CH 0 M1 */
-		i = 32;
-		do
+	case EG_ATT:    /* attack phase */
+		if ( !(eg_cnt & ((1<<op->eg_sh_ar)-1) ) )
 		{
-			switch(op->state)
-			{
-			case EG_ATT:    /* attack phase */
-				if ( !(PSG->eg_cnt & ((1<<op->eg_sh_ar)-1) ) )
-				{
-					op->volume += (~op->volume *
-									(eg_inc[op->eg_sel_ar + ((PSG->eg_cnt>>op->eg_sh_ar)&7)])
-									) >>4;
-
-					if (op->volume <= MIN_ATT_INDEX)
-					{
-						op->volume = MIN_ATT_INDEX;
-						op->state = EG_DEC;
-					}
+			op->volume += (~op->volume *
+							(eg_inc[op->eg_sel_ar + ((eg_cnt>>op->eg_sh_ar)&7)])
+							) >>4;
 
-				}
-			break;
+			if (op->volume <= MIN_ATT_INDEX)
+			{
+				op->volume = MIN_ATT_INDEX;
+				op->state = EG_DEC;
+			}
 
-			case EG_DEC:    /* decay phase */
-				if ( !(PSG->eg_cnt & ((1<<op->eg_sh_d1r)-1) ) )
-				{
-					op->volume += eg_inc[op->eg_sel_d1r + ((PSG->eg_cnt>>op->eg_sh_d1r)&7)];
+		}
+	break;
 
-					if ( op->volume >= op->d1l )
-						op->state = EG_SUS;
+	case EG_DEC:    /* decay phase */
+		if ( !(eg_cnt & ((1<<op->eg_sh_d1r)-1) ) )
+		{
+			op->volume += eg_inc[op->eg_sel_d1r + ((eg_cnt>>op->eg_sh_d1r)&7)];
 
-				}
-			break;
+			if ( op->volume >= op->d1l )
+				op->state = EG_SUS;
 
-			case EG_SUS:    /* sustain phase */
-				if ( !(PSG->eg_cnt & ((1<<op->eg_sh_d2r)-1) ) )
-				{
-					op->volume += eg_inc[op->eg_sel_d2r + ((PSG->eg_cnt>>op->eg_sh_d2r)&7)];
+		}
+	break;
 
-					if ( op->volume >= MAX_ATT_INDEX )
-					{
-						op->volume = MAX_ATT_INDEX;
-						op->state = EG_OFF;
-					}
+	case EG_SUS:    /* sustain phase */
+		if ( !(eg_cnt & ((1<<op->eg_sh_d2r)-1) ) )
+		{
+			op->volume += eg_inc[op->eg_sel_d2r + ((eg_cnt>>op->eg_sh_d2r)&7)];
 
-				}
-			break;
+			if ( op->volume >= MAX_ATT_INDEX )
+			{
+				op->volume = MAX_ATT_INDEX;
+				op->state = EG_OFF;
+			}
 
-			case EG_REL:    /* release phase */
-				if ( !(PSG->eg_cnt & ((1<<op->eg_sh_rr)-1) ) )
-				{
-					op->volume += eg_inc[op->eg_sel_rr + ((PSG->eg_cnt>>op->eg_sh_rr)&7)];
+		}
+	break;
 
-					if ( op->volume >= MAX_ATT_INDEX )
-					{
-						op->volume = MAX_ATT_INDEX;
-						op->state = EG_OFF;
-					}
+	case EG_REL:    /* release phase */
+		if ( !(eg_cnt & ((1<<op->eg_sh_rr)-1) ) )
+		{
+			op->volume += eg_inc[op->eg_sel_rr + ((eg_cnt>>op->eg_sh_rr)&7)];
 
-				}
-			break;
+			if ( op->volume >= MAX_ATT_INDEX )
+			{
+				op->volume = MAX_ATT_INDEX;
+				op->state = EG_OFF;
 			}
-			op++;
-			i--;
-		}while (i);
+
+		}
+	break;
 	}
 }
 
 
-static inline void advance(YM2151 *PSG)
+/* advance the LFO to the next sample */
+static inline void advance_lfo(YM2151 *PSG)
 {
-	YM2151Operator *op;
 	unsigned int i;
 	int a,p;
 
@@ -2175,7 +2187,12 @@ static inline void advance(YM2151 *PSG)
 	}
 	PSG->lfa = a * PSG->amd / 128;
 	PSG->lfp = p * PSG->pmd / 128;
+}
 
+/* advance the noise generator to the next sample */
+static inline void advance_noise(YM2151 *PSG)
+{
+	unsigned int i;
 
 	/*  The Noise Generator of the YM2151 is 17-bit shift register.
 	*   Input to the bit16 is negated (bit0 XOR bit3) (EXNOR).
@@ -2192,49 +2209,49 @@ static inline void advance(YM2151 *PSG)
 		PSG->noise_rng = (j<<16) | (PSG->noise_rng>>1);
 		i--;
 	}
+}
 
-
-	/* phase generator */
-	op = &PSG->oper[0]; /* CH 0 M1 */
-	i = 8;
-	do
+/* advance the phases of a channel's operators by one sample */
+static inline void advance_phase(YM2151 *PSG, YM2151Operator *op, INT32 lfp)
+{
+	if (op->pms)    /* only when phase modulation from LFO is enabled for this channel */
 	{
-		if (op->pms)    /* only when phase modulation from LFO is enabled for this channel */
-		{
-			INT32 mod_ind = PSG->lfp;       /* -128..+127 (8bits signed) */
-			if (op->pms < 6)
-				mod_ind >>= (6 - op->pms);
-			else
-				mod_ind <<= (op->pms - 5);
+		INT32 mod_ind = lfp;       /* -128..+127 (8bits signed) */
+		if (op->pms < 6)
+			mod_ind >>= (6 - op->pms);
+		else
+			mod_ind <<= (op->pms - 5);
 
-			if (mod_ind)
-			{
-				UINT32 kc_channel = op->kc_i + mod_ind;
-				(op+0)->phase += ( (PSG->freq[ kc_channel + (op+0)->dt2 ] + (op+0)->dt1) * (op+0)->mul ) >> 1;
-				(op+1)->phase += ( (PSG->freq[ kc_channel + (op+1)->dt2 ] + (op+1)->dt1) * (op+1)->mul ) >> 1;
-				(op+2)->phase += ( (PSG->freq[ kc_channel + (op+2)->dt2 ] + (op+2)->dt1) * (op+2)->mul ) >> 1;
-				(op+3)->phase += ( (PSG->freq[ kc_channel + (op+3)->dt2 ] + (op+3)->dt1) * (op+3)->mul ) >> 1;
-			}
-			else        /* phase modulation from LFO is equal to zero */
-			{
-				(op+0)->phase += (op+0)->freq;
-				(op+1)->phase += (op+1)->freq;
-				(op+2)->phase += (op+2)->freq;
-				(op+3)->phase += (op+3)->freq;
-			}
+		if (mod_ind)
+		{
+			UINT32 kc_channel = op->kc_i + mod_ind;
+			(op+0)->phase += ( (PSG->freq[ kc_channel + (op+0)->dt2 ] + (op+0)->dt1) * (op+0)->mul ) >> 1;
+			(op+1)->phase += ( (PSG->freq[ kc_channel + (op+1)->dt2 ] + (op+1)->dt1) * (op+1)->mul ) >> 1;
+			(op+2)->phase += ( (PSG->freq[ kc_channel + (op+2)->dt2 ] + (op+2)->dt1) * (op+2)->mul ) >> 1;
+			(op+3)->phase += ( (PSG->freq[ kc_channel + (op+3)->dt2 ] + (op+3)->dt1) * (op+3)->mul ) >> 1;
 		}
-		else            /* phase modulation from LFO is disabled */
+		else        /* phase modulation from LFO is equal to zero */
 		{
 			(op+0)->phase += (op+0)->freq;
 			(op+1)->phase += (op+1)->freq;
 			(op+2)->phase += (op+2)->freq;
 			(op+3)->phase += (op+3)->freq;
 		}
+	}
+	else            /* phase modulation from LFO is disabled */
+	{
+		(op+0)->phase += (op+0)->freq;
+		(op+1)->phase += (op+1)->freq;
+		(op+2)->phase += (op+2)->freq;
+		(op+3)->phase += (op+3)->freq;
+	}
+}
 
-		op+=4;
-		i--;
-	}while (i);
-
+/* run a pending CSM key on / key off step */
+static inline void advance_csm(YM2151 *PSG)
+{
+	YM2151Operator *op;
+	unsigned int i;
 
 	/* CSM is calculated *after* the phase generator calculations (verified on real chip)
 	* CSM keyon line seems to be ORed with the KO line inside of the chip.
@@ -2370,6 +2387,115 @@ static inline signed int acc_calc(signed int value)
 #endif
 
 
+/* chip-wide generator values for each sample of a block; the envelope
+   counter is given before each sample's ticks, plus the final count, and
+   the LFO PM output is the one the phase generator sees after the sample */
+struct YM2151_BLOCK
+{
+	int     length;
+	UINT32  eg_cnt[YM2151_BLOCK_SAMPLES+1];
+	UINT32  lfa[YM2151_BLOCK_SAMPLES];
+	INT32   lfp[YM2151_BLOCK_SAMPLES];
+	UINT32  noise_rng[YM2151_BLOCK_SAMPLES];
+	INT32   chanout[8][YM2151_BLOCK_SAMPLES];
+};
+
+/* run the envelope timer, LFO and noise generator through a block */
+static inline void advance_block(YM2151 *PSG, YM2151_BLOCK *blk)
+{
+	UINT32 eg_cnt = PSG->eg_cnt;
+
+	for (int i = 0; i < blk->length; i++)
+	{
+		blk->eg_cnt[i] = eg_cnt;
+		PSG->eg_timer += PSG->eg_timer_add;
+		while (PSG->eg_timer >= PSG->eg_timer_overflow)
+		{
+			PSG->eg_timer -= PSG->eg_timer_overflow;
+			eg_cnt++;
+		}
+
+		blk->lfa[i] = PSG->lfa;
+		blk->noise_rng[i] = PSG->noise_rng;
+
+		advance_lfo(PSG);
+		advance_noise(PSG);
+		blk->lfp[i] = PSG->lfp;
+	}
+	blk->eg_cnt[blk->length] = eg_cnt;
+	PSG->eg_cnt = eg_cnt;
+}
+
+/* render one channel for a whole block */
+static void render_channel(YM2151 *PSG, YM2151_BLOCK *blk, unsigned int chan)
+{
+	YM2151Operator *op = &PSG->oper[chan*4];
+	signed int *chanout = PSG->chanout;
+
+	for (int i = 0; i < blk->length; i++)
+	{
+		for (UINT32 eg_cnt = blk->eg_cnt[i]; eg_cnt != blk->eg_cnt[i+1]; )
+		{
+			eg_cnt++;
+			advance_eg(op+0, eg_cnt);
+			advance_eg(op+1, eg_cnt);
+			advance_eg(op+2, eg_cnt);
+			advance_eg(op+3, eg_cnt);
+		}
+
+		PSG->lfa = blk->lfa[i];
+		chanout[chan] = 0;
+		if (chan == 7)
+			chan7_calc(PSG, blk->noise_rng[i]);
+		else
+			chan_calc(PSG, chan);
+		SAVE_SINGLE_CHANNEL(chan)
+		blk->chanout[chan][i] = chanout[chan];
+
+		advance_phase(PSG, op, blk->lfp[i]);
+	}
+}
+
+/* advance a silent channel through a block; its envelopes are off and stay
+   that way until a key on, so only the phases move */
+static void skip_channel(YM2151 *PSG, YM2151_BLOCK *blk, unsigned int chan)
+{
+	YM2151Operator *op = &PSG->oper[chan*4];
+
+	memset(blk->chanout[chan], 0, sizeof(blk->chanout[chan][0]) * blk->length);
+	if (op->pms)
+	{
+		for (int i = 0; i < blk->length; i++)
+			advance_phase(PSG, op, blk->lfp[i]);
+	}
+	else
+	{
+		(op+0)->phase += (op+0)->freq * blk->length;
+		(op+1)->phase += (op+1)->freq * blk->length;
+		(op+2)->phase += (op+2)->freq * blk->length;
+		(op+3)->phase += (op+3)->freq * blk->length;
+	}
+}
+
+/* render a block of per-channel output into blk->chanout */
+static void render_block(YM2151 *PSG, YM2151_BLOCK *blk)
+{
+	UINT32 active = active_channels(PSG);
+
+	advance_block(PSG, blk);
+	UINT32 lfa = PSG->lfa;
+
+	for (unsigned int chan = 0; chan < 8; chan++)
+	{
+		if (active & (1 << chan))
+			render_channel(PSG, blk, chan);
+		else
+			skip_channel(PSG, blk, chan);
+	}
+	PSG->lfa = lfa;
+}
+
+
 /*  Generate samples for one of the YM2151's
 *
 *   'num' is the number of virtual YM2151
@@ -2379,9 +2505,7 @@ static inline signed int acc_calc(signed int value)
 void ym2151_update_one(void *chip, SAMP **buffers, int length)
 {
 	YM2151 *PSG = (YM2151 *)chip;
-	signed int *chanout = PSG->chanout;
-	int i;
-	signed int outl,outr;
+	YM2151_BLOCK blk;
 	SAMP *bufL, *bufR;
 
 	bufL = buffers[0];
@@ -2406,63 +2530,45 @@ void ym2151_update_one(void *chip, SAMP **buffers, int length)
 	}
 #endif
 
-	for (i=0; i<length; i++)
+	for (int done = 0; done < length; done += blk.length)
 	{
-		advance_eg(PSG);
-
-		chanout[0] = 0;
-		chanout[1] = 0;
-		chanout[2] = 0;
-		chanout[3] = 0;
-		chanout[4] = 0;
-		chanout[5] = 0;
-		chanout[6] = 0;
-		chanout[7] = 0;
-
-		chan_calc(PSG, 0);
-		SAVE_SINGLE_CHANNEL(0)
-		chan_calc(PSG, 1);
-		SAVE_SINGLE_CHANNEL(1)
-		chan_calc(PSG, 2);
-		SAVE_SINGLE_CHANNEL(2)
-		chan_calc(PSG, 3);
-		SAVE_SINGLE_CHANNEL(3)
-		chan_calc(PSG, 4);
-		SAVE_SINGLE_CHANNEL(4)
-		chan_calc(PSG, 5);
-		SAVE_SINGLE_CHANNEL(5)
-		chan_calc(PSG, 6);
-		SAVE_SINGLE_CHANNEL(6)
-		chan7_calc(PSG);
-		SAVE_SINGLE_CHANNEL(7)
-
-		outl = chanout[0] & PSG->pan[0];
-		outr = chanout[0] & PSG->pan[1];
-		outl += (chanout[1] & PSG->pan[2]);
-		outr += (chanout[1] & PSG->pan[3]);
-		outl += (chanout[2] & PSG->pan[4]);
-		outr += (chanout[2] & PSG->pan[5]);
-		outl += (chanout[3] & PSG->pan[6]);
-		outr += (chanout[3] & PSG->pan[7]);
-		outl += (chanout[4] & PSG->pan[8]);
-		outr += (chanout[4] & PSG->pan[9]);
-		outl += (chanout[5] & PSG->pan[10]);
-		outr += (chanout[5] & PSG->pan[11]);
-		outl += (chanout[6] & PSG->pan[12]);
-		outr += (chanout[6] & PSG->pan[13]);
-		outl += (chanout[7] & PSG->pan[14]);
-		outr += (chanout[7] & PSG->pan[15]);
-
-		outl >>= FINAL_SH;
-		outr >>= FINAL_SH;
-		if (outl > MAXOUT) outl = MAXOUT;
-			else if (outl < MINOUT) outl = MINOUT;
-		if (outr > MAXOUT) outr = MAXOUT;
-			else if (outr < MINOUT) outr = MINOUT;
-		((SAMP*)bufL)[i] = (SAMP)outl;
-		((SAMP*)bufR)[i] = (SAMP)outr;
-
-		SAVE_ALL_CHANNELS
+		INT32 accl[YM2151_BLOCK_SAMPLES] = { 0 };
+		INT32 accr[YM2151_BLOCK_SAMPLES] = { 0 };
+
+#ifdef USE_MAME_TIMERS
+		/* a CSM sequence keys operators on and off between samples */
+		blk.length = PSG->csm_req ? 1 : std::min(length - done, YM2151_BLOCK_SAMPLES);
+#else
+		/* timer A can start a CSM sequence on any sample */
+		blk.length = 1;
+#endif
+		render_block(PSG, &blk);
+
+		for (int chan = 0; chan < 8; chan++)
+		{
+			const INT32 *out = blk.chanout[chan];
+			const UINT32 *pan = &PSG->pan[chan*2];
+
+			for (int i = 0; i < blk.length; i++)
+			{
+				accl[i] += out[i] & pan[0];
+				accr[i] += out[i] & pan[1];
+			}
+		}
+
+		for (int i = 0; i < blk.length; i++)
+		{
+			signed int outl = accl[i] >> FINAL_SH;
+			signed int outr = accr[i] >> FINAL_SH;
+			if (outl > MAXOUT) outl = MAXOUT;
+				else if (outl < MINOUT) outl = MINOUT;
+			if (outr > MAXOUT) outr = MAXOUT;
+				else if (outr < MINOUT) outr = MINOUT;
+			((SAMP*)bufL)[done + i] = (SAMP)outl;
+			((SAMP*)bufR)[done + i] = (SAMP)outr;
+
+			SAVE_ALL_CHANNELS
+		}
 
 #ifdef USE_MAME_TIMERS
 		/* ASG 980324 - handled by real timers now */
@@ -2485,7 +2591,7 @@ void ym2151_update_one(void *chip, SAMP **buffers, int length)
 			}
 		}
 #endif
-		advance(PSG);
+		advance_csm(PSG);
 	}
 }
 
@@ -108,6 +108,9 @@ differences between OPL2 and OPL3 shown in datasheets:
 #define EG_REL          1
 #define EG_OFF          0
 
+/* samples rendered channel by channel in one go */
+#define OPL3_BLOCK_SAMPLES  64
+
 
 /* save output as raw 16-bit sample */
 
@@ -682,137 +685,118 @@ static inline void advance_lfo(OPL3 *chip)
 	chip->LFO_PM = ((chip->lfo_pm_cnt>>LFO_SH) & 7) | chip->lfo_pm_depth_range;
 }
 
-/* advance to next sample */
-static inline void advance(OPL3 *chip)
+/* advance an operator's envelope by one tick of the envelope generator */
+static inline void advance_eg(OPL3_SLOT *op, UINT32 eg_cnt)
 {
-	OPL3_CH *CH;
-	OPL3_SLOT *op;
-	int i;
-
-	chip->eg_timer += chip->eg_timer_add;
-
-	while (chip->eg_timer >= chip->eg_timer_overflow)
+	switch(op->state)
 	{
-		chip->eg_timer -= chip->eg_timer_overflow;
-
-		chip->eg_cnt++;
-
-		for (i=0; i<9*2*2; i++)
+	case EG_ATT:    /* attack phase */
+//      if ( !(eg_cnt & ((1<<op->eg_sh_ar)-1) ) )
+		if ( !(eg_cnt & op->eg_m_ar) )
 		{
-			CH  = &chip->P_CH[i/2];
-			op  = &CH->SLOT[i&1];
-#if 1
-			/* Envelope Generator */
-			switch(op->state)
-			{
-			case EG_ATT:    /* attack phase */
-//              if ( !(chip->eg_cnt & ((1<<op->eg_sh_ar)-1) ) )
-				if ( !(chip->eg_cnt & op->eg_m_ar) )
-				{
-					op->volume += (~op->volume *
-												(eg_inc[op->eg_sel_ar + ((chip->eg_cnt>>op->eg_sh_ar)&7)])
-												) >>3;
-
-					if (op->volume <= MIN_ATT_INDEX)
-					{
-						op->volume = MIN_ATT_INDEX;
-						op->state = EG_DEC;
-					}
+			op->volume += (~op->volume *
+										(eg_inc[op->eg_sel_ar + ((eg_cnt>>op->eg_sh_ar)&7)])
+										) >>3;
 
-				}
-			break;
-
-			case EG_DEC:    /* decay phase */
-//              if ( !(chip->eg_cnt & ((1<<op->eg_sh_dr)-1) ) )
-				if ( !(chip->eg_cnt & op->eg_m_dr) )
-				{
-					op->volume += eg_inc[op->eg_sel_dr + ((chip->eg_cnt>>op->eg_sh_dr)&7)];
+			if (op->volume <= MIN_ATT_INDEX)
+			{
+				op->volume = MIN_ATT_INDEX;
+				op->state = EG_DEC;
+			}
 
-					if ( op->volume >= op->sl )
-						op->state = EG_SUS;
+		}
+	break;
 
-				}
-			break;
+	case EG_DEC:    /* decay phase */
+//      if ( !(eg_cnt & ((1<<op->eg_sh_dr)-1) ) )
+		if ( !(eg_cnt & op->eg_m_dr) )
+		{
+			op->volume += eg_inc[op->eg_sel_dr + ((eg_cnt>>op->eg_sh_dr)&7)];
 
-			case EG_SUS:    /* sustain phase */
+			if ( op->volume >= op->sl )
+				op->state = EG_SUS;
 
-				/* this is important behaviour:
-				one can change percusive/non-percussive modes on the fly and
-				the chip will remain in sustain phase - verified on real YM3812 */
+		}
+	break;
 
-				if(op->eg_type)     /* non-percussive mode */
-				{
-									/* do nothing */
-				}
-				else                /* percussive mode */
-				{
-					/* during sustain phase chip adds Release Rate (in percussive mode) */
-//                  if ( !(chip->eg_cnt & ((1<<op->eg_sh_rr)-1) ) )
-					if ( !(chip->eg_cnt & op->eg_m_rr) )
-					{
-						op->volume += eg_inc[op->eg_sel_rr + ((chip->eg_cnt>>op->eg_sh_rr)&7)];
+	case EG_SUS:    /* sustain phase */
 
-						if ( op->volume >= MAX_ATT_INDEX )
-							op->volume = MAX_ATT_INDEX;
-					}
-					/* else do nothing in sustain phase */
-				}
-			break;
+		/* this is important behaviour:
+		one can change percusive/non-percussive modes on the fly and
+		the chip will remain in sustain phase - verified on real YM3812 */
 
-			case EG_REL:    /* release phase */
-//              if ( !(chip->eg_cnt & ((1<<op->eg_sh_rr)-1) ) )
-				if ( !(chip->eg_cnt & op->eg_m_rr) )
-				{
-					op->volume += eg_inc[op->eg_sel_rr + ((chip->eg_cnt>>op->eg_sh_rr)&7)];
+		if(op->eg_type)     /* non-percussive mode */
+		{
+							/* do nothing */
+		}
+		else                /* percussive mode */
+		{
+			/* during sustain phase chip adds Release Rate (in percussive mode) */
+//          if ( !(eg_cnt & ((1<<op->eg_sh_rr)-1) ) )
+			if ( !(eg_cnt & op->eg_m_rr) )
+			{
+				op->volume += eg_inc[op->eg_sel_rr + ((eg_cnt>>op->eg_sh_rr)&7)];
 
-					if ( op->volume >= MAX_ATT_INDEX )
-					{
-						op->volume = MAX_ATT_INDEX;
-						op->state = EG_OFF;
-					}
+				if ( op->volume >= MAX_ATT_INDEX )
+					op->volume = MAX_ATT_INDEX;
+			}
+			/* else do nothing in sustain phase */
+		}
+	break;
 
-				}
-			break;
+	case EG_REL:    /* release phase */
+//      if ( !(eg_cnt & ((1<<op->eg_sh_rr)-1) ) )
+		if ( !(eg_cnt & op->eg_m_rr) )
+		{
+			op->volume += eg_inc[op->eg_sel_rr + ((eg_cnt>>op->eg_sh_rr)&7)];
 
-			default:
-			break;
+			if ( op->volume >= MAX_ATT_INDEX )
+			{
+				op->volume = MAX_ATT_INDEX;
+				op->state = EG_OFF;
 			}
-#endif
+
 		}
+	break;
+
+	default:
+	break;
 	}
+}
 
-	for (i=0; i<9*2*2; i++)
+/* advance an operator's phase by one sample */
+static inline void advance_phase(OPL3 *chip, OPL3_CH *CH, OPL3_SLOT *op, INT32 lfo_pm)
+{
+	/* Phase Generator */
+	if(op->vib)
 	{
-		CH  = &chip->P_CH[i/2];
-		op  = &CH->SLOT[i&1];
+		UINT8 block;
+		unsigned int block_fnum = CH->block_fnum;
 
-		/* Phase Generator */
-		if(op->vib)
-		{
-			UINT8 block;
-			unsigned int block_fnum = CH->block_fnum;
-
-			unsigned int fnum_lfo   = (block_fnum&0x0380) >> 7;
+		unsigned int fnum_lfo   = (block_fnum&0x0380) >> 7;
 
-			signed int lfo_fn_table_index_offset = lfo_pm_table[chip->LFO_PM + 16*fnum_lfo ];
+		signed int lfo_fn_table_index_offset = lfo_pm_table[lfo_pm + 16*fnum_lfo ];
 
-			if (lfo_fn_table_index_offset)  /* LFO phase modulation active */
-			{
-				block_fnum += lfo_fn_table_index_offset;
-				block = (block_fnum&0x1c00) >> 10;
-				op->Cnt += (chip->fn_tab[block_fnum&0x03ff] >> (7-block)) * op->mul;
-			}
-			else    /* LFO phase modulation  = zero */
-			{
-				op->Cnt += op->Incr;
-			}
+		if (lfo_fn_table_index_offset)  /* LFO phase modulation active */
+		{
+			block_fnum += lfo_fn_table_index_offset;
+			block = (block_fnum&0x1c00) >> 10;
+			op->Cnt += (chip->fn_tab[block_fnum&0x03ff] >> (7-block)) * op->mul;
 		}
-		else    /* LFO phase modulation disabled for this operator */
+		else    /* LFO phase modulation  = zero */
 		{
 			op->Cnt += op->Incr;
 		}
 	}
+	else    /* LFO phase modulation disabled for this operator */
+	{
+		op->Cnt += op->Incr;
+	}
+}
 
+/* advance the noise generator by one sample */
+static inline void advance_noise(OPL3 *chip)
+{
 	/*  The Noise Generator of the YM3812 is 23-bit shift register.
 	*   Period is equal to 2^23-2 samples.
 	*   Register works at sampling frequency of the chip, so output
@@ -825,7 +809,7 @@ static inline void advance(OPL3 *chip)
 	*/
 
 	chip->noise_p += chip->noise_f;
-	i = chip->noise_p >> FREQ_SH;       /* number of events (shifts of the shift register) */
+	int i = chip->noise_p >> FREQ_SH;       /* number of events (shifts of the shift register) */
 	chip->noise_p &= FREQ_MASK;
 	while (i)
 	{
@@ -934,6 +918,35 @@ static inline void chan_calc_ext( OPL3 *chip, OPL3_CH *CH )
 
 }
 
+/* a channel whose slots have both finished releasing, and whose feedback
+   history has drained, adds exactly nothing until its next key on; each
+   block skips such channels, advancing only their phases.
+   The halves of a 4-op channel pass modulation through the chip, so
+   they are only ever skipped together */
+static inline UINT32 OPL3_active_channels(OPL3 *chip)
+{
+	UINT32 active = 0;
+
+	for (int ch = 0; ch < 18; ch++)
+	{
+		const OPL3_SLOT *SLOT1P = &chip->P_CH[ch].SLOT[SLOT1];
+		const OPL3_SLOT *SLOT2P = &chip->P_CH[ch].SLOT[SLOT2];
+
+		if (SLOT1P->state != EG_OFF || SLOT1P->volume < ENV_QUIET || SLOT1P->op1_out[0] != 0 || SLOT1P->op1_out[1] != 0 ||
+			SLOT2P->state != EG_OFF || SLOT2P->volume < ENV_QUIET)
+			active |= 1 << ch;
+	}
+
+	static const UINT8 pairs[6] = { 0, 1, 2, 9, 10, 11 };
+	for (int p = 0; p < 6; p++)
+	{
+		int const ch = pairs[p];
+		if (chip->P_CH[ch].extended && (active & ((1 << ch) | (1 << (ch + 3)))))
+			active |= (1 << ch) | (1 << (ch + 3));
+	}
+	return active;
+}
+
 /*
     operators used in the rhythm sounds generation process:
 
@@ -1138,6 +1151,158 @@ static inline void chan_calc_rhythm( OPL3 *chip, OPL3_CH *CH, unsigned int noise
 }
 
 
+/* chip-wide generator values for each sample of a block; the envelope
+   counter is given before each sample's ticks, plus the final count */
+struct OPL3_BLOCK
+{
+	int     length;
+	UINT32  eg_cnt[OPL3_BLOCK_SAMPLES+1];
+	UINT32  LFO_AM[OPL3_BLOCK_SAMPLES];
+	INT32   LFO_PM[OPL3_BLOCK_SAMPLES];
+	UINT8   noise[OPL3_BLOCK_SAMPLES];
+	INT32   chanout[18][OPL3_BLOCK_SAMPLES];
+};
+
+/* run the LFO, envelope timer and noise generator through a block */
+static inline void OPL3_advance_block(OPL3 *chip, OPL3_BLOCK *blk)
+{
+	UINT32 eg_cnt = chip->eg_cnt;
+
+	for (int i = 0; i < blk->length; i++)
+	{
+		advance_lfo(chip);
+		blk->LFO_AM[i] = chip->LFO_AM;
+		blk->LFO_PM[i] = chip->LFO_PM;
+		blk->noise[i] = chip->noise_rng & 1;
+		blk->eg_cnt[i] = eg_cnt;
+
+		chip->eg_timer += chip->eg_timer_add;
+		while (chip->eg_timer >= chip->eg_timer_overflow)
+		{
+			chip->eg_timer -= chip->eg_timer_overflow;
+			eg_cnt++;
+		}
+
+		advance_noise(chip);
+	}
+	blk->eg_cnt[blk->length] = eg_cnt;
+	chip->eg_cnt = eg_cnt;
+}
+
+/* advance both operators of a channel past sample i of a block */
+static inline void OPL3_advance_channel(OPL3 *chip, OPL3_CH *CH, const OPL3_BLOCK *blk, int i)
+{
+	for (int slot = 0; slot < 2; slot++)
+	{
+		OPL3_SLOT *op = &CH->SLOT[slot];
+		for (UINT32 eg_cnt = blk->eg_cnt[i]; eg_cnt != blk->eg_cnt[i+1]; )
+			advance_eg(op, ++eg_cnt);
+		advance_phase(chip, CH, op, blk->LFO_PM[i]);
+	}
+}
+
+/* render a 2-op channel, or both halves of a 4-op channel when ext is
+   set, for a whole block; their slots only write to their own outputs */
+static void OPL3_render_channel(OPL3 *chip, OPL3_BLOCK *blk, int ch, bool ext)
+{
+	OPL3_CH *CH = &chip->P_CH[ch];
+	signed int *chanout = chip->chanout;
+
+	for (int i = 0; i < blk->length; i++)
+	{
+		chip->LFO_AM = blk->LFO_AM[i];
+
+		chanout[ch] = 0;
+		if (ext)
+			chanout[ch+3] = 0;
+
+		chan_calc(chip, CH);
+		if (ext)
+			chan_calc_ext(chip, CH+3);
+
+		blk->chanout[ch][i] = chanout[ch];
+		OPL3_advance_channel(chip, CH, blk, i);
+		if (ext)
+		{
+			blk->chanout[ch+3][i] = chanout[ch+3];
+			OPL3_advance_channel(chip, CH+3, blk, i);
+		}
+	}
+}
+
+/* advance a silent channel through a block; its envelopes are off and stay
+   that way until a key on, so only the phases move */
+static void OPL3_skip_channel(OPL3 *chip, OPL3_BLOCK *blk, int ch)
+{
+	OPL3_CH *CH = &chip->P_CH[ch];
+
+	memset(blk->chanout[ch], 0, sizeof(blk->chanout[ch][0]) * blk->length);
+	for (int slot = 0; slot < 2; slot++)
+	{
+		OPL3_SLOT *op = &CH->SLOT[slot];
+		if (op->vib)
+		{
+			for (int i = 0; i < blk->length; i++)
+				advance_phase(chip, CH, op, blk->LFO_PM[i]);
+		}
+		else
+			op->Cnt += op->Incr * blk->length;
+	}
+}
+
+/* render a block of per-channel output into blk->chanout; the rhythm
+   channels depend on each other and are rendered together */
+static void OPL3_render_block(OPL3 *chip, OPL3_BLOCK *blk)
+{
+	UINT8 rhythm = chip->rhythm&0x20;
+	UINT32 active = OPL3_active_channels(chip);
+
+	OPL3_advance_block(chip, blk);
+
+	for (int ch = 0; ch < 18; ch++)
+	{
+		int const pos = ch % 9;
+
+		/* rhythm channels are handled below */
+		if (rhythm && ch >= 6 && ch < 9)
+			continue;
+
+		/* second half of a 4-op channel goes with the first */
+		if (pos >= 3 && pos < 6 && chip->P_CH[ch-3].extended)
+			continue;
+
+		bool const ext = (pos < 3) && chip->P_CH[ch].extended;
+		if (active & (1 << ch))
+			OPL3_render_channel(chip, blk, ch, ext);
+		else
+		{
+			OPL3_skip_channel(chip, blk, ch);
+			if (ext)
+				OPL3_skip_channel(chip, blk, ch+3);
+		}
+	}
+
+	if (rhythm)
+	{
+		signed int *chanout = chip->chanout;
+
+		for (int i = 0; i < blk->length; i++)
+		{
+			chip->LFO_AM = blk->LFO_AM[i];
+			chanout[6] = chanout[7] = chanout[8] = 0;
+			chan_calc_rhythm(chip, &chip->P_CH[0], blk->noise[i]);
+
+			for (int ch = 6; ch < 9; ch++)
+			{
+				blk->chanout[ch][i] = chanout[ch];
+				OPL3_advance_channel(chip, &chip->P_CH[ch], blk, i);
+			}
+		}
+	}
+	chip->LFO_AM = blk->LFO_AM[blk->length-1];
+}
+
+
 /* generic table initialize */
 static int init_tables(void)
 {
@@ -2522,194 +2687,64 @@ void ymf262_set_update_handler(void *chip,OPL3_UPDATEHANDLER UpdateHandler,void
 */
 void ymf262_update_one(void *_chip, OPL3SAMPLE **buffers, int length)
 {
-	int i;
 	OPL3        *chip  = (OPL3 *)_chip;
-	signed int *chanout = chip->chanout;
-	UINT8       rhythm = chip->rhythm&0x20;
+	OPL3_BLOCK  blk;
 
 	OPL3SAMPLE  *ch_a = buffers[0];
 	OPL3SAMPLE  *ch_b = buffers[1];
 	OPL3SAMPLE  *ch_c = buffers[2];
 	OPL3SAMPLE  *ch_d = buffers[3];
 
-	for( i=0; i < length ; i++ )
+	for (int done = 0; done < length; done += blk.length)
 	{
-		int a,b,c,d;
-
-
-		advance_lfo(chip);
-
-		/* clear channel outputs */
-		memset(chip->chanout, 0, sizeof(chip->chanout));
-
-#if 1
-	/* register set #1 */
-		chan_calc(chip, &chip->P_CH[0]);            /* extended 4op ch#0 part 1 or 2op ch#0 */
-		if (chip->P_CH[0].extended)
-			chan_calc_ext(chip, &chip->P_CH[3]);    /* extended 4op ch#0 part 2 */
-		else
-			chan_calc(chip, &chip->P_CH[3]);        /* standard 2op ch#3 */
-
+		INT32 acc_a[OPL3_BLOCK_SAMPLES] = { 0 };
+		INT32 acc_b[OPL3_BLOCK_SAMPLES] = { 0 };
+		INT32 acc_c[OPL3_BLOCK_SAMPLES] = { 0 };
+		INT32 acc_d[OPL3_BLOCK_SAMPLES] = { 0 };
 
-		chan_calc(chip, &chip->P_CH[1]);            /* extended 4op ch#1 part 1 or 2op ch#1 */
-		if (chip->P_CH[1].extended)
-			chan_calc_ext(chip, &chip->P_CH[4]);    /* extended 4op ch#1 part 2 */
-		else
-			chan_calc(chip, &chip->P_CH[4]);        /* standard 2op ch#4 */
+		blk.length = std::min(length - done, OPL3_BLOCK_SAMPLES);
+		OPL3_render_block(chip, &blk);
 
-
-		chan_calc(chip, &chip->P_CH[2]);            /* extended 4op ch#2 part 1 or 2op ch#2 */
-		if (chip->P_CH[2].extended)
-			chan_calc_ext(chip, &chip->P_CH[5]);    /* extended 4op ch#2 part 2 */
-		else
-			chan_calc(chip, &chip->P_CH[5]);        /* standard 2op ch#5 */
-
-
-		if(!rhythm)
-		{
-			chan_calc(chip, &chip->P_CH[6]);
-			chan_calc(chip, &chip->P_CH[7]);
-			chan_calc(chip, &chip->P_CH[8]);
-		}
-		else        /* Rhythm part */
+		/* accumulators, channel by channel */
+		for (int ch = 0; ch < 18; ch++)
 		{
-			chan_calc_rhythm(chip, &chip->P_CH[0], (chip->noise_rng>>0)&1 );
-		}
-
-	/* register set #2 */
-		chan_calc(chip, &chip->P_CH[ 9]);
-		if (chip->P_CH[9].extended)
-			chan_calc_ext(chip, &chip->P_CH[12]);
-		else
-			chan_calc(chip, &chip->P_CH[12]);
-
-
-		chan_calc(chip, &chip->P_CH[10]);
-		if (chip->P_CH[10].extended)
-			chan_calc_ext(chip, &chip->P_CH[13]);
-		else
-			chan_calc(chip, &chip->P_CH[13]);
-
-
-		chan_calc(chip, &chip->P_CH[11]);
-		if (chip->P_CH[11].extended)
-			chan_calc_ext(chip, &chip->P_CH[14]);
-		else
-			chan_calc(chip, &chip->P_CH[14]);
-
+			const INT32 *out = blk.chanout[ch];
+			const UINT32 *pan = &chip->pan[ch*4];
 
-		/* channels 15,16,17 are fixed 2-operator channels only */
-		chan_calc(chip, &chip->P_CH[15]);
-		chan_calc(chip, &chip->P_CH[16]);
-		chan_calc(chip, &chip->P_CH[17]);
-#endif
-
-		/* accumulator register set #1 */
-		a =  chanout[0] & chip->pan[0];
-		b =  chanout[0] & chip->pan[1];
-		c =  chanout[0] & chip->pan[2];
-		d =  chanout[0] & chip->pan[3];
-#if 1
-		a += chanout[1] & chip->pan[4];
-		b += chanout[1] & chip->pan[5];
-		c += chanout[1] & chip->pan[6];
-		d += chanout[1] & chip->pan[7];
-		a += chanout[2] & chip->pan[8];
-		b += chanout[2] & chip->pan[9];
-		c += chanout[2] & chip->pan[10];
-		d += chanout[2] & chip->pan[11];
-
-		a += chanout[3] & chip->pan[12];
-		b += chanout[3] & chip->pan[13];
-		c += chanout[3] & chip->pan[14];
-		d += chanout[3] & chip->pan[15];
-		a += chanout[4] & chip->pan[16];
-		b += chanout[4] & chip->pan[17];
-		c += chanout[4] & chip->pan[18];
-		d += chanout[4] & chip->pan[19];
-		a += chanout[5] & chip->pan[20];
-		b += chanout[5] & chip->pan[21];
-		c += chanout[5] & chip->pan[22];
-		d += chanout[5] & chip->pan[23];
-
-		a += chanout[6] & chip->pan[24];
-		b += chanout[6] & chip->pan[25];
-		c += chanout[6] & chip->pan[26];
-		d += chanout[6] & chip->pan[27];
-		a += chanout[7] & chip->pan[28];
-		b += chanout[7] & chip->pan[29];
-		c += chanout[7] & chip->pan[30];
-		d += chanout[7] & chip->pan[31];
-		a += chanout[8] & chip->pan[32];
-		b += chanout[8] & chip->pan[33];
-		c += chanout[8] & chip->pan[34];
-		d += chanout[8] & chip->pan[35];
-
-		/* accumulator register set #2 */
-		a += chanout[9] & chip->pan[36];
-		b += chanout[9] & chip->pan[37];
-		c += chanout[9] & chip->pan[38];
-		d += chanout[9] & chip->pan[39];
-		a += chanout[10] & chip->pan[40];
-		b += chanout[10] & chip->pan[41];
-		c += chanout[10] & chip->pan[42];
-		d += chanout[10] & chip->pan[43];
-		a += chanout[11] & chip->pan[44];
-		b += chanout[11] & chip->pan[45];
-		c += chanout[11] & chip->pan[46];
-		d += chanout[11] & chip->pan[47];
-
-		a += chanout[12] & chip->pan[48];
-		b += chanout[12] & chip->pan[49];
-		c += chanout[12] & chip->pan[50];
-		d += chanout[12] & chip->pan[51];
-		a += chanout[13] & chip->pan[52];
-		b += chanout[13] & chip->pan[53];
-		c += chanout[13] & chip->pan[54];
-		d += chanout[13] & chip->pan[55];
-		a += chanout[14] & chip->pan[56];
-		b += chanout[14] & chip->pan[57];
-		c += chanout[14] & chip->pan[58];
-		d += chanout[14] & chip->pan[59];
-
-		a += chanout[15] & chip->pan[60];
-		b += chanout[15] & chip->pan[61];
-		c += chanout[15] & chip->pan[62];
-		d += chanout[15] & chip->pan[63];
-		a += chanout[16] & chip->pan[64];
-		b += chanout[16] & chip->pan[65];
-		c += chanout[16] & chip->pan[66];
-		d += chanout[16] & chip->pan[67];
-		a += chanout[17] & chip->pan[68];
-		b += chanout[17] & chip->pan[69];
-		c += chanout[17] & chip->pan[70];
-		d += chanout[17] & chip->pan[71];
-#endif
-		a >>= FINAL_SH;
-		b >>= FINAL_SH;
-		c >>= FINAL_SH;
-		d >>= FINAL_SH;
-
-		/* limit check */
-		a = limit( a , MAXOUT, MINOUT );
-		b = limit( b , MAXOUT, MINOUT );
-		c = limit( c , MAXOUT, MINOUT );
-		d = limit( d , MAXOUT, MINOUT );
-
-		#ifdef SAVE_SAMPLE
-		if (which==0)
-		{
-			SAVE_ALL_CHANNELS
+			for (int i = 0; i < blk.length; i++)
+			{
+				acc_a[i] += out[i] & pan[0];
+				acc_b[i] += out[i] & pan[1];
+				acc_c[i] += out[i] & pan[2];
+				acc_d[i] += out[i] & pan[3];
+			}
 		}
-		#endif
 
-		/* store to sound buffer */
-		ch_a[i] = a;
-		ch_b[i] = b;
-		ch_c[i] = c;
-		ch_d[i] = d;
+		for (int i = 0; i < blk.length; i++)
+		{
+			int a = acc_a[i] >> FINAL_SH;
+			int b = acc_b[i] >> FINAL_SH;
+			int c = acc_c[i] >> FINAL_SH;
+			int d = acc_d[i] >> FINAL_SH;
+
+			/* limit check */
+			a = limit( a , MAXOUT, MINOUT );
+			b = limit( b , MAXOUT, MINOUT );
+			c = limit( c , MAXOUT, MINOUT );
+			d = limit( d , MAXOUT, MINOUT );
+
+			#ifdef SAVE_SAMPLE
+			if (which==0)
+			{
+				SAVE_ALL_CHANNELS
+			}
+			#endif
 
-		advance(chip);
+			/* store to sound buffer */
+			ch_a[done + i] = a;
+			ch_b[done + i] = b;
+			ch_c[done + i] = c;
+			ch_d[done + i] = d;
+		}
 	}
-
 }
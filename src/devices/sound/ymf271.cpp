@@ -24,6 +24,7 @@
 
 #include "emu.h"
 #include "ymf271.h"
+#include "sndlog.h"
 
 #define STD_CLOCK       (16934400)
 
@@ -1427,6 +1428,7 @@ void ymf271_device::ymf271_write_timer(UINT8 address, UINT8 data)
 
 WRITE8_MEMBER( ymf271_device::write )
 {
+	log_register_write(offset, data, mem_mask);
 	m_stream->update();
 
 	m_regs_main[offset & 0xf] = data;
@@ -1695,6 +1697,17 @@ void ymf271_device::init_state()
 	save_item(NAME(m_ext_readlatch));
 }
 
+//-------------------------------------------------
+//  sound_log_memory - add the sample ROM to a
+//  register log
+//-------------------------------------------------
+
+void ymf271_device::sound_log_memory(sound_log_writer &log)
+{
+	if (m_mem_base != nullptr)
+		log.add_memory(0, *memregion(DEVICE_SELF));
+}
+
 //-------------------------------------------------
 //  device_start - device-specific startup
 //-------------------------------------------------
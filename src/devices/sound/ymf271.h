@@ -38,6 +38,7 @@ protected:
 
 	// sound stream update overrides
 	virtual void sound_stream_update(sound_stream &stream, stream_sample_t **inputs, stream_sample_t **outputs, int samples) override;
+	virtual void sound_log_memory(sound_log_writer &log) override;
 private:
 	struct YMF271Slot
 	{
@@ -30,6 +30,20 @@
         +---------------+---------------+---------------+
     (0.0,2.0)       (1.0,2.0)       (2.0,2.0)       (3.0,2.0)
 
+****************************************************************************
+
+    Work distribution:
+
+    Each polygon is cut into work units of up to SCANLINES_PER_BUCKET
+    scanlines.  Units in the same bucket row are chained so that they run
+    in the order queued.  A polygon's units are handed to one per-thread
+    deque as a batch, and threads that run out of work steal from the
+    others.
+
+    Binning is by scanline rows only.  A 2D tile mode was tried and
+    dropped: untiled units could run alongside tiled ones covering the same
+    pixels, and no driver used it.
+
 ***************************************************************************/
 
 #pragma once
@@ -39,14 +53,15 @@
 
 #include <limits.h>
 #include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 //**************************************************************************
 //  DEBUGGING
 //**************************************************************************
 
-// keep statistics
-#define KEEP_POLY_STATISTICS            0
-
 // turn this on to log the reasons for any long waits
 #define LOG_WAITS                       0
 
@@ -63,9 +78,9 @@
 #define POLYFLAG_INCLUDE_RIGHT_EDGE         0x02
 #define POLYFLAG_NO_WORK_QUEUE              0x04
 
-#define SCANLINES_PER_BUCKET                8
+#define SCANLINES_PER_BUCKET                8           // maximum scanlines in a work unit
 #define CACHE_LINE_SIZE                     64          // this is a general guess
-#define TOTAL_BUCKETS                       (512 / SCANLINES_PER_BUCKET)
+#define MAX_BUCKET_ROWS                     4096        // rows beyond this share buckets, which only serializes them
 #define UNITS_PER_POLY                      (100 / SCANLINES_PER_BUCKET)
 
 
@@ -92,6 +107,40 @@ inline double poly_abs(double x) { return fabs(x); }
 inline double poly_recip(double x) { return 1.0 / x; }
 
 
+// ======================> poly_statistics
+
+// counters describing the work a poly_manager has done since they were reset
+struct poly_statistics
+{
+	UINT32              tiles;                      // number of tiles queued
+	UINT32              triangles;                  // number of triangles queued
+	UINT32              quads;                      // number of quads queued
+	UINT64              pixels;                     // number of pixels rendered
+	UINT32              units;                      // number of work units queued
+	UINT32              unit_waits;                 // stalls waiting for free work units
+	UINT32              polygon_waits;              // stalls waiting for free polygons
+	UINT32              object_waits;               // stalls waiting for free object data
+	UINT32              conflicts;                  // units whose predecessor in the same bucket was still running
+	UINT32              resolved;                   // conflicts handed off to the predecessor's thread
+	UINT32              steals;                     // units taken from another thread's queue
+	UINT32              thread_units[WORK_MAX_THREADS]; // units executed by each thread
+
+	// ratio of the busiest thread's units to the average over threads that did any work; 1.0 is perfect
+	float imbalance() const
+	{
+		UINT32 total = 0, busiest = 0, threads = 0;
+		for (UINT32 count : thread_units)
+			if (count != 0)
+			{
+				total += count;
+				busiest = MAX(busiest, count);
+				threads++;
+			}
+		return (total == 0) ? 1.0f : float(busiest) * float(threads) / float(total);
+	}
+};
+
+
 // poly_manager is a template class
 template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
 class poly_manager
@@ -134,6 +183,10 @@ public:
 	// synchronization
 	void wait(const char *debug_reason = "general");
 
+	// statistics
+	poly_statistics statistics() const;
+	void reset_statistics();
+
 	// object data allocators
 	_ObjectData &object_data_alloc();
 	_ObjectData &object_data_last() const { return m_object.last(); }
@@ -163,6 +216,14 @@ private:
 		render_delegate     m_callback;             // callback to handle a scanline's worth of work
 	};
 
+	// per-thread queue of unit indexes; the owning thread takes from the front
+	// and idle threads steal from the back
+	struct work_deque
+	{
+		std::mutex          m_lock;
+		std::deque<UINT32>  m_units;
+	};
+
 	// internal unit of work
 	struct work_unit
 	{
@@ -208,6 +269,7 @@ private:
 
 		// operations
 		void reset() { m_next = 0; }
+		void reset_waits() { m_waits = 0; }
 		_Type &next() { if (m_next > m_max) m_max = m_next; assert(m_next < _Count); return *new(m_base.get() + m_next++ * k_itemsize) _Type; }
 		_Type &last() const { return (*this)[m_next - 1]; }
 		void wait_for_space(int count = 1) { while ((m_next + count) >= _Count) { m_waits++; m_manager.wait(""); }  }
@@ -251,8 +313,16 @@ private:
 		return polygon;
 	}
 
+	// return the offset of a scanline within its bucket row
+	UINT32 bucket_offset(INT32 scanline) const { return UINT32(scanline) % SCANLINES_PER_BUCKET; }
+
+	void link_unit(UINT32 unitnum);
+	void queue_units(UINT32 startunit);
 	static void *work_item_callback(void *param, int threadid);
+	static void *worker_callback(void *param, int threadid);
+	bool worker_pop(int home, UINT32 &unitnum);
 	void presave() { wait("pre-save"); }
+	void machine_exit() { wait("exit"); }
 
 	// queue management
 	running_machine &   m_machine;
@@ -268,17 +338,24 @@ private:
 	UINT8               m_flags;                    // flags
 
 	// buckets
-	UINT16              m_unit_bucket[TOTAL_BUCKETS]; // buckets for tracking unit usage
+	std::vector<UINT16> m_unit_bucket;              // last unit queued to each bucket row
+
+	// work stealing
+	int                 m_workers;                  // maximum concurrent workers, and number of deques
+	std::unique_ptr<work_deque[]> m_deque;          // per-worker deques of queued units
+	std::atomic<int>    m_pending;                  // units queued but not yet taken
+	std::atomic<int>    m_active;                   // workers running or queued
 
 	// statistics
 	UINT32              m_tiles;                    // number of tiles queued
 	UINT32              m_triangles;                // number of triangles queued
 	UINT32              m_quads;                    // number of quads queued
 	UINT64              m_pixels;                   // number of pixels rendered
-#if KEEP_POLY_STATISTICS
-	UINT32              m_conflicts[WORK_MAX_THREADS]; // number of conflicts found, per thread
-	UINT32              m_resolved[WORK_MAX_THREADS];   // number of conflicts resolved, per thread
-#endif
+	UINT32              m_units;                    // number of units queued
+	std::atomic<UINT32> m_conflicts;                // number of conflicts found
+	std::atomic<UINT32> m_resolved;                 // number of conflicts resolved
+	std::atomic<UINT32> m_steals;                   // number of units stolen
+	std::atomic<UINT32> m_thread_units[WORK_MAX_THREADS]; // number of units executed, per thread
 };
 
 
@@ -295,21 +372,24 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(runnin
 		m_object(machine, *this),
 		m_unit(machine, *this),
 		m_flags(flags),
-		m_triangles(0),
-		m_quads(0),
-		m_pixels(0)
+		m_workers(1),
+		m_pending(0),
+		m_active(0)
 {
-#if KEEP_POLY_STATISTICS
-	memset(m_conflicts, 0, sizeof(m_conflicts));
-	memset(m_resolved, 0, sizeof(m_resolved));
-#endif
+	reset_statistics();
 
-	// create the work queue
+	// create the work queue, plus a deque per worker it can run
 	if (!(flags & POLYFLAG_NO_WORK_QUEUE))
+	{
 		m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+		m_workers = MAX(1, MIN(int(std::thread::hardware_concurrency()), WORK_MAX_THREADS));
+		m_deque = std::make_unique<work_deque[]>(m_workers);
+	}
 
-	// request a pre-save callback for synchronization
+	// request a pre-save callback for synchronization, and finish our work at
+	// exit while whatever owns us is still intact
 	machine.save().register_presave(save_prepost_delegate(FUNC(poly_manager::presave), this));
+	machine.add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(poly_manager::machine_exit), this));
 }
 
 
@@ -322,21 +402,24 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(screen
 		m_object(screen.machine(), *this),
 		m_unit(screen.machine(), *this),
 		m_flags(flags),
-		m_triangles(0),
-		m_quads(0),
-		m_pixels(0)
+		m_workers(1),
+		m_pending(0),
+		m_active(0)
 {
-#if KEEP_POLY_STATISTICS
-	memset(m_conflicts, 0, sizeof(m_conflicts));
-	memset(m_resolved, 0, sizeof(m_resolved));
-#endif
+	reset_statistics();
 
-	// create the work queue
+	// create the work queue, plus a deque per worker it can run
 	if (!(flags & POLYFLAG_NO_WORK_QUEUE))
+	{
 		m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI | WORK_QUEUE_FLAG_HIGH_FREQ);
+		m_workers = MAX(1, MIN(int(std::thread::hardware_concurrency()), WORK_MAX_THREADS));
+		m_deque = std::make_unique<work_deque[]>(m_workers);
+	}
 
-	// request a pre-save callback for synchronization
+	// request a pre-save callback for synchronization, and finish our work at
+	// exit while whatever owns us is still intact
 	machine().save().register_presave(save_prepost_delegate(FUNC(poly_manager::presave), this));
+	machine().add_notifier(MACHINE_NOTIFY_EXIT, machine_notify_delegate(FUNC(poly_manager::machine_exit), this));
 }
 
 
@@ -347,30 +430,28 @@ poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::poly_manager(screen
 template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::~poly_manager()
 {
-#if KEEP_POLY_STATISTICS
-{
-	// accumulate stats over the entire collection
-	int conflicts = 0, resolved = 0;
-	for (int i = 0; i < ARRAY_LENGTH(m_conflicts); i++)
+	// everything was drained at exit; by now a derived class or owning device
+	// may be partly destroyed, so drop anything queued since rather than run
+	// it, and only let units already running finish
+	if (m_queue != nullptr)
 	{
-		conflicts += m_conflicts[i];
-		resolved += m_resolved[i];
+		for (int dequenum = 0; dequenum < m_workers; dequenum++)
+		{
+			std::lock_guard<std::mutex> lock(m_deque[dequenum].m_lock);
+			m_deque[dequenum].m_units.clear();
+		}
+		osd_work_queue_wait(m_queue, osd_ticks_per_second() * 100);
 	}
 
-	// output global stats
-	printf("Total triangles = %d\n", m_triangles);
-	printf("Total quads = %d\n", m_quads);
-	if (m_pixels > 1000000000)
-		printf("Total pixels   = %d%09d\n", (UINT32)(m_pixels / 1000000000), (UINT32)(m_pixels % 1000000000));
-	else
-		printf("Total pixels   = %d\n", (UINT32)m_pixels);
-
-	printf("Conflicts:   %d resolved, %d total\n", resolved, conflicts);
-	printf("Units:       %5d used, %5d allocated, %5d waits, %4d bytes each, %7d total\n", m_unit.max(), m_unit.allocated(), m_unit.waits(), m_unit.itemsize(), m_unit.allocated() * m_unit.itemsize());
-	printf("Polygons:    %5d used, %5d allocated, %5d waits, %4d bytes each, %7d total\n", m_polygon.max(), m_polygon.allocated(), m_polygon.waits(), m_polygon.itemsize(), m_polygon.allocated() * m_polygon.itemsize());
-	printf("Object data: %5d used, %5d allocated, %5d waits, %4d bytes each, %7d total\n", m_object.max(), m_object.allocated(), m_object.waits(), m_object.itemsize(), m_object.allocated() * m_object.itemsize());
-}
-#endif
+	// report what we did
+	poly_statistics stats = statistics();
+	if (stats.units != 0)
+	{
+		osd_printf_verbose("Poly: %d tiles, %d triangles, %d quads, %d units, %.0f pixels\n", stats.tiles, stats.triangles, stats.quads, stats.units, (double)stats.pixels);
+		osd_printf_verbose("Poly: %d conflicts (%d resolved), %d steals, imbalance %.2f across %d workers\n", stats.conflicts, stats.resolved, stats.steals, (double)stats.imbalance(), m_workers);
+		osd_printf_verbose("Poly: units %d/%d used, %d waits; polygons %d/%d used, %d waits; object data %d/%d used, %d waits\n",
+				m_unit.max(), m_unit.allocated(), stats.unit_waits, m_polygon.max(), m_polygon.allocated(), stats.polygon_waits, m_object.max(), m_object.allocated(), stats.object_waits);
+	}
 
 	// free the work queue
 	if (m_queue != nullptr)
@@ -408,12 +489,11 @@ void *poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::work_item_cal
 					new_count_next = orig_count_next | (unitnum << 16);
 				} while (!prevunit.count_next.compare_exchange_weak(orig_count_next, new_count_next, std::memory_order_release, std::memory_order_relaxed));
 
-#if KEEP_POLY_STATISTICS
 				// track resolved conflicts
-				polygon.m_owner->m_conflicts[threadid]++;
+				polygon.m_owner->m_conflicts.fetch_add(1, std::memory_order_relaxed);
 				if (orig_count_next != 0)
-					polygon.m_owner->m_resolved[threadid]++;
-#endif
+					polygon.m_owner->m_resolved.fetch_add(1, std::memory_order_relaxed);
+
 				// if we succeeded, skip out early so we can do other work
 				if (orig_count_next != 0)
 					break;
@@ -421,6 +501,7 @@ void *poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::work_item_cal
 		}
 
 		// iterate over extents
+		polygon.m_owner->m_thread_units[threadid % WORK_MAX_THREADS].fetch_add(1, std::memory_order_relaxed);
 		for (int curscan = 0; curscan < count; curscan++)
 			polygon.m_callback(unit.scanline + curscan, unit.extent[curscan], *polygon.m_object, threadid);
 
@@ -453,9 +534,15 @@ void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::wait(const cha
 	if (LOG_WAITS)
 		time = get_profile_ticks();
 
-	// wait for all pending work items to complete
+	// wait for all pending work items to complete, then run anything the
+	// workers left behind ourselves
 	if (m_queue != nullptr)
+	{
 		osd_work_queue_wait(m_queue, osd_ticks_per_second() * 100);
+		UINT32 unitnum;
+		while (worker_pop(0, unitnum))
+			work_item_callback(&m_unit[unitnum], 0);
+	}
 
 	// if we don't have a queue, just run the whole list now
 	else
@@ -473,7 +560,7 @@ void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::wait(const cha
 	// reset the state
 	m_polygon.reset();
 	m_unit.reset();
-	memset(m_unit_bucket, 0xff, sizeof(m_unit_bucket));
+	std::fill(m_unit_bucket.begin(), m_unit_bucket.end(), 0xffff);
 
 	// we need to preserve the last object data that was supplied
 	if (m_object.count() > 0)
@@ -487,6 +574,176 @@ void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::wait(const cha
 }
 
 
+//-------------------------------------------------
+//  statistics - return a snapshot of the work
+//  done since the statistics were last reset
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+poly_statistics poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::statistics() const
+{
+	poly_statistics stats;
+	stats.tiles = m_tiles;
+	stats.triangles = m_triangles;
+	stats.quads = m_quads;
+	stats.pixels = m_pixels;
+	stats.units = m_units;
+	stats.unit_waits = m_unit.waits();
+	stats.polygon_waits = m_polygon.waits();
+	stats.object_waits = m_object.waits();
+	stats.conflicts = m_conflicts.load(std::memory_order_relaxed);
+	stats.resolved = m_resolved.load(std::memory_order_relaxed);
+	stats.steals = m_steals.load(std::memory_order_relaxed);
+	for (int threadnum = 0; threadnum < WORK_MAX_THREADS; threadnum++)
+		stats.thread_units[threadnum] = m_thread_units[threadnum].load(std::memory_order_relaxed);
+	return stats;
+}
+
+
+//-------------------------------------------------
+//  reset_statistics - zero all the counters
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::reset_statistics()
+{
+	m_tiles = m_triangles = m_quads = m_units = 0;
+	m_pixels = 0;
+	m_unit.reset_waits();
+	m_polygon.reset_waits();
+	m_object.reset_waits();
+	m_conflicts = 0;
+	m_resolved = 0;
+	m_steals = 0;
+	for (auto &count : m_thread_units)
+		count = 0;
+}
+
+
+//-------------------------------------------------
+//  link_unit - chain a unit behind the last one
+//  queued to the same bucket row, so that units
+//  touching the same scanlines run in order
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::link_unit(UINT32 unitnum)
+{
+	work_unit &unit = m_unit[unitnum];
+
+	// rows past the limit (or above 0) wrap around, which only serializes them further
+	UINT32 row = (UINT32(unit.scanline) / SCANLINES_PER_BUCKET) % MAX_BUCKET_ROWS;
+	if (row >= m_unit_bucket.size())
+		m_unit_bucket.resize(row + 1, 0xffff);
+
+	unit.previtem = m_unit_bucket[row];
+	m_unit_bucket[row] = unitnum;
+	m_units++;
+}
+
+
+//-------------------------------------------------
+//  queue_units - hand the units of one polygon to
+//  a worker deque in a single batch
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::queue_units(UINT32 startunit)
+{
+	UINT32 endunit = m_unit.count();
+	if (m_queue == nullptr || startunit >= endunit)
+		return;
+
+	// the deque is chosen by the first bucket row, so that small polygons in
+	// the same area tend to stay on one thread; idle workers steal the rest
+	UINT32 row = (UINT32(m_unit[startunit].scanline) / SCANLINES_PER_BUCKET) % MAX_BUCKET_ROWS;
+	work_deque &deque = m_deque[row % m_workers];
+	{
+		std::lock_guard<std::mutex> lock(deque.m_lock);
+		for (UINT32 unitnum = startunit; unitnum < endunit; unitnum++)
+			deque.m_units.push_back(unitnum);
+	}
+	m_pending += endunit - startunit;
+
+	// start more workers, up to one per unit, if we're not running the maximum already
+	int wanted = MIN(m_workers, int(endunit - startunit));
+	int active = m_active.load();
+	while (active < m_workers && wanted > 0)
+		if (m_active.compare_exchange_weak(active, active + 1))
+		{
+			osd_work_item_queue(m_queue, worker_callback, this, WORK_ITEM_FLAG_AUTO_RELEASE);
+			active++;
+			wanted--;
+		}
+}
+
+
+//-------------------------------------------------
+//  worker_pop - take the next unit from our own
+//  deque, or steal one from another worker's
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+bool poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::worker_pop(int home, UINT32 &unitnum)
+{
+	for (int dequenum = 0; dequenum < m_workers; dequenum++)
+	{
+		work_deque &deque = m_deque[(home + dequenum) % m_workers];
+		std::lock_guard<std::mutex> lock(deque.m_lock);
+		if (deque.m_units.empty())
+			continue;
+
+		// our own deque runs oldest first; steals take the newest
+		if (dequenum == 0)
+		{
+			unitnum = deque.m_units.front();
+			deque.m_units.pop_front();
+		}
+		else
+		{
+			unitnum = deque.m_units.back();
+			deque.m_units.pop_back();
+			m_steals.fetch_add(1, std::memory_order_relaxed);
+		}
+		m_pending--;
+		return true;
+	}
+	return false;
+}
+
+
+//-------------------------------------------------
+//  worker_callback - run units until every deque
+//  is empty
+//-------------------------------------------------
+
+template<typename _BaseType, class _ObjectData, int _MaxParams, int _MaxPolys>
+void *poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::worker_callback(void *param, int threadid)
+{
+	poly_manager &owner = *reinterpret_cast<poly_manager *>(param);
+	int home = threadid % owner.m_workers;
+
+	while (1)
+	{
+		UINT32 unitnum;
+		while (owner.worker_pop(home, unitnum))
+			work_item_callback(&owner.m_unit[unitnum], threadid);
+
+		// retire, unless more work arrived after we looked and nobody else can take it
+		owner.m_active--;
+		if (owner.m_pending.load() <= 0)
+			break;
+		int active = owner.m_active.load();
+		do
+		{
+			if (active >= owner.m_workers)
+				return nullptr;
+		} while (!owner.m_active.compare_exchange_weak(active, active + 1));
+	}
+	return nullptr;
+}
+
+
 //-------------------------------------------------
 //  object_data_alloc - allocate a new _ObjectData
 //-------------------------------------------------
@@ -579,23 +836,20 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tile(
 
 	// compute the X extents for each scanline
 	INT32 pixels = 0;
-	UINT32 startunit = m_unit.count();
 	INT32 scaninc = 1;
+	UINT32 startunit = m_unit.count();
 	for (INT32 curscan = v1yclip; curscan < v2yclip; curscan += scaninc)
 	{
-		UINT32 bucketnum = ((UINT32)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
 		UINT32 unit_index = m_unit.count();
 		work_unit &unit = m_unit.next();
 
 		// determine how much to advance to hit the next bucket
-		scaninc = SCANLINES_PER_BUCKET - (UINT32)curscan % SCANLINES_PER_BUCKET;
+		scaninc = SCANLINES_PER_BUCKET - bucket_offset(curscan);
 
 		// fill in the work unit basics
 		unit.polygon = &polygon;
 		unit.count_next = MIN(v2yclip - curscan, scaninc);
 		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -618,11 +872,13 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_tile(
 				extent.param[paramnum].dpdx = param_dpdx[paramnum];
 			}
 		}
+
+		// chain the unit into its bucket
+		link_unit(unit_index);
 	}
 
-	// enqueue the work items
-	if (m_queue != nullptr)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	// hand all of the polygon's units to the workers at once
+	queue_units(startunit);
 
 	// return the total number of pixels in the triangle
 	m_tiles++;
@@ -737,23 +993,20 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_trian
 
 	// compute the X extents for each scanline
 	INT32 pixels = 0;
-	UINT32 startunit = m_unit.count();
 	INT32 scaninc = 1;
+	UINT32 startunit = m_unit.count();
 	for (INT32 curscan = v1yclip; curscan < v3yclip; curscan += scaninc)
 	{
-		UINT32 bucketnum = ((UINT32)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
 		UINT32 unit_index = m_unit.count();
 		work_unit &unit = m_unit.next();
 
 		// determine how much to advance to hit the next bucket
-		scaninc = SCANLINES_PER_BUCKET - (UINT32)curscan % SCANLINES_PER_BUCKET;
+		scaninc = SCANLINES_PER_BUCKET - bucket_offset(curscan);
 
 		// fill in the work unit basics
 		unit.polygon = &polygon;
 		unit.count_next = MIN(v3yclip - curscan, scaninc);
 		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -806,11 +1059,13 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_trian
 				extent.param[paramnum].dpdx = param_dpdx[paramnum];
 			}
 		}
+
+		// chain the unit into its bucket
+		link_unit(unit_index);
 	}
 
-	// enqueue the work items
-	if (m_queue != nullptr)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	// hand all of the polygon's units to the workers at once
+	queue_units(startunit);
 
 	// return the total number of pixels in the triangle
 	m_triangles++;
@@ -870,23 +1125,20 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_trian
 
 	// compute the X extents for each scanline
 	INT32 pixels = 0;
-	UINT32 startunit = m_unit.count();
 	INT32 scaninc = 1;
+	UINT32 startunit = m_unit.count();
 	for (INT32 curscan = v1yclip; curscan < v3yclip; curscan += scaninc)
 	{
-		UINT32 bucketnum = ((UINT32)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
 		UINT32 unit_index = m_unit.count();
 		work_unit &unit = m_unit.next();
 
 		// determine how much to advance to hit the next bucket
-		scaninc = SCANLINES_PER_BUCKET - (UINT32)curscan % SCANLINES_PER_BUCKET;
+		scaninc = SCANLINES_PER_BUCKET - bucket_offset(curscan);
 
 		// fill in the work unit basics
 		unit.polygon = &polygon;
 		unit.count_next = MIN(v3yclip - curscan, scaninc);
 		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -922,11 +1174,13 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_trian
 			else if(istopx < istartx)
 				pixels += istartx - istopx;
 		}
+
+		// chain the unit into its bucket
+		link_unit(unit_index);
 	}
 
-	// enqueue the work items
-	if (m_queue != nullptr)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	// hand all of the polygon's units to the workers at once
+	queue_units(startunit);
 
 	// return the total number of pixels in the object
 	m_triangles++;
@@ -1045,23 +1299,20 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_polyg
 
 	// compute the X extents for each scanline
 	INT32 pixels = 0;
-	UINT32 startunit = m_unit.count();
 	INT32 scaninc = 1;
+	UINT32 startunit = m_unit.count();
 	for (INT32 curscan = minyclip; curscan < maxyclip; curscan += scaninc)
 	{
-		UINT32 bucketnum = ((UINT32)curscan / SCANLINES_PER_BUCKET) % TOTAL_BUCKETS;
 		UINT32 unit_index = m_unit.count();
 		work_unit &unit = m_unit.next();
 
 		// determine how much to advance to hit the next bucket
-		scaninc = SCANLINES_PER_BUCKET - (UINT32)curscan % SCANLINES_PER_BUCKET;
+		scaninc = SCANLINES_PER_BUCKET - bucket_offset(curscan);
 
 		// fill in the work unit basics
 		unit.polygon = &polygon;
 		unit.count_next = MIN(maxyclip - curscan, scaninc);
 		unit.scanline = curscan;
-		unit.previtem = m_unit_bucket[bucketnum];
-		m_unit_bucket[bucketnum] = unit_index;
 
 		// iterate over extents
 		for (int extnum = 0; extnum < unit.count_next; extnum++)
@@ -1121,11 +1372,13 @@ UINT32 poly_manager<_BaseType, _ObjectData, _MaxParams, _MaxPolys>::render_polyg
 			extent.userdata = nullptr;
 			pixels += istopx - istartx;
 		}
+
+		// chain the unit into its bucket
+		link_unit(unit_index);
 	}
 
-	// enqueue the work items
-	if (m_queue != nullptr)
-		osd_work_item_queue_multiple(m_queue, work_item_callback, m_unit.count() - startunit, &m_unit[startunit], m_unit.itemsize(), WORK_ITEM_FLAG_AUTO_RELEASE);
+	// hand all of the polygon's units to the workers at once
+	queue_units(startunit);
 
 	// return the total number of pixels in the triangle
 	m_quads++;
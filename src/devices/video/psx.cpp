@@ -14,6 +14,9 @@
 
 #define VERBOSE_LEVEL ( 0 )
 
+// set to 0 to process GP0 commands synchronously on the emulation thread
+#define THREADED_RENDER ( 1 )
+
 // device type definition
 const device_type CXD8514Q = &device_creator<cxd8514q_device>;
 const device_type CXD8538Q = &device_creator<cxd8538q_device>;
@@ -24,7 +27,9 @@ const device_type CXD8654Q = &device_creator<cxd8654q_device>;
 
 psxgpu_device::psxgpu_device(const machine_config &mconfig, device_type type, const char *name, const char *tag, device_t *owner, UINT32 clock, const char *shortname, const char *source) :
 	device_t(mconfig, type, name, tag, owner, clock, shortname, source),
-	m_vblank_handler(*this)
+	m_vblank_handler(*this),
+	m_render_queue(nullptr),
+	m_render_busy(false)
 #if DEBUG_VIEWER
 ,
 	m_screen(*this, "screen")
@@ -36,6 +41,13 @@ void psxgpu_device::device_start( void )
 {
 	m_vblank_handler.resolve_safe();
 
+	if( THREADED_RENDER )
+	{
+		m_render_queue = osd_work_queue_alloc( 0 );
+	}
+	machine().save().register_presave( save_prepost_delegate( FUNC( psxgpu_device::render_sync ), this ) );
+	machine().save().register_preload( save_prepost_delegate( FUNC( psxgpu_device::render_sync ), this ) );
+
 	if( m_type == CXD8538Q )
 	{
 		psx_gpu_init( 1 );
@@ -48,9 +60,20 @@ void psxgpu_device::device_start( void )
 
 void psxgpu_device::device_reset( void )
 {
+	render_sync();
 	gpu_reset();
 }
 
+void psxgpu_device::device_stop( void )
+{
+	render_sync();
+	if( m_render_queue != nullptr )
+	{
+		osd_work_queue_free( m_render_queue );
+		m_render_queue = nullptr;
+	}
+}
+
 cxd8514q_device::cxd8514q_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock)
 	: psxgpu_device(mconfig, CXD8514Q, "CXD8514Q GPU", tag, owner, clock, "cxd8514q", __FILE__)
 {
@@ -630,6 +653,8 @@ UINT32 psxgpu_device::update_screen(screen_device &screen, bitmap_ind16 &bitmap,
 	}
 #endif
 
+	render_sync();
+
 	if( ( n_gpustatus & ( 1 << 0x17 ) ) != 0 )
 	{
 		/* todo: only draw to necessary area */
@@ -3037,7 +3062,55 @@ void psxgpu_device::MoveImage( void )
 
 void psxgpu_device::dma_write( UINT32 *p_n_psxram, UINT32 n_address, INT32 n_size )
 {
-	gpu_write( &p_n_psxram[ n_address / 4 ], n_size );
+	queue_write( &p_n_psxram[ n_address / 4 ], n_size );
+}
+
+void psxgpu_device::queue_write( const UINT32 *p_ram, INT32 n_size )
+{
+	if( m_render_queue == nullptr )
+	{
+		gpu_write( const_cast<UINT32 *>( p_ram ), n_size );
+		return;
+	}
+
+	// copy the words now, so the CPU is free to reuse its buffer
+	std::lock_guard<std::mutex> lock( m_render_lock );
+	m_render_fifo.insert( m_render_fifo.end(), p_ram, p_ram + n_size );
+	if( !m_render_busy )
+	{
+		m_render_busy = true;
+		osd_work_item_queue( m_render_queue, render_callback, this, WORK_ITEM_FLAG_AUTO_RELEASE );
+	}
+}
+
+void *psxgpu_device::render_callback( void *param, int threadid )
+{
+	psxgpu_device &gpu = *reinterpret_cast<psxgpu_device *>( param );
+	std::vector<UINT32> words;
+
+	for( ;; )
+	{
+		{
+			std::lock_guard<std::mutex> lock( gpu.m_render_lock );
+			words.clear();
+			words.swap( gpu.m_render_fifo );
+			if( words.empty() )
+			{
+				gpu.m_render_busy = false;
+				break;
+			}
+		}
+		gpu.gpu_write( words.data(), words.size() );
+	}
+	return nullptr;
+}
+
+void psxgpu_device::render_sync()
+{
+	if( m_render_queue != nullptr )
+	{
+		osd_work_queue_wait( m_render_queue, osd_ticks_per_second() * 100 );
+	}
 }
 
 void psxgpu_device::gpu_write( UINT32 *p_ram, INT32 n_size )
@@ -3530,9 +3603,10 @@ WRITE32_MEMBER( psxgpu_device::write )
 	switch( offset )
 	{
 	case 0x00:
-		gpu_write( &data, 1 );
+		queue_write( &data, 1 );
 		break;
 	case 0x01:
+		render_sync();
 		switch( data >> 24 )
 		{
 		case 0x00:
@@ -3670,6 +3744,7 @@ WRITE32_MEMBER( psxgpu_device::write )
 
 void psxgpu_device::dma_read( UINT32 *p_n_psxram, UINT32 n_address, INT32 n_size )
 {
+	render_sync();
 	gpu_read( &p_n_psxram[ n_address / 4 ], n_size );
 }
 
@@ -3725,6 +3800,7 @@ READ32_MEMBER( psxgpu_device::read )
 {
 	UINT32 data;
 
+	render_sync();
 	switch( offset )
 	{
 	case 0x00:
@@ -3750,6 +3826,7 @@ void psxgpu_device::vblank(screen_device &screen, bool vblank_state)
 		DebugCheckKeys();
 #endif
 
+		render_sync();
 		n_gpustatus ^= ( 1L << 31 );
 		m_vblank_handler(1);
 	}
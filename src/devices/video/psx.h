@@ -13,6 +13,7 @@
 #define __PSXGPU_H__
 
 #include "emu.h"
+#include <mutex>
 
 #define MCFG_PSX_GPU_VBLANK_HANDLER(_devcb) \
 	devcb = &psxgpu_device::set_vblank_handler(*device, DEVCB_##_devcb);
@@ -208,6 +209,7 @@ public:
 protected:
 	virtual void device_start() override;
 	virtual void device_reset() override;
+	virtual void device_stop() override;
 
 private:
 	void updatevisiblearea();
@@ -231,6 +233,9 @@ private:
 	void gpu_reset();
 	void gpu_read( UINT32 *p_ram, INT32 n_size );
 	void gpu_write( UINT32 *p_ram, INT32 n_size );
+	void queue_write( const UINT32 *p_ram, INT32 n_size );
+	void render_sync();
+	static void *render_callback( void *param, int threadid );
 
 	INT32 m_n_tx;
 	INT32 m_n_ty;
@@ -303,6 +308,13 @@ private:
 
 	devcb_write_line m_vblank_handler;
 
+	// GP0 words are handed to a render thread, which runs them through gpu_write
+	// in order; anything that observes GPU state or VRAM waits for it first
+	osd_work_queue *m_render_queue;
+	std::mutex m_render_lock;
+	std::vector<UINT32> m_render_fifo;    // words not yet taken by the render thread
+	bool m_render_busy;                   // render item queued or running, guarded by m_render_lock
+
 #if defined(DEBUG_VIEWER) && DEBUG_VIEWER
 	required_device<screen_device> m_screen;
 	void DebugMeshInit( void );
@@ -2658,14 +2658,14 @@ static inline bool ATTR_FORCE_INLINE combineColor(voodoo_device *vd, stats_block
 
 #define RASTERIZER(name, TMUS, FBZCOLORPATH, FBZMODE, ALPHAMODE, FOGMODE, TEXMODE0, TEXMODE1) \
 																				\
-void voodoo_device::raster_##name(void *destbase, INT32 y, const poly_extent *extent, const void *extradata, int threadid) \
+void voodoo_device::raster_##name(void *destbase, INT32 y, const voodoo_poly_manager::extent_t &extent, const poly_extra_data &extradata, int threadid) \
 {                                                                               \
-	const poly_extra_data *extra = (const poly_extra_data *)extradata;          \
+	const poly_extra_data *extra = &extradata;                                  \
 	voodoo_device *vd = extra->device; \
 	stats_block *stats = &vd->thread_stats[threadid];                            \
 	DECLARE_DITHER_POINTERS;                                                    \
-	INT32 startx = extent->startx;                                              \
-	INT32 stopx = extent->stopx;                                                \
+	INT32 startx = extent.startx;                                               \
+	INT32 stopx = extent.stopx;                                                 \
 	rgbaint_t iterargb, iterargbDelta;                                           \
 	INT32 iterz;                                                                \
 	INT64 iterw, iterw0 = 0, iterw1 = 0;                                        \
@@ -162,7 +162,6 @@ bits(7:4) and bit(24)), X, and Y:
 #define LOG_FIFO            (0)
 #define LOG_FIFO_VERBOSE    (0)
 #define LOG_REGISTERS       (0)
-#define LOG_WAITS           (0)
 #define LOG_LFB             (0)
 #define LOG_TEXTURE_RAM     (0)
 #define LOG_RASTERIZERS     (0)
@@ -172,6 +171,10 @@ bits(7:4) and bit(24)), X, and Y:
 
 #define MODIFY_PIXEL(VV)
 
+// Set to 0 to send unlisted register combinations to the fully generic
+// rasterizers instead of the feature-specialized ones, for comparison.
+#define USE_FEATURE_RASTERIZERS (1)
+
 // Need to turn off cycle eating when debugging MIPS drc
 // otherwise timer interrupts won't match nodrc debug mode.
 #define EAT_CYCLES          (1)
@@ -2407,21 +2410,21 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 
 		/* mask off invalid bits for different cards */
 		case fbzColorPath:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			if (vd->vd_type < TYPE_VOODOO_2)
 				data &= 0x0fffffff;
 			if (chips & 1) vd->reg[fbzColorPath].u = data;
 			break;
 
 		case fbzMode:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			if (vd->vd_type < TYPE_VOODOO_2)
 				data &= 0x001fffff;
 			if (chips & 1) vd->reg[fbzMode].u = data;
 			break;
 
 		case fogMode:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			if (vd->vd_type < TYPE_VOODOO_2)
 				data &= 0x0000003f;
 			if (chips & 1) vd->reg[fogMode].u = data;
@@ -2450,7 +2453,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 
 		/* other commands */
 		case nopCMD:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			if (data & 1)
 				reset_counters(vd);
 			if (data & 2)
@@ -2462,12 +2465,12 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 			break;
 
 		case swapbufferCMD:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			cycles = swapbuffer(vd, data);
 			break;
 
 		case userIntrCMD:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			//fatalerror("userIntrCMD\n");
 
 			vd->reg[intrCtrl].u |= 0x1800;
@@ -2482,7 +2485,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 		case clutData:
 			if (vd->vd_type <= TYPE_VOODOO_2 && (chips & 1))
 			{
-				poly_wait(vd->poly, vd->regnames[regnum]);
+				vd->poly->wait(vd->regnames[regnum]);
 				if (!FBIINIT1_VIDEO_TIMING_RESET(vd->reg[fbiInit1].u))
 				{
 					int index = data >> 24;
@@ -2501,7 +2504,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 		case dacData:
 			if (vd->vd_type <= TYPE_VOODOO_2 && (chips & 1))
 			{
-				poly_wait(vd->poly, vd->regnames[regnum]);
+				vd->poly->wait(vd->regnames[regnum]);
 				if (!(data & 0x800))
 					dacdata_w(&vd->dac, (data >> 8) & 7, data & 0xff);
 				else
@@ -2516,7 +2519,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 		case videoDimensions:
 			if (vd->vd_type <= TYPE_VOODOO_2 && (chips & 1))
 			{
-				poly_wait(vd->poly, vd->regnames[regnum]);
+				vd->poly->wait(vd->regnames[regnum]);
 				vd->reg[regnum].u = data;
 				if (vd->reg[hSync].u != 0 && vd->reg[vSync].u != 0 && vd->reg[videoDimensions].u != 0)
 				{
@@ -2605,7 +2608,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 
 		/* fbiInit0 can only be written if initEnable says we can -- Voodoo/Voodoo2 only */
 		case fbiInit0:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			if (vd->vd_type <= TYPE_VOODOO_2 && (chips & 1) && INITEN_ENABLE_HW_INIT(vd->pci.init_enable))
 			{
 				vd->reg[fbiInit0].u = data;
@@ -2629,7 +2632,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 		case fbiInit1:
 		case fbiInit2:
 		case fbiInit4:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			if (vd->vd_type <= TYPE_VOODOO_2 && (chips & 1) && INITEN_ENABLE_HW_INIT(vd->pci.init_enable))
 			{
 				vd->reg[regnum].u = data;
@@ -2639,7 +2642,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 			break;
 
 		case fbiInit3:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			if (vd->vd_type <= TYPE_VOODOO_2 && (chips & 1) && INITEN_ENABLE_HW_INIT(vd->pci.init_enable))
 			{
 				vd->reg[regnum].u = data;
@@ -2653,7 +2656,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 /*      case swapPending: -- Banshee */
 			if (vd->vd_type == TYPE_VOODOO_2 && (chips & 1) && INITEN_ENABLE_HW_INIT(vd->pci.init_enable))
 			{
-				poly_wait(vd->poly, vd->regnames[regnum]);
+				vd->poly->wait(vd->regnames[regnum]);
 				vd->reg[regnum].u = data;
 				vd->fbi.cmdfifo[0].enable = FBIINIT7_CMDFIFO_ENABLE(data);
 				vd->fbi.cmdfifo[0].count_holes = !FBIINIT7_DISABLE_CMDFIFO_HOLES(data);
@@ -2666,7 +2669,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 		case cmdFifoBaseAddr:
 			if (vd->vd_type == TYPE_VOODOO_2 && (chips & 1))
 			{
-				poly_wait(vd->poly, vd->regnames[regnum]);
+				vd->poly->wait(vd->regnames[regnum]);
 				vd->reg[regnum].u = data;
 				vd->fbi.cmdfifo[0].base = (data & 0x3ff) << 12;
 				vd->fbi.cmdfifo[0].end = (((data >> 16) & 0x3ff) + 1) << 12;
@@ -2742,7 +2745,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 		case nccTable+9:
 		case nccTable+10:
 		case nccTable+11:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			if (chips & 2) ncc_table_write(&vd->tmu[0].ncc[0], regnum - nccTable, data);
 			if (chips & 4) ncc_table_write(&vd->tmu[1].ncc[0], regnum - nccTable, data);
 			break;
@@ -2759,7 +2762,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 		case nccTable+21:
 		case nccTable+22:
 		case nccTable+23:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			if (chips & 2) ncc_table_write(&vd->tmu[0].ncc[1], regnum - (nccTable+12), data);
 			if (chips & 4) ncc_table_write(&vd->tmu[1].ncc[1], regnum - (nccTable+12), data);
 			break;
@@ -2797,7 +2800,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 		case fogTable+29:
 		case fogTable+30:
 		case fogTable+31:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			if (chips & 1)
 			{
 				int base = 2 * (regnum - fogTable);
@@ -2816,7 +2819,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 		case texBaseAddr_1:
 		case texBaseAddr_2:
 		case texBaseAddr_3_8:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			if (chips & 2)
 			{
 				vd->tmu[0].reg[regnum].u = data;
@@ -2845,7 +2848,7 @@ INT32 voodoo_device::register_w(voodoo_device *vd, offs_t offset, UINT32 data)
 		case color0:
 		case clipLowYHighY:
 		case clipLeftRight:
-			poly_wait(vd->poly, vd->regnames[regnum]);
+			vd->poly->wait(vd->regnames[regnum]);
 			/* fall through to default implementation */
 
 		/* by default, just feed the data to the chips */
@@ -3173,7 +3176,7 @@ INT32 voodoo_device::lfb_w(voodoo_device* vd, offs_t offset, UINT32 data, UINT32
 		COMPUTE_DITHER_POINTERS_NO_DITHER_VAR(vd->reg[fbzMode].u, y);
 
 		/* wait for any outstanding work to finish */
-		poly_wait(vd->poly, "LFB Write");
+		vd->poly->wait("LFB Write");
 
 		/* loop over up to two pixels */
 		for (pix = 0; mask; pix++)
@@ -3328,7 +3331,7 @@ INT32 voodoo_device::lfb_w(voodoo_device* vd, offs_t offset, UINT32 data, UINT32
 
 
 				/* wait for any outstanding work to finish */
-				poly_wait(vd->poly, "LFB Write");
+				vd->poly->wait("LFB Write");
 
 				/* pixel pipeline part 2 handles color blending, fog, alpha, and final output */
 				PIXEL_PIPELINE_END(vd, stats, dither, dither4, dither_lookup, x, dest, depth,
@@ -3369,7 +3372,7 @@ INT32 voodoo_device::texture_w(voodoo_device *vd, offs_t offset, UINT32 data)
 		fatalerror("Texture direct write!\n");
 
 	/* wait for any outstanding work to finish */
-	poly_wait(vd->poly, "Texture write");
+	vd->poly->wait("Texture write");
 
 	/* update texture info if dirty */
 	if (t->regdirty)
@@ -4026,7 +4029,7 @@ static UINT32 lfb_r(voodoo_device *vd, offs_t offset, bool lfb_3d)
 	}
 
 	/* wait for any outstanding work to finish */
-	poly_wait(vd->poly, "LFB read");
+	vd->poly->wait("LFB read");
 
 	/* compute the data */
 	data = buffer[bufoffs + 0] | (buffer[bufoffs + 1] << 16);
@@ -4944,7 +4947,7 @@ void voodoo_device::common_start_voodoo(UINT8 type)
 	device->m_stall.resolve();
 
 	/* create a multiprocessor work queue */
-	poly = poly_alloc(machine(), 64, sizeof(poly_extra_data), 0);
+	poly = std::make_unique<voodoo_poly_manager>(machine());
 	thread_stats = auto_alloc_array(machine(), stats_block, WORK_MAX_THREADS);
 
 	/* create a table of precomputed 1/n and log2(n) values */
@@ -5124,7 +5127,7 @@ INT32 voodoo_device::fastfill(voodoo_device *vd)
 	int ex = (vd->reg[clipLeftRight].u >> 0) & 0x3ff;
 	int sy = (vd->reg[clipLowYHighY].u >> 16) & 0x3ff;
 	int ey = (vd->reg[clipLowYHighY].u >> 0) & 0x3ff;
-	poly_extent extents[64];
+	voodoo_poly_manager::extent_t extents[64];
 	UINT16 dithermatrix[16];
 	UINT16 *drawbuf = nullptr;
 	UINT32 pixels = 0;
@@ -5170,22 +5173,25 @@ INT32 voodoo_device::fastfill(voodoo_device *vd)
 		}
 	}
 
-	/* fill in a block of extents */
-	extents[0].startx = sx;
-	extents[0].stopx = ex;
+	/* fill in a block of extents; the poly manager draws custom extents as given, so order them here */
+	extents[0].startx = MIN(sx, ex);
+	extents[0].stopx = MAX(sx, ex);
+	extents[0].param[0].start = extents[0].param[0].dpdx = 0.0f;
+	extents[0].userdata = nullptr;
 	for (extnum = 1; extnum < ARRAY_LENGTH(extents); extnum++)
 		extents[extnum] = extents[0];
 
 	/* iterate over blocks of extents */
 	for (y = sy; y < ey; y += ARRAY_LENGTH(extents))
 	{
-		poly_extra_data *extra = (poly_extra_data *)poly_get_extra_data(vd->poly);
+		poly_extra_data &extra = vd->poly->object_data_alloc();
 		int count = MIN(ey - y, ARRAY_LENGTH(extents));
 
-		extra->device= vd;
-		memcpy(extra->dither, dithermatrix, sizeof(extra->dither));
+		extra.device = vd;
+		extra.destbase = drawbuf;
+		memcpy(extra.dither, dithermatrix, sizeof(extra.dither));
 
-		pixels += poly_render_triangle_custom(vd->poly, drawbuf, global_cliprect, raster_fastfill, y, count, extents);
+		pixels += vd->poly->render_triangle_custom(global_cliprect, voodoo_poly_manager::render_delegate(FUNC(voodoo_device::raster_fastfill), vd), y, count, extents);
 	}
 
 	/* 2 pixels per clock */
@@ -5273,7 +5279,7 @@ INT32 voodoo_device::triangle(voodoo_device *vd)
 	}
 
 	/* wait for any outstanding work to finish */
-//  poly_wait(vd->poly, "triangle");
+//  vd->poly->wait("triangle");
 
 	/* determine the draw buffer */
 	destbuf = (vd->vd_type >= TYPE_VOODOO_BANSHEE) ? 1 : FBZMODE_DRAW_BUFFER(vd->reg[fbzMode].u);
@@ -5524,10 +5530,10 @@ INT32 voodoo_device::setup_and_draw_triangle(voodoo_device *vd)
 
 INT32 voodoo_device::triangle_create_work_item(voodoo_device* vd, UINT16 *drawbuf, int texcount)
 {
-	poly_extra_data *extra = (poly_extra_data *)poly_get_extra_data(vd->poly);
+	poly_extra_data *extra = &vd->poly->object_data_alloc();
 
 	raster_info *info = find_rasterizer(vd, texcount);
-	poly_vertex vert[3];
+	voodoo_poly_manager::vertex_t vert[3];
 
 	/* fill in the vertex data */
 	vert[0].x = (float)vd->fbi.ax * (1.0f / 16.0f);
@@ -5540,6 +5546,7 @@ INT32 voodoo_device::triangle_create_work_item(voodoo_device* vd, UINT16 *drawbu
 	/* fill in the extra data */
 	extra->device = vd;
 	extra->info = info;
+	extra->destbase = drawbuf;
 
 	/* fill in triangle parameters */
 	extra->ax = vd->fbi.ax;
@@ -5597,7 +5604,7 @@ INT32 voodoo_device::triangle_create_work_item(voodoo_device* vd, UINT16 *drawbu
 
 	/* farm the rasterization out to other threads */
 	info->polys++;
-	return poly_render_triangle(vd->poly, drawbuf, global_cliprect, info->callback, 0, &vert[0], &vert[1], &vert[2]);
+	return vd->poly->render_triangle(global_cliprect, voodoo_poly_manager::render_delegate(FUNC(voodoo_device::raster_dispatch), vd), 0, vert[0], vert[1], vert[2]);
 }
 
 
@@ -5684,8 +5691,18 @@ raster_info *voodoo_device::find_rasterizer(voodoo_device *vd, int texcount)
 			return info;
 		}
 
-	/* generate a new one using the generic entry */
-	curinfo.callback = (texcount == 0) ? raster_generic_0tmu : (texcount == 1) ? raster_generic_1tmu : raster_generic_2tmu;
+	/* generate a new one using the generic entry, specialized on the features in use; */
+	/* these are still flagged generic so that the stats dump suggests them for the table */
+	if (USE_FEATURE_RASTERIZERS)
+	{
+		int features = FBZMODE_ENABLE_DEPTHBUF(curinfo.eff_fbz_mode) |
+				(ALPHAMODE_ALPHATEST(curinfo.eff_alpha_mode) << 1) |
+				(ALPHAMODE_ALPHABLEND(curinfo.eff_alpha_mode) << 2) |
+				(FOGMODE_ENABLE_FOG(curinfo.eff_fog_mode) << 3);
+		curinfo.callback = feature_raster_table[texcount][features];
+	}
+	else
+		curinfo.callback = (texcount == 0) ? raster_generic_0tmu : (texcount == 1) ? raster_generic_1tmu : raster_generic_2tmu;
 	curinfo.is_generic = TRUE;
 	curinfo.display = 0;
 	curinfo.polys = 0;
@@ -5786,8 +5803,7 @@ void voodoo_device::device_reset()
 void voodoo_device::device_stop()
 {
 	/* release the work queue, ensuring all work is finished */
-	if (poly != nullptr)
-		poly_free(poly);
+	poly = nullptr;
 }
 
 
@@ -5869,18 +5885,31 @@ void voodoo_3_device::device_start()
     GENERIC RASTERIZERS
 ***************************************************************************/
 
+/*-------------------------------------------------
+    raster_dispatch - per-scanline entry point
+    for triangles; forwards to the rasterizer
+    selected when the triangle was set up
+-------------------------------------------------*/
+
+void voodoo_device::raster_dispatch(INT32 y, const voodoo_poly_manager::extent_t &extent, const poly_extra_data &extra, int threadid)
+{
+	(*extra.info->callback)(extra.destbase, y, extent, extra, threadid);
+}
+
+
 /*-------------------------------------------------
     raster_fastfill - per-scanline
     implementation of the 'fastfill' command
 -------------------------------------------------*/
 
-void voodoo_device::raster_fastfill(void *destbase, INT32 y, const poly_extent *extent, const void *extradata, int threadid)
+void voodoo_device::raster_fastfill(INT32 y, const voodoo_poly_manager::extent_t &extent, const poly_extra_data &extradata, int threadid)
 {
-	const poly_extra_data *extra = (const poly_extra_data *)extradata;
+	const poly_extra_data *extra = &extradata;
 	voodoo_device* vd = extra->device;
-	stats_block *stats = &vd->thread_stats[threadid];
-	INT32 startx = extent->startx;
-	INT32 stopx = extent->stopx;
+	stats_block *threadstats = &vd->thread_stats[threadid];
+	void *destbase = extra->destbase;
+	INT32 startx = extent.startx;
+	INT32 stopx = extent.stopx;
 	int scry, x;
 
 	/* determine the screen Y */
@@ -5901,7 +5930,7 @@ void voodoo_device::raster_fastfill(void *destbase, INT32 y, const poly_extent *
 			*(UINT64 *)&dest[x] = expanded;
 		for ( ; x < stopx; x++)
 			dest[x] = ditherow[x & 3];
-		stats->pixels_out += stopx - startx;
+		threadstats->pixels_out += stopx - startx;
 	}
 
 	/* fill this dest buffer row */
@@ -5943,3 +5972,67 @@ RASTERIZER(generic_1tmu, 1, vd->reg[fbzColorPath].u, vd->reg[fbzMode].u, vd->reg
 
 RASTERIZER(generic_2tmu, 2, vd->reg[fbzColorPath].u, vd->reg[fbzMode].u, vd->reg[alphaMode].u,
 			vd->reg[fogMode].u, vd->tmu[0].reg[textureMode].u, vd->tmu[1].reg[textureMode].u)
+
+
+/*-------------------------------------------------
+    feature rasterizers - generic rasterizers
+    with the costliest per-pixel decisions fixed
+    at compile time; the register values are
+    still read at runtime, but the feature bits
+    are forced to constants so that the compiler
+    can drop the disabled stages entirely
+
+    feature index bits:
+        0 = depth buffer enable (fbzMode bit 4)
+        1 = alpha test (alphaMode bit 0)
+        2 = alpha blend (alphaMode bit 4)
+        3 = fog enable (fogMode bit 0)
+-------------------------------------------------*/
+
+#define FEATURE_FBZMODE(f)      ((vd->reg[fbzMode].u & ~(1 << 4)) | (((f) & 1) << 4))
+#define FEATURE_ALPHAMODE(f)    ((vd->reg[alphaMode].u & ~((1 << 0) | (1 << 4))) | (((f) >> 1) & 1) | ((((f) >> 2) & 1) << 4))
+#define FEATURE_FOGMODE(f)      ((vd->reg[fogMode].u & ~(1 << 0)) | (((f) >> 3) & 1))
+
+#define FEATURE_RASTERIZERS(f) \
+RASTERIZER(feature_0tmu_##f, 0, vd->reg[fbzColorPath].u, FEATURE_FBZMODE(f), FEATURE_ALPHAMODE(f), \
+			FEATURE_FOGMODE(f), 0, 0) \
+RASTERIZER(feature_1tmu_##f, 1, vd->reg[fbzColorPath].u, FEATURE_FBZMODE(f), FEATURE_ALPHAMODE(f), \
+			FEATURE_FOGMODE(f), vd->tmu[0].reg[textureMode].u, 0) \
+RASTERIZER(feature_2tmu_##f, 2, vd->reg[fbzColorPath].u, FEATURE_FBZMODE(f), FEATURE_ALPHAMODE(f), \
+			FEATURE_FOGMODE(f), vd->tmu[0].reg[textureMode].u, vd->tmu[1].reg[textureMode].u)
+
+FEATURE_RASTERIZERS(0)
+FEATURE_RASTERIZERS(1)
+FEATURE_RASTERIZERS(2)
+FEATURE_RASTERIZERS(3)
+FEATURE_RASTERIZERS(4)
+FEATURE_RASTERIZERS(5)
+FEATURE_RASTERIZERS(6)
+FEATURE_RASTERIZERS(7)
+FEATURE_RASTERIZERS(8)
+FEATURE_RASTERIZERS(9)
+FEATURE_RASTERIZERS(10)
+FEATURE_RASTERIZERS(11)
+FEATURE_RASTERIZERS(12)
+FEATURE_RASTERIZERS(13)
+FEATURE_RASTERIZERS(14)
+FEATURE_RASTERIZERS(15)
+
+#define FEATURE_RASTER_ROW(tmus) \
+	{ raster_feature_##tmus##_0,  raster_feature_##tmus##_1,  raster_feature_##tmus##_2,  raster_feature_##tmus##_3, \
+		raster_feature_##tmus##_4,  raster_feature_##tmus##_5,  raster_feature_##tmus##_6,  raster_feature_##tmus##_7, \
+		raster_feature_##tmus##_8,  raster_feature_##tmus##_9,  raster_feature_##tmus##_10, raster_feature_##tmus##_11, \
+		raster_feature_##tmus##_12, raster_feature_##tmus##_13, raster_feature_##tmus##_14, raster_feature_##tmus##_15 }
+
+const voodoo_raster_func voodoo_device::feature_raster_table[3][16] =
+{
+	FEATURE_RASTER_ROW(0tmu),
+	FEATURE_RASTER_ROW(1tmu),
+	FEATURE_RASTER_ROW(2tmu)
+};
+
+#undef FEATURE_RASTER_ROW
+#undef FEATURE_RASTERIZERS
+#undef FEATURE_FOGMODE
+#undef FEATURE_ALPHAMODE
+#undef FEATURE_FBZMODE
@@ -11,7 +11,7 @@
 #ifndef __VOODOO_H__
 #define __VOODOO_H__
 
-#include "video/polylgcy.h"
+#include "video/poly.h"
 
 #pragma once
 
@@ -1364,6 +1364,7 @@ static const UINT8 dither_matrix_2x2[16] =
 
 struct voodoo_state;
 struct poly_extra_data;
+struct raster_info;
 class voodoo_device;
 
 struct rgba
@@ -1610,28 +1611,11 @@ struct dac_state
 };
 
 
-struct raster_info
-{
-	raster_info *       next;                   /* pointer to next entry with the same hash */
-	poly_draw_scanline_func callback;           /* callback pointer */
-	UINT8               is_generic;             /* TRUE if this is one of the generic rasterizers */
-	UINT8               display;                /* display index */
-	UINT32              hits;                   /* how many hits (pixels) we've used this for */
-	UINT32              polys;                  /* how many polys we've used this for */
-	UINT32              eff_color_path;         /* effective fbzColorPath value */
-	UINT32              eff_alpha_mode;         /* effective alphaMode value */
-	UINT32              eff_fog_mode;           /* effective fogMode value */
-	UINT32              eff_fbz_mode;           /* effective fbzMode value */
-	UINT32              eff_tex_mode_0;         /* effective textureMode value for TMU #0 */
-	UINT32              eff_tex_mode_1;         /* effective textureMode value for TMU #1 */
-	UINT32              hash;
-};
-
-
 struct poly_extra_data
 {
 	voodoo_device * device;
 	raster_info *       info;                   /* pointer to rasterizer information */
+	UINT16 *            destbase;               /* base of the buffer being drawn */
 
 	INT16               ax, ay;                 /* vertex A x,y (12.4) */
 	INT32               startr, startg, startb, starta; /* starting R,G,B,A (12.12) */
@@ -1664,6 +1648,28 @@ struct poly_extra_data
 };
 
 
+typedef poly_manager<float, poly_extra_data, 1, 64> voodoo_poly_manager;
+typedef void (*voodoo_raster_func)(void *dest, INT32 scanline, const voodoo_poly_manager::extent_t &extent, const poly_extra_data &extra, int threadid);
+
+
+struct raster_info
+{
+	raster_info *       next;                   /* pointer to next entry with the same hash */
+	voodoo_raster_func  callback;               /* callback pointer */
+	UINT8               is_generic;             /* TRUE if this is one of the generic rasterizers */
+	UINT8               display;                /* display index */
+	UINT32              hits;                   /* how many hits (pixels) we've used this for */
+	UINT32              polys;                  /* how many polys we've used this for */
+	UINT32              eff_color_path;         /* effective fbzColorPath value */
+	UINT32              eff_alpha_mode;         /* effective alphaMode value */
+	UINT32              eff_fog_mode;           /* effective fogMode value */
+	UINT32              eff_fbz_mode;           /* effective fbzMode value */
+	UINT32              eff_tex_mode_0;         /* effective textureMode value for TMU #0 */
+	UINT32              eff_tex_mode_1;         /* effective textureMode value for TMU #1 */
+	UINT32              hash;
+};
+
+
 struct banshee_info
 {
 	UINT32              io[0x40];               /* I/O registers */
@@ -1820,19 +1826,32 @@ public:
 	static INT32 cmdfifo_execute_if_ready(voodoo_device* vd, cmdfifo_info *f);
 	static void cmdfifo_w(voodoo_device *vd, cmdfifo_info *f, offs_t offset, UINT32 data);
 
-	static void raster_fastfill(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
-	static void raster_generic_0tmu(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
-	static void raster_generic_1tmu(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
-	static void raster_generic_2tmu(void *dest, INT32 scanline, const poly_extent *extent, const void *extradata, int threadid);
+	void raster_dispatch(INT32 scanline, const voodoo_poly_manager::extent_t &extent, const poly_extra_data &extra, int threadid);
+	void raster_fastfill(INT32 scanline, const voodoo_poly_manager::extent_t &extent, const poly_extra_data &extra, int threadid);
+	static void raster_generic_0tmu(void *dest, INT32 scanline, const voodoo_poly_manager::extent_t &extent, const poly_extra_data &extra, int threadid);
+	static void raster_generic_1tmu(void *dest, INT32 scanline, const voodoo_poly_manager::extent_t &extent, const poly_extra_data &extra, int threadid);
+	static void raster_generic_2tmu(void *dest, INT32 scanline, const voodoo_poly_manager::extent_t &extent, const poly_extra_data &extra, int threadid);
 
 #define RASTERIZER_HEADER(name) \
-	static void raster_##name(void *destbase, INT32 y, const poly_extent *extent, const void *extradata, int threadid);
+	static void raster_##name(void *destbase, INT32 y, const voodoo_poly_manager::extent_t &extent, const poly_extra_data &extradata, int threadid);
 #define RASTERIZER_ENTRY(fbzcp, alpha, fog, fbz, tex0, tex1) \
 	RASTERIZER_HEADER(fbzcp##_##alpha##_##fog##_##fbz##_##tex0##_##tex1)
 #include "voodoo_rast.hxx"
 
 #undef RASTERIZER_ENTRY
 
+#define FEATURE_RASTERIZER_HEADERS(features) \
+	RASTERIZER_HEADER(feature_0tmu_##features) \
+	RASTERIZER_HEADER(feature_1tmu_##features) \
+	RASTERIZER_HEADER(feature_2tmu_##features)
+	FEATURE_RASTERIZER_HEADERS(0)  FEATURE_RASTERIZER_HEADERS(1)  FEATURE_RASTERIZER_HEADERS(2)  FEATURE_RASTERIZER_HEADERS(3)
+	FEATURE_RASTERIZER_HEADERS(4)  FEATURE_RASTERIZER_HEADERS(5)  FEATURE_RASTERIZER_HEADERS(6)  FEATURE_RASTERIZER_HEADERS(7)
+	FEATURE_RASTERIZER_HEADERS(8)  FEATURE_RASTERIZER_HEADERS(9)  FEATURE_RASTERIZER_HEADERS(10) FEATURE_RASTERIZER_HEADERS(11)
+	FEATURE_RASTERIZER_HEADERS(12) FEATURE_RASTERIZER_HEADERS(13) FEATURE_RASTERIZER_HEADERS(14) FEATURE_RASTERIZER_HEADERS(15)
+#undef FEATURE_RASTERIZER_HEADERS
+
+	static const voodoo_raster_func feature_raster_table[3][16];
+
 
 
 protected:
@@ -1866,7 +1885,7 @@ public:
 	tmu_shared_state    tmushare;               /* TMU shared state */
 	banshee_info        banshee;                /* Banshee state */
 
-	legacy_poly_manager * poly;                 /* polygon manager */
+	std::unique_ptr<voodoo_poly_manager> poly;  /* polygon manager */
 	stats_block *       thread_stats;           /* per-thread statistics */
 
 	voodoo_stats        stats;                  /* internal statistics */
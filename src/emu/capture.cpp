@@ -0,0 +1,197 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    capture.cpp
+
+    Background encoding of snapshots and movie frames.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "capture.h"
+
+
+
+//**************************************************************************
+//  CAPTURE QUEUE
+//**************************************************************************
+
+//-------------------------------------------------
+//  capture_queue - constructor
+//-------------------------------------------------
+
+capture_queue::capture_queue(UINT32 depth, bool drop)
+	: m_depth(depth),
+		m_drop(drop),
+		m_last(NO_BUFFER),
+		m_repeatable(false),
+		m_repeat_width(0),
+		m_repeat_height(0),
+		m_busy(false),
+		m_exiting(false),
+		m_dropped(0)
+{
+	if (m_depth == 0)
+		return;
+
+	for (UINT32 index = 0; index <= m_depth; index++)
+	{
+		m_buffers.push_back(std::make_unique<bitmap_rgb32>());
+		m_free.push_back(index);
+	}
+	m_thread = std::thread([this] { worker(); });
+}
+
+
+//-------------------------------------------------
+//  ~capture_queue - destructor; finishes all
+//  queued work first
+//-------------------------------------------------
+
+capture_queue::~capture_queue()
+{
+	if (!m_thread.joinable())
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_exiting = true;
+	}
+	m_queued.notify_all();
+	m_thread.join();
+}
+
+
+//-------------------------------------------------
+//  push_frame - queue work on a copy of a frame
+//-------------------------------------------------
+
+void capture_queue::push_frame(bitmap_rgb32 &bitmap, bool movie, frame_func func)
+{
+	if (!async())
+	{
+		func(bitmap);
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	// a repeat costs nothing here and keeps the movie the right length; only
+	// a movie frame of the same size can stand in for another
+	if (m_free.empty() && m_drop && movie && m_repeatable && bitmap.width() == m_repeat_width && bitmap.height() == m_repeat_height)
+	{
+		m_dropped++;
+		m_queue.push_back(job{ REPEAT_BUFFER, true, std::move(func), nullptr });
+		m_queued.notify_one();
+		return;
+	}
+
+	// otherwise wait for the encoder to give a buffer back
+	m_done.wait(lock, [this] { return !m_free.empty(); });
+	int const index = m_free.back();
+	m_free.pop_back();
+	lock.unlock();
+
+	// the buffer is ours until it's queued, so copy without the lock
+	bitmap_rgb32 &dest = *m_buffers[index];
+	if (dest.width() != bitmap.width() || dest.height() != bitmap.height())
+		dest.allocate(bitmap.width(), bitmap.height());
+	for (int y = 0; y < bitmap.height(); y++)
+		memcpy(&dest.pix32(y), &bitmap.pix32(y), bitmap.width() * sizeof(UINT32));
+
+	lock.lock();
+	if (movie)
+	{
+		m_repeatable = true;
+		m_repeat_width = bitmap.width();
+		m_repeat_height = bitmap.height();
+	}
+	m_queue.push_back(job{ index, movie, std::move(func), nullptr });
+	m_queued.notify_one();
+}
+
+
+//-------------------------------------------------
+//  push - queue work that needs no frame
+//-------------------------------------------------
+
+void capture_queue::push(work_func func)
+{
+	if (!async())
+	{
+		func();
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_queue.push_back(job{ NO_BUFFER, false, nullptr, std::move(func) });
+	m_queued.notify_one();
+}
+
+
+//-------------------------------------------------
+//  flush - wait for all queued work
+//-------------------------------------------------
+
+void capture_queue::flush()
+{
+	if (!async())
+		return;
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_done.wait(lock, [this] { return m_queue.empty() && !m_busy; });
+
+	// the worker is idle, so the kept frame can go back in the pool
+	if (m_last >= 0)
+		m_free.push_back(m_last);
+	m_last = NO_BUFFER;
+	m_repeatable = false;
+}
+
+
+//-------------------------------------------------
+//  worker - run queued work until told to exit
+//  with nothing left to do
+//-------------------------------------------------
+
+void capture_queue::worker()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	for (;;)
+	{
+		m_queued.wait(lock, [this] { return m_exiting || !m_queue.empty(); });
+		if (m_queue.empty())
+			break;
+
+		job current = std::move(m_queue.front());
+		m_queue.pop_front();
+		m_busy = true;
+		lock.unlock();
+
+		// only this thread changes m_last while jobs are queued, so it can be
+		// read unlocked; a repeat always follows the movie frame it repeats
+		if (current.buffer >= 0)
+			current.frame(*m_buffers[current.buffer]);
+		else if (current.buffer == REPEAT_BUFFER && m_last >= 0)
+			current.frame(*m_buffers[m_last]);
+		else if (current.work)
+			current.work();
+
+		// release whatever the work held (files, samples) outside the lock
+		current.frame = nullptr;
+		current.work = nullptr;
+
+		lock.lock();
+		if (current.buffer >= 0 && current.movie)
+		{
+			if (m_last >= 0)
+				m_free.push_back(m_last);
+			m_last = current.buffer;
+		}
+		else if (current.buffer >= 0)
+			m_free.push_back(current.buffer);
+		m_busy = false;
+		m_done.notify_all();
+	}
+}
@@ -0,0 +1,106 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    capture.h
+
+    Background encoding of snapshots and movie frames.
+
+    Compressing a PNG or appending an AVI frame can take longer than
+    emulating the frame it came from.  A capture_queue copies each frame
+    into one of a small pool of bitmaps and leaves the encoding to a
+    worker thread, so recording costs the emulation thread only the
+    copy.  All work is done in the order it was queued, which keeps the
+    video and audio of a movie interleaved as they were produced.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __EMU_H__
+#error Dont include this file directly; include emu.h instead.
+#endif
+
+#ifndef __CAPTURE_H__
+#define __CAPTURE_H__
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> capture_queue
+
+class capture_queue
+{
+public:
+	typedef std::function<void ()> work_func;
+	typedef std::function<void (bitmap_rgb32 &)> frame_func;
+
+	// construction/destruction; a depth of 0 does all work immediately
+	// on the calling thread
+	capture_queue(UINT32 depth, bool drop);
+	~capture_queue();
+
+	// getters
+	bool async() const { return m_depth != 0; }
+	UINT32 dropped() const { return m_dropped; }
+
+	// queue work that needs a copy of a frame; when all the buffers are in
+	// use, either wait for one or, for a movie frame when dropping, hand the
+	// encoder the previous movie frame again so movie timing is kept
+	void push_frame(bitmap_rgb32 &bitmap, bool movie, frame_func func);
+
+	// queue work that needs no frame; this is never dropped
+	void push(work_func func);
+
+	// wait until everything queued so far is done; the next movie frame
+	// won't repeat one from before this
+	void flush();
+
+private:
+	struct job
+	{
+		int             buffer;         // pool index, or one of the values below
+		bool            movie;          // frame may be repeated in place of a later one
+		frame_func      frame;
+		work_func       work;
+	};
+
+	static constexpr int NO_BUFFER = -1;
+	static constexpr int REPEAT_BUFFER = -2;
+
+	void worker();
+
+	// configuration
+	UINT32                  m_depth;        // frames that can wait for the encoder
+	bool                    m_drop;         // repeat the last frame rather than wait
+
+	// pooled frames; one more than the depth, so the last encoded frame can
+	// be kept for repeats while the queue is full
+	std::vector<std::unique_ptr<bitmap_rgb32>> m_buffers;
+	std::vector<int>        m_free;         // buffers available to push_frame
+	int                     m_last;         // buffer holding the last encoded movie frame
+	bool                    m_repeatable;   // a movie frame is queued or kept in m_last
+	int                     m_repeat_width; // size of that frame
+	int                     m_repeat_height;
+
+	// queue and worker
+	std::deque<job>         m_queue;
+	std::mutex              m_mutex;
+	std::condition_variable m_queued;       // signalled when a job is added
+	std::condition_variable m_done;         // signalled when a job finishes
+	std::thread             m_thread;
+	bool                    m_busy;         // worker is running a job
+	bool                    m_exiting;
+	UINT32                  m_dropped;      // frames replaced by repeats
+};
+
+
+#endif  /* __CAPTURE_H__ */
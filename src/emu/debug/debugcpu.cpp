@@ -95,6 +95,10 @@ void debugger_cpu::configure_memory(symbol_table &table)
 		std::bind(&debugger_cpu::expression_validate, this, _1, _2, _3),
 		std::bind(&debugger_cpu::expression_read_memory, this, _1, _2, _3, _4, _5),
 		std::bind(&debugger_cpu::expression_write_memory, this, _1, _2, _3, _4, _5, _6));
+	table.configure_bound_memory(
+		std::bind(&debugger_cpu::expression_bind_memory, this, _1, _2, _3),
+		std::bind(&debugger_cpu::expression_read_bound_memory, this, _1, _2, _3, _4, _5),
+		std::bind(&debugger_cpu::expression_write_bound_memory, this, _1, _2, _3, _4, _5, _6));
 }
 
 /*-------------------------------------------------
@@ -1471,6 +1475,121 @@ expression_error::error_code debugger_cpu::expression_validate(void *param, cons
 }
 
 
+/*-------------------------------------------------
+    expression_bind_memory - resolve a named
+    device's address space once so that later
+    accesses skip the tag lookup; unnamed
+    references follow the visible CPU and regions
+    can be freed, so neither is bound
+-------------------------------------------------*/
+
+void *debugger_cpu::expression_bind_memory(void *param, const char *name, expression_space spacenum)
+{
+	int spaceindex;
+	switch (spacenum)
+	{
+	case EXPSPACE_PROGRAM_LOGICAL:
+	case EXPSPACE_DATA_LOGICAL:
+	case EXPSPACE_IO_LOGICAL:
+	case EXPSPACE_SPACE3_LOGICAL:
+		spaceindex = AS_PROGRAM + (spacenum - EXPSPACE_PROGRAM_LOGICAL);
+		break;
+
+	case EXPSPACE_PROGRAM_PHYSICAL:
+	case EXPSPACE_DATA_PHYSICAL:
+	case EXPSPACE_IO_PHYSICAL:
+	case EXPSPACE_SPACE3_PHYSICAL:
+		spaceindex = AS_PROGRAM + (spacenum - EXPSPACE_PROGRAM_PHYSICAL);
+		break;
+
+	case EXPSPACE_OPCODE:
+	case EXPSPACE_RAMWRITE:
+		spaceindex = AS_PROGRAM;
+		break;
+
+	default:
+		return nullptr;
+	}
+
+	if (name == nullptr)
+		return nullptr;
+	device_t *device = expression_get_device(name);
+	device_memory_interface *memory;
+	if (device == nullptr || !device->interface(memory) || !memory->has_space(spaceindex))
+		return nullptr;
+	return &memory->space(spaceindex);
+}
+
+
+/*-------------------------------------------------
+    expression_read_bound_memory - read 1,2,4 or 8
+    bytes from an address space resolved by
+    expression_bind_memory
+-------------------------------------------------*/
+
+UINT64 debugger_cpu::expression_read_bound_memory(void *param, void *target, expression_space spacenum, UINT32 address, int size)
+{
+	address_space &space = *reinterpret_cast<address_space *>(target);
+	switch (spacenum)
+	{
+	case EXPSPACE_PROGRAM_LOGICAL:
+	case EXPSPACE_DATA_LOGICAL:
+	case EXPSPACE_IO_LOGICAL:
+	case EXPSPACE_SPACE3_LOGICAL:
+		return read_memory(space, space.address_to_byte(address), size, true);
+
+	case EXPSPACE_PROGRAM_PHYSICAL:
+	case EXPSPACE_DATA_PHYSICAL:
+	case EXPSPACE_IO_PHYSICAL:
+	case EXPSPACE_SPACE3_PHYSICAL:
+		return read_memory(space, space.address_to_byte(address), size, false);
+
+	case EXPSPACE_OPCODE:
+	case EXPSPACE_RAMWRITE:
+		return expression_read_program_direct(space, (spacenum == EXPSPACE_OPCODE), address, size);
+
+	default:
+		return 0;
+	}
+}
+
+
+/*-------------------------------------------------
+    expression_write_bound_memory - write 1,2,4
+    or 8 bytes to an address space resolved by
+    expression_bind_memory
+-------------------------------------------------*/
+
+void debugger_cpu::expression_write_bound_memory(void *param, void *target, expression_space spacenum, UINT32 address, int size, UINT64 data)
+{
+	address_space &space = *reinterpret_cast<address_space *>(target);
+	switch (spacenum)
+	{
+	case EXPSPACE_PROGRAM_LOGICAL:
+	case EXPSPACE_DATA_LOGICAL:
+	case EXPSPACE_IO_LOGICAL:
+	case EXPSPACE_SPACE3_LOGICAL:
+		write_memory(space, space.address_to_byte(address), data, size, true);
+		break;
+
+	case EXPSPACE_PROGRAM_PHYSICAL:
+	case EXPSPACE_DATA_PHYSICAL:
+	case EXPSPACE_IO_PHYSICAL:
+	case EXPSPACE_SPACE3_PHYSICAL:
+		write_memory(space, space.address_to_byte(address), data, size, false);
+		break;
+
+	case EXPSPACE_OPCODE:
+	case EXPSPACE_RAMWRITE:
+		expression_write_program_direct(space, (spacenum == EXPSPACE_OPCODE), address, size, data);
+		break;
+
+	default:
+		break;
+	}
+}
+
+
 
 /***************************************************************************
     VARIABLE GETTERS/SETTERS
@@ -597,6 +597,9 @@ private:
 	void expression_write_program_direct(address_space &space, int opcode, offs_t address, int size, UINT64 data);
 	void expression_write_memory_region(const char *rgntag, offs_t address, int size, UINT64 data);
 	expression_error::error_code expression_validate(void *param, const char *name, expression_space space);
+	void *expression_bind_memory(void *param, const char *name, expression_space space);
+	UINT64 expression_read_bound_memory(void *param, void *target, expression_space space, UINT32 address, int size);
+	void expression_write_bound_memory(void *param, void *target, expression_space space, UINT32 address, int size, UINT64 data);
 	device_t* expression_get_device(const char *tag);
 
 	/* variable getters/setters */
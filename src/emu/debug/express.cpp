@@ -390,7 +390,10 @@ symbol_table::symbol_table(void *globalref, symbol_table *parent)
 		m_memory_param(nullptr),
 		m_memory_valid(nullptr),
 		m_memory_read(nullptr),
-		m_memory_write(nullptr)
+		m_memory_write(nullptr),
+		m_memory_bind(nullptr),
+		m_bound_read(nullptr),
+		m_bound_write(nullptr)
 {
 }
 
@@ -408,6 +411,21 @@ void symbol_table::configure_memory(void *param, valid_func valid, read_func rea
 }
 
 
+//-------------------------------------------------
+//  configure_bound_memory - set the callbacks
+//  used to resolve memory references once, when
+//  an expression is parsed, rather than by name
+//  on every access
+//-------------------------------------------------
+
+void symbol_table::configure_bound_memory(bind_func bind, bound_read_func read, bound_write_func write)
+{
+	m_memory_bind = bind;
+	m_bound_read = read;
+	m_bound_write = write;
+}
+
+
 //-------------------------------------------------
 //  add - add a new UINT64 pointer symbol
 //-------------------------------------------------
@@ -549,6 +567,58 @@ void symbol_table::set_memory_value(const char *name, expression_space space, UI
 }
 
 
+//-------------------------------------------------
+//  memory_bind - resolve a memory reference ahead
+//  of time; returns nullptr if it can't be bound
+//  and must be looked up by name on each access
+//-------------------------------------------------
+
+void *symbol_table::memory_bind(const char *name, expression_space space)
+{
+	// walk up the table hierarchy to find the owner
+	for (symbol_table *symtable = this; symtable != nullptr; symtable = symtable->m_parent)
+		if (symtable->m_memory_valid != nullptr)
+		{
+			if (symtable->m_memory_bind != nullptr && symtable->m_bound_read != nullptr && symtable->m_bound_write != nullptr)
+				return symtable->m_memory_bind(symtable->m_memory_param, name, space);
+			return nullptr;
+		}
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  bound_memory_value - return a value read
+//  through a bound memory reference
+//-------------------------------------------------
+
+UINT64 symbol_table::bound_memory_value(void *target, expression_space space, UINT32 offset, int size)
+{
+	// walk up the table hierarchy to find the owner
+	for (symbol_table *symtable = this; symtable != nullptr; symtable = symtable->m_parent)
+		if (symtable->m_memory_valid != nullptr)
+			return symtable->m_bound_read(symtable->m_memory_param, target, space, offset, size);
+	return 0;
+}
+
+
+//-------------------------------------------------
+//  set_bound_memory_value - write a value through
+//  a bound memory reference
+//-------------------------------------------------
+
+void symbol_table::set_bound_memory_value(void *target, expression_space space, UINT32 offset, int size, UINT64 value)
+{
+	// walk up the table hierarchy to find the owner
+	for (symbol_table *symtable = this; symtable != nullptr; symtable = symtable->m_parent)
+		if (symtable->m_memory_valid != nullptr)
+		{
+			symtable->m_bound_write(symtable->m_memory_param, target, space, offset, size, value);
+			return;
+		}
+}
+
+
 
 //**************************************************************************
 //  PARSED EXPRESSION
@@ -588,6 +658,9 @@ void parsed_expression::parse(const char *expression)
 
 	// convert the infix order to postfix order
 	infix_to_postfix();
+
+	// and evaluate whatever doesn't depend on symbols or memory
+	fold_constants();
 }
 
 
@@ -1137,8 +1210,10 @@ void parsed_expression::parse_memory_operator(parse_token &token, const char *st
 			throw expression_error(err, token.offset() + (string - startstring));
 	}
 
-	// configure the token
+	// configure the token, binding the memory now if the owner allows it
 	token.configure_operator(TVL_MEMORYAT, 2).set_memory_size(memsize).set_memory_space(memspace).set_memory_source(namestring);
+	if (m_symtable != nullptr)
+		token.set_memory_target(m_symtable->memory_bind(namestring, memspace));
 }
 
 
@@ -1304,6 +1379,91 @@ void parsed_expression::infix_to_postfix()
 }
 
 
+//-------------------------------------------------
+//  fold_constants - replace operators whose
+//  operands are all numbers with their result
+//-------------------------------------------------
+
+void parsed_expression::fold_constants()
+{
+	// in postfix order, an operand that is a single number token is the
+	// last surviving token before its operator, so keep those in a stack
+	std::vector<parse_token *> stack;
+	parse_token *nexttoken;
+	for (parse_token *token = m_tokenlist.first(); token != nullptr; token = nexttoken)
+	{
+		nexttoken = token->next();
+		if (token->is_operator() && !stack.empty() && stack.back()->is_number())
+		{
+			UINT8 const optype = token->optype();
+			parse_token &t2 = *stack.back();
+			UINT64 result;
+
+			// unary operators fold into their operand
+			if (optype >= TVL_COMPLEMENT && optype <= TVL_UMINUS)
+			{
+				fold_operator(optype, t2.value(), 0, result);
+				t2.configure_number(result);
+				m_tokenlist.remove(*token);
+				continue;
+			}
+
+			// binary operators fold into the left operand; errors such as
+			// dividing by zero are left to be reported at execution time
+			if (optype >= TVL_MULTIPLY && optype <= TVL_LOR && stack.size() >= 2 && stack[stack.size() - 2]->is_number())
+			{
+				parse_token &t1 = *stack[stack.size() - 2];
+				if (fold_operator(optype, t1.value(), t2.value(), result))
+				{
+					t1.configure_number(result).set_offset(t1, t2);
+					stack.pop_back();
+					m_tokenlist.remove(t2);
+					m_tokenlist.remove(*token);
+					continue;
+				}
+			}
+		}
+		stack.push_back(token);
+	}
+}
+
+
+//-------------------------------------------------
+//  fold_operator - compute the result of a side
+//  effect free operator on constant operands
+//-------------------------------------------------
+
+bool parsed_expression::fold_operator(UINT8 optype, UINT64 left, UINT64 right, UINT64 &result)
+{
+	switch (optype)
+	{
+		case TVL_COMPLEMENT:        result = !left;                 return true;
+		case TVL_NOT:               result = ~left;                 return true;
+		case TVL_UPLUS:             result = left;                  return true;
+		case TVL_UMINUS:            result = -left;                 return true;
+		case TVL_MULTIPLY:          result = left * right;          return true;
+		case TVL_DIVIDE:            if (right == 0) return false;   result = left / right;  return true;
+		case TVL_MODULO:            if (right == 0) return false;   result = left % right;  return true;
+		case TVL_ADD:               result = left + right;          return true;
+		case TVL_SUBTRACT:          result = left - right;          return true;
+		case TVL_LSHIFT:            result = left << right;         return true;
+		case TVL_RSHIFT:            result = left >> right;         return true;
+		case TVL_LESS:              result = left < right;          return true;
+		case TVL_LESSOREQUAL:       result = left <= right;         return true;
+		case TVL_GREATER:           result = left > right;          return true;
+		case TVL_GREATEROREQUAL:    result = left >= right;         return true;
+		case TVL_EQUAL:             result = left == right;         return true;
+		case TVL_NOTEQUAL:          result = left != right;         return true;
+		case TVL_BAND:              result = left & right;          return true;
+		case TVL_BXOR:              result = left ^ right;          return true;
+		case TVL_BOR:               result = left | right;          return true;
+		case TVL_LAND:              result = left && right;         return true;
+		case TVL_LOR:               result = left || right;         return true;
+		default:                                                    return false;
+	}
+}
+
+
 //-------------------------------------------------
 //  push_token - push a token onto the stack
 //-------------------------------------------------
@@ -1664,7 +1824,8 @@ parsed_expression::parse_token::parse_token(int offset)
 		m_value(0),
 		m_flags(0),
 		m_string(nullptr),
-		m_symbol(nullptr)
+		m_symbol(nullptr),
+		m_target(nullptr)
 {
 }
 
@@ -1681,6 +1842,8 @@ UINT64 parsed_expression::parse_token::get_lval_value(symbol_table *table)
 		return m_symbol->value();
 
 	// or get the value from the memory callbacks
+	else if (is_memory() && table != nullptr && m_target != nullptr)
+		return table->bound_memory_value(m_target, memory_space(), address(), 1 << memory_size());
 	else if (is_memory() && table != nullptr)
 		return table->memory_value(m_string, memory_space(), address(), 1 << memory_size());
 
@@ -1700,6 +1863,8 @@ inline void parsed_expression::parse_token::set_lval_value(symbol_table *table,
 		m_symbol->set_value(value);
 
 	// or set the value via the memory callbacks
+	else if (is_memory() && table != nullptr && m_target != nullptr)
+		table->set_bound_memory_value(m_target, memory_space(), address(), 1 << memory_size(), value);
 	else if (is_memory() && table != nullptr)
 		table->set_memory_value(m_string, memory_space(), address(), 1 << memory_size(), value);
 }
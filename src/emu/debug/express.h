@@ -161,6 +161,11 @@ public:
 	typedef std::function<UINT64(void *cbparam, const char *name, expression_space space, UINT32 offset, int size)> read_func;
 	typedef std::function<void(void *cbparam, const char *name, expression_space space, UINT32 offset, int size, UINT64 value)> write_func;
 
+	// callback functions for memory references bound once at parse time
+	typedef std::function<void *(void *cbparam, const char *name, expression_space space)> bind_func;
+	typedef std::function<UINT64(void *cbparam, void *target, expression_space space, UINT32 offset, int size)> bound_read_func;
+	typedef std::function<void(void *cbparam, void *target, expression_space space, UINT32 offset, int size, UINT64 value)> bound_write_func;
+
 	enum read_write
 	{
 		READ_ONLY = 0,
@@ -177,6 +182,7 @@ public:
 
 	// setters
 	void configure_memory(void *param, valid_func valid, read_func read, write_func write);
+	void configure_bound_memory(bind_func bind, bound_read_func read, bound_write_func write);
 
 	// symbol access
 	void add(const char *name, read_write rw, UINT64 *ptr = nullptr);
@@ -194,6 +200,9 @@ public:
 	expression_error::error_code memory_valid(const char *name, expression_space space);
 	UINT64 memory_value(const char *name, expression_space space, UINT32 offset, int size);
 	void set_memory_value(const char *name, expression_space space, UINT32 offset, int size, UINT64 value);
+	void *memory_bind(const char *name, expression_space space);
+	UINT64 bound_memory_value(void *target, expression_space space, UINT32 offset, int size);
+	void set_bound_memory_value(void *target, expression_space space, UINT32 offset, int size, UINT64 value);
 
 private:
 	// internal state
@@ -204,6 +213,9 @@ private:
 	valid_func              m_memory_valid;     // validation callback
 	read_func               m_memory_read;      // read callback
 	write_func              m_memory_write;     // write callback
+	bind_func               m_memory_bind;      // bind callback
+	bound_read_func         m_bound_read;       // read callback for bound references
+	bound_write_func        m_bound_write;      // write callback for bound references
 };
 
 
@@ -299,7 +311,7 @@ private:
 		parse_token &set_offset(const parse_token &src1, const parse_token &src2) { m_offset = MIN(src1.m_offset, src2.m_offset); return *this; }
 		parse_token &configure_number(UINT64 value) { m_type = NUMBER; m_value = value; return *this; }
 		parse_token &configure_string(const char *string) { m_type = STRING; m_string = string; return *this; }
-		parse_token &configure_memory(UINT32 address, parse_token &memoryat) { m_type = MEMORY; m_value = address; m_flags = memoryat.m_flags; m_string = memoryat.m_string; return *this; }
+		parse_token &configure_memory(UINT32 address, parse_token &memoryat) { m_type = MEMORY; m_value = address; m_flags = memoryat.m_flags; m_string = memoryat.m_string; m_target = memoryat.m_target; return *this; }
 		parse_token &configure_symbol(symbol_entry &symbol) { m_type = SYMBOL; m_symbol = &symbol; return *this; }
 		parse_token &configure_operator(UINT8 optype, UINT8 precedence)
 			{ m_type = OPERATOR; m_flags = ((optype << TIN_OPTYPE_SHIFT) & TIN_OPTYPE_MASK) | ((precedence << TIN_PRECEDENCE_SHIFT) & TIN_PRECEDENCE_MASK); return *this; }
@@ -309,6 +321,7 @@ private:
 		parse_token &set_memory_space(expression_space space) { assert(m_type == OPERATOR || m_type == MEMORY); m_flags = (m_flags & ~TIN_MEMORY_SPACE_MASK) | ((space << TIN_MEMORY_SPACE_SHIFT) & TIN_MEMORY_SPACE_MASK); return *this; }
 		parse_token &set_memory_size(int log2ofbits) { assert(m_type == OPERATOR || m_type == MEMORY); m_flags = (m_flags & ~TIN_MEMORY_SIZE_MASK) | ((log2ofbits << TIN_MEMORY_SIZE_SHIFT) & TIN_MEMORY_SIZE_MASK); return *this; }
 		parse_token &set_memory_source(const char *string) { assert(m_type == OPERATOR || m_type == MEMORY); m_string = string; return *this; }
+		parse_token &set_memory_target(void *target) { assert(m_type == OPERATOR || m_type == MEMORY); m_target = target; return *this; }
 
 		// access
 		UINT64 get_lval_value(symbol_table *symtable);
@@ -323,6 +336,7 @@ private:
 		UINT32                  m_flags;            // additional flags/info
 		const char *            m_string;           // associated string
 		symbol_entry *          m_symbol;           // symbol pointer
+		void *                  m_target;           // memory bound at parse time, if any
 	};
 
 	// an expression_string holds an indexed string parsed from the expression
@@ -359,6 +373,8 @@ private:
 	void parse_memory_operator(parse_token &token, const char *string);
 	void normalize_operator(parse_token *prevtoken, parse_token &thistoken);
 	void infix_to_postfix();
+	void fold_constants();
+	static bool fold_operator(UINT8 optype, UINT64 left, UINT64 right, UINT64 &result);
 
 	// execution helpers
 	void push_token(parse_token &token);
@@ -9,6 +9,8 @@
 ***************************************************************************/
 
 #include "emu.h"
+#include "emuopts.h"
+#include "sndlog.h"
 
 
 
@@ -331,6 +333,9 @@ void device_sound_interface::interface_post_start()
 			}
 		}
 	}
+
+	// start logging register writes if asked to
+	open_register_log();
 }
 
 
@@ -348,6 +353,71 @@ void device_sound_interface::interface_pre_reset()
 }
 
 
+//-------------------------------------------------
+//  interface_post_stop - close any register log
+//-------------------------------------------------
+
+void device_sound_interface::interface_post_stop()
+{
+	m_register_log = nullptr;
+}
+
+
+//-------------------------------------------------
+//  open_register_log - create a register write
+//  log if the device is listed in -soundlog
+//-------------------------------------------------
+
+void device_sound_interface::open_register_log()
+{
+	const char *tags = m_device.machine().options().sound_log();
+	if (tags[0] == 0)
+		return;
+
+	// match against the comma-separated list, with or without the leading colon
+	std::string const ourtag(m_device.tag() + 1);
+	bool found = false;
+	for (const char *start = tags; *start != 0 && !found; )
+	{
+		const char *end = strchr(start, ',');
+		if (end == nullptr)
+			end = start + strlen(start);
+		std::string tag(start, end);
+		strtrimspace(tag);
+		if (!tag.empty() && tag[0] == ':')
+			tag.erase(0, 1);
+		found = (tag == ourtag);
+		start = (*end == ',') ? end + 1 : end;
+	}
+	if (!found)
+		return;
+
+	// logs go in the snapshot directory, named after the system and device
+	std::string filename = string_format("%s/%s.srl", m_device.machine().basename(), ourtag);
+	strreplacechr(filename, ':', '_');
+	auto file = std::make_unique<emu_file>(m_device.machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file->open(filename.c_str()) != osd_file::error::NONE)
+	{
+		osd_printf_error("Unable to create sound register log %s\n", filename.c_str());
+		return;
+	}
+
+	m_register_log = std::make_unique<sound_log_writer>(m_device, std::move(file));
+	sound_log_memory(*m_register_log);
+	osd_printf_info("Logging %s register writes to %s\n", m_device.tag(), filename.c_str());
+}
+
+
+//-------------------------------------------------
+//  append_register_log - add a write to the log
+//-------------------------------------------------
+
+void device_sound_interface::append_register_log(offs_t offset, UINT32 data, UINT32 mem_mask)
+{
+	m_register_log->write(offset, data, mem_mask);
+}
+
+
 
 //**************************************************************************
 //  SOUND ROUTE
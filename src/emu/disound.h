@@ -58,6 +58,7 @@ const int AUTO_ALLOC_INPUT  = 65535;
 //**************************************************************************
 
 class sound_stream;
+class sound_log_writer;
 
 
 // ======================> device_sound_interface
@@ -106,17 +107,30 @@ public:
 	void set_output_gain(int outputnum, float gain);
 	int inputnum_from_device(device_t &device, int outputnum = 0) const;
 
+	// register write logging (-soundlog); devices that support it call this
+	// from their register write handlers
+	void log_register_write(offs_t offset, UINT32 data, UINT32 mem_mask) { if (m_register_log != nullptr) append_register_log(offset, data, mem_mask); }
+
 protected:
 	// optional operation overrides
 	virtual void interface_validity_check(validity_checker &valid) const override;
 	virtual void interface_pre_start() override;
 	virtual void interface_post_start() override;
 	virtual void interface_pre_reset() override;
+	virtual void interface_post_stop() override;
+
+	// add any sample memory needed to replay a register log
+	virtual void sound_log_memory(sound_log_writer &log) { }
+
+	// internal helpers
+	void open_register_log();
+	void append_register_log(offs_t offset, UINT32 data, UINT32 mem_mask);
 
 	// internal state
 	simple_list<sound_route> m_route_list;      // list of sound routes
 	int             m_outputs;                  // number of outputs from this instance
 	int             m_auto_allocated_inputs;    // number of auto-allocated inputs targeting us
+	std::unique_ptr<sound_log_writer> m_register_log; // register write log, if enabled for this device
 };
 
 // iterator
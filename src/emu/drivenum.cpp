@@ -9,9 +9,55 @@
 ***************************************************************************/
 
 #include "emu.h"
+#include "emuopts.h"
 #include "drivenum.h"
 #include "softlist.h"
+#include "trigram.h"
 #include <ctype.h>
+#include <mutex>
+
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> driver_summary_cache
+
+// process-wide store of driver summaries, optionally backed by an append-only
+// file in the cache directory that is discarded whenever the build changes;
+// the file can't tell when definitions change within a build, so it is only
+// used with -summary_cache
+class driver_summary_cache
+{
+public:
+	// construction/destruction
+	driver_summary_cache(const char *cachepath, bool usefile);
+
+	// singleton
+	static driver_summary_cache &instance(emu_options &options);
+
+	// operations
+	const driver_summary &get(int index);
+	void flush();
+
+private:
+	static const UINT32 VERSION = 1;
+
+	// internal helpers
+	void load();
+	std::string header() const;
+
+	// internal state
+	std::mutex              m_lock;
+	std::string             m_cachepath;
+	bool                    m_usefile;      // read and write the cache file
+	bool                    m_loaded;
+	std::vector<UINT8>      m_data;         // contents of the cache file
+	std::unordered_map<std::string, size_t> m_offsets;  // driver name to summary in m_data
+	std::vector<std::unique_ptr<driver_summary>> m_summaries;
+	std::vector<UINT8>      m_pending;      // records not yet written to the file
+};
 
 
 
@@ -119,6 +165,380 @@ int driver_list::penalty_compare(const char *source, const char *target)
 }
 
 
+//-------------------------------------------------
+//  search_index - return an index over all
+//  driver names and descriptions, built on first
+//  use
+//-------------------------------------------------
+
+const trigram_index &driver_list::search_index()
+{
+	static const trigram_index s_index = []
+	{
+		trigram_index index;
+		for (int drivnum = 0; drivnum < s_driver_count; drivnum++)
+		{
+			index.add(drivnum, s_drivers_sorted[drivnum]->name);
+			index.add(drivnum, s_drivers_sorted[drivnum]->description);
+		}
+		index.finalize();
+		return index;
+	}();
+	return s_index;
+}
+
+
+
+//**************************************************************************
+//  DRIVER SUMMARY
+//**************************************************************************
+
+namespace {
+
+// serialization helpers
+void save_int(std::vector<UINT8> &data, UINT32 value)
+{
+	for (int shift = 0; shift < 32; shift += 8)
+		data.push_back(value >> shift);
+}
+
+void save_string(std::vector<UINT8> &data, const std::string &value)
+{
+	save_int(data, value.length());
+	data.insert(data.end(), value.begin(), value.end());
+}
+
+bool load_int(const UINT8 *&data, const UINT8 *end, UINT32 &value)
+{
+	if (end - data < 4)
+		return false;
+	value = data[0] | (data[1] << 8) | (data[2] << 16) | (UINT32(data[3]) << 24);
+	data += 4;
+	return true;
+}
+
+bool load_int(const UINT8 *&data, const UINT8 *end, int &value)
+{
+	UINT32 raw;
+	if (!load_int(data, end, raw))
+		return false;
+	value = INT32(raw);
+	return true;
+}
+
+bool load_bool(const UINT8 *&data, const UINT8 *end, bool &value)
+{
+	UINT32 raw;
+	if (!load_int(data, end, raw))
+		return false;
+	value = (raw != 0);
+	return true;
+}
+
+bool load_string(const UINT8 *&data, const UINT8 *end, std::string &value)
+{
+	UINT32 length;
+	if (!load_int(data, end, length) || UINT32(end - data) < length)
+		return false;
+	value.assign(reinterpret_cast<const char *>(data), length);
+	data += length;
+	return true;
+}
+
+} // anonymous namespace
+
+
+//-------------------------------------------------
+//  driver_summary - summarize a configuration
+//-------------------------------------------------
+
+driver_summary::driver_summary(machine_config &config)
+{
+	// devices and their ROMs
+	for (device_t &device : device_iterator(config.root_device()))
+	{
+		int devindex = m_devices.size();
+		m_devices.push_back(device_info{ device.tag(), device.name(), (device.shortname() != nullptr) ? device.shortname() : "", device.clock() });
+
+		for (const rom_entry *region = rom_first_region(device); region != nullptr; region = rom_next_region(region))
+			for (const rom_entry *rom = rom_first_file(region); rom != nullptr; rom = rom_next_file(rom))
+				m_roms.push_back(rom_info{ devindex, ROM_GETNAME(rom), ROM_GETHASHDATA(rom), ROMREGION_ISROMDATA(region) ? int(rom_file_size(rom)) : -1, bool(ROM_ISOPTIONAL(rom)) });
+	}
+
+	// slots and the names of the devices their options select
+	for (const device_slot_interface &slot : slot_interface_iterator(config.root_device()))
+	{
+		m_slots.push_back(slot_info{ slot.device().tag(), slot.fixed(), { } });
+		for (const device_slot_option &option : slot.option_list())
+		{
+			device_t *dev = (*option.devtype())(config, "dummy", &config.root_device(), 0);
+			dev->config_complete();
+			m_slots.back().options.push_back(slot_option_info{ option.name(), dev->name(), option.selectable() });
+			global_free(dev);
+		}
+	}
+
+	// software lists
+	for (software_list_device &swlistdev : software_list_device_iterator(config.root_device()))
+		m_softlists.push_back(swlistdev.list_name());
+}
+
+
+//-------------------------------------------------
+//  save - append the serialized summary
+//-------------------------------------------------
+
+void driver_summary::save(std::vector<UINT8> &data) const
+{
+	save_int(data, m_devices.size());
+	for (const device_info &device : m_devices)
+	{
+		save_string(data, device.tag);
+		save_string(data, device.name);
+		save_string(data, device.shortname);
+		save_int(data, device.clock);
+	}
+
+	save_int(data, m_roms.size());
+	for (const rom_info &rom : m_roms)
+	{
+		save_int(data, rom.device);
+		save_string(data, rom.name);
+		save_string(data, rom.hashdata);
+		save_int(data, rom.length);
+		save_int(data, rom.optional);
+	}
+
+	save_int(data, m_slots.size());
+	for (const slot_info &slot : m_slots)
+	{
+		save_string(data, slot.tag);
+		save_int(data, slot.fixed);
+		save_int(data, slot.options.size());
+		for (const slot_option_info &option : slot.options)
+		{
+			save_string(data, option.name);
+			save_string(data, option.devname);
+			save_int(data, option.selectable);
+		}
+	}
+
+	save_int(data, m_softlists.size());
+	for (const std::string &softlist : m_softlists)
+		save_string(data, softlist);
+}
+
+
+//-------------------------------------------------
+//  load - read a serialized summary, returning
+//  false if the data is truncated or invalid
+//-------------------------------------------------
+
+bool driver_summary::load(const UINT8 *&data, const UINT8 *end)
+{
+	UINT32 count;
+	if (!load_int(data, end, count))
+		return false;
+	m_devices.resize(count);
+	for (device_info &device : m_devices)
+		if (!load_string(data, end, device.tag) || !load_string(data, end, device.name) || !load_string(data, end, device.shortname) || !load_int(data, end, device.clock))
+			return false;
+
+	if (!load_int(data, end, count))
+		return false;
+	m_roms.resize(count);
+	for (rom_info &rom : m_roms)
+		if (!load_int(data, end, rom.device) || rom.device < 0 || rom.device >= m_devices.size() || !load_string(data, end, rom.name) ||
+				!load_string(data, end, rom.hashdata) || !load_int(data, end, rom.length) || !load_bool(data, end, rom.optional))
+			return false;
+
+	if (!load_int(data, end, count))
+		return false;
+	m_slots.resize(count);
+	for (slot_info &slot : m_slots)
+	{
+		if (!load_string(data, end, slot.tag) || !load_bool(data, end, slot.fixed) || !load_int(data, end, count))
+			return false;
+		slot.options.resize(count);
+		for (slot_option_info &option : slot.options)
+			if (!load_string(data, end, option.name) || !load_string(data, end, option.devname) || !load_bool(data, end, option.selectable))
+				return false;
+	}
+
+	if (!load_int(data, end, count))
+		return false;
+	m_softlists.resize(count);
+	for (std::string &softlist : m_softlists)
+		if (!load_string(data, end, softlist))
+			return false;
+
+	return true;
+}
+
+
+
+//**************************************************************************
+//  DRIVER SUMMARY CACHE
+//**************************************************************************
+
+//-------------------------------------------------
+//  driver_summary_cache - constructor
+//-------------------------------------------------
+
+driver_summary_cache::driver_summary_cache(const char *cachepath, bool usefile)
+	: m_cachepath(cachepath),
+		m_usefile(usefile),
+		m_loaded(false),
+		m_summaries(driver_list::total())
+{
+}
+
+
+//-------------------------------------------------
+//  instance - return the process-wide cache
+//-------------------------------------------------
+
+driver_summary_cache &driver_summary_cache::instance(emu_options &options)
+{
+	static driver_summary_cache s_instance(options.cache_directory(), options.summary_cache());
+	return s_instance;
+}
+
+
+//-------------------------------------------------
+//  header - return the header identifying files
+//  written by this build
+//-------------------------------------------------
+
+std::string driver_summary_cache::header() const
+{
+	return string_format("MAME driver summaries %u %d %s\n", VERSION, driver_list::total(), emulator_info::get_build_version());
+}
+
+
+//-------------------------------------------------
+//  load - read and index the cache file; records
+//  are decoded on demand
+//-------------------------------------------------
+
+void driver_summary_cache::load()
+{
+	m_loaded = true;
+	if (!m_usefile)
+		return;
+
+	emu_file file(m_cachepath.c_str(), OPEN_FLAG_READ);
+	if (file.open("drivers.sum") != osd_file::error::NONE)
+		return;
+	m_data.resize(file.size());
+	if (!m_data.empty() && file.read(&m_data[0], m_data.size()) != m_data.size())
+		m_data.clear();
+
+	// ignore the file entirely if another build wrote it
+	std::string expected = header();
+	if (m_data.size() < expected.length() || memcmp(&m_data[0], expected.c_str(), expected.length()) != 0)
+	{
+		m_data.clear();
+		return;
+	}
+
+	// index the records; later ones supersede earlier ones, and a truncated tail is ignored
+	const UINT8 *cur = &m_data[0] + expected.length();
+	const UINT8 *end = &m_data[0] + m_data.size();
+	std::string name;
+	UINT32 length;
+	while (load_string(cur, end, name) && load_int(cur, end, length) && UINT32(end - cur) >= length)
+	{
+		m_offsets[name] = cur - &m_data[0];
+		cur += length;
+	}
+}
+
+
+//-------------------------------------------------
+//  get - return the summary for a driver,
+//  building it if it is not in the cache
+//-------------------------------------------------
+
+const driver_summary &driver_summary_cache::get(int index)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	if (!m_loaded)
+		load();
+
+	std::unique_ptr<driver_summary> &summary = m_summaries[index];
+	if (summary == nullptr)
+	{
+		const game_driver &driver = driver_list::driver(index);
+
+		// try the cache file first
+		auto found = m_offsets.find(driver.name);
+		if (found != m_offsets.end())
+		{
+			const UINT8 *cur = &m_data[found->second - 4];
+			const UINT8 *end = &m_data[0] + m_data.size();
+			UINT32 length;
+			load_int(cur, end, length);
+			end = cur + length;
+			summary = std::make_unique<driver_summary>();
+			if (!summary->load(cur, end) || cur != end)
+				summary = nullptr;
+		}
+
+		// otherwise build it from the default configuration and queue it for writing
+		if (summary == nullptr)
+		{
+			emu_options options;
+			machine_config config(driver, options);
+			summary = std::make_unique<driver_summary>(config);
+			if (!m_usefile)
+				return *summary;
+
+			std::vector<UINT8> record;
+			summary->save(record);
+			save_string(m_pending, driver.name);
+			save_int(m_pending, record.size());
+			m_pending.insert(m_pending.end(), record.begin(), record.end());
+		}
+	}
+	return *summary;
+}
+
+
+//-------------------------------------------------
+//  flush - append any newly built summaries to
+//  the cache file
+//-------------------------------------------------
+
+void driver_summary_cache::flush()
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	if (m_pending.empty())
+		return;
+
+	// append to a valid file, or start a new one
+	emu_file file(m_cachepath.c_str(), OPEN_FLAG_READ | OPEN_FLAG_WRITE);
+	osd_file::error filerr = m_data.empty() ? osd_file::error::NOT_FOUND : file.open("drivers.sum");
+	if (filerr == osd_file::error::NONE)
+		file.seek(0, SEEK_END);
+	else
+	{
+		file.set_openflags(OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+		filerr = file.open("drivers.sum");
+		if (filerr == osd_file::error::NONE)
+		{
+			std::string expected = header();
+			file.write(expected.c_str(), expected.length());
+			m_data.assign(expected.begin(), expected.end());
+		}
+	}
+
+	if (filerr == osd_file::error::NONE)
+		file.write(&m_pending[0], m_pending.size());
+	m_pending.clear();
+}
+
+
 
 //**************************************************************************
 //  DRIVER ENUMERATOR
@@ -173,7 +593,8 @@ driver_enumerator::driver_enumerator(emu_options &options, const game_driver &dr
 
 driver_enumerator::~driver_enumerator()
 {
-	// configs are freed by the cache
+	// configs are freed by the cache; save any summaries we built
+	driver_summary_cache::instance(m_options).flush();
 }
 
 
@@ -203,6 +624,25 @@ machine_config &driver_enumerator::config(int index, emu_options &options) const
 }
 
 
+//-------------------------------------------------
+//  summary - return a summary of the default
+//  configuration for the given driver
+//-------------------------------------------------
+
+const driver_summary &driver_enumerator::summary(int index) const
+{
+	assert(index >= 0 && index < s_driver_count);
+
+	// slot options only apply to the selected system, so describe its actual configuration
+	if (core_stricmp(s_drivers_sorted[index]->name, m_options.system_name()) == 0)
+	{
+		m_selected_summary = std::make_unique<driver_summary>(config(index));
+		return *m_selected_summary;
+	}
+	return driver_summary_cache::instance(m_options).get(index);
+}
+
+
 //-------------------------------------------------
 //  filter - filter the driver list against the
 //  given string
@@ -348,42 +788,62 @@ void driver_enumerator::find_approximate_matches(const char *string, int count,
 	std::vector<int> penalty(count);
 
 	// initialize everyone's states
-	for (int matchnum = 0; matchnum < count; matchnum++)
+	auto reset = [&]()
 	{
-		penalty[matchnum] = 9999;
-		results[matchnum] = -1;
-	}
-
-	// scan the entire drivers array
-	for (int index = 0; index < s_driver_count; index++)
-		if (m_included[index])
+		for (int matchnum = 0; matchnum < count; matchnum++)
 		{
-			// skip things that can't run
-			if ((s_drivers_sorted[index]->flags & MACHINE_NO_STANDALONE) != 0)
-				continue;
+			penalty[matchnum] = 9999;
+			results[matchnum] = -1;
+		}
+	};
+
+	// score a single driver
+	auto consider = [&](int index)
+	{
+		// skip things that can't run
+		if (!m_included[index] || (s_drivers_sorted[index]->flags & MACHINE_NO_STANDALONE) != 0)
+			return;
+
+		// pick the best match between driver name and description
+		int curpenalty = penalty_compare(string, s_drivers_sorted[index]->description);
+		int tmp = penalty_compare(string, s_drivers_sorted[index]->name);
+		curpenalty = MIN(curpenalty, tmp);
 
-			// pick the best match between driver name and description
-			int curpenalty = penalty_compare(string, s_drivers_sorted[index]->description);
-			int tmp = penalty_compare(string, s_drivers_sorted[index]->name);
-			curpenalty = MIN(curpenalty, tmp);
+		// insert into the sorted table of matches
+		for (int matchnum = count - 1; matchnum >= 0; matchnum--)
+		{
+			// stop if we're worse than the current entry
+			if (curpenalty >= penalty[matchnum])
+				break;
 
-			// insert into the sorted table of matches
-			for (int matchnum = count - 1; matchnum >= 0; matchnum--)
+			// as long as this isn't the last entry, bump this one down
+			if (matchnum < count - 1)
 			{
-				// stop if we're worse than the current entry
-				if (curpenalty >= penalty[matchnum])
-					break;
-
-				// as long as this isn't the last entry, bump this one down
-				if (matchnum < count - 1)
-				{
-					penalty[matchnum + 1] = penalty[matchnum];
-					results[matchnum + 1] = results[matchnum];
-				}
-				results[matchnum] = index;
-				penalty[matchnum] = curpenalty;
+				penalty[matchnum + 1] = penalty[matchnum];
+				results[matchnum + 1] = results[matchnum];
 			}
+			results[matchnum] = index;
+			penalty[matchnum] = curpenalty;
 		}
+	};
+
+	// rank the drivers sharing the most trigrams with the string, which is
+	// enough unless the filter leaves too few of them to fill the table
+	reset();
+	if (trigram_index::usable(string))
+	{
+		std::vector<int> candidates;
+		search_index().candidates(string, MAX(count * 4, 256), candidates);
+		for (int index : candidates)
+			consider(index);
+		if (count == 0 || results[count - 1] != -1)
+			return;
+		reset();
+	}
+
+	// scan the entire drivers array
+	for (int index = 0; index < s_driver_count; index++)
+		consider(index);
 }
 
 
@@ -25,6 +25,10 @@ GAME_EXTERN(___empty);
 //  TYPE DEFINITIONS
 //**************************************************************************
 
+// forward references
+class trigram_index;
+
+
 // ======================> driver_list
 
 // driver_list is a purely static class that wraps the global driver list
@@ -58,6 +62,7 @@ public:
 	// static helpers
 	static bool matches(const char *wildstring, const char *string);
 	static int penalty_compare(const char *source, const char *target);
+	static const trigram_index &search_index();
 
 protected:
 	// internal helpers
@@ -69,6 +74,67 @@ protected:
 };
 
 
+// ======================> driver_summary
+
+// precomputed description of a driver's default configuration, letting
+// listings and audits skip constructing a machine_config
+class driver_summary
+{
+public:
+	struct device_info
+	{
+		std::string     tag;            // full device tag
+		std::string     name;           // device name
+		std::string     shortname;      // device shortname
+		UINT32          clock;          // configured clock
+	};
+
+	struct rom_info
+	{
+		int             device;         // index of the owning device
+		std::string     name;           // ROM or disk name
+		std::string     hashdata;       // hash string
+		int             length;         // total length, or -1 for disks
+		bool            optional;       // ROM_OPTIONAL
+	};
+
+	struct slot_option_info
+	{
+		std::string     name;           // option name
+		std::string     devname;        // name of the device it selects
+		bool            selectable;     // whether the user may select it
+	};
+
+	struct slot_info
+	{
+		std::string     tag;            // full tag of the slot device
+		bool            fixed;          // whether the slot is fixed
+		std::vector<slot_option_info> options;
+	};
+
+	// construction
+	driver_summary() { }
+	driver_summary(machine_config &config);
+
+	// getters
+	const std::vector<device_info> &devices() const { return m_devices; }
+	const std::vector<rom_info> &roms() const { return m_roms; }
+	const std::vector<slot_info> &slots() const { return m_slots; }
+	const std::vector<std::string> &softlists() const { return m_softlists; }
+
+	// serialization
+	void save(std::vector<UINT8> &data) const;
+	bool load(const UINT8 *&data, const UINT8 *end);
+
+private:
+	// internal state
+	std::vector<device_info>    m_devices;      // in device_iterator order
+	std::vector<rom_info>       m_roms;         // every ROM and disk in region order
+	std::vector<slot_info>      m_slots;
+	std::vector<std::string>    m_softlists;
+};
+
+
 // ======================> driver_enumerator
 
 // driver_enumerator enables efficient iteration through the driver list
@@ -102,6 +168,8 @@ public:
 	bool excluded(int index) const { assert(index >= 0 && index < s_driver_count); return !m_included[index]; }
 	machine_config &config(int index) const { return config(index,m_options); }
 	machine_config &config(int index, emu_options &options) const;
+	const driver_summary &summary() const { return summary(m_current); }
+	const driver_summary &summary(int index) const;
 	void include(int index) { assert(index >= 0 && index < s_driver_count); if (!m_included[index]) { m_included[index] = true; m_filtered_count++; }  }
 	void exclude(int index) { assert(index >= 0 && index < s_driver_count); if (m_included[index]) { m_included[index] = false; m_filtered_count--; } }
 	using driver_list::driver;
@@ -135,6 +203,7 @@ private:
 	std::vector<UINT8> m_included;
 	mutable std::vector<std::unique_ptr<machine_config>> m_config;
 	mutable std::vector<int> m_config_cache;
+	mutable std::unique_ptr<driver_summary> m_selected_summary;
 };
 
 #endif
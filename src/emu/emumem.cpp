@@ -1631,7 +1631,7 @@ void memory_manager::dump(FILE *file)
 //  region_alloc - allocates memory for a region
 //-------------------------------------------------
 
-memory_region *memory_manager::region_alloc(const char *name, UINT32 length, UINT8 width, endianness_t endian)
+memory_region *memory_manager::region_alloc(const char *name, UINT32 length, UINT8 width, endianness_t endian, bool mappable)
 {
 osd_printf_verbose("Region '%s' created\n", name);
 	// make sure we don't have a region of the same name; also find the end of the list
@@ -1640,7 +1640,7 @@ osd_printf_verbose("Region '%s' created\n", name);
 		fatalerror("region_alloc called with duplicate region name \"%s\"\n", name);
 
 	// allocate the region
-	return &m_regionlist.append(name, *global_alloc(memory_region(machine(), name, length, width, endian)));
+	return &m_regionlist.append(name, *global_alloc(memory_region(machine(), name, length, width, endian, mappable)));
 }
 
 
@@ -4254,16 +4254,46 @@ void memory_bank::configure_entries(int startentry, int numentries, void *base,
 //  memory_region - constructor
 //-------------------------------------------------
 
-memory_region::memory_region(running_machine &machine, const char *name, UINT32 length, UINT8 width, endianness_t endian)
+memory_region::memory_region(running_machine &machine, const char *name, UINT32 length, UINT8 width, endianness_t endian, bool mappable)
 	: m_machine(machine),
 		m_next(nullptr),
 		m_name(name),
-		m_buffer(length),
+		m_base(nullptr),
+		m_length(length),
+		m_mapped_length(0),
 		m_endianness(endian),
 		m_bitwidth(width * 8),
 		m_bytewidth(width)
 {
 	assert(width == 1 || width == 2 || width == 4 || width == 8);
+
+	// regions that ROM files may be mapped over need whole pages from the OSD
+	size_t const granularity = mappable ? osd_map_granularity() : 0;
+	if (granularity != 0 && length != 0)
+	{
+		size_t const size = ((size_t(length) + granularity - 1) / granularity) * granularity;
+		m_base = reinterpret_cast<UINT8 *>(osd_alloc_mappable(size));
+		if (m_base != nullptr)
+			m_mapped_length = size;
+	}
+
+	// otherwise fall back to ordinary memory
+	if (m_base == nullptr && length != 0)
+	{
+		m_buffer.resize(length);
+		m_base = &m_buffer[0];
+	}
+}
+
+
+//-------------------------------------------------
+//  ~memory_region - destructor
+//-------------------------------------------------
+
+memory_region::~memory_region()
+{
+	if (m_mapped_length != 0)
+		osd_free_mappable(m_base, m_mapped_length);
 }
 
 
@@ -673,16 +673,18 @@ class memory_region
 	friend resource_pool_object<memory_region>::~resource_pool_object();
 
 	// construction/destruction
-	memory_region(running_machine &machine, const char *name, UINT32 length, UINT8 width, endianness_t endian);
+	memory_region(running_machine &machine, const char *name, UINT32 length, UINT8 width, endianness_t endian, bool mappable);
+	~memory_region();
 
 public:
 	// getters
 	running_machine &machine() const { return m_machine; }
 	memory_region *next() const { return m_next; }
-	UINT8 *base() { return (m_buffer.size() > 0) ? &m_buffer[0] : nullptr; }
-	UINT8 *end() { return base() + m_buffer.size(); }
-	UINT32 bytes() const { return m_buffer.size(); }
+	UINT8 *base() { return m_base; }
+	UINT8 *end() { return m_base + m_length; }
+	UINT32 bytes() const { return m_length; }
 	const char *name() const { return m_name.c_str(); }
+	bool mappable() const { return m_mapped_length != 0; }
 
 	// flag expansion
 	endianness_t endianness() const { return m_endianness; }
@@ -690,7 +692,7 @@ public:
 	UINT8 bytewidth() const { return m_bytewidth; }
 
 	// data access
-	UINT8 &u8(offs_t offset = 0) { return m_buffer[offset]; }
+	UINT8 &u8(offs_t offset = 0) { return m_base[offset]; }
 	UINT16 &u16(offs_t offset = 0) { return reinterpret_cast<UINT16 *>(base())[offset]; }
 	UINT32 &u32(offs_t offset = 0) { return reinterpret_cast<UINT32 *>(base())[offset]; }
 	UINT64 &u64(offs_t offset = 0) { return reinterpret_cast<UINT64 *>(base())[offset]; }
@@ -700,7 +702,10 @@ private:
 	running_machine &       m_machine;
 	memory_region *         m_next;
 	std::string             m_name;
-	dynamic_buffer          m_buffer;
+	dynamic_buffer          m_buffer;               // storage, unless files can be mapped over the region
+	UINT8 *                 m_base;
+	UINT32                  m_length;
+	size_t                  m_mapped_length;        // size of the osd_alloc_mappable block, or 0
 	endianness_t            m_endianness;
 	UINT8                   m_bitwidth;
 	UINT8                   m_bytewidth;
@@ -733,7 +738,7 @@ public:
 	UINT8 **bank_pointer_addr(UINT8 index) { return &m_bank_ptr[index]; }
 
 	// regions
-	memory_region *region_alloc(const char *name, UINT32 length, UINT8 width, endianness_t endian);
+	memory_region *region_alloc(const char *name, UINT32 length, UINT8 width, endianness_t endian, bool mappable = false);
 	void region_free(const char *name);
 	memory_region *region_containing(const void *memory, offs_t bytes) const;
 
@@ -49,6 +49,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_SNAPSHOT_DIRECTORY,                         "snap",      OPTION_STRING,     "directory to save/load screenshots" },
 	{ OPTION_DIFF_DIRECTORY,                             "diff",      OPTION_STRING,     "directory to save hard drive image difference files" },
 	{ OPTION_COMMENT_DIRECTORY,                          "comments",  OPTION_STRING,     "directory to save debugger comments" },
+	{ OPTION_CACHE_DIRECTORY,                            "cache",     OPTION_STRING,     "directory to save precompiled data caches" },
 
 	// state/playback options
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE STATE/PLAYBACK OPTIONS" },
@@ -58,17 +59,27 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_RECORD ";rec",                              nullptr,        OPTION_STRING,     "record an input file" },
 	{ OPTION_RECORD_TIMECODE,                            "0",            OPTION_BOOLEAN,    "record an input timecode file (requires -record option)" },
 	{ OPTION_EXIT_AFTER_PLAYBACK,                        "0",            OPTION_BOOLEAN,    "close the program at the end of playback" },
+	{ OPTION_RECORD_KEYFRAMES,                           "0",            OPTION_INTEGER,    "frames between keyframes when recording an input file (0 = none)" },
+	{ OPTION_PLAYBACK_SEEK,                              "0",            OPTION_INTEGER,    "frame at which to start playback of an input file" },
+	{ OPTION_PLAYBACK_VERIFY,                            "0",            OPTION_BOOLEAN,    "play back unthrottled and report where the emulated state diverges from the recording" },
 
 	{ OPTION_MNGWRITE,                                   nullptr,        OPTION_STRING,     "optional filename to write a MNG movie of the current session" },
 	{ OPTION_AVIWRITE,                                   nullptr,        OPTION_STRING,     "optional filename to write an AVI movie of the current session" },
+	{ OPTION_AVICODEC,                                   "raw",          OPTION_STRING,     "video format for AVI movies: raw (uncompressed RGB) or mlsc (lossless, compressed on all cores)" },
 #ifdef MAME_DEBUG
 	{ OPTION_DUMMYWRITE,                                 "0",         OPTION_BOOLEAN,    "indicates if a snapshot should be created if each frame" },
 #endif
 	{ OPTION_WAVWRITE,                                   nullptr,        OPTION_STRING,     "optional filename to write a WAV file of the current session" },
+	{ OPTION_SOUNDLOG,                                   nullptr,        OPTION_STRING,     "comma-separated tags of sound devices whose register writes are logged to the snapshot directory" },
+	{ OPTION_SOUNDREPLAY,                                nullptr,        OPTION_STRING,     "sound register log to play back with the sndreplay systems" },
 	{ OPTION_SNAPNAME,                                   "%g/%i",     OPTION_STRING,     "override of the default snapshot/movie naming; %g == gamename, %i == index" },
 	{ OPTION_SNAPSIZE,                                   "auto",      OPTION_STRING,     "specify snapshot/movie resolution (<width>x<height>) or 'auto' to use minimal size " },
 	{ OPTION_SNAPVIEW,                                   "internal",  OPTION_STRING,     "specify snapshot/movie view or 'internal' to use internal pixel-aspect views" },
 	{ OPTION_SNAPBILINEAR,                               "1",         OPTION_BOOLEAN,    "specify if the snapshot/movie should have bilinear filtering applied" },
+	{ OPTION_SNAPQUEUE "(0-64)",                         "8",         OPTION_INTEGER,    "number of snapshot/movie frames that can wait for the encoder thread (0 = encode on the emulation thread)" },
+	{ OPTION_SNAPDROP,                                   "0",         OPTION_BOOLEAN,    "repeat the previous movie frame instead of waiting when the encoder falls behind" },
+	{ OPTION_SNAPCOMPRESS,                               "-1",        OPTION_INTEGER,    "PNG/MNG compression level, 0-9 (-1 = zlib default)" },
+	{ OPTION_SNAPFILTER,                                 "none",      OPTION_STRING,     "PNG/MNG row filter: none, sub, up, average, paeth or adaptive" },
 	{ OPTION_STATENAME,                                  "%g",        OPTION_STRING,     "override of the default state subfolder naming; %g == gamename" },
 	{ OPTION_BURNIN,                                     "0",         OPTION_BOOLEAN,    "create burn-in snapshots for each screen" },
 
@@ -109,6 +120,7 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_USE_BEZELS ";bezel",                        "1",         OPTION_BOOLEAN,    "enable bezels if artwork is enabled and available" },
 	{ OPTION_USE_CPANELS ";cpanel",                      "1",         OPTION_BOOLEAN,    "enable cpanels if artwork is enabled and available" },
 	{ OPTION_USE_MARQUEES ";marquee",                    "1",         OPTION_BOOLEAN,    "enable marquees if artwork is enabled and available" },
+	{ OPTION_ARTWORK_CACHE ";artcache(0-4096)",          "128",       OPTION_INTEGER,    "megabytes of scaled artwork kept for all render targets; 0 to scale per texture" },
 
 	// screen options
 	{ nullptr,                                              nullptr,        OPTION_HEADER,     "CORE SCREEN OPTIONS" },
@@ -199,6 +211,9 @@ const options_entry emu_options::s_option_entries[] =
 	{ OPTION_PLUGIN,                                    nullptr,     OPTION_STRING,     "list of plugins to enable" },
 	{ OPTION_NO_PLUGIN,                                  nullptr,     OPTION_STRING,     "list of plugins to disable" },
 	{ OPTION_LANGUAGE ";lang",                           "English",   OPTION_STRING,    "display language" },
+	{ OPTION_LISTXML_CACHE,                              "0",         OPTION_BOOLEAN,    "reuse complete -listxml output saved in the cache directory by the same build" },
+	{ OPTION_SUMMARY_CACHE,                              "0",         OPTION_BOOLEAN,    "reuse per-system ROM, device and slot summaries saved in the cache directory by the same build" },
+	{ OPTION_ARCHIVE_CACHE,                              "64",        OPTION_INTEGER,    "memory in MB for each of the ZIP/7Z index and decompressed 7Z block caches" },
 	{ nullptr }
 };
 
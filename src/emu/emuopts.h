@@ -45,6 +45,7 @@
 #define OPTION_SNAPSHOT_DIRECTORY   "snapshot_directory"
 #define OPTION_DIFF_DIRECTORY       "diff_directory"
 #define OPTION_COMMENT_DIRECTORY    "comment_directory"
+#define OPTION_CACHE_DIRECTORY      "cache_directory"
 
 // core state/playback options
 #define OPTION_STATE                "state"
@@ -53,16 +54,26 @@
 #define OPTION_RECORD               "record"
 #define OPTION_RECORD_TIMECODE      "record_timecode"
 #define OPTION_EXIT_AFTER_PLAYBACK  "exit_after_playback"
+#define OPTION_RECORD_KEYFRAMES     "record_keyframes"
+#define OPTION_PLAYBACK_SEEK        "playback_seek"
+#define OPTION_PLAYBACK_VERIFY      "playback_verify"
 #define OPTION_MNGWRITE             "mngwrite"
 #define OPTION_AVIWRITE             "aviwrite"
+#define OPTION_AVICODEC             "avicodec"
 #ifdef MAME_DEBUG
 #define OPTION_DUMMYWRITE           "dummywrite"
 #endif
 #define OPTION_WAVWRITE             "wavwrite"
+#define OPTION_SOUNDLOG             "soundlog"
+#define OPTION_SOUNDREPLAY          "soundreplay"
 #define OPTION_SNAPNAME             "snapname"
 #define OPTION_SNAPSIZE             "snapsize"
 #define OPTION_SNAPVIEW             "snapview"
 #define OPTION_SNAPBILINEAR         "snapbilinear"
+#define OPTION_SNAPQUEUE            "snapqueue"
+#define OPTION_SNAPDROP             "snapdrop"
+#define OPTION_SNAPCOMPRESS         "snapcompress"
+#define OPTION_SNAPFILTER           "snapfilter"
 #define OPTION_STATENAME            "statename"
 #define OPTION_BURNIN               "burnin"
 
@@ -99,6 +110,7 @@
 #define OPTION_USE_BEZELS           "use_bezels"
 #define OPTION_USE_CPANELS          "use_cpanels"
 #define OPTION_USE_MARQUEES         "use_marquees"
+#define OPTION_ARTWORK_CACHE        "artwork_cache"
 
 // core screen options
 #define OPTION_BRIGHTNESS           "brightness"
@@ -185,6 +197,9 @@
 #define OPTION_NO_PLUGIN            "noplugin"
 
 #define OPTION_LANGUAGE             "language"
+#define OPTION_LISTXML_CACHE        "listxml_cache"
+#define OPTION_SUMMARY_CACHE        "summary_cache"
+#define OPTION_ARCHIVE_CACHE        "archive_cache"
 
 //**************************************************************************
 //  TYPE DEFINITIONS
@@ -231,6 +246,7 @@ public:
 	const char *snapshot_directory() const { return value(OPTION_SNAPSHOT_DIRECTORY); }
 	const char *diff_directory() const { return value(OPTION_DIFF_DIRECTORY); }
 	const char *comment_directory() const { return value(OPTION_COMMENT_DIRECTORY); }
+	const char *cache_directory() const { return value(OPTION_CACHE_DIRECTORY); }
 
 	// core state/playback options
 	const char *state() const { return value(OPTION_STATE); }
@@ -239,16 +255,26 @@ public:
 	const char *record() const { return value(OPTION_RECORD); }
 	bool record_timecode() const { return bool_value(OPTION_RECORD_TIMECODE); }
 	bool exit_after_playback() const { return bool_value(OPTION_EXIT_AFTER_PLAYBACK); }
+	int record_keyframes() const { return int_value(OPTION_RECORD_KEYFRAMES); }
+	int playback_seek() const { return int_value(OPTION_PLAYBACK_SEEK); }
+	bool playback_verify() const { return bool_value(OPTION_PLAYBACK_VERIFY); }
 	const char *mng_write() const { return value(OPTION_MNGWRITE); }
 	const char *avi_write() const { return value(OPTION_AVIWRITE); }
+	const char *avi_codec() const { return value(OPTION_AVICODEC); }
 #ifdef MAME_DEBUG
 	bool dummy_write() const { return bool_value(OPTION_DUMMYWRITE); }
 #endif
 	const char *wav_write() const { return value(OPTION_WAVWRITE); }
+	const char *sound_log() const { return value(OPTION_SOUNDLOG); }
+	const char *sound_replay() const { return value(OPTION_SOUNDREPLAY); }
 	const char *snap_name() const { return value(OPTION_SNAPNAME); }
 	const char *snap_size() const { return value(OPTION_SNAPSIZE); }
 	const char *snap_view() const { return value(OPTION_SNAPVIEW); }
 	bool snap_bilinear() const { return bool_value(OPTION_SNAPBILINEAR); }
+	int snap_queue() const { return int_value(OPTION_SNAPQUEUE); }
+	bool snap_drop() const { return bool_value(OPTION_SNAPDROP); }
+	int snap_compress() const { return int_value(OPTION_SNAPCOMPRESS); }
+	const char *snap_filter() const { return value(OPTION_SNAPFILTER); }
 	const char *state_name() const { return value(OPTION_STATENAME); }
 	bool burnin() const { return bool_value(OPTION_BURNIN); }
 
@@ -285,6 +311,7 @@ public:
 	bool use_bezels() const { return bool_value(OPTION_USE_BEZELS); }
 	bool use_cpanels() const { return bool_value(OPTION_USE_CPANELS); }
 	bool use_marquees() const { return bool_value(OPTION_USE_MARQUEES); }
+	int artwork_cache() const { return int_value(OPTION_ARTWORK_CACHE); }
 
 	// core screen options
 	float brightness() const { return float_value(OPTION_BRIGHTNESS); }
@@ -372,6 +399,9 @@ public:
 	const char *no_plugin() const { return value(OPTION_NO_PLUGIN); }
 
 	const char *language() const { return value(OPTION_LANGUAGE); }
+	bool listxml_cache() const { return bool_value(OPTION_LISTXML_CACHE); }
+	bool summary_cache() const { return bool_value(OPTION_SUMMARY_CACHE); }
+	int archive_cache() const { return int_value(OPTION_ARCHIVE_CACHE); }
 
 	// cache frequently used options in members
 	void update_cached_options();
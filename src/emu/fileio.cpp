@@ -498,6 +498,24 @@ UINT32 emu_file::read(void *buffer, UINT32 length)
 }
 
 
+//-------------------------------------------------
+//  map - map data from a file over memory
+//  allocated with osd_alloc_mappable
+//-------------------------------------------------
+
+osd_file::error emu_file::map(void *dest, UINT32 length)
+{
+	// ZIP and 7z data is decompressed into RAM, so there's nothing to map
+	if (compressed_file_ready())
+		return osd_file::error::FAILURE;
+
+	if (m_file)
+		return m_file->map(dest, length);
+
+	return osd_file::error::FAILURE;
+}
+
+
 //-------------------------------------------------
 //  getc - read a character from a file
 //-------------------------------------------------
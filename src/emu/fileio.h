@@ -124,6 +124,7 @@ public:
 
 	// reading
 	UINT32 read(void *buffer, UINT32 length);
+	osd_file::error map(void *dest, UINT32 length);
 	int getc();
 	int ungetc(int c);
 	char *gets(char *s, int n);
@@ -101,6 +101,7 @@
 
 #include <ctype.h>
 #include <time.h>
+#include <zlib.h>
 
 
 namespace {
@@ -2442,6 +2443,25 @@ ioport_manager::ioport_manager(running_machine &machine)
 		m_playback_file(machine.options().input_directory(), OPEN_FLAG_READ),
 		m_playback_accumulated_speed(0),
 		m_playback_accumulated_frames(0),
+		m_playback_version(0),
+		m_playback_cursor(0),
+		m_playback_time(attotime::zero),
+		m_playback_interval(attotime::zero),
+		m_playback_speed(0),
+		m_playback_frame(0),
+		m_playback_target(0),
+		m_playback_throttled(true),
+		m_playback_indexed(false),
+		m_playback_keyframes(0),
+		m_playback_diverged(0),
+		m_playback_seeking(false),
+		m_record_cursor(0),
+		m_record_time(attotime::zero),
+		m_record_last_time(attotime::zero),
+		m_record_interval(attotime::zero),
+		m_record_speed(0),
+		m_record_last_speed(0),
+		m_record_frame(0),
 		m_timecode_file(machine.options().input_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS),
 		m_timecode_count(0),
 		m_timecode_last_time(attotime::zero),
@@ -2848,6 +2868,15 @@ void ioport_manager::frame_update()
 {
 g_profiler.start(PROFILER_INPUT);
 
+	// jump ahead or drop throttling before the first frame played back
+	if (m_playback_file.is_open() && m_playback_accumulated_frames == 0 && (m_playback_target > 0 || machine().options().playback_verify()))
+	{
+		m_playback_throttled = machine().video().throttled();
+		machine().video().set_throttled(false);
+		if (m_playback_target > 0 && m_playback_version != inp_header::LEGACY_MAJVERSION)
+			playback_seek(m_playback_target);
+	}
+
 	// record/playback information about the current frame
 	attotime curtime = machine().time();
 	playback_frame(curtime);
@@ -2884,6 +2913,9 @@ g_profiler.start(PROFILER_INPUT);
 				dynfield.write(newvalue);
 	}
 
+	// write the frame now that all the port values are known
+	record_frame_end();
+
 g_profiler.stop();
 }
 
@@ -3277,6 +3309,112 @@ void ioport_manager::save_game_inputs(xml_data_node *parentnode)
 
 
 
+//**************************************************************************
+//  INPUT FILE ENCODING
+//**************************************************************************
+
+// Version 4 input files follow the header with a sequence of records, each a
+// tag byte and a varint payload length.  Frame records hold only the port
+// values that changed since the previous frame, as (gap, zigzag delta)
+// varint pairs.  Keyframe records hold a full snapshot of the decoder state
+// and a deflated save state, and the file ends with an index of keyframes
+// located by a fixed-size trailer, so playback can seek without scanning.
+// A keyframe follows the frame record before the frame it precedes; its
+// state is saved, checked and restored at the scheduler's next safe point
+// after that frame, never from inside the frame callback.
+
+namespace {
+
+// record tags
+const UINT8 INP_TAG_FRAME = 0x01;
+const UINT8 INP_TAG_KEYFRAME = 0x02;
+const UINT8 INP_TAG_INDEX = 0x03;
+
+// frame record flags
+const UINT64 INP_FRAME_INTERVAL = 0x01;     // time since the previous frame changed
+const UINT64 INP_FRAME_SPEED = 0x02;        // recorded speed changed
+
+// trailer: magic followed by the little-endian offset of the index record
+const UINT8 INP_TRAILER_MAGIC[8] = { 'I', 'N', 'P', 'I', 'N', 'D', 'E', 'X' };
+const int INP_TRAILER_SIZE = 16;
+
+// a frame never has anywhere near this many port values
+const UINT64 INP_MAX_VALUES = 1 << 20;
+
+
+void inp_write_varint(std::vector<UINT8> &buffer, UINT64 value)
+{
+	while (value >= 0x80)
+	{
+		buffer.push_back(UINT8(value | 0x80));
+		value >>= 7;
+	}
+	buffer.push_back(UINT8(value));
+}
+
+bool inp_read_varint(const UINT8 *&data, const UINT8 *end, UINT64 &value)
+{
+	value = 0;
+	for (int shift = 0; data < end && shift < 64; shift += 7)
+	{
+		UINT8 byte = *data++;
+		value |= UINT64(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			return true;
+	}
+	return false;
+}
+
+void inp_write_time(std::vector<UINT8> &buffer, const attotime &time)
+{
+	inp_write_varint(buffer, UINT32(time.seconds()));
+	inp_write_varint(buffer, UINT64(time.attoseconds()));
+}
+
+bool inp_read_time(const UINT8 *&data, const UINT8 *end, attotime &time)
+{
+	UINT64 seconds, attoseconds;
+	if (!inp_read_varint(data, end, seconds) || !inp_read_varint(data, end, attoseconds) || attoseconds >= ATTOSECONDS_PER_SECOND)
+		return false;
+	time = attotime(seconds_t(seconds), attoseconds_t(attoseconds));
+	return true;
+}
+
+// everything in a keyframe record
+struct inp_keyframe
+{
+	UINT64 frame, speed, crc, rawlength, length;
+	attotime time, interval;
+	std::vector<UINT32> values;
+	const UINT8 *state;         // deflated state, within the record buffer
+};
+
+bool inp_read_keyframe(const std::vector<UINT8> &buffer, inp_keyframe &key)
+{
+	const UINT8 *data = buffer.data();
+	const UINT8 *end = data + buffer.size();
+	UINT64 count;
+	bool valid = inp_read_varint(data, end, key.frame) && inp_read_time(data, end, key.time) && inp_read_time(data, end, key.interval) &&
+			inp_read_varint(data, end, key.speed) && inp_read_varint(data, end, count) && count < INP_MAX_VALUES;
+	key.values.resize(valid ? count : 0);
+	for (UINT32 &value : key.values)
+	{
+		UINT64 temp;
+		valid = valid && inp_read_varint(data, end, temp);
+		value = UINT32(temp);
+	}
+	valid = valid && inp_read_varint(data, end, key.crc) && inp_read_varint(data, end, key.rawlength) && inp_read_varint(data, end, key.length) && key.length <= UINT64(end - data);
+	key.state = data;
+	return valid;
+}
+
+inline UINT64 inp_zigzag(INT32 value) { return (UINT32(value) << 1) ^ UINT32(value >> 31); }
+inline UINT32 inp_unzigzag(UINT64 value) { return UINT32(value >> 1) ^ (0 - UINT32(value & 1)); }
+
+} // anonymous namespace
+
+
+
 //**************************************************************************
 //  INPUT PLAYBACK
 //**************************************************************************
@@ -3319,6 +3457,36 @@ bool ioport_manager::playback_read<bool>(bool &result)
 }
 
 
+//-------------------------------------------------
+//  playback_record - read the next record from a
+//  version 4 file into the playback buffer,
+//  returning false at the end of the file
+//-------------------------------------------------
+
+bool ioport_manager::playback_record(UINT8 &tag)
+{
+	if (m_playback_file.read(&tag, 1) != 1)
+		return false;
+
+	// the length is a varint, read a byte at a time
+	UINT64 length = 0;
+	for (int shift = 0; ; shift += 7)
+	{
+		UINT8 byte;
+		if (shift >= 64 || m_playback_file.read(&byte, 1) != 1)
+			return false;
+		length |= UINT64(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			break;
+	}
+	if (length > m_playback_file.size())
+		return false;
+
+	m_playback_buffer.resize(length);
+	return length == 0 || m_playback_file.read(&m_playback_buffer[0], length) == length;
+}
+
+
 //-------------------------------------------------
 //  playback_init - initialize INP playback
 //-------------------------------------------------
@@ -3340,8 +3508,9 @@ time_t ioport_manager::playback_init()
 		fatalerror("Input file is corrupt or invalid (missing header)\n");
 	if (!header.check_magic())
 		fatalerror("Input file invalid or in an older, unsupported format\n");
-	if (header.get_majversion() != inp_header::MAJVERSION)
+	if (header.get_majversion() != inp_header::MAJVERSION && header.get_majversion() != inp_header::LEGACY_MAJVERSION)
 		fatalerror("Input file format version mismatch\n");
+	m_playback_version = header.get_majversion();
 
 	// output info to console
 	osd_printf_info("Input file: %s\n", filename);
@@ -3355,8 +3524,46 @@ time_t ioport_manager::playback_init()
 	if (sysname != machine().system().name)
 		osd_printf_info("Input file is for machine '%s', not for current machine '%s'\n", sysname.c_str(), machine().system().name);
 
-	// enable compression
-	m_playback_file.compress(FCOMPRESS_MEDIUM);
+	// legacy files are compressed as a whole; newer ones must stay seekable
+	m_playback_target = MAX(machine().options().playback_seek(), 0);
+	if (m_playback_version == inp_header::LEGACY_MAJVERSION)
+	{
+		m_playback_file.compress(FCOMPRESS_MEDIUM);
+		if (machine().options().playback_verify())
+			osd_printf_warning("Input file has no keyframes; playback cannot be verified\n");
+	}
+	else
+	{
+		// load the keyframe index if the recording was closed cleanly
+		UINT64 datastart = m_playback_file.tell();
+		UINT8 trailer[INP_TRAILER_SIZE];
+		if (m_playback_file.size() >= datastart + INP_TRAILER_SIZE && m_playback_file.seek(-INP_TRAILER_SIZE, SEEK_END) == 0 &&
+				m_playback_file.read(trailer, INP_TRAILER_SIZE) == INP_TRAILER_SIZE && memcmp(trailer, INP_TRAILER_MAGIC, sizeof(INP_TRAILER_MAGIC)) == 0)
+		{
+			UINT64 offset = 0;
+			for (int byte = 7; byte >= 0; byte--)
+				offset = (offset << 8) | trailer[sizeof(INP_TRAILER_MAGIC) + byte];
+
+			UINT8 tag;
+			if (m_playback_file.seek(offset, SEEK_SET) == 0 && playback_record(tag) && tag == INP_TAG_INDEX)
+			{
+				const UINT8 *data = m_playback_buffer.data();
+				const UINT8 *end = data + m_playback_buffer.size();
+				UINT64 count, frame, position;
+				bool valid = inp_read_varint(data, end, count);
+				for (UINT64 entry = 0; valid && entry < count; entry++)
+				{
+					valid = inp_read_varint(data, end, frame) && inp_read_varint(data, end, position);
+					if (valid)
+						m_playback_index.emplace_back(frame, position);
+				}
+				m_playback_indexed = valid;
+				if (!valid)
+					m_playback_index.clear();
+			}
+		}
+		m_playback_file.seek(datastart, SEEK_SET);
+	}
 	return basetime;
 }
 
@@ -3383,6 +3590,15 @@ void ioport_manager::playback_end(const char *message)
 		osd_printf_info("Total playback frames: %d\n", UINT32(m_playback_accumulated_frames));
 		osd_printf_info("Average recorded speed: %d%%\n", UINT32((m_playback_accumulated_speed * 200 + 1) >> 21));
 
+		// report how the emulation compared with the recording
+		if (machine().options().playback_verify())
+		{
+			if (m_playback_diverged > 0)
+				osd_printf_info("Playback diverged from recording at %d of %d keyframes\n", m_playback_diverged, m_playback_keyframes);
+			else
+				osd_printf_info("Playback matched recording at all %d keyframes\n", m_playback_keyframes);
+		}
+
 		// close the program at the end of inp file playback
 		if (machine().options().exit_after_playback()) {
 			osd_printf_info("Exiting MAME now...\n");
@@ -3400,7 +3616,7 @@ void ioport_manager::playback_end(const char *message)
 void ioport_manager::playback_frame(const attotime &curtime)
 {
 	// if playing back, fetch the information and verify
-	if (m_playback_file.is_open())
+	if (m_playback_file.is_open() && m_playback_version == inp_header::LEGACY_MAJVERSION)
 	{
 		// first the absolute time
 		seconds_t seconds_temp;
@@ -3415,6 +3631,69 @@ void ioport_manager::playback_frame(const attotime &curtime)
 		UINT32 curspeed;
 		m_playback_accumulated_speed += playback_read(curspeed);
 		m_playback_accumulated_frames++;
+		m_playback_frame++;
+	}
+	else if (m_playback_file.is_open())
+	{
+		// read up to the next frame; keyframes were dealt with after the last one
+		UINT8 tag = 0;
+		bool valid;
+		while ((valid = playback_record(tag)) && tag == INP_TAG_KEYFRAME) { }
+		if (!valid || tag != INP_TAG_FRAME)
+		{
+			playback_end("End of file");
+			return;
+		}
+
+		// apply the timing and port value changes
+		const UINT8 *data = m_playback_buffer.data();
+		const UINT8 *end = data + m_playback_buffer.size();
+		UINT64 flags, value, changes, gap, position = 0;
+		valid = inp_read_varint(data, end, flags);
+		if (valid && (flags & INP_FRAME_INTERVAL))
+			valid = inp_read_time(data, end, m_playback_interval);
+		if (valid && (flags & INP_FRAME_SPEED) && (valid = inp_read_varint(data, end, value)))
+			m_playback_speed = UINT32(value);
+		valid = valid && inp_read_varint(data, end, changes);
+		for (UINT64 change = 0; valid && change < changes; change++)
+		{
+			valid = inp_read_varint(data, end, gap) && inp_read_varint(data, end, value) && position + gap < INP_MAX_VALUES;
+			if (valid)
+			{
+				position += gap;
+				if (position >= m_playback_values.size())
+					m_playback_values.resize(position + 1);
+				m_playback_values[position++] += inp_unzigzag(value);
+			}
+		}
+		if (!valid)
+		{
+			playback_end("Input file is corrupt");
+			return;
+		}
+
+		m_playback_time += m_playback_interval;
+		if (m_playback_time != curtime)
+		{
+			playback_end("Out of sync");
+			return;
+		}
+		m_playback_accumulated_speed += m_playback_speed;
+		m_playback_accumulated_frames++;
+		m_playback_cursor = 0;
+		m_playback_frame++;
+
+		// keyframes before the next frame are checked where they were saved
+		playback_keyframes();
+	}
+
+	// resume normal speed once we reach the requested frame
+	if (m_playback_file.is_open() && m_playback_target > 0 && m_playback_frame >= m_playback_target)
+	{
+		if (!machine().options().playback_verify())
+			machine().video().set_throttled(m_playback_throttled);
+		osd_printf_info("Playback reached frame %d\n", UINT32(m_playback_frame));
+		m_playback_target = 0;
 	}
 }
 
@@ -3426,7 +3705,7 @@ void ioport_manager::playback_frame(const attotime &curtime)
 void ioport_manager::playback_port(ioport_port &port)
 {
 	// if playing back, fetch information about this port
-	if (m_playback_file.is_open())
+	if (m_playback_file.is_open() && m_playback_version == inp_header::LEGACY_MAJVERSION)
 	{
 		// read the default value and the digital state
 		playback_read(port.live().defvalue);
@@ -3444,32 +3723,177 @@ void ioport_manager::playback_port(ioport_port &port)
 			playback_read(analog.m_reverse);
 		}
 	}
+	else if (m_playback_file.is_open())
+	{
+		// values past the end of the list were never changed from zero
+		auto next = [this]() { UINT32 value = (m_playback_cursor < m_playback_values.size()) ? m_playback_values[m_playback_cursor] : 0; m_playback_cursor++; return value; };
+
+		port.live().defvalue = next();
+		port.live().digital = next();
+		for (analog_field &analog : port.live().analoglist)
+		{
+			analog.m_accum = INT32(next());
+			analog.m_previous = INT32(next());
+			analog.m_sensitivity = INT32(next());
+			analog.m_reverse = (next() != 0);
+		}
+	}
 }
 
 
 //-------------------------------------------------
-//  record_write - write a value to the record file
+//  playback_keyframes - read the keyframes that
+//  precede the next frame, scheduling a check of
+//  each against the emulated state
 //-------------------------------------------------
 
-template<typename _Type>
-void ioport_manager::record_write(_Type value)
+void ioport_manager::playback_keyframes()
 {
-	// protect against nullptr handles if previous reads fail
-	if (!m_record_file.is_open())
+	for (;;)
+	{
+		// stop in front of anything that isn't a keyframe
+		UINT64 const offset = m_playback_file.tell();
+		UINT8 tag;
+		if (!playback_record(tag) || tag != INP_TAG_KEYFRAME)
+		{
+			m_playback_file.seek(offset, SEEK_SET);
+			return;
+		}
+
+		inp_keyframe key;
+		if (!inp_read_keyframe(m_playback_buffer, key) || key.frame != m_playback_frame)
+		{
+			playback_end("Input file is corrupt");
+			return;
+		}
+
+		// compare a hash of our state with the one recorded at this point
+		if (machine().options().playback_verify() && key.rawlength != 0 && !m_playback_seeking)
+		{
+			UINT32 const crc = UINT32(key.crc);
+			UINT64 const frame = key.frame;
+			machine().schedule_save_buffer(m_playback_state, [this, crc, frame] (save_error err)
+			{
+				if (err != STATERR_NONE)
+					return;
+				m_playback_keyframes++;
+				if (crc32_creator::simple(&m_playback_state[0], m_playback_state.size()) != crc)
+				{
+					if (m_playback_diverged++ == 0)
+						osd_printf_warning("Playback diverged from recording by frame %d\n", UINT32(frame));
+					else
+						osd_printf_verbose("Playback differs from recording at frame %d\n", UINT32(frame));
+				}
+			});
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  playback_build_index - find the keyframes in a
+//  file that has no index, starting from the
+//  current position
+//-------------------------------------------------
+
+void ioport_manager::playback_build_index()
+{
+	if (m_playback_indexed)
 		return;
 
-	// read the value; if we fail, end playback
-	if (m_record_file.write(&value, sizeof(value)) != sizeof(value))
-		record_end("Out of space");
+	UINT64 start = m_playback_file.tell();
+	UINT64 offset = start;
+	UINT8 tag;
+	while (playback_record(tag))
+	{
+		const UINT8 *data = m_playback_buffer.data();
+		UINT64 frame;
+		if (tag == INP_TAG_KEYFRAME && inp_read_varint(data, data + m_playback_buffer.size(), frame))
+			m_playback_index.emplace_back(frame, offset);
+		offset = m_playback_file.tell();
+	}
+	m_playback_file.seek(start, SEEK_SET);
+	m_playback_indexed = true;
 }
 
-template<>
-void ioport_manager::record_write<bool>(bool value)
+
+//-------------------------------------------------
+//  playback_seek - restore the latest keyframe at
+//  or before the given frame; playback then runs
+//  unthrottled until it reaches the frame
+//-------------------------------------------------
+
+void ioport_manager::playback_seek(UINT64 frame)
 {
-	UINT8 byte = UINT8(value);
-	record_write(byte);
+	playback_build_index();
+
+	// try keyframes from the latest usable one backwards
+	m_playback_seek_offsets.clear();
+	for (auto &entry : m_playback_index)
+		if (entry.first <= frame)
+			m_playback_seek_offsets.push_back(entry.second);
+	playback_seek_next();
 }
 
+
+//-------------------------------------------------
+//  playback_seek_next - schedule a load of the
+//  next keyframe to try; if none can be loaded,
+//  everything plays from the start
+//-------------------------------------------------
+
+void ioport_manager::playback_seek_next()
+{
+	UINT64 const start = m_playback_file.tell();
+	while (!m_playback_seek_offsets.empty())
+	{
+		UINT64 const offset = m_playback_seek_offsets.back();
+		m_playback_seek_offsets.pop_back();
+
+		// inflate the state
+		UINT8 tag;
+		inp_keyframe key;
+		if (m_playback_file.seek(offset, SEEK_SET) != 0 || !playback_record(tag) || tag != INP_TAG_KEYFRAME || !inp_read_keyframe(m_playback_buffer, key) || key.rawlength == 0)
+			continue;
+		m_playback_state.resize(key.rawlength);
+		uLongf statelength = key.rawlength;
+		if (uncompress(&m_playback_state[0], &statelength, key.state, key.length) != Z_OK || statelength != key.rawlength)
+			continue;
+
+		// load it where it was saved, then pick up decoding where the keyframe left off
+		UINT64 const resume = m_playback_file.tell();
+		key.state = nullptr;
+		m_playback_seeking = true;
+		machine().schedule_load_buffer(m_playback_state, [this, key, resume] (save_error err)
+		{
+			m_playback_seeking = false;
+			if (!m_playback_file.is_open())
+				return;
+			if (err != STATERR_NONE)
+			{
+				playback_seek_next();
+				return;
+			}
+
+			m_playback_frame = key.frame;
+			m_playback_time = key.time;
+			m_playback_interval = key.interval;
+			m_playback_speed = UINT32(key.speed);
+			m_playback_values = key.values;
+			m_playback_file.seek(resume, SEEK_SET);
+			osd_printf_info("Playback resuming from keyframe at frame %d\n", UINT32(key.frame));
+		});
+		break;
+	}
+	m_playback_file.seek(start, SEEK_SET);
+}
+
+
+
+//**************************************************************************
+//  INPUT RECORDING
+//**************************************************************************
+
 template<typename _Type>
 void ioport_manager::timecode_write(_Type value)
 {
@@ -3494,6 +3918,25 @@ void ioport_manager::timecode_write<std::string>(std::string value) {
 }
 
 
+//-------------------------------------------------
+//  record_record - write the record buffer to the
+//  record file with the given tag
+//-------------------------------------------------
+
+void ioport_manager::record_record(UINT8 tag)
+{
+	// protect against nullptr handles if previous writes fail
+	if (!m_record_file.is_open())
+		return;
+
+	std::vector<UINT8> prefix(1, tag);
+	inp_write_varint(prefix, m_record_buffer.size());
+	if (m_record_file.write(&prefix[0], prefix.size()) != prefix.size() ||
+			(!m_record_buffer.empty() && m_record_file.write(&m_record_buffer[0], m_record_buffer.size()) != m_record_buffer.size()))
+		record_end("Out of space");
+}
+
+
 //-------------------------------------------------
 //  record_init - initialize INP recording
 //-------------------------------------------------
@@ -3521,11 +3964,8 @@ void ioport_manager::record_init()
 	header.set_sysname(machine().system().name);
 	header.set_appdesc(util::string_format("%s %s", emulator_info::get_appname(), emulator_info::get_build_version()));
 
-	// write it
+	// write it; the records that follow are delta encoded rather than compressed as a stream so the file stays seekable
 	header.write(m_record_file);
-
-	// enable compression
-	m_record_file.compress(FCOMPRESS_MEDIUM);
 }
 
 
@@ -3576,6 +4016,27 @@ void ioport_manager::record_end(const char *message)
 	// only applies if we have a live file
 	if (m_record_file.is_open())
 	{
+		// finish a clean recording with the keyframe index and the trailer that locates it
+		if (message == nullptr)
+		{
+			UINT64 offset = m_record_file.tell();
+			m_record_buffer.clear();
+			inp_write_varint(m_record_buffer, m_record_index.size());
+			for (auto &entry : m_record_index)
+			{
+				inp_write_varint(m_record_buffer, entry.first);
+				inp_write_varint(m_record_buffer, entry.second);
+			}
+			record_record(INP_TAG_INDEX);
+
+			UINT8 trailer[INP_TRAILER_SIZE];
+			memcpy(trailer, INP_TRAILER_MAGIC, sizeof(INP_TRAILER_MAGIC));
+			for (int byte = 0; byte < 8; byte++)
+				trailer[sizeof(INP_TRAILER_MAGIC) + byte] = UINT8(offset >> (byte * 8));
+			if (m_record_file.is_open())
+				m_record_file.write(trailer, INP_TRAILER_SIZE);
+		}
+
 		// close the file
 		m_record_file.close();
 
@@ -3609,12 +4070,10 @@ void ioport_manager::record_frame(const attotime &curtime)
 	// if recording, record information about the current frame
 	if (m_record_file.is_open())
 	{
-		// first the absolute time
-		record_write(curtime.seconds());
-		record_write(curtime.attoseconds());
-
-		// then the current speed
-		record_write(UINT32(machine().video().speed_percent() * double(1 << 20)));
+		// note the time and current speed; the frame is written once the ports are known
+		m_record_time = curtime;
+		m_record_speed = UINT32(machine().video().speed_percent() * double(1 << 20));
+		m_record_cursor = 0;
 	}
 
 	if (m_timecode_file.is_open() && machine().video().get_timecode_write())
@@ -3719,25 +4178,139 @@ void ioport_manager::record_port(ioport_port &port)
 	// if recording, store information about this port
 	if (m_record_file.is_open())
 	{
+		auto store = [this](UINT32 value)
+		{
+			if (m_record_cursor >= m_record_values.size())
+				m_record_values.resize(m_record_cursor + 1);
+			m_record_values[m_record_cursor++] = value;
+		};
+
 		// store the default value and digital state
-		record_write(port.live().defvalue);
-		record_write(port.live().digital);
+		store(port.live().defvalue);
+		store(port.live().digital);
 
 		// loop over analog ports and save their data
 		for (analog_field &analog : port.live().analoglist)
 		{
 			// store current and previous values
-			record_write(analog.m_accum);
-			record_write(analog.m_previous);
+			store(analog.m_accum);
+			store(analog.m_previous);
 
 			// store configuration information
-			record_write(analog.m_sensitivity);
-			record_write(analog.m_reverse);
+			store(analog.m_sensitivity);
+			store(analog.m_reverse);
+		}
+	}
+}
+
+
+//-------------------------------------------------
+//  record_frame_end - end of frame callback for
+//  recording; writes the values that changed
+//-------------------------------------------------
+
+void ioport_manager::record_frame_end()
+{
+	if (!m_record_file.is_open())
+		return;
+
+	// timing changes rarely, so only write it when it does
+	attotime interval = m_record_time - m_record_last_time;
+	UINT64 flags = 0;
+	if (interval != m_record_interval)
+		flags |= INP_FRAME_INTERVAL;
+	if (m_record_speed != m_record_last_speed)
+		flags |= INP_FRAME_SPEED;
+
+	m_record_buffer.clear();
+	inp_write_varint(m_record_buffer, flags);
+	if (flags & INP_FRAME_INTERVAL)
+		inp_write_time(m_record_buffer, interval);
+	if (flags & INP_FRAME_SPEED)
+		inp_write_varint(m_record_buffer, m_record_speed);
+
+	// then the port values that changed, as gaps and deltas
+	m_record_previous.resize(m_record_values.size());
+	size_t changes = 0;
+	for (size_t index = 0; index < m_record_values.size(); index++)
+		if (m_record_values[index] != m_record_previous[index])
+			changes++;
+	inp_write_varint(m_record_buffer, changes);
+	for (size_t index = 0, position = 0; index < m_record_values.size(); index++)
+		if (m_record_values[index] != m_record_previous[index])
+		{
+			inp_write_varint(m_record_buffer, index - position);
+			inp_write_varint(m_record_buffer, inp_zigzag(INT32(m_record_values[index] - m_record_previous[index])));
+			m_record_previous[index] = m_record_values[index];
+			position = index + 1;
 		}
+	record_record(INP_TAG_FRAME);
+
+	m_record_last_time = m_record_time;
+	m_record_interval = interval;
+	m_record_last_speed = m_record_speed;
+	m_record_frame++;
+
+	// keyframes capture the state before the frame they precede, taken at
+	// the next safe point; if another frame gets in first, skip it
+	int const keyframes = machine().options().record_keyframes();
+	if (keyframes > 0 && (m_record_frame % keyframes) == 0)
+	{
+		UINT64 const frame = m_record_frame;
+		machine().schedule_save_buffer(m_record_state, [this, frame] (save_error err)
+		{
+			if (m_record_file.is_open() && m_record_frame == frame)
+				record_keyframe(err);
+		});
 	}
 }
 
 
+//-------------------------------------------------
+//  record_keyframe - write a keyframe holding the
+//  decoder state and the save state just taken
+//-------------------------------------------------
+
+void ioport_manager::record_keyframe(save_error err)
+{
+	// everything needed to resume decoding at this frame
+	m_record_buffer.clear();
+	inp_write_varint(m_record_buffer, m_record_frame);
+	inp_write_time(m_record_buffer, m_record_last_time);
+	inp_write_time(m_record_buffer, m_record_interval);
+	inp_write_varint(m_record_buffer, m_record_last_speed);
+	inp_write_varint(m_record_buffer, m_record_previous.size());
+	for (UINT32 value : m_record_previous)
+		inp_write_varint(m_record_buffer, value);
+
+	// then the state, along with a hash for verifying playback
+	std::vector<UINT8> &state = m_record_state;
+	if (err == STATERR_NONE)
+	{
+		uLongf length = compressBound(state.size());
+		std::vector<UINT8> compressed(length);
+		if (compress2(&compressed[0], &length, &state[0], state.size(), Z_BEST_SPEED) != Z_OK)
+			length = 0;
+
+		inp_write_varint(m_record_buffer, crc32_creator::simple(&state[0], state.size()));
+		inp_write_varint(m_record_buffer, (length != 0) ? state.size() : 0);
+		inp_write_varint(m_record_buffer, length);
+		m_record_buffer.insert(m_record_buffer.end(), compressed.begin(), compressed.begin() + length);
+	}
+	else
+	{
+		if (m_record_index.empty())
+			osd_printf_warning("Unable to save state for input keyframes\n");
+		inp_write_varint(m_record_buffer, 0);
+		inp_write_varint(m_record_buffer, 0);
+		inp_write_varint(m_record_buffer, 0);
+	}
+
+	m_record_index.emplace_back(m_record_frame, m_record_file.tell());
+	record_record(INP_TAG_KEYFRAME);
+}
+
+
 
 //**************************************************************************
 //  I/O PORT CONFIGURER
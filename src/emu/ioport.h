@@ -688,8 +688,9 @@ class inp_header
 {
 public:
 	// parameters
-	static constexpr unsigned MAJVERSION = 3;
+	static constexpr unsigned MAJVERSION = 4;
 	static constexpr unsigned MINVERSION = 0;
+	static constexpr unsigned LEGACY_MAJVERSION = 3;    // uncompressed port values every frame; still played back
 
 	bool read(emu_file &f)
 	{
@@ -1535,12 +1536,19 @@ private:
 	void playback_end(const char *message = nullptr);
 	void playback_frame(const attotime &curtime);
 	void playback_port(ioport_port &port);
+	bool playback_record(UINT8 &tag);
+	void playback_keyframes();
+	void playback_build_index();
+	void playback_seek(UINT64 frame);
+	void playback_seek_next();
 
-	template<typename _Type> void record_write(_Type value);
 	void record_init();
 	void record_end(const char *message = nullptr);
 	void record_frame(const attotime &curtime);
 	void record_port(ioport_port &port);
+	void record_frame_end();
+	void record_record(UINT8 tag);
+	void record_keyframe(save_error err);
 
 	template<typename _Type> void timecode_write(_Type value);
 	void timecode_init();
@@ -1568,6 +1576,35 @@ private:
 	emu_file                m_playback_file;        // playback file (nullptr if not recording)
 	UINT64                  m_playback_accumulated_speed; // accumulated speed during playback
 	UINT32                  m_playback_accumulated_frames; // accumulated frames during playback
+	unsigned                m_playback_version;     // major version of the playback file
+	std::vector<UINT32>     m_playback_values;      // port values of the current playback frame
+	size_t                  m_playback_cursor;      // next value for playback_port
+	std::vector<UINT8>      m_playback_buffer;      // payload of the current playback record
+	attotime                m_playback_time;        // time of the last frame played back
+	attotime                m_playback_interval;    // time between the last two frames played back
+	UINT32                  m_playback_speed;       // speed of the last frame played back
+	UINT64                  m_playback_frame;       // frames played back so far
+	UINT64                  m_playback_target;      // frame to fast forward to, or 0
+	bool                    m_playback_throttled;   // throttle state to restore after fast forwarding
+	std::vector<std::pair<UINT64, UINT64>> m_playback_index; // keyframe frame numbers and file offsets
+	bool                    m_playback_indexed;     // whether m_playback_index is complete
+	UINT32                  m_playback_keyframes;   // keyframes verified
+	UINT32                  m_playback_diverged;    // keyframes whose state did not match
+	std::vector<UINT8>      m_playback_state;       // state to check or load at the next safe point
+	std::vector<UINT64>     m_playback_seek_offsets; // keyframes left to try when seeking, latest last
+	bool                    m_playback_seeking;     // a keyframe load is scheduled
+	std::vector<UINT32>     m_record_values;        // port values of the current recorded frame
+	std::vector<UINT32>     m_record_previous;      // port values of the previous recorded frame
+	size_t                  m_record_cursor;        // next value for record_port
+	std::vector<UINT8>      m_record_buffer;        // payload of the record being built
+	attotime                m_record_time;          // time of the frame being recorded
+	attotime                m_record_last_time;     // time of the previous recorded frame
+	attotime                m_record_interval;      // time between the previous two recorded frames
+	UINT32                  m_record_speed;         // speed of the frame being recorded
+	UINT32                  m_record_last_speed;    // speed of the previous recorded frame
+	UINT64                  m_record_frame;         // frames recorded so far
+	std::vector<std::pair<UINT64, UINT64>> m_record_index; // keyframe frame numbers and file offsets
+	std::vector<UINT8>      m_record_state;         // state for the next keyframe
 	emu_file                m_timecode_file;        // timecode/frames playback file (nullptr if not recording)
 	int                     m_timecode_count;
 	attotime                m_timecode_last_time;
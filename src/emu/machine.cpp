@@ -346,7 +346,7 @@ int running_machine::run(bool quiet)
 				m_video->frame_update();
 
 			// handle save/load
-			if (m_saveload_schedule != SLS_NONE)
+			if (m_saveload_schedule != SLS_NONE || !m_saveload_buffer_ops.empty())
 				handle_saveload();
 
 			g_profiler.stop();
@@ -647,6 +647,28 @@ void running_machine::immediate_load(const char *filename)
 }
 
 
+//-------------------------------------------------
+//  schedule_save_buffer - schedule a save to memory at
+//  the next safe point
+//-------------------------------------------------
+
+void running_machine::schedule_save_buffer(std::vector<UINT8> &buffer, saveload_buffer_func done)
+{
+	m_saveload_buffer_ops.push_back(saveload_buffer_op{ SLS_SAVE, &buffer, std::move(done) });
+}
+
+
+//-------------------------------------------------
+//  schedule_load_buffer - schedule a load from memory at
+//  the next safe point
+//-------------------------------------------------
+
+void running_machine::schedule_load_buffer(const std::vector<UINT8> &buffer, saveload_buffer_func done)
+{
+	m_saveload_buffer_ops.push_back(saveload_buffer_op{ SLS_LOAD, const_cast<std::vector<UINT8> *>(&buffer), std::move(done) });
+}
+
+
 //-------------------------------------------------
 //  pause - pause the system
 //-------------------------------------------------
@@ -794,6 +816,28 @@ void running_machine::call_notifiers(machine_notification which)
 
 void running_machine::handle_saveload()
 {
+	// in-memory operations belong to the point they were asked for, so they
+	// fail rather than wait for anonymous timers to clear
+	if (!m_saveload_buffer_ops.empty())
+	{
+		std::vector<saveload_buffer_op> ops;
+		ops.swap(m_saveload_buffer_ops);
+		for (saveload_buffer_op &op : ops)
+		{
+			save_error saverr = STATERR_PENDING_TIMERS;
+			if (m_scheduler.can_save())
+			{
+				if (op.schedule == SLS_LOAD)
+					saverr = op.buffer->empty() ? STATERR_READ_ERROR : m_save.read_buffer(&(*op.buffer)[0], op.buffer->size());
+				else
+					saverr = m_save.write_buffer(*op.buffer);
+			}
+			op.done(saverr);
+		}
+		if (m_saveload_schedule == SLS_NONE)
+			return;
+	}
+
 	// if no name, bail
 	if (!m_saveload_pending_file.empty())
 	{
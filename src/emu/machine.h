@@ -225,6 +225,13 @@ public:
 	void schedule_save(const char *filename);
 	void schedule_load(const char *filename);
 
+	// in-memory state, saved or loaded at the next point where that's safe;
+	// unlike files these never wait for a later point, so the callback may be
+	// told STATERR_PENDING_TIMERS
+	typedef std::function<void (save_error)> saveload_buffer_func;
+	void schedule_save_buffer(std::vector<UINT8> &buffer, saveload_buffer_func done);
+	void schedule_load_buffer(const std::vector<UINT8> &buffer, saveload_buffer_func done);
+
 	// date & time
 	void base_datetime(system_time &systime);
 	void current_datetime(system_time &systime);
@@ -322,6 +329,14 @@ private:
 	std::string             m_saveload_pending_file;
 	const char *            m_saveload_searchpath;
 
+	struct saveload_buffer_op
+	{
+		saveload_schedule       schedule;
+		std::vector<UINT8> *    buffer;
+		saveload_buffer_func    done;
+	};
+	std::vector<saveload_buffer_op> m_saveload_buffer_ops; // in-memory operations, in order
+
 	// notifier callbacks
 	struct notifier_callback_item
 	{
@@ -54,6 +54,7 @@ enum profile_type
 	PROFILER_INPUT,             // input.c and inptport.c
 	PROFILER_MOVIE_REC,         // movie recording
 	PROFILER_LOGERROR,          // logerror
+	PROFILER_LUA,               // Lua scripts
 	PROFILER_EXTRA,             // everything else
 
 	// the USER types are available to driver writers to profile
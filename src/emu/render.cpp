@@ -332,7 +332,8 @@ render_texture::render_texture()
 		m_osddata(~0L),
 		m_scaler(nullptr),
 		m_param(nullptr),
-		m_curseq(0)
+		m_curseq(0),
+		m_cachebucket(nullptr)
 {
 	m_sbounds.set(0, -1, 0, -1);
 	memset(m_scaled, 0, sizeof(m_scaled));
@@ -373,6 +374,11 @@ void render_texture::reset(render_manager &manager, texture_scaler_func scaler,
 
 void render_texture::release()
 {
+	// the scale cache keeps its copies, but must finish with our scaler
+	if (m_cachebucket != nullptr)
+		m_manager->scale_cache().wait(*this);
+	m_cachebucket = nullptr;
+
 	// free all scaled versions
 	for (auto & elem : m_scaled)
 	{
@@ -407,6 +413,10 @@ void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, text
 	if (&bitmap != m_bitmap && m_bitmap != nullptr)
 		m_manager->invalidate_all(m_bitmap);
 
+	// don't pull the source out from under a worker
+	if (m_cachebucket != nullptr)
+		m_manager->scale_cache().wait(*this);
+
 	// set the new bitmap/palette
 	m_bitmap = &bitmap;
 	m_sbounds = sbounds;
@@ -426,6 +436,21 @@ void render_texture::set_bitmap(bitmap_t &bitmap, const rectangle &sbounds, text
 }
 
 
+//-------------------------------------------------
+//  set_cache_key - get scaled versions from the
+//  scale cache under the given key
+//-------------------------------------------------
+
+void render_texture::set_cache_key(const std::string &key)
+{
+	assert(m_scaler != nullptr);
+
+	render_scale_cache &cache = m_manager->scale_cache();
+	if (cache.enabled())
+		m_cachebucket = cache.find_bucket(key);
+}
+
+
 //-------------------------------------------------
 //  hq_scale - generic high quality resampling
 //  scaler
@@ -467,6 +492,18 @@ void render_texture::get_scaled(UINT32 dwidth, UINT32 dheight, render_texinfo &t
 		// palette will be set later
 		texinfo.seqid = ++m_curseq;
 	}
+	else if (m_cachebucket != nullptr)
+	{
+		// shared sizes come from the cache, which may hand back another size while this one is scaled
+		render_scale_cache::entry *scaled = m_manager->scale_cache().get_scaled(*m_cachebucket, *this, dwidth, dheight, primlist);
+		primlist.add_reference(scaled->m_bitmap.get());
+		texinfo.base = &scaled->m_bitmap->pix32(0);
+		texinfo.rowpixels = scaled->m_bitmap->rowpixels();
+		texinfo.width = scaled->m_bitmap->width();
+		texinfo.height = scaled->m_bitmap->height();
+		// palette will be set later
+		texinfo.seqid = scaled->m_seqid;
+	}
 	else
 	{
 		// make sure we can recover the original argb32 bitmap
@@ -560,6 +597,183 @@ const rgb_t *render_texture::get_adjusted_palette(render_container &container)
 
 
 
+//**************************************************************************
+//  RENDER SCALE CACHE
+//**************************************************************************
+
+//-------------------------------------------------
+//  render_scale_cache - constructor
+//-------------------------------------------------
+
+render_scale_cache::render_scale_cache(render_manager &manager, UINT64 budget)
+	: m_manager(manager),
+		m_budget(budget),
+		m_used(0),
+		m_curseq(0),
+		m_lookups(0),
+		m_queue(nullptr)
+{
+	// without a queue everything is scaled as it's asked for
+	if (m_budget != 0)
+		m_queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+}
+
+
+//-------------------------------------------------
+//  ~render_scale_cache - destructor
+//-------------------------------------------------
+
+render_scale_cache::~render_scale_cache()
+{
+	if (m_queue != nullptr)
+	{
+		while (!osd_work_queue_wait(m_queue, 10 * osd_ticks_per_second())) { }
+		osd_work_queue_free(m_queue);
+	}
+}
+
+
+//-------------------------------------------------
+//  find_bucket - return the bucket for a key,
+//  creating it if needed
+//-------------------------------------------------
+
+render_scale_cache::bucket *render_scale_cache::find_bucket(const std::string &key)
+{
+	// map nodes never move, so textures can hold on to this
+	return &m_buckets[key];
+}
+
+
+//-------------------------------------------------
+//  get_scaled - return a scaled bitmap for a
+//  texture; this is the requested size if it's
+//  ready, or else the last size drawn while the
+//  requested one is scaled
+//-------------------------------------------------
+
+render_scale_cache::entry *render_scale_cache::get_scaled(bucket &target, render_texture &texture, UINT32 dwidth, UINT32 dheight, render_primitive_list &primlist)
+{
+	m_lookups++;
+
+	// find the size we want, and the most recently used size that's ready
+	entry *exact = nullptr;
+	entry *previous = nullptr;
+	for (auto &scaled : target.m_entries)
+	{
+		bool const ready = scaled->m_ready;
+		if (ready)
+			scaled->m_texture = nullptr;
+		if (scaled->m_bitmap->width() == dwidth && scaled->m_bitmap->height() == dheight)
+			exact = scaled.get();
+		else if (ready && (previous == nullptr || scaled->m_lastuse > previous->m_lastuse))
+			previous = scaled.get();
+	}
+
+	// if we don't have it, start scaling it
+	if (exact == nullptr)
+	{
+		target.m_entries.push_back(std::make_unique<entry>());
+		exact = target.m_entries.back().get();
+		exact->m_bucket = &target;
+		exact->m_bitmap = std::make_unique<bitmap_argb32>(dwidth, dheight);
+		exact->m_seqid = ++m_curseq;
+		exact->m_lastuse = m_lookups;
+		exact->m_ready = false;
+		exact->m_texture = &texture;
+		exact->m_scaler = texture.m_scaler;
+		exact->m_param = texture.m_param;
+		exact->m_source = (texture.m_bitmap != nullptr) ? &downcast<bitmap_argb32 &>(*texture.m_bitmap) : nullptr;
+		exact->m_sbounds = texture.m_sbounds;
+		m_used += UINT64(exact->m_bitmap->rowbytes()) * dheight;
+
+		// with nothing else to show, there's no point waiting for a worker
+		if (m_queue != nullptr && previous != nullptr)
+			osd_work_item_queue(m_queue, scale_work, exact, WORK_ITEM_FLAG_AUTO_RELEASE);
+		else
+			scale_work(exact, 0);
+	}
+
+	// a size queued earlier may have had its fallback thrown out since
+	else if (!exact->m_ready && previous == nullptr)
+		while (!osd_work_queue_wait(m_queue, 10 * osd_ticks_per_second())) { }
+
+	entry *result = exact->m_ready ? exact : previous;
+	result->m_lastuse = m_lookups;
+	trim(primlist, exact, result);
+	return result;
+}
+
+
+//-------------------------------------------------
+//  wait - finish any scaling that uses a texture's
+//  scaler, before it goes away
+//-------------------------------------------------
+
+void render_scale_cache::wait(render_texture &texture)
+{
+	assert(texture.m_cachebucket != nullptr);
+
+	for (auto &scaled : texture.m_cachebucket->m_entries)
+		if (scaled->m_texture == &texture)
+		{
+			if (!scaled->m_ready)
+				while (!osd_work_queue_wait(m_queue, 10 * osd_ticks_per_second())) { }
+			scaled->m_texture = nullptr;
+		}
+}
+
+
+//-------------------------------------------------
+//  trim - free the least recently used bitmaps
+//  until we're within budget
+//-------------------------------------------------
+
+void render_scale_cache::trim(render_primitive_list &primlist, entry *keep1, entry *keep2)
+{
+	while (m_used > m_budget)
+	{
+		// find the oldest bitmap nobody is waiting for or drawing right now
+		entry *oldest = nullptr;
+		for (auto &slot : m_buckets)
+			for (auto &scaled : slot.second.m_entries)
+				if (scaled.get() != keep1 && scaled.get() != keep2 && scaled->m_ready && !primlist.has_reference(scaled->m_bitmap.get()))
+					if (oldest == nullptr || scaled->m_lastuse < oldest->m_lastuse)
+						oldest = scaled.get();
+		if (oldest == nullptr)
+			break;
+
+		// throw it out
+		m_manager.invalidate_all(oldest->m_bitmap.get());
+		m_used -= UINT64(oldest->m_bitmap->rowbytes()) * oldest->m_bitmap->height();
+		auto &entries = oldest->m_bucket->m_entries;
+		for (auto it = entries.begin(); it != entries.end(); ++it)
+			if (it->get() == oldest)
+			{
+				entries.erase(it);
+				break;
+			}
+	}
+}
+
+
+//-------------------------------------------------
+//  scale_work - scale one entry; called on a
+//  worker thread when there's a queue
+//-------------------------------------------------
+
+void *render_scale_cache::scale_work(void *param, int threadid)
+{
+	entry &scaled = *reinterpret_cast<entry *>(param);
+
+	bitmap_argb32 dummy;
+	(*scaled.m_scaler)(*scaled.m_bitmap, (scaled.m_source != nullptr) ? *scaled.m_source : dummy, scaled.m_sbounds, scaled.m_param);
+	scaled.m_ready = true;
+	return nullptr;
+}
+
+
+
 //**************************************************************************
 //  RENDER CONTAINER
 //**************************************************************************
@@ -2591,6 +2805,7 @@ done:
 
 render_manager::render_manager(running_machine &machine)
 	: m_machine(machine),
+		m_scale_cache(std::make_unique<render_scale_cache>(*this, UINT64(machine.options().artwork_cache()) << 20)),
 		m_ui_target(nullptr),
 		m_live_textures(0),
 		m_ui_container(global_alloc(render_container(*this)))
@@ -49,7 +49,9 @@
 //#include "osdepend.h"
 
 #include <math.h>
+#include <atomic>
 #include <mutex>
+#include <unordered_map>
 
 #include "emu.h"
 //#include "bitmap.h"
@@ -165,6 +167,7 @@ class render_font;
 struct object_transform;
 class layout_element;
 class layout_view;
+class render_texture;
 
 
 // texture scaling callback
@@ -415,6 +418,67 @@ private:
 };
 
 
+// ======================> render_scale_cache
+
+// a render_scale_cache holds scaled copies of textures whose contents are
+// named by a key, so every texture with the same key shares them; missing
+// sizes are scaled on worker threads while the last size ready is drawn
+class render_scale_cache
+{
+	friend class render_texture;
+
+public:
+	// construction/destruction
+	render_scale_cache(render_manager &manager, UINT64 budget);
+	~render_scale_cache();
+
+	// getters
+	bool enabled() const { return m_budget != 0; }
+
+private:
+	struct bucket;
+
+	// a single scaled size of a keyed texture
+	struct entry
+	{
+		bucket *            m_bucket;               // bucket we belong to
+		std::unique_ptr<bitmap_argb32> m_bitmap;    // scaled bitmap
+		UINT32              m_seqid;                // sequence number for the OSD
+		UINT32              m_lastuse;              // lookup count when last drawn
+		std::atomic<bool>   m_ready;                // set by the worker when scaled
+
+		// scaling parameters; m_texture is cleared once we see m_ready
+		render_texture *    m_texture;              // texture that asked for this size
+		texture_scaler_func m_scaler;               // scaling callback
+		void *              m_param;                // scaling callback parameter
+		bitmap_argb32 *     m_source;               // source bitmap, if any
+		rectangle           m_sbounds;              // source bounds
+	};
+
+	// all the sizes for one key
+	struct bucket
+	{
+		std::vector<std::unique_ptr<entry>> m_entries;
+	};
+
+	// internal helpers
+	bucket *find_bucket(const std::string &key);
+	entry *get_scaled(bucket &target, render_texture &texture, UINT32 dwidth, UINT32 dheight, render_primitive_list &primlist);
+	void wait(render_texture &texture);
+	void trim(render_primitive_list &primlist, entry *keep1, entry *keep2);
+	static void *scale_work(void *param, int threadid);
+
+	// internal state
+	render_manager &    m_manager;                  // reference to our manager
+	UINT64              m_budget;                   // bytes of scaled bitmaps to keep
+	UINT64              m_used;                     // bytes of scaled bitmaps allocated
+	UINT32              m_curseq;                   // current sequence number
+	UINT32              m_lookups;                  // number of lookups, for LRU
+	osd_work_queue *    m_queue;                    // queue for scaling
+	std::unordered_map<std::string, bucket> m_buckets; // buckets by key
+};
+
+
 // ======================> render_texture
 
 // a render_texture is used to track transformations when building an object list
@@ -425,6 +489,7 @@ class render_texture
 	friend class fixed_allocator<render_texture>;
 	friend class render_manager;
 	friend class render_target;
+	friend class render_scale_cache;
 
 	// construction/destruction
 	render_texture();
@@ -447,6 +512,10 @@ public:
 	// set any necessary aux data
 	void set_osd_data(UINT64 data) { m_osddata = data; }
 
+	// share scaled copies with other textures through the scale cache; the
+	// scaler must depend only on the key and may run on a worker thread
+	void set_cache_key(const std::string &key);
+
 	// generic high-quality bitmap scaler
 	static void hq_scale(bitmap_argb32 &dest, bitmap_argb32 &source, const rectangle &sbounds, void *param);
 
@@ -477,6 +546,7 @@ private:
 	void *              m_param;                    // scaling callback parameter
 	UINT32              m_curseq;                   // current sequence number
 	scaled_texture      m_scaled[MAX_TEXTURE_SCALES];// array of scaled variants of this texture
+	render_scale_cache::bucket *m_cachebucket;      // shared scaled variants, if keyed
 };
 
 
@@ -764,6 +834,7 @@ private:
 	simple_list<component> m_complist;      // list of components
 	int                 m_defstate;         // default state of this element
 	int                 m_maxstate;         // maximum state value for all components
+	std::string         m_cache_key;        // key for sharing scaled textures, if they can be
 	std::vector<texture>     m_elemtex;       // array of element textures used for managing the scaled bitmaps
 };
 
@@ -1073,6 +1144,7 @@ public:
 	// textures
 	render_texture *texture_alloc(texture_scaler_func scaler = nullptr, void *param = nullptr);
 	void texture_free(render_texture *texture);
+	render_scale_cache &scale_cache() const { return *m_scale_cache; }
 
 	// fonts
 	render_font *font_alloc(const char *filename = nullptr);
@@ -1095,6 +1167,7 @@ private:
 
 	// internal state
 	running_machine &               m_machine;          // reference back to the machine
+	std::unique_ptr<render_scale_cache> m_scale_cache;  // scaled textures shared by targets; outlives them
 
 	// array of live targets
 	simple_list<render_target>      m_targetlist;       // list of targets
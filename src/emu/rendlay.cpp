@@ -475,6 +475,25 @@ layout_element::layout_element(running_machine &machine, xml_data_node &elemnode
 		}
 	}
 
+	// elements made only of images, rectangles and disks look the same
+	// wherever they're used, so describe them for the scale cache
+	m_cache_key.clear();
+	for (component &curcomp : m_complist)
+	{
+		if (curcomp.m_type != component::CTYPE_IMAGE && curcomp.m_type != component::CTYPE_RECT && curcomp.m_type != component::CTYPE_DISK)
+		{
+			m_cache_key.clear();
+			break;
+		}
+		m_cache_key.append(string_format("%d:%d:%.9g,%.9g,%.9g,%.9g:%.9g,%.9g,%.9g,%.9g:",
+				int(curcomp.m_type), curcomp.m_state,
+				curcomp.m_bounds.x0, curcomp.m_bounds.y0, curcomp.m_bounds.x1, curcomp.m_bounds.y1,
+				curcomp.m_color.a, curcomp.m_color.r, curcomp.m_color.g, curcomp.m_color.b));
+		if (curcomp.m_type == component::CTYPE_IMAGE)
+			m_cache_key.append(curcomp.m_dirname).append("/").append(curcomp.m_imagefile[0]).append("/").append(curcomp.m_alphafile[0]);
+		m_cache_key.append(";");
+	}
+
 	// allocate an array of element textures for the states
 	m_elemtex.resize(m_maxstate + 1);
 }
@@ -503,6 +522,15 @@ render_texture *layout_element::state_texture(int state)
 		m_elemtex[state].m_element = this;
 		m_elemtex[state].m_state = state;
 		m_elemtex[state].m_texture = machine().render().texture_alloc(element_scale, &m_elemtex[state]);
+
+		// load images now so the scale cache's workers only ever read them
+		if (!m_cache_key.empty() && machine().render().scale_cache().enabled())
+		{
+			for (component &curcomp : m_complist)
+				if (curcomp.m_type == component::CTYPE_IMAGE && !curcomp.m_bitmap[0].valid())
+					curcomp.load_bitmap();
+			m_elemtex[state].m_texture->set_cache_key(string_format("%s#%d", m_cache_key, state));
+		}
 	}
 	return m_elemtex[state].m_texture;
 }
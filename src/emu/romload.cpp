@@ -24,6 +24,15 @@
 
 #define TEMPBUFFER_MAX_SIZE     (1024 * 1024 * 1024)
 
+/* regions at least this big have ROM files mapped into them where possible */
+#define MAPPED_REGION_MIN_SIZE  (1024 * 1024)
+
+/* how far ahead of the loader the prefetch workers may get, in bytes */
+#define PREFETCH_WINDOW         (256 * 1024 * 1024)
+
+/* size of the pieces files are hashed in by the prefetch workers */
+#define PREFETCH_HASH_CHUNK     (1024 * 1024)
+
 /***************************************************************************
     HELPERS (also used by diimage.cpp)
  ***************************************************************************/
@@ -415,7 +424,7 @@ void rom_load_manager::dump_wrong_and_correct_checksums(const hash_collection &h
     and hash signatures of a file
 -------------------------------------------------*/
 
-void rom_load_manager::verify_length_and_hash(const char *name, UINT32 explength, const hash_collection &hashes)
+void rom_load_manager::verify_length_and_hash(const char *name, UINT32 explength, const hash_collection &hashes, const UINT8 *verbatim)
 {
 	/* we've already complained if there is no file */
 	if (m_file == nullptr)
@@ -429,8 +438,18 @@ void rom_load_manager::verify_length_and_hash(const char *name, UINT32 explength
 		m_warnings++;
 	}
 
+	/* use the hashes from prefetching, or hash a verbatim copy of the whole file in the region
+	   in place, rather than reading the file into memory again */
+	hash_collection regionhashes;
+	const hash_collection *known = m_filehashes;
+	if (known == nullptr && verbatim != nullptr && explength == actlength)
+	{
+		regionhashes.compute(verbatim, actlength, hashes.hash_types().c_str());
+		known = &regionhashes;
+	}
+	const hash_collection &acthashes = (known != nullptr) ? *known : m_file->hashes(hashes.hash_types().c_str());
+
 	/* If there is no good dump known, write it */
-	hash_collection &acthashes = m_file->hashes(hashes.hash_types().c_str());
 	if (hashes.flag(hash_collection::FLAG_NO_DUMP))
 	{
 		m_errorstring.append(string_format("%s NO GOOD DUMP KNOWN\n", name));
@@ -542,35 +561,32 @@ void rom_load_manager::region_post_process(const char *rgntag, bool invert)
 
 
 /*-------------------------------------------------
-    open_rom_file - open a ROM file, searching
-    up the parent and loading by checksum
+    find_rom_file - search for a ROM file up the
+    parent chain and by checksum; this is safe to
+    call from the prefetch worker threads
 -------------------------------------------------*/
 
-int rom_load_manager::open_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names, bool from_list)
+std::unique_ptr<emu_file> rom_load_manager::find_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names) const
 {
 	osd_file::error filerr = osd_file::error::NOT_FOUND;
-	UINT32 romsize = rom_file_size(romp);
 	tried_file_names = "";
 
-	/* update status display */
-	display_loading_rom_message(ROM_GETNAME(romp), from_list);
-
 	/* extract CRC to use for searching */
 	UINT32 crc = 0;
 	bool has_crc = hash_collection(ROM_GETHASHDATA(romp)).crc(crc);
 
 	/* attempt reading up the chain through the parents. It automatically also
 	 attempts any kind of load by checksum supported by the archives. */
-	m_file = nullptr;
-	for (int drv = driver_list::find(machine().system()); m_file == nullptr && drv != -1; drv = driver_list::clone(drv)) {
+	std::unique_ptr<emu_file> file;
+	for (int drv = driver_list::find(machine().system()); file == nullptr && drv != -1; drv = driver_list::clone(drv)) {
 		if (tried_file_names.length() != 0)
 			tried_file_names += " ";
 		tried_file_names += driver_list::driver(drv).name;
-		m_file = common_process_file(machine().options(), driver_list::driver(drv).name, has_crc, crc, romp, filerr);
+		file = common_process_file(machine().options(), driver_list::driver(drv).name, has_crc, crc, romp, filerr);
 	}
 
 	/* if the region is load by name, load the ROM from there */
-	if (m_file == nullptr && regiontag != nullptr)
+	if (file == nullptr && regiontag != nullptr)
 	{
 		// check if we are dealing with softwarelists. if so, locationtag
 		// is actually a concatenation of: listname + setname + parentname
@@ -619,43 +635,121 @@ int rom_load_manager::open_rom_file(const char *regiontag, const rom_entry *romp
 		if (!is_list)
 		{
 			tried_file_names += " " + tag1;
-			m_file = common_process_file(machine().options(), tag1.c_str(), has_crc, crc, romp, filerr);
+			file = common_process_file(machine().options(), tag1.c_str(), has_crc, crc, romp, filerr);
 		}
 		else
 		{
 			// try to load from list/setname
-			if ((m_file == nullptr) && (tag2.c_str() != nullptr))
+			if ((file == nullptr) && (tag2.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag2;
-				m_file = common_process_file(machine().options(), tag2.c_str(), has_crc, crc, romp, filerr);
+				file = common_process_file(machine().options(), tag2.c_str(), has_crc, crc, romp, filerr);
 			}
 			// try to load from list/parentname
-			if ((m_file == nullptr) && has_parent && (tag3.c_str() != nullptr))
+			if ((file == nullptr) && has_parent && (tag3.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag3;
-				m_file = common_process_file(machine().options(), tag3.c_str(), has_crc, crc, romp, filerr);
+				file = common_process_file(machine().options(), tag3.c_str(), has_crc, crc, romp, filerr);
 			}
 			// try to load from setname
-			if ((m_file == nullptr) && (tag4.c_str() != nullptr))
+			if ((file == nullptr) && (tag4.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag4;
-				m_file = common_process_file(machine().options(), tag4.c_str(), has_crc, crc, romp, filerr);
+				file = common_process_file(machine().options(), tag4.c_str(), has_crc, crc, romp, filerr);
 			}
 			// try to load from parentname
-			if ((m_file == nullptr) && has_parent && (tag5.c_str() != nullptr))
+			if ((file == nullptr) && has_parent && (tag5.c_str() != nullptr))
 			{
 				tried_file_names += " " + tag5;
-				m_file = common_process_file(machine().options(), tag5.c_str(), has_crc, crc, romp, filerr);
+				file = common_process_file(machine().options(), tag5.c_str(), has_crc, crc, romp, filerr);
 			}
 		}
 	}
 
+	return file;
+}
+
+
+/*-------------------------------------------------
+    open_rom_file - open a ROM file, searching
+    up the parent and loading by checksum
+-------------------------------------------------*/
+
+int rom_load_manager::open_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names, bool from_list)
+{
+	UINT32 romsize = rom_file_size(romp);
+
+	/* update status display */
+	display_loading_rom_message(ROM_GETNAME(romp), from_list);
+
+	/* take the file from the prefetch workers if they have it, otherwise search now */
+	prefetch_entry *entry = collect_prefetch(romp);
+	if (entry != nullptr)
+	{
+		m_file = std::move(entry->file);
+		tried_file_names = entry->tried_file_names;
+		m_filehashes = (m_file != nullptr) ? &entry->hashes : nullptr;
+	}
+	else
+	{
+		m_file = find_rom_file(regiontag, romp, tried_file_names);
+		m_filehashes = nullptr;
+	}
+
 	/* update counters */
 	m_romsloaded++;
 	m_romsloadedsize += romsize;
 
 	/* return the result */
-	return (filerr == osd_file::error::NONE);
+	return (m_file != nullptr);
+}
+
+
+/*-------------------------------------------------
+    rom_is_verbatim - true if a ROM entry copies
+    file data straight into its region
+-------------------------------------------------*/
+
+static inline bool rom_is_verbatim(const rom_entry *romp)
+{
+	int datamask = ((1 << ROM_GETBITWIDTH(romp)) - 1) << ROM_GETBITSHIFT(romp);
+	return datamask == 0xff && (ROM_GETGROUPSIZE(romp) == 1 || !ROM_ISREVERSED(romp)) && ROM_GETSKIPCOUNT(romp) == 0;
+}
+
+
+/*-------------------------------------------------
+    region_is_mappable - true if ROM files can be
+    mapped into a region instead of read
+-------------------------------------------------*/
+
+static inline bool region_is_mappable(const rom_entry *region, UINT8 width, endianness_t endianness)
+{
+	/* inverting or byte swapping would copy every page anyway */
+	return ROMREGION_GETLENGTH(region) >= MAPPED_REGION_MIN_SIZE && !ROMREGION_ISINVERTED(region) && (width == 1 || endianness == ENDIANNESS_NATIVE);
+}
+
+
+/*-------------------------------------------------
+    rom_fmap - map file data into the region
+    rather than reading it, if possible; the
+    pages stay shared with the OS file cache
+    until something writes to them
+-------------------------------------------------*/
+
+bool rom_load_manager::rom_fmap(UINT8 *buffer, UINT32 length)
+{
+	if (m_file == nullptr || !m_region->mappable())
+		return false;
+
+	/* both ends must be page aligned, except that a partial last page may overhang the end of the region */
+	size_t const granularity = osd_map_granularity();
+	UINT32 const offset = buffer - m_region->base();
+	if ((offset % granularity) != 0 || (m_file->tell() % granularity) != 0)
+		return false;
+	if ((length % granularity) != 0 && (offset + length) != m_region->bytes())
+		return false;
+
+	return m_file->map(buffer, length) == osd_file::error::NONE;
 }
 
 
@@ -710,9 +804,9 @@ int rom_load_manager::read_rom_data(const rom_entry *parent_region, const rom_en
 	if (numbytes == 0)
 		fatalerror("Error in RomModule definition: %s has an invalid length\n", ROM_GETNAME(romp));
 
-	/* special case for simple loads */
-	if (datamask == 0xff && (groupsize == 1 || !reversed) && skip == 0)
-		return rom_fread(base, numbytes, parent_region);
+	/* special case for simple loads, which can often skip the copy entirely */
+	if (rom_is_verbatim(romp))
+		return rom_fmap(base, numbytes) ? numbytes : rom_fread(base, numbytes, parent_region);
 
 	/* use a temporary buffer for complex loads */
 	tempbufsize = MIN(TEMPBUFFER_MAX_SIZE, numbytes);
@@ -893,6 +987,7 @@ void rom_load_manager::process_rom_entries(const char *regiontag, const rom_entr
 		{
 			int irrelevantbios = (ROM_GETBIOSFLAGS(romp) != 0 && ROM_GETBIOSFLAGS(romp) != device->system_bios());
 			const rom_entry *baserom = romp;
+			const UINT8 *verbatim = nullptr;
 			int explength = 0;
 
 			/* open the file if it is a non-BIOS or matches the current BIOS */
@@ -918,6 +1013,10 @@ void rom_load_manager::process_rom_entries(const char *regiontag, const rom_entr
 
 					explength += ROM_GETLENGTH(&modified_romp);
 
+					/* a file loaded by a single verbatim entry can be hashed from the region */
+					bool const single = (baserom == romp - 1) && !ROMENTRY_ISCONTINUE(romp) && !ROMENTRY_ISIGNORE(romp);
+					verbatim = (single && !irrelevantbios && rom_is_verbatim(&modified_romp)) ? m_region->base() + ROM_GETOFFSET(&modified_romp) : nullptr;
+
 					/* attempt to read using the modified entry */
 					if (!ROMENTRY_ISIGNORE(&modified_romp) && !irrelevantbios)
 						/*readresult = */read_rom_data(parent_region, &modified_romp);
@@ -928,7 +1027,7 @@ void rom_load_manager::process_rom_entries(const char *regiontag, const rom_entr
 				if (baserom)
 				{
 					LOG(("Verifying length (%X) and checksums\n", explength));
-					verify_length_and_hash(ROM_GETNAME(baserom), explength, hash_collection(ROM_GETHASHDATA(baserom)));
+					verify_length_and_hash(ROM_GETNAME(baserom), explength, hash_collection(ROM_GETHASHDATA(baserom)), verbatim);
 					LOG(("Verify finished\n"));
 				}
 
@@ -1332,15 +1431,15 @@ void rom_load_manager::load_software_part_region(device_t &device, software_list
 		}
 
 		/* remember the base and length */
-		m_region = machine().memory().region_alloc(regiontag.c_str(), regionlength, width, endianness);
+		m_region = machine().memory().region_alloc(regiontag.c_str(), regionlength, width, endianness, region_is_mappable(region, width, endianness));
 		LOG(("Allocated %X bytes @ %p\n", m_region->bytes(), m_region->base()));
 
 		/* clear the region if it's requested */
 		if (ROMREGION_ISERASE(region))
 			memset(m_region->base(), ROMREGION_GETERASEVAL(region), m_region->bytes());
 
-		/* or if it's sufficiently small (<= 4MB) */
-		else if (m_region->bytes() <= 0x400000)
+		/* or if it's sufficiently small (<= 4MB); mappable regions start out clear */
+		else if (m_region->bytes() <= 0x400000 && !m_region->mappable())
 			memset(m_region->base(), 0, m_region->bytes());
 
 #ifdef MAME_DEBUG
@@ -1375,6 +1474,169 @@ void rom_load_manager::load_software_part_region(device_t &device, software_list
 }
 
 
+/*-------------------------------------------------
+    set_is_7z - true if a set is stored as a 7z
+    archive anywhere on the ROM path
+-------------------------------------------------*/
+
+static bool set_is_7z(emu_options &options, const char *name)
+{
+	emu_file file(options.media_path(), OPEN_FLAG_READ);
+	return file.open(name, ".7z") == osd_file::error::NONE;
+}
+
+
+/*-------------------------------------------------
+    start_prefetch - list every ROM file the
+    machine will load, in order, and start worker
+    threads opening, decompressing and hashing
+    them
+-------------------------------------------------*/
+
+void rom_load_manager::start_prefetch()
+{
+	/* 7z sets are usually solid: fetching their files in parallel would decode the same blocks on
+	   every worker, so files that may come from one are fetched one at a time, in order */
+	bool system_solid = false;
+	for (int drv = driver_list::find(machine().system()); drv != -1; drv = driver_list::clone(drv))
+		system_solid = system_solid || set_is_7z(machine().options(), driver_list::driver(drv).name);
+
+	for (device_t &device : device_iterator(machine().root_device()))
+	{
+		bool const solid = system_solid || set_is_7z(machine().options(), device.shortname());
+		for (const rom_entry *region = rom_first_region(device); region != nullptr; region = rom_next_region(region))
+			if (ROMREGION_ISROMDATA(region))
+				for (const rom_entry *rom = rom_first_file(region); rom != nullptr; rom = rom_next_file(rom))
+					if (ROM_GETBIOSFLAGS(rom) == 0 || ROM_GETBIOSFLAGS(rom) == device.system_bios())
+					{
+						prefetch_entry entry;
+						entry.manager = this;
+						entry.romp = rom;
+						entry.location = device.shortname();
+						entry.length = rom_file_size(rom);
+						entry.solid = solid;
+						entry.item = nullptr;
+						entry.ticks = 0;
+						m_prefetch.push_back(std::move(entry));
+					}
+	}
+
+	m_prefetch_queue.reset(osd_work_queue_alloc(WORK_QUEUE_FLAG_IO | WORK_QUEUE_FLAG_MULTI));
+	queue_prefetch();
+}
+
+
+/*-------------------------------------------------
+    queue_prefetch - hand the workers as many
+    files as fit in the window ahead of the loader
+-------------------------------------------------*/
+
+void rom_load_manager::queue_prefetch()
+{
+	/* the next file the loader wants is always queued, however big it is */
+	while (m_prefetch_queued < m_prefetch.size() && (m_prefetch_queued <= m_prefetch_next || m_prefetch_pending < PREFETCH_WINDOW))
+	{
+		/* files that may share a solid archive wait for the one before */
+		prefetch_entry &entry = m_prefetch[m_prefetch_queued];
+		if (entry.solid && m_prefetch_solid != nullptr && m_prefetch_solid->item != nullptr && !osd_work_item_wait(m_prefetch_solid->item, 0))
+			break;
+		if (entry.solid)
+			m_prefetch_solid = &entry;
+
+		m_prefetch_queued++;
+		m_prefetch_pending += entry.length;
+		entry.item = osd_work_item_queue(m_prefetch_queue.get(), prefetch_work, &entry, 0);
+
+		/* without a work item, do the work here */
+		if (entry.item == nullptr)
+			prefetch_work(&entry, 0);
+	}
+}
+
+
+/*-------------------------------------------------
+    collect_prefetch - wait for the workers to
+    finish with the given ROM, if it was handed
+    to them
+-------------------------------------------------*/
+
+rom_load_manager::prefetch_entry *rom_load_manager::collect_prefetch(const rom_entry *romp)
+{
+	/* files are collected in the order they were listed; anything else is loaded directly */
+	if (m_prefetch_next >= m_prefetch.size() || m_prefetch[m_prefetch_next].romp != romp)
+		return nullptr;
+	prefetch_entry &entry = m_prefetch[m_prefetch_next++];
+	m_prefetch_pending -= entry.length;
+
+	/* keep the workers ahead of us before waiting, which may mean waiting out a solid archive first */
+	queue_prefetch();
+	if (m_prefetch_queued < m_prefetch_next)
+	{
+		while (m_prefetch_solid->item != nullptr && !osd_work_item_wait(m_prefetch_solid->item, 10 * osd_ticks_per_second())) { }
+		queue_prefetch();
+	}
+	if (entry.item != nullptr)
+	{
+		while (!osd_work_item_wait(entry.item, 10 * osd_ticks_per_second())) { }
+		osd_work_item_release(entry.item);
+		entry.item = nullptr;
+	}
+	m_prefetch_ticks += entry.ticks;
+	return &entry;
+}
+
+
+/*-------------------------------------------------
+    finish_prefetch - stop the workers and free
+    anything the loader didn't collect
+-------------------------------------------------*/
+
+void rom_load_manager::finish_prefetch()
+{
+	if (m_prefetch_queue)
+	{
+		while (!osd_work_queue_wait(m_prefetch_queue.get(), 10 * osd_ticks_per_second())) { }
+		for (prefetch_entry &entry : m_prefetch)
+			if (entry.item != nullptr)
+				osd_work_item_release(entry.item);
+		m_prefetch_queue.reset();
+	}
+
+	m_prefetch.clear();
+	m_prefetch_queued = m_prefetch_next = 0;
+	m_prefetch_pending = 0;
+	m_prefetch_solid = nullptr;
+	m_filehashes = nullptr;
+}
+
+
+/*-------------------------------------------------
+    prefetch_work - open a ROM file, which
+    decompresses archived files, and hash it
+-------------------------------------------------*/
+
+void *rom_load_manager::prefetch_work(void *param, int threadid)
+{
+	prefetch_entry &entry = *reinterpret_cast<prefetch_entry *>(param);
+	osd_ticks_t const start = osd_ticks();
+
+	entry.file = entry.manager->find_rom_file(entry.location, entry.romp, entry.tried_file_names);
+	if (entry.file != nullptr)
+	{
+		/* hash in pieces rather than reading plain files into memory, then rewind for the loader */
+		std::vector<UINT8> buffer(PREFETCH_HASH_CHUNK);
+		entry.hashes.begin(hash_collection(ROM_GETHASHDATA(entry.romp)).hash_types().c_str());
+		for (UINT32 actual; (actual = entry.file->read(&buffer[0], buffer.size())) != 0; )
+			entry.hashes.buffer(&buffer[0], actual);
+		entry.hashes.end();
+		entry.file->seek(0, SEEK_SET);
+	}
+
+	entry.ticks = osd_ticks() - start;
+	return nullptr;
+}
+
+
 /*-------------------------------------------------
     process_region_list - process a region list
 -------------------------------------------------*/
@@ -1382,6 +1644,10 @@ void rom_load_manager::load_software_part_region(device_t &device, software_list
 void rom_load_manager::process_region_list()
 {
 	std::string regiontag;
+	osd_ticks_t const start = osd_ticks();
+
+	/* get the workers going on the files before the regions need them */
+	start_prefetch();
 
 	/* loop until we hit the end */
 	device_iterator deviter(machine().root_device());
@@ -1405,15 +1671,15 @@ void rom_load_manager::process_region_list()
 					normalize_flags_for_device(machine(), regiontag.c_str(), width, endianness);
 
 				/* remember the base and length */
-				m_region = machine().memory().region_alloc(regiontag.c_str(), regionlength, width, endianness);
+				m_region = machine().memory().region_alloc(regiontag.c_str(), regionlength, width, endianness, region_is_mappable(region, width, endianness));
 				LOG(("Allocated %X bytes @ %p\n", m_region->bytes(), m_region->base()));
 
 				/* clear the region if it's requested */
 				if (ROMREGION_ISERASE(region))
 					memset(m_region->base(), ROMREGION_GETERASEVAL(region), m_region->bytes());
 
-				/* or if it's sufficiently small (<= 4MB) */
-				else if (m_region->bytes() <= 0x400000)
+				/* or if it's sufficiently small (<= 4MB); mappable regions start out clear */
+				else if (m_region->bytes() <= 0x400000 && !m_region->mappable())
 					memset(m_region->base(), 0, m_region->bytes());
 
 #ifdef MAME_DEBUG
@@ -1429,6 +1695,13 @@ void rom_load_manager::process_region_list()
 				process_disk_entries(regiontag.c_str(), region, region + 1, nullptr);
 		}
 
+	/* every file has been collected by now */
+	UINT32 const prefetched = m_prefetch_next;
+	finish_prefetch();
+	osd_printf_verbose("Loaded %d ROM files (%u prefetched) in %.1f ms; prefetch workers were busy for %.1f ms\n",
+		m_romsloaded, prefetched, 1000.0 * double(osd_ticks() - start) / double(osd_ticks_per_second()),
+		1000.0 * double(m_prefetch_ticks) / double(osd_ticks_per_second()));
+
 	/* now go back and post-process all the regions */
 	for (device_t &device : deviter)
 		for (const rom_entry *region = rom_first_region(device); region != nullptr; region = rom_next_region(region))
@@ -1453,7 +1726,13 @@ void rom_load_manager::process_region_list()
 -------------------------------------------------*/
 
 rom_load_manager::rom_load_manager(running_machine &machine)
-	: m_machine(machine)
+	: m_machine(machine),
+		m_filehashes(nullptr),
+		m_prefetch_queued(0),
+		m_prefetch_next(0),
+		m_prefetch_pending(0),
+		m_prefetch_solid(nullptr),
+		m_prefetch_ticks(0)
 {
 	/* figure out which BIOS we are using */
 
@@ -280,6 +280,21 @@ class rom_load_manager
 		chd_file            m_diffchd;              /* handle to the diff CHD */
 	};
 
+	/* a ROM file opened, decompressed and hashed ahead of time on a worker thread */
+	struct prefetch_entry
+	{
+		rom_load_manager *          manager;
+		const rom_entry *           romp;           /* ROM to fetch */
+		const char *                location;       /* device shortname to search under */
+		UINT32                      length;         /* expected size of the file */
+		bool                        solid;          /* may come from a 7z, so fetch in order */
+		osd_work_item *             item;           /* work item, until collected */
+		std::unique_ptr<emu_file>   file;           /* the file, if it was found */
+		std::string                 tried_file_names;
+		hash_collection             hashes;         /* hashes of the whole file */
+		osd_ticks_t                 ticks;          /* time the worker spent on it */
+	};
+
 public:
 	// construction/destruction
 	rom_load_manager(running_machine &machine);
@@ -311,11 +326,13 @@ private:
 	void fill_random(UINT8 *base, UINT32 length);
 	void handle_missing_file(const rom_entry *romp, std::string tried_file_names, chd_error chderr);
 	void dump_wrong_and_correct_checksums(const hash_collection &hashes, const hash_collection &acthashes);
-	void verify_length_and_hash(const char *name, UINT32 explength, const hash_collection &hashes);
+	void verify_length_and_hash(const char *name, UINT32 explength, const hash_collection &hashes, const UINT8 *verbatim);
 	void display_loading_rom_message(const char *name, bool from_list);
 	void display_rom_load_results(bool from_list);
 	void region_post_process(const char *rgntag, bool invert);
+	std::unique_ptr<emu_file> find_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names) const;
 	int open_rom_file(const char *regiontag, const rom_entry *romp, std::string &tried_file_names, bool from_list);
+	bool rom_fmap(UINT8 *buffer, UINT32 length);
 	int rom_fread(UINT8 *buffer, int length, const rom_entry *parent_region);
 	int read_rom_data(const rom_entry *parent_region, const rom_entry *romp);
 	void fill_rom_data(const rom_entry *romp);
@@ -324,6 +341,11 @@ private:
 	chd_error open_disk_diff(emu_options &options, const rom_entry *romp, chd_file &source, chd_file &diff_chd);
 	void process_disk_entries(const char *regiontag, const rom_entry *parent_region, const rom_entry *romp, const char *locationtag);
 	void normalize_flags_for_device(running_machine &machine, const char *rgntag, UINT8 &width, endianness_t &endian);
+	void start_prefetch();
+	void queue_prefetch();
+	prefetch_entry *collect_prefetch(const rom_entry *romp);
+	void finish_prefetch();
+	static void *prefetch_work(void *param, int threadid);
 	void process_region_list();
 
 
@@ -340,12 +362,23 @@ private:
 	UINT32          m_romstotalsize;      /* total size of ROMs to read */
 
 	std::unique_ptr<emu_file>  m_file;               /* current file */
+	const hash_collection *    m_filehashes;         /* hashes of the current file, if already known */
 	std::vector<std::unique_ptr<open_chd>> m_chd_list;     /* disks */
 
 	memory_region * m_region;             /* info about current region */
 
 	std::string     m_errorstring;        /* error string */
 	std::string     m_softwarningstring;  /* software warning string */
+
+	struct work_queue_deleter { void operator()(osd_work_queue *queue) const { osd_work_queue_free(queue); } };
+
+	std::vector<prefetch_entry> m_prefetch;           /* ROM files in the order they are loaded */
+	std::unique_ptr<osd_work_queue, work_queue_deleter> m_prefetch_queue; /* worker threads, stopped before the entries go */
+	size_t                      m_prefetch_queued;    /* entries handed to the workers */
+	size_t                      m_prefetch_next;      /* next entry the loader will collect */
+	UINT64                      m_prefetch_pending;   /* bytes queued but not yet collected */
+	prefetch_entry *            m_prefetch_solid;     /* last entry queued that may come from a 7z */
+	osd_ticks_t                 m_prefetch_ticks;     /* total time spent by the workers */
 };
 
 
@@ -121,6 +121,27 @@ void save_manager::register_presave(save_prepost_delegate func)
 }
 
 
+//-------------------------------------------------
+//  register_preload - register a pre-load
+//  function callback
+//-------------------------------------------------
+
+void save_manager::register_preload(save_prepost_delegate func)
+{
+	// check for invalid timing
+	if (!m_reg_allowed)
+		fatalerror("Attempt to register callback function after state registration is closed!\n");
+
+	// scan for duplicates and push through to the end
+	for (state_callback &cb : m_preload_list)
+		if (cb.m_func == func)
+			fatalerror("Duplicate save state function (%s/%s)\n", cb.m_func.name(), func.name());
+
+	// allocate a new entry
+	m_preload_list.append(*global_alloc(state_callback(func)));
+}
+
+
 //-------------------------------------------------
 //  state_save_register_postload -
 //  register a post-load function callback
@@ -213,6 +234,17 @@ save_error save_manager::check_file(running_machine &machine, emu_file &file, co
 	return validate_header(header, gamename, sig, errormsg, "");
 }
 
+//-------------------------------------------------
+//  dispatch_preload - invoke all registered
+//  preload callbacks before state is replaced
+//-------------------------------------------------
+
+void save_manager::dispatch_preload()
+{
+	for (state_callback &func : m_preload_list)
+		func.m_func();
+}
+
 //-------------------------------------------------
 //  dispatch_postload - invoke all registered
 //  postload callbacks for updates
@@ -251,6 +283,9 @@ save_error save_manager::read_file(emu_file &file)
 	// determine whether or not to flip the data when done
 	bool flip = NATIVE_ENDIAN_VALUE_LE_BE((header[9] & SS_MSB_FIRST) != 0, (header[9] & SS_MSB_FIRST) == 0);
 
+	// call the pre-load functions
+	dispatch_preload();
+
 	// read all the data, flipping if necessary
 	for (state_entry &entry : m_entry_list)
 	{
@@ -321,6 +356,82 @@ save_error save_manager::write_file(emu_file &file)
 }
 
 
+//-------------------------------------------------
+//  write_buffer - write the data to memory,
+//  prefixed by the registration signature; there
+//  is no header, so the image is only valid for
+//  the running system
+//-------------------------------------------------
+
+save_error save_manager::write_buffer(std::vector<UINT8> &data)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// call the pre-save functions
+	dispatch_presave();
+
+	// size the buffer once and copy everything in
+	size_t total = sizeof(UINT32);
+	for (state_entry &entry : m_entry_list)
+		total += entry.m_typesize * entry.m_typecount;
+	data.resize(total);
+
+	UINT32 sig = LITTLE_ENDIANIZE_INT32(signature());
+	memcpy(&data[0], &sig, sizeof(sig));
+	UINT8 *dest = &data[sizeof(sig)];
+	for (state_entry &entry : m_entry_list)
+	{
+		UINT32 totalsize = entry.m_typesize * entry.m_typecount;
+		memcpy(dest, entry.m_data, totalsize);
+		dest += totalsize;
+	}
+	return STATERR_NONE;
+}
+
+
+//-------------------------------------------------
+//  read_buffer - read data written by
+//  write_buffer
+//-------------------------------------------------
+
+save_error save_manager::read_buffer(const UINT8 *data, size_t length)
+{
+	// if we have illegal registrations, return an error
+	if (m_illegal_regs > 0)
+		return STATERR_ILLEGAL_REGISTRATIONS;
+
+	// the signature and total size must match exactly
+	size_t total = sizeof(UINT32);
+	for (state_entry &entry : m_entry_list)
+		total += entry.m_typesize * entry.m_typecount;
+	UINT32 sig;
+	if (length != total)
+		return STATERR_INVALID_HEADER;
+	memcpy(&sig, data, sizeof(sig));
+	if (LITTLE_ENDIANIZE_INT32(sig) != signature())
+		return STATERR_INVALID_HEADER;
+
+	// call the pre-load functions
+	dispatch_preload();
+
+	// copy everything out
+	const UINT8 *src = data + sizeof(sig);
+	for (state_entry &entry : m_entry_list)
+	{
+		UINT32 totalsize = entry.m_typesize * entry.m_typecount;
+		memcpy(entry.m_data, src, totalsize);
+		src += totalsize;
+	}
+
+	// call the post-load functions
+	dispatch_postload();
+
+	return STATERR_NONE;
+}
+
+
 //-------------------------------------------------
 //  signature - compute the signature, which
 //  is a CRC over the structure of the data
@@ -29,7 +29,8 @@ enum save_error
 	STATERR_ILLEGAL_REGISTRATIONS,
 	STATERR_INVALID_HEADER,
 	STATERR_READ_ERROR,
-	STATERR_WRITE_ERROR
+	STATERR_WRITE_ERROR,
+	STATERR_PENDING_TIMERS
 };
 
 
@@ -38,7 +39,7 @@ enum save_error
 //  MACROS
 //**************************************************************************
 
-// callback delegate for presave/postload
+// callback delegate for presave/preload/postload
 typedef delegate<void ()> save_prepost_delegate;
 
 
@@ -104,10 +105,12 @@ public:
 
 	// function registration
 	void register_presave(save_prepost_delegate func);
+	void register_preload(save_prepost_delegate func);
 	void register_postload(save_prepost_delegate func);
 
 	// callback dispatching
 	void dispatch_presave();
+	void dispatch_preload();
 	void dispatch_postload();
 
 	// generic memory registration
@@ -157,6 +160,10 @@ public:
 	save_error write_file(emu_file &file);
 	save_error read_file(emu_file &file);
 
+	// in-memory images, for states embedded in other files
+	save_error write_buffer(std::vector<UINT8> &data);
+	save_error read_buffer(const UINT8 *data, size_t length);
+
 private:
 	// internal helpers
 	UINT32 signature() const;
@@ -185,6 +192,7 @@ private:
 
 	simple_list<state_entry> m_entry_list;          // list of reigstered entries
 	simple_list<state_callback> m_presave_list;     // list of pre-save functions
+	simple_list<state_callback> m_preload_list;     // list of pre-load functions
 	simple_list<state_callback> m_postload_list;    // list of post-load functions
 };
 
@@ -0,0 +1,319 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    sndlog.cpp
+
+    Sound device register write logs.
+
+    File layout; all integers past the magic and version are LEB128-style
+    varints (7 bits per byte, low group first) and strings are a varint
+    length followed by the characters:
+
+        4 bytes     "MSRL"
+        1 byte      version
+        varint      device clock
+        string      device shortname
+        string      device tag in the capturing machine
+        varint      number of device outputs
+
+    followed by records, each introduced by a type byte:
+
+        RECORD_MEMORY       varint index, byte width, byte endianness,
+                            varint length, length bytes of data
+        RECORD_WRITE        varint nanoseconds since the previous write,
+                            varint offset, varint data
+        RECORD_WRITE_MASK   as RECORD_WRITE, then varint mem_mask; later
+                            RECORD_WRITEs reuse the mask
+
+    Timestamps are kept to the nanosecond, which is finer than any sound
+    device's sample period but keeps the common record down to 4-6 bytes.
+
+***************************************************************************/
+
+#include "emu.h"
+#include "sndlog.h"
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+const UINT8 sound_log::MAGIC[4] = { 'M', 'S', 'R', 'L' };
+
+// bytes gathered before writing them out
+const size_t WRITE_CHUNK = 65536;
+
+
+
+//**************************************************************************
+//  LOG READER
+//**************************************************************************
+
+namespace {
+
+// pull a varint from a file; returns false at end of file
+bool get_varint(util::core_file &file, UINT64 &value)
+{
+	value = 0;
+	for (int shift = 0; shift < 64; shift += 7)
+	{
+		int const c = file.getc();
+		if (c == EOF)
+			return false;
+		value |= UINT64(c & 0x7f) << shift;
+		if (!(c & 0x80))
+			return true;
+	}
+	return false;
+}
+
+bool get_string(util::core_file &file, std::string &string)
+{
+	UINT64 length;
+	if (!get_varint(file, length) || length > 1024)
+		return false;
+	string.resize(length);
+	return (length == 0) || (file.read(&string[0], length) == length);
+}
+
+} // anonymous namespace
+
+
+//-------------------------------------------------
+//  sound_log - constructor
+//-------------------------------------------------
+
+sound_log::sound_log()
+	: m_clock(0),
+		m_outputs(0)
+{
+}
+
+
+//-------------------------------------------------
+//  load - read a log from a file
+//-------------------------------------------------
+
+bool sound_log::load(const char *filename, bool header_only)
+{
+	m_memory.clear();
+	m_writes.clear();
+
+	util::core_file::ptr file;
+	if (util::core_file::open(filename, OPEN_FLAG_READ, file) != osd_file::error::NONE)
+		return false;
+
+	// header
+	UINT8 magic[5];
+	if (file->read(magic, sizeof(magic)) != sizeof(magic) || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || magic[4] != VERSION)
+		return false;
+	UINT64 clock, outputs;
+	if (!get_varint(*file, clock) || !get_string(*file, m_shortname) || !get_string(*file, m_tag) || !get_varint(*file, outputs))
+		return false;
+	m_clock = UINT32(clock);
+	m_outputs = int(outputs);
+
+	// records
+	UINT64 time_ns = 0;
+	UINT32 mem_mask = 0xffffffff;
+	for (int type = file->getc(); type != EOF; type = file->getc())
+	{
+		switch (type)
+		{
+			case RECORD_MEMORY:
+			{
+				UINT64 index, length;
+				memory_block block;
+				if (!get_varint(*file, index))
+					return false;
+				block.index = int(index);
+				block.width = file->getc();
+				block.endian = endianness_t(file->getc());
+				if (!get_varint(*file, length))
+					return false;
+
+				// the header pass only needs to know which blocks are present
+				if (header_only)
+					file->seek(length, SEEK_CUR);
+				else
+				{
+					block.data.resize(length);
+					if (length != 0 && file->read(&block.data[0], length) != length)
+						return false;
+				}
+				m_memory.push_back(std::move(block));
+				break;
+			}
+
+			case RECORD_WRITE:
+			case RECORD_WRITE_MASK:
+			{
+				// memory always precedes the first write
+				if (header_only)
+					return true;
+
+				UINT64 delta, offset, data, mask;
+				if (!get_varint(*file, delta) || !get_varint(*file, offset) || !get_varint(*file, data))
+					return false;
+				if (type == RECORD_WRITE_MASK)
+				{
+					if (!get_varint(*file, mask))
+						return false;
+					mem_mask = UINT32(mask);
+				}
+				time_ns += delta;
+				m_writes.push_back(write_entry{ attotime::from_nsec(time_ns), offs_t(offset), UINT32(data), mem_mask });
+				break;
+			}
+
+			default:
+				return false;
+		}
+	}
+	return true;
+}
+
+
+//-------------------------------------------------
+//  find_memory - return the memory block with
+//  the given index, if present
+//-------------------------------------------------
+
+const sound_log::memory_block *sound_log::find_memory(int index) const
+{
+	for (const memory_block &block : m_memory)
+		if (block.index == index)
+			return &block;
+	return nullptr;
+}
+
+
+
+//**************************************************************************
+//  LOG WRITER
+//**************************************************************************
+
+//-------------------------------------------------
+//  sound_log_writer - constructor; writes the
+//  file header
+//-------------------------------------------------
+
+sound_log_writer::sound_log_writer(device_t &device, std::unique_ptr<emu_file> &&file)
+	: m_device(device),
+		m_file(std::move(file)),
+		m_last_ns(0),
+		m_last_mask(0xffffffff),
+		m_count(0)
+{
+	device_sound_interface *sound;
+	device.interface(sound);
+
+	m_buffer.reserve(WRITE_CHUNK + 64);
+	for (UINT8 c : sound_log::MAGIC)
+		put_byte(c);
+	put_byte(sound_log::VERSION);
+	put_varint(device.clock());
+	put_string(device.shortname());
+	put_string(device.tag());
+	put_varint((sound != nullptr) ? sound->outputs() : 0);
+}
+
+
+//-------------------------------------------------
+//  ~sound_log_writer - destructor
+//-------------------------------------------------
+
+sound_log_writer::~sound_log_writer()
+{
+	flush();
+	m_device.logerror("Logged %u register writes to %s\n", m_count, m_file->fullpath());
+}
+
+
+//-------------------------------------------------
+//  add_memory - record the contents of a memory
+//  region the device plays samples from
+//-------------------------------------------------
+
+void sound_log_writer::add_memory(int index, memory_region &region)
+{
+	put_byte(sound_log::RECORD_MEMORY);
+	put_varint(index);
+	put_byte(region.bytewidth());
+	put_byte(region.endianness());
+	put_varint(region.bytes());
+	flush();
+	m_file->write(region.base(), region.bytes());
+}
+
+
+//-------------------------------------------------
+//  write - record a register write at the
+//  current emulated time
+//-------------------------------------------------
+
+void sound_log_writer::write(offs_t offset, UINT32 data, UINT32 mem_mask)
+{
+	// writes from CPUs executing out of step can arrive a little out of order;
+	// keep the log monotonic rather than reorder them
+	attotime const now = m_device.machine().time();
+	UINT64 const now_ns = std::max(m_last_ns, UINT64(now.seconds()) * 1000000000 + now.attoseconds() / (ATTOSECONDS_PER_SECOND / 1000000000));
+
+	bool const new_mask = (mem_mask != m_last_mask);
+	put_byte(new_mask ? sound_log::RECORD_WRITE_MASK : sound_log::RECORD_WRITE);
+	put_varint(now_ns - m_last_ns);
+	put_varint(offset);
+	put_varint(data);
+	if (new_mask)
+		put_varint(mem_mask);
+
+	m_last_ns = now_ns;
+	m_last_mask = mem_mask;
+	m_count++;
+
+	if (m_buffer.size() >= WRITE_CHUNK)
+		flush();
+}
+
+
+//-------------------------------------------------
+//  put_varint - append a variable-length integer
+//-------------------------------------------------
+
+void sound_log_writer::put_varint(UINT64 value)
+{
+	while (value >= 0x80)
+	{
+		put_byte(UINT8(value | 0x80));
+		value >>= 7;
+	}
+	put_byte(UINT8(value));
+}
+
+
+//-------------------------------------------------
+//  put_string - append a length-prefixed string
+//-------------------------------------------------
+
+void sound_log_writer::put_string(const char *string)
+{
+	size_t const length = strlen(string);
+	put_varint(length);
+	m_buffer.insert(m_buffer.end(), string, string + length);
+}
+
+
+//-------------------------------------------------
+//  flush - write out pending bytes
+//-------------------------------------------------
+
+void sound_log_writer::flush()
+{
+	if (!m_buffer.empty())
+	{
+		m_file->write(&m_buffer[0], m_buffer.size());
+		m_buffer.clear();
+	}
+}
@@ -0,0 +1,117 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    sndlog.h
+
+    Sound device register write logs.
+
+    A log holds every register write made to one sound device, stamped
+    with the emulated time it happened, along with the device type, clock
+    and any sample memory it plays from.  That is enough to instantiate
+    the device on its own and replay the writes (see the sndreplay
+    systems), so sound cores can be benchmarked and regression tested
+    without the machine that drove them.
+
+***************************************************************************/
+
+#pragma once
+
+#ifndef __SNDLOG_H__
+#define __SNDLOG_H__
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> sound_log
+
+// contents of a register log, as read back from a file
+class sound_log
+{
+public:
+	struct memory_block
+	{
+		int                 index;          // device-specific memory index
+		UINT8               width;          // region width in bytes
+		endianness_t        endian;         // region endianness
+		std::vector<UINT8>  data;
+	};
+
+	struct write_entry
+	{
+		attotime            time;           // emulated time of the write
+		offs_t              offset;
+		UINT32              data;
+		UINT32              mem_mask;
+	};
+
+	// construction
+	sound_log();
+
+	// read a log; with header_only set, memory contents and writes are skipped
+	bool load(const char *filename, bool header_only = false);
+
+	// getters
+	const std::string &shortname() const { return m_shortname; }
+	const std::string &tag() const { return m_tag; }
+	UINT32 clock() const { return m_clock; }
+	int outputs() const { return m_outputs; }
+	const std::vector<memory_block> &memory() const { return m_memory; }
+	const std::vector<write_entry> &writes() const { return m_writes; }
+	const memory_block *find_memory(int index) const;
+
+	// file format
+	static const UINT8 MAGIC[4];
+	static const UINT8 VERSION = 1;
+
+	enum
+	{
+		RECORD_MEMORY = 0,          // index, width, endianness, length, data
+		RECORD_WRITE,               // delta ns, offset, data (mask as for the previous write)
+		RECORD_WRITE_MASK           // delta ns, offset, data, new mask
+	};
+
+private:
+	std::string                 m_shortname;
+	std::string                 m_tag;
+	UINT32                      m_clock;
+	int                         m_outputs;
+	std::vector<memory_block>   m_memory;
+	std::vector<write_entry>    m_writes;
+};
+
+
+// ======================> sound_log_writer
+
+// appends writes to a log file as a device receives them
+class sound_log_writer
+{
+public:
+	// construction/destruction
+	sound_log_writer(device_t &device, std::unique_ptr<emu_file> &&file);
+	~sound_log_writer();
+
+	// logging
+	void add_memory(int index, memory_region &region);
+	void write(offs_t offset, UINT32 data, UINT32 mem_mask);
+
+private:
+	// internal helpers
+	void put_byte(UINT8 value) { m_buffer.push_back(value); }
+	void put_varint(UINT64 value);
+	void put_string(const char *string);
+	void flush();
+
+	// internal state
+	device_t &                  m_device;
+	std::unique_ptr<emu_file>   m_file;
+	std::vector<UINT8>          m_buffer;       // pending bytes, written out in large chunks
+	UINT64                      m_last_ns;      // time of the previous write in nanoseconds
+	UINT32                      m_last_mask;    // mask of the previous write
+	UINT32                      m_count;        // writes logged
+};
+
+
+#endif  /* __SNDLOG_H__ */
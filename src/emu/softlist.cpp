@@ -15,6 +15,7 @@
 #include "expat.h"
 
 #include <ctype.h>
+#include <algorithm>
 
 
 //**************************************************************************
@@ -24,13 +25,34 @@
 typedef std::unordered_map<std::string,software_info *> softlist_map;
 
 
+// ======================> softlist_cache_header
+
+// header of a compiled software list cache file; all fields are native-endian
+// UINT32s and the payload that follows is a string table, the packed records
+// and finally an index of record numbers sorted by shortname
+struct softlist_cache_header
+{
+	char        magic[4];       // 'MSWC'
+	UINT32      version;        // SOFTLIST_CACHE_VERSION
+	UINT32      byteorder;      // 0x01020304 in native order
+	UINT32      xmllength;      // length of the source XML
+	UINT32      xmlcrc;         // CRC32 of the source XML
+	UINT32      stringsize;     // size of the string table in bytes
+	UINT32      count;          // number of software records
+	UINT32      description;    // offset of the list description
+};
+
+const UINT32 SOFTLIST_CACHE_VERSION = 1;
+const UINT32 SOFTLIST_CACHE_NULL = ~UINT32(0);
+
+
 // ======================> softlist_parser
 
 class softlist_parser
 {
 public:
 	// construction (== execution)
-	softlist_parser(software_list_device &list, std::ostringstream &errors);
+	softlist_parser(software_list_device &list, const char *data, UINT32 length, std::ostringstream &errors);
 
 private:
 	enum parse_position
@@ -386,8 +408,8 @@ void software_list_device::find_approx_matches(const char *name, int matches, so
 		list[matchnum] = nullptr;
 	}
 
-	// iterate over our info (will cause a parse if needed)
-	for (software_info &swinfo : get_info())
+	// score a single entry
+	auto consider = [&](software_info &swinfo)
 	{
 		software_part *part = swinfo.first_part();
 		if ((interface == nullptr || part->matches_interface(interface)) && part->is_compatible(*this) == SOFTWARE_IS_COMPATIBLE)
@@ -414,7 +436,40 @@ void software_list_device::find_approx_matches(const char *name, int matches, so
 				penalty[matchnum] = curpenalty;
 			}
 		}
+	};
+
+	// rank the entries sharing the most trigrams with the name first (will cause a parse if needed)
+	get_info();
+	if (trigram_index::usable(name))
+	{
+		if (m_search_index.empty())
+		{
+			for (int index = 0; index < m_index.size(); index++)
+			{
+				m_search_index.add(index, m_index[index]->shortname());
+				m_search_index.add(index, m_index[index]->longname());
+			}
+			m_search_index.finalize();
+		}
+
+		std::vector<int> candidates;
+		m_search_index.candidates(name, MAX(matches * 4, 256), candidates);
+		for (int index : candidates)
+			consider(*m_index[index]);
+		if (matches == 0 || list[matches - 1] != nullptr)
+			return;
+
+		// too few compatible candidates; start over with everything
+		for (int matchnum = 0; matchnum < matches; matchnum++)
+		{
+			penalty[matchnum] = 9999;
+			list[matchnum] = nullptr;
+		}
 	}
+
+	// iterate over our info
+	for (software_info &swinfo : m_infolist)
+		consider(swinfo);
 }
 
 
@@ -430,6 +485,9 @@ void software_list_device::release()
 	m_errors.clear();
 	m_infolist.reset();
 	m_stringpool.reset();
+	m_index.clear();
+	m_search_index.reset();
+	m_cache.clear();
 }
 
 
@@ -503,6 +561,15 @@ software_info *software_list_device::find(const char *look_for, software_info *p
 
 	bool iswild = strchr(look_for, '*') != nullptr || strchr(look_for, '?');
 
+	// exact lookups from the start can use the shortname index
+	if (!iswild && prev == nullptr)
+	{
+		if (!m_parsed)
+			parse();
+		auto found = std::lower_bound(m_index.begin(), m_index.end(), look_for, [] (const software_info *info, const char *name) { return core_stricmp(info->shortname(), name) < 0; });
+		return (found != m_index.end() && core_stricmp(look_for, (*found)->shortname()) == 0) ? *found : nullptr;
+	}
+
 	// find a match (will cause a parse if needed when calling get_info)
 	for (prev = (prev != nullptr) ? prev->next() : get_info().first(); prev != nullptr; prev = prev->next())
 		if ((iswild && core_strwildcmp(look_for, prev->shortname()) == 0) || core_stricmp(look_for, prev->shortname()) == 0)
@@ -529,11 +596,24 @@ void software_list_device::parse()
 	osd_file::error filerr = m_file.open(m_list_name.c_str(), ".xml");
 	if (filerr == osd_file::error::NONE)
 	{
-		// parse if no error
-		std::ostringstream errs;
-		softlist_parser parser(*this, errs);
+		// read the whole file; its length and CRC identify the compiled cache
+		std::vector<char> xml(m_file.size());
+		UINT32 length = m_file.read(xml.data(), xml.size());
+		UINT32 crc = crc32_creator::simple(xml.data(), length);
+
+		// parse only if there is no valid compiled cache
+		if (!load_cache(length, crc))
+		{
+			std::ostringstream errs;
+			softlist_parser parser(*this, xml.data(), length, errs);
+			m_errors = errs.str();
+			build_index();
+
+			// only cache lists that parsed cleanly so errors keep being reported
+			if (m_errors.empty())
+				save_cache(length, crc);
+		}
 		m_file.close();
-		m_errors = errs.str();
 	}
 	else
 		m_errors = string_format("Error opening file: %s\n", filename());
@@ -543,6 +623,259 @@ void software_list_device::parse()
 }
 
 
+//-------------------------------------------------
+//  build_index - build the sorted shortname
+//  index used by find
+//-------------------------------------------------
+
+void software_list_device::build_index()
+{
+	m_index.clear();
+	m_index.reserve(m_infolist.count());
+	for (software_info &swinfo : m_infolist)
+		m_index.push_back(&swinfo);
+
+	// stable so that duplicate names resolve to the first in list order, like a linear scan
+	std::stable_sort(m_index.begin(), m_index.end(), [] (const software_info *a, const software_info *b) { return core_stricmp(a->shortname(), b->shortname()) < 0; });
+}
+
+
+//-------------------------------------------------
+//  load_cache - attempt to populate the list
+//  from a compiled cache matching the given
+//  source XML; returns false if there is no
+//  usable cache
+//-------------------------------------------------
+
+bool software_list_device::load_cache(UINT32 xmllength, UINT32 xmlcrc)
+{
+	// read the whole cache file in one go
+	emu_file file(mconfig().options().cache_directory(), OPEN_FLAG_READ);
+	if (file.open(m_list_name.c_str(), ".swc") != osd_file::error::NONE)
+		return false;
+	m_cache.resize(file.size());
+	if (m_cache.size() < sizeof(softlist_cache_header) || file.read(&m_cache[0], m_cache.size()) != m_cache.size())
+	{
+		m_cache.clear();
+		return false;
+	}
+	file.close();
+
+	// validate the header against the source file
+	softlist_cache_header header;
+	memcpy(&header, &m_cache[0], sizeof(header));
+	if (memcmp(header.magic, "MSWC", 4) != 0 || header.version != SOFTLIST_CACHE_VERSION || header.byteorder != 0x01020304 ||
+		header.xmllength != xmllength || header.xmlcrc != xmlcrc || sizeof(header) + header.stringsize > m_cache.size())
+	{
+		m_cache.clear();
+		return false;
+	}
+
+	// the payload is a string table followed by a stream of UINT32s
+	const char *strings = (const char *)&m_cache[sizeof(header)];
+	const UINT8 *cur = &m_cache[sizeof(header) + header.stringsize];
+	const UINT8 *end = &m_cache[0] + m_cache.size();
+	bool overrun = false;
+	auto next = [&cur, end, &overrun] () -> UINT32
+	{
+		UINT32 result = 0;
+		if (cur + sizeof(result) > end)
+			overrun = true;
+		else
+		{
+			memcpy(&result, cur, sizeof(result));
+			cur += sizeof(result);
+		}
+		return result;
+	};
+	auto next_string = [&next, &overrun, strings, &header] () -> const char *
+	{
+		UINT32 offset = next();
+		if (offset == SOFTLIST_CACHE_NULL)
+			return nullptr;
+		if (offset >= header.stringsize)
+		{
+			overrun = true;
+			return nullptr;
+		}
+		return strings + offset;
+	};
+	auto next_features = [&next, &next_string, &overrun] (simple_list<feature_list_item> &list)
+	{
+		for (UINT32 count = next(); count > 0 && !overrun; count--)
+		{
+			const char *name = next_string();
+			const char *value = next_string();
+			list.append(*global_alloc(feature_list_item(name, value)));
+		}
+	};
+
+	// rebuild the records
+	std::vector<software_info *> records;
+	records.reserve(header.count);
+	m_description = (header.description != SOFTLIST_CACHE_NULL) ? strings + header.description : nullptr;
+	for (UINT32 index = 0; index < header.count && !overrun; index++)
+	{
+		const char *name = next_string();
+		const char *parent = next_string();
+		software_info &swinfo = m_infolist.append(*global_alloc(software_info(*this, name, parent, nullptr)));
+		records.push_back(&swinfo);
+		swinfo.m_supported = next();
+		swinfo.m_longname = next_string();
+		swinfo.m_year = next_string();
+		swinfo.m_publisher = next_string();
+		next_features(swinfo.m_other_info);
+		next_features(swinfo.m_shared_info);
+
+		for (UINT32 parts = next(); parts > 0 && !overrun; parts--)
+		{
+			const char *partname = next_string();
+			const char *interface = next_string();
+			software_part &part = swinfo.m_partdata.append(*global_alloc(software_part(swinfo, partname, interface)));
+			next_features(part.m_featurelist);
+
+			UINT32 roms = next();
+			part.m_romdata.resize(overrun ? 0 : std::min<size_t>(roms, (end - cur) / (5 * sizeof(UINT32))));
+			for (rom_entry &entry : part.m_romdata)
+			{
+				entry._name = next_string();
+				UINT32 hashdata = next();
+				entry._offset = next();
+				entry._length = next();
+				entry._flags = next();
+
+				// fill entries carry their value in place of the hash string
+				if ((entry._flags & ROMENTRY_TYPEMASK) == ROMENTRYTYPE_FILL)
+					entry._hashdata = (const char *)(FPTR)hashdata;
+				else if (hashdata != SOFTLIST_CACHE_NULL && hashdata < header.stringsize)
+					entry._hashdata = strings + hashdata;
+				else
+					entry._hashdata = nullptr;
+			}
+			if (part.m_romdata.size() != roms)
+				overrun = true;
+		}
+	}
+
+	// the index closes the file
+	m_index.resize(header.count);
+	for (auto &entry : m_index)
+	{
+		UINT32 record = next();
+		entry = (record < records.size()) ? records[record] : nullptr;
+		if (entry == nullptr)
+			overrun = true;
+	}
+
+	// if anything was inconsistent, throw it all away and fall back to parsing
+	if (overrun || cur != end)
+	{
+		osd_printf_verbose("Discarding invalid software list cache for %s\n", m_list_name.c_str());
+		m_description = nullptr;
+		m_infolist.reset();
+		m_index.clear();
+		m_cache.clear();
+		return false;
+	}
+
+	osd_printf_verbose("Loaded %s from software list cache\n", m_list_name.c_str());
+	return true;
+}
+
+
+//-------------------------------------------------
+//  save_cache - write a compiled cache of the
+//  freshly parsed list
+//-------------------------------------------------
+
+void software_list_device::save_cache(UINT32 xmllength, UINT32 xmlcrc)
+{
+	// pool the strings, sharing identical ones
+	std::vector<char> strings;
+	std::unordered_map<std::string, UINT32> offsets;
+	auto add_string = [&strings, &offsets] (const char *string) -> UINT32
+	{
+		if (string == nullptr)
+			return SOFTLIST_CACHE_NULL;
+		auto found = offsets.emplace(string, UINT32(strings.size()));
+		if (found.second)
+			strings.insert(strings.end(), string, string + strlen(string) + 1);
+		return found.first->second;
+	};
+
+	// pack the records
+	std::vector<UINT32> data;
+	auto add_features = [&data, &add_string] (const simple_list<feature_list_item> &list)
+	{
+		data.push_back(list.count());
+		for (const feature_list_item &item : list)
+		{
+			data.push_back(add_string(item.name()));
+			data.push_back(add_string(item.value()));
+		}
+	};
+	std::unordered_map<const software_info *, UINT32> recordnum;
+	for (software_info &swinfo : m_infolist)
+	{
+		recordnum.emplace(&swinfo, UINT32(recordnum.size()));
+		data.push_back(add_string(swinfo.shortname()));
+		data.push_back(add_string(swinfo.parentname()));
+		data.push_back(swinfo.supported());
+		data.push_back(add_string(swinfo.longname()));
+		data.push_back(add_string(swinfo.year()));
+		data.push_back(add_string(swinfo.publisher()));
+		add_features(swinfo.other_info());
+		add_features(swinfo.shared_info());
+
+		data.push_back(swinfo.parts().count());
+		for (software_part &part : swinfo.parts())
+		{
+			data.push_back(add_string(part.name()));
+			data.push_back(add_string(part.interface()));
+			add_features(part.featurelist());
+
+			data.push_back(part.m_romdata.size());
+			for (const rom_entry &entry : part.m_romdata)
+			{
+				data.push_back(add_string(entry._name));
+				if ((entry._flags & ROMENTRY_TYPEMASK) == ROMENTRYTYPE_FILL)
+					data.push_back(UINT32(FPTR(entry._hashdata)));
+				else
+					data.push_back(add_string(entry._hashdata));
+				data.push_back(entry._offset);
+				data.push_back(entry._length);
+				data.push_back(entry._flags);
+			}
+		}
+	}
+	for (const software_info *swinfo : m_index)
+		data.push_back(recordnum[swinfo]);
+
+	// build the header
+	softlist_cache_header header;
+	memcpy(header.magic, "MSWC", 4);
+	header.version = SOFTLIST_CACHE_VERSION;
+	header.byteorder = 0x01020304;
+	header.xmllength = xmllength;
+	header.xmlcrc = xmlcrc;
+	header.description = add_string(m_description);
+	header.stringsize = strings.size();
+	header.count = recordnum.size();
+
+	// write it out; failure just means we parse again next time
+	emu_file file(mconfig().options().cache_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (file.open(m_list_name.c_str(), ".swc") == osd_file::error::NONE)
+	{
+		bool ok = file.write(&header, sizeof(header)) == sizeof(header);
+		ok = ok && file.write(strings.data(), strings.size()) == strings.size();
+		ok = ok && file.write(data.data(), data.size() * sizeof(UINT32)) == data.size() * sizeof(UINT32);
+		if (!ok)
+			file.remove_on_close();
+		file.close();
+	}
+}
+
+
 //-------------------------------------------------
 //  device_validity_check - validate the device
 //  configuration
@@ -697,7 +1030,7 @@ void software_list_device::internal_validity_check(validity_checker &valid)
 //  softlist_parser - constructor
 //-------------------------------------------------
 
-softlist_parser::softlist_parser(software_list_device &list, std::ostringstream &errors)
+softlist_parser::softlist_parser(software_list_device &list, const char *data, UINT32 length, std::ostringstream &errors)
 	: m_list(list),
 		m_errors(errors),
 		m_done(false),
@@ -724,19 +1057,10 @@ softlist_parser::softlist_parser(software_list_device &list, std::ostringstream
 	XML_SetElementHandler(m_parser, &softlist_parser::start_handler, &softlist_parser::end_handler);
 	XML_SetCharacterDataHandler(m_parser, &softlist_parser::data_handler);
 
-	// parse the file contents
-	m_list.m_file.seek(0, SEEK_SET);
-	char buffer[1024];
-	while (!m_done)
-	{
-		UINT32 length = m_list.m_file.read(buffer, sizeof(buffer));
-		m_done = m_list.m_file.eof();
-		if (XML_Parse(m_parser, buffer, length, m_done) == XML_STATUS_ERROR)
-		{
-			parse_error("%s", parser_error());
-			break;
-		}
-	}
+	// parse the file contents in one go
+	m_done = true;
+	if (XML_Parse(m_parser, data, length, m_done) == XML_STATUS_ERROR)
+		parse_error("%s", parser_error());
 
 	// free the parser
 	XML_ParserFree(m_parser);
@@ -12,6 +12,7 @@
 #define __SOFTLIST_H_
 
 #include "cstrpool.h"
+#include "trigram.h"
 
 
 
@@ -106,6 +107,7 @@ private:
 class software_part
 {
 	friend class softlist_parser;
+	friend class software_list_device;
 	friend class simple_list<software_part>;
 
 public:
@@ -143,6 +145,7 @@ private:
 class software_info
 {
 	friend class softlist_parser;
+	friend class software_list_device;
 	friend class simple_list<software_info>;
 
 public:
@@ -218,7 +221,7 @@ public:
 
 	// string pool helpers
 	const char *add_string(const char *string) { return m_stringpool.add(string); }
-	bool string_pool_contains(const char *string) { return m_stringpool.contains(string); }
+	bool string_pool_contains(const char *string) { return m_stringpool.contains(string) || cache_contains(string); }
 
 	// static helpers
 	static software_list_device *find_by_name(const machine_config &mconfig, const char *name);
@@ -229,6 +232,12 @@ protected:
 	void parse();
 	void internal_validity_check(validity_checker &valid) ATTR_COLD;
 
+	// compiled cache helpers
+	bool load_cache(UINT32 xmllength, UINT32 xmlcrc);
+	void save_cache(UINT32 xmllength, UINT32 xmlcrc);
+	void build_index();
+	bool cache_contains(const char *string) const { return (!m_cache.empty() && string >= (const char *)&m_cache[0] && string < (const char *)&m_cache[0] + m_cache.size()); }
+
 	// device-level overrides
 	virtual void device_start() override;
 	virtual void device_validity_check(validity_checker &valid) const override ATTR_COLD;
@@ -245,6 +254,9 @@ protected:
 	std::string                 m_errors;
 	simple_list<software_info>  m_infolist;
 	const_string_pool           m_stringpool;
+	std::vector<UINT8>          m_cache;        // compiled list image; strings point directly into it
+	std::vector<software_info *> m_index;       // entries sorted by shortname for fast lookup
+	trigram_index               m_search_index; // names and descriptions of m_index entries, built on first search
 };
 
 
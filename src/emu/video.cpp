@@ -100,13 +100,17 @@ video_manager::video_manager(running_machine &machine)
 		m_snap_native(true),
 		m_snap_width(0),
 		m_snap_height(0),
+		m_snap_compress(PNG_LEVEL_DEFAULT),
+		m_snap_filter(PNG_PF_None),
 		m_mng_frame_period(attotime::zero),
 		m_mng_next_frame_time(attotime::zero),
 		m_mng_frame(0),
+		m_mng_failed(false),
 		m_avi_file(nullptr),
 		m_avi_frame_period(attotime::zero),
 		m_avi_next_frame_time(attotime::zero),
 		m_avi_frame(0),
+		m_avi_failed(false),
 		m_dummy_recording(false),
 		m_timecode_enabled(false),
 		m_timecode_write(false),
@@ -151,6 +155,23 @@ video_manager::video_manager(running_machine &machine)
 	if (sscanf(machine.options().snap_size(), "%dx%d", &m_snap_width, &m_snap_height) != 2)
 		m_snap_width = m_snap_height = 0;
 
+	// extract PNG encoding settings
+	m_snap_compress = std::max(PNG_LEVEL_DEFAULT, std::min(9, machine.options().snap_compress()));
+	static const char *const filter_names[] = { "none", "sub", "up", "average", "paeth", "adaptive" };
+	int const filter_count = ARRAY_LENGTH(filter_names);
+	const char *filtername = machine.options().snap_filter();
+	for (m_snap_filter = PNG_PF_None; m_snap_filter < filter_count; m_snap_filter++)
+		if (core_stricmp(filtername, filter_names[m_snap_filter]) == 0)
+			break;
+	if (m_snap_filter == filter_count)
+	{
+		osd_printf_error("Unknown snapshot filter '%s'; using none\n", filtername);
+		m_snap_filter = PNG_PF_None;
+	}
+
+	// start the encoder before any recording begins
+	m_capture = std::make_unique<capture_queue>(machine.options().snap_queue(), machine.options().snap_drop());
+
 	// start recording movie if specified
 	const char *filename = machine.options().mng_write();
 	if (filename[0] != 0)
@@ -325,7 +346,7 @@ void video_manager::save_snapshot(screen_device *screen, emu_file &file)
 	// now do the actual work
 	const rgb_t *palette = (screen != nullptr && screen->has_palette()) ? screen->palette().palette()->entry_list_adjusted() : nullptr;
 	int entries = (screen != nullptr && screen->has_palette()) ? screen->palette().entries() : 0;
-	png_error error = png_write_bitmap(file, &pnginfo, m_snap_bitmap, entries, palette);
+	png_error error = png_write_bitmap(file, &pnginfo, m_snap_bitmap, entries, palette, m_snap_compress, m_snap_filter);
 	if (error != PNGERR_NONE)
 		osd_printf_error("Error generating PNG for snapshot: png_error = %d\n", error);
 
@@ -347,22 +368,44 @@ void video_manager::save_active_screen_snapshots()
 		// write one snapshot per visible screen
 		for (screen_device &screen : screen_device_iterator(machine().root_device()))
 			if (machine().render().is_live(screen))
-			{
-				emu_file file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
-				osd_file::error filerr = open_next(file, "png");
-				if (filerr == osd_file::error::NONE)
-					save_snapshot(&screen, file);
-			}
+				queue_snapshot(&screen);
 	}
 
 	// otherwise, just write a single snapshot
 	else
+		queue_snapshot(nullptr);
+}
+
+
+//-------------------------------------------------
+//  queue_snapshot - render a snapshot now and
+//  leave compressing and writing it to the
+//  encoder thread
+//-------------------------------------------------
+
+void video_manager::queue_snapshot(screen_device *screen)
+{
+	// the file is opened here so the numbering follows the order of requests
+	auto file = std::make_shared<emu_file>(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	if (open_next(*file, "png") != osd_file::error::NONE)
+		return;
+
+	// the snapshot bitmap is always RGB, so no palette is needed to encode it
+	create_snapshot_bitmap(screen);
+	std::string text1 = std::string(emulator_info::get_appname()).append(" ").append(emulator_info::get_build_version());
+	std::string text2 = std::string(machine().system().manufacturer).append(" ").append(machine().system().description);
+	int const level = m_snap_compress;
+	int const filter = m_snap_filter;
+	m_capture->push_frame(m_snap_bitmap, false, [file, text1, text2, level, filter] (bitmap_rgb32 &bitmap)
 	{
-		emu_file file(machine().options().snapshot_directory(), OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
-		osd_file::error filerr = open_next(file, "png");
-		if (filerr == osd_file::error::NONE)
-			save_snapshot(nullptr, file);
-	}
+		png_info pnginfo = { nullptr };
+		png_add_text(&pnginfo, "Software", text1.c_str());
+		png_add_text(&pnginfo, "System", text2.c_str());
+		png_error error = png_write_bitmap(*file, &pnginfo, bitmap, 0, nullptr, level, filter);
+		if (error != PNGERR_NONE)
+			osd_printf_error("Error generating PNG for snapshot: png_error = %d\n", error);
+		png_free(&pnginfo);
+	});
 }
 
 
@@ -429,6 +472,11 @@ void video_manager::begin_recording(const char *name, movie_format format)
 		screen_device *screen = machine().first_screen();
 		avi_file::movie_info info;
 		info.video_format = 0;
+		const char *codec = machine().options().avi_codec();
+		if (core_stricmp(codec, "mlsc") == 0)
+			info.video_format = FORMAT_MLSC;
+		else if (core_stricmp(codec, "raw") != 0)
+			osd_printf_error("Unknown AVI codec '%s'; using raw\n", codec);
 		info.video_timescale = 1000 * ((screen != nullptr) ? ATTOSECONDS_TO_HZ(screen->frame_period().attoseconds()) : screen_device::DEFAULT_FRAME_RATE);
 		info.video_sampletime = 1000;
 		info.video_numsamples = 0;
@@ -524,10 +572,12 @@ void video_manager::end_recording(movie_format format)
 {
 	if (format == MF_AVI)
 	{
-		// close the file if it exists
+		// close the file if it exists, once the encoder is done with it
 		if (m_avi_file)
 		{
+			m_capture->flush();
 			m_avi_file.reset();
+			m_avi_failed = false;
 
 			// reset the state
 			m_avi_frame = 0;
@@ -535,11 +585,13 @@ void video_manager::end_recording(movie_format format)
 	}
 	else if (format == MF_MNG)
 	{
-		// close the file if it exists
+		// close the file if it exists, once the encoder is done with it
 		if (m_mng_file != nullptr)
 		{
+			m_capture->flush();
 			mng_capture_stop(*m_mng_file);
 			m_mng_file.reset();
+			m_mng_failed = false;
 
 			// reset the state
 			m_mng_frame = 0;
@@ -555,17 +607,28 @@ void video_manager::end_recording(movie_format format)
 
 void video_manager::add_sound_to_recording(const INT16 *sound, int numsamples)
 {
+	// stop if the encoder hit an error
+	if (m_avi_failed)
+		end_recording(MF_AVI);
+
 	// only record if we have a file
 	if (m_avi_file != nullptr)
 	{
 		g_profiler.start(PROFILER_MOVIE_REC);
 
-		// write the next frame
-		avi_file::error avierr = m_avi_file->append_sound_samples(0, sound + 0, numsamples, 1);
-		if (avierr == avi_file::error::NONE)
-			avierr = m_avi_file->append_sound_samples(1, sound + 1, numsamples, 1);
-		if (avierr != avi_file::error::NONE)
-			end_recording(MF_AVI);
+		// samples go through the encoder too, so they stay in order with the frames
+		auto samples = std::make_shared<std::vector<INT16>>(sound, sound + numsamples * 2);
+		avi_file *avi = m_avi_file.get();
+		m_capture->push([this, avi, samples, numsamples] ()
+		{
+			if (m_avi_failed)
+				return;
+			avi_file::error avierr = avi->append_sound_samples(0, &(*samples)[0], numsamples, 1);
+			if (avierr == avi_file::error::NONE)
+				avierr = avi->append_sound_samples(1, &(*samples)[1], numsamples, 1);
+			if (avierr != avi_file::error::NONE)
+				m_avi_failed = true;
+		});
 
 		g_profiler.stop();
 	}
@@ -583,6 +646,11 @@ void video_manager::exit()
 	end_recording(MF_AVI);
 	end_recording(MF_MNG);
 
+	// finish any snapshots still being written
+	if (m_capture->dropped() != 0)
+		osd_printf_info("Movie encoder fell behind; %u frames were repeated\n", m_capture->dropped());
+	m_capture.reset();
+
 	// free the snapshot target
 	machine().render().target_free(m_snap_target);
 	m_snap_bitmap.reset();
@@ -1271,6 +1339,12 @@ osd_file::error video_manager::open_next(emu_file &file, const char *extension)
 
 void video_manager::record_frame()
 {
+	// stop any recording the encoder could not write
+	if (m_avi_failed)
+		end_recording(MF_AVI);
+	if (m_mng_failed)
+		end_recording(MF_MNG);
+
 	// ignore if nothing to do
 	if (m_mng_file == nullptr && m_avi_file == nullptr && !m_dummy_recording)
 		return;
@@ -1288,14 +1362,13 @@ void video_manager::record_frame()
 		// loop until we hit the right time
 		while (m_avi_next_frame_time <= curtime)
 		{
-			// write the next frame
-			avi_file::error avierr = m_avi_file->append_video_frame(m_snap_bitmap);
-			if (avierr != avi_file::error::NONE)
+			// queue the next frame
+			avi_file *avi = m_avi_file.get();
+			m_capture->push_frame(m_snap_bitmap, true, [this, avi] (bitmap_rgb32 &bitmap)
 			{
-				g_profiler.stop();
-				end_recording(MF_AVI);
-				break;
-			}
+				if (!m_avi_failed && avi->append_video_frame(bitmap) != avi_file::error::NONE)
+					m_avi_failed = true;
+			});
 
 			// advance time
 			m_avi_next_frame_time += m_avi_frame_period;
@@ -1310,27 +1383,32 @@ void video_manager::record_frame()
 		while (m_mng_next_frame_time <= curtime)
 		{
 			// set up the text fields in the movie info
-			png_info pnginfo = { nullptr };
+			std::string text1, text2;
 			if (m_mng_frame == 0)
 			{
-				std::string text1 = std::string(emulator_info::get_appname()).append(" ").append(emulator_info::get_build_version());
-				std::string text2 = std::string(machine().system().manufacturer).append(" ").append(machine().system().description);
-				png_add_text(&pnginfo, "Software", text1.c_str());
-				png_add_text(&pnginfo, "System", text2.c_str());
+				text1 = std::string(emulator_info::get_appname()).append(" ").append(emulator_info::get_build_version());
+				text2 = std::string(machine().system().manufacturer).append(" ").append(machine().system().description);
 			}
 
-			// write the next frame
-			screen_device *screen = machine().first_screen();
-			const rgb_t *palette = (screen != nullptr && screen->has_palette()) ? screen->palette().palette()->entry_list_adjusted() : nullptr;
-			int entries = (screen != nullptr && screen->has_palette()) ? screen->palette().entries() : 0;
-			png_error error = mng_capture_frame(*m_mng_file, &pnginfo, m_snap_bitmap, entries, palette);
-			png_free(&pnginfo);
-			if (error != PNGERR_NONE)
+			// queue the next frame; the snapshot bitmap is always RGB, so no
+			// palette is needed to encode it
+			emu_file *file = m_mng_file.get();
+			int const level = m_snap_compress;
+			int const filter = m_snap_filter;
+			m_capture->push_frame(m_snap_bitmap, true, [this, file, text1, text2, level, filter] (bitmap_rgb32 &bitmap)
 			{
-				g_profiler.stop();
-				end_recording(MF_MNG);
-				break;
-			}
+				if (m_mng_failed)
+					return;
+				png_info pnginfo = { nullptr };
+				if (!text1.empty())
+				{
+					png_add_text(&pnginfo, "Software", text1.c_str());
+					png_add_text(&pnginfo, "System", text2.c_str());
+				}
+				if (mng_capture_frame(*file, &pnginfo, bitmap, 0, nullptr, level, filter) != PNGERR_NONE)
+					m_mng_failed = true;
+				png_free(&pnginfo);
+			});
 
 			// advance time
 			m_mng_next_frame_time += m_mng_frame_period;
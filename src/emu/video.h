@@ -18,6 +18,9 @@
 #define MAME_EMU_VIDEO_H
 
 #include "aviio.h"
+#include "capture.h"
+
+#include <atomic>
 
 
 //**************************************************************************
@@ -131,6 +134,7 @@ private:
 	// snapshot/movie helpers
 	void create_snapshot_bitmap(screen_device *screen);
 	void record_frame();
+	void queue_snapshot(screen_device *screen);
 
 	// internal state
 	running_machine &   m_machine;                  // reference to our machine
@@ -178,18 +182,23 @@ private:
 	bool                m_snap_native;              // are we using native per-screen layouts?
 	INT32               m_snap_width;               // width of snapshots (0 == auto)
 	INT32               m_snap_height;              // height of snapshots (0 == auto)
+	int                 m_snap_compress;            // zlib level for snapshots and MNG frames
+	int                 m_snap_filter;              // PNG row filter for snapshots and MNG frames
+	std::unique_ptr<capture_queue> m_capture;       // encodes snapshots and movie frames
 
 	// movie recording - MNG
 	std::unique_ptr<emu_file> m_mng_file;              // handle to the open movie file
 	attotime            m_mng_frame_period;         // period of a single movie frame
 	attotime            m_mng_next_frame_time;      // time of next frame
 	UINT32              m_mng_frame;                // current movie frame number
+	std::atomic<bool>   m_mng_failed;               // set by the encoder if a frame could not be written
 
 	// movie recording - AVI
 	avi_file::ptr       m_avi_file;                 // handle to the open movie file
 	attotime            m_avi_frame_period;         // period of a single movie frame
 	attotime            m_avi_next_frame_time;      // time of next frame
 	UINT32              m_avi_frame;                // current movie frame number
+	std::atomic<bool>   m_avi_failed;               // set by the encoder if a frame could not be written
 
 	// movie recording - dummy
 	bool                m_dummy_recording;          // indicates if snapshot should be created of every frame
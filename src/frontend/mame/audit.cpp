@@ -45,6 +45,10 @@ media_auditor::summary media_auditor::audit_media(const char *validation)
 	// store validation for later
 	m_validation = validation;
 
+	// systems without ROMs need nothing, and the summary avoids constructing their configuration
+	if (m_enumerator.summary().roms().empty())
+		return NONE_NEEDED;
+
 // temporary hack until romload is update: get the driver path and support it for
 // all searches
 const char *driverpath = m_enumerator.config().root_device().searchpath();
@@ -508,16 +508,21 @@ void cheat_script::script_entry::execute(cheat_manager &manager, UINT64 &arginde
 		for (auto &arg : m_arglist)
 			curarg += arg->values(argindex, &params[curarg]);
 
-		// generate the astring
-		manager.get_output_astring(m_line, m_justify) = string_format(m_format,
-			(UINT32)params[0],  (UINT32)params[1],  (UINT32)params[2],  (UINT32)params[3],
-			(UINT32)params[4],  (UINT32)params[5],  (UINT32)params[6],  (UINT32)params[7],
-			(UINT32)params[8],  (UINT32)params[9],  (UINT32)params[10], (UINT32)params[11],
-			(UINT32)params[12], (UINT32)params[13], (UINT32)params[14], (UINT32)params[15],
-			(UINT32)params[16], (UINT32)params[17], (UINT32)params[18], (UINT32)params[19],
-			(UINT32)params[20], (UINT32)params[21], (UINT32)params[22], (UINT32)params[23],
-			(UINT32)params[24], (UINT32)params[25], (UINT32)params[26], (UINT32)params[27],
-			(UINT32)params[28], (UINT32)params[29], (UINT32)params[30], (UINT32)params[31]);
+		// generate the astring, reusing the last one if no argument has changed
+		if (m_outputparams.size() != curarg || !std::equal(m_outputparams.begin(), m_outputparams.end(), params))
+		{
+			m_outputparams.assign(params, params + curarg);
+			m_output = string_format(m_format,
+				(UINT32)params[0],  (UINT32)params[1],  (UINT32)params[2],  (UINT32)params[3],
+				(UINT32)params[4],  (UINT32)params[5],  (UINT32)params[6],  (UINT32)params[7],
+				(UINT32)params[8],  (UINT32)params[9],  (UINT32)params[10], (UINT32)params[11],
+				(UINT32)params[12], (UINT32)params[13], (UINT32)params[14], (UINT32)params[15],
+				(UINT32)params[16], (UINT32)params[17], (UINT32)params[18], (UINT32)params[19],
+				(UINT32)params[20], (UINT32)params[21], (UINT32)params[22], (UINT32)params[23],
+				(UINT32)params[24], (UINT32)params[25], (UINT32)params[26], (UINT32)params[27],
+				(UINT32)params[28], (UINT32)params[29], (UINT32)params[30], (UINT32)params[31]);
+		}
+		manager.get_output_astring(m_line, m_justify) = m_output;
 	}
 }
 
@@ -180,6 +180,8 @@ private:
 		std::vector<std::unique_ptr<output_argument>> m_arglist;             // list of arguments
 		INT8                m_line;                         // which line to print on
 		UINT8               m_justify;                      // justification when printing
+		std::string         m_output;                       // most recently formatted output
+		std::vector<UINT64> m_outputparams;                 // argument values m_output was formatted from
 
 		// constants
 		static const int MAX_ARGUMENTS = 32;
@@ -185,6 +185,9 @@ int cli_frontend::execute(int argc, char **argv)
 
 		mame_options::parse_standard_inis(m_options,option_errors);
 
+		// size the archive caches before anything is opened
+		util::archive_file::set_cache_size(std::size_t(std::max(m_options.archive_cache(), 0)) * 1024 * 1024);
+
 		load_translation(m_options);
 
 		manager->start_luaengine();
@@ -348,9 +351,12 @@ void cli_frontend::listxml(const char *gamename)
 	if (drivlist.count() == 0)
 		throw emu_fatalerror(EMU_ERR_NO_SUCH_GAME, "No matching games found for '%s'", gamename);
 
-	// create the XML and print it to stdout
+	// create the XML and print it to stdout; the complete list may come from the cache
 	info_xml_creator creator(drivlist);
-	creator.output(stdout);
+	if (m_options.listxml_cache() && drivlist.count() == driver_enumerator(m_options).count())
+		creator.output_cached(stdout, m_options.cache_directory());
+	else
+		creator.output(stdout);
 }
 
 
@@ -499,15 +505,15 @@ void cli_frontend::listcrc(const char *gamename)
 	// iterate through matches, and then through ROMs
 	while (drivlist.next())
 	{
-		for (device_t &device : device_iterator(drivlist.config().root_device()))
-			for (const rom_entry *region = rom_first_region(device); region; region = rom_next_region(region))
-				for (const rom_entry *rom = rom_first_file(region); rom; rom = rom_next_file(rom))
-				{
-					// if we have a CRC, display it
-					UINT32 crc;
-					if (hash_collection(ROM_GETHASHDATA(rom)).crc(crc))
-						osd_printf_info("%08x %-16s \t %-8s \t %s\n", crc, ROM_GETNAME(rom), device.shortname(), device.name());
-				}
+		const driver_summary &summary = drivlist.summary();
+		for (const driver_summary::rom_info &rom : summary.roms())
+		{
+			// if we have a CRC, display it
+			const driver_summary::device_info &device = summary.devices()[rom.device];
+			UINT32 crc;
+			if (hash_collection(rom.hashdata.c_str()).crc(crc))
+				osd_printf_info("%08x %-16s \t %-8s \t %s\n", crc, rom.name.c_str(), device.shortname.c_str(), device.name.c_str());
+		}
 	}
 }
 
@@ -536,39 +542,31 @@ void cli_frontend::listroms(const char *gamename)
 				"Name                    Size Checksum\n", drivlist.driver().name);
 
 		// iterate through roms
-		for (device_t &device : device_iterator(drivlist.config().root_device()))
-			for (const rom_entry *region = rom_first_region(device); region; region = rom_next_region(region))
-				for (const rom_entry *rom = rom_first_file(region); rom; rom = rom_next_file(rom))
-				{
-					// accumulate the total length of all chunks
-					int length = -1;
-					if (ROMREGION_ISROMDATA(region))
-						length = rom_file_size(rom);
-
-					// start with the name
-					const char *name = ROM_GETNAME(rom);
-					osd_printf_info("%-20s ", name);
-
-					// output the length next
-					if (length >= 0)
-						osd_printf_info("%7d", length);
-					else
-						osd_printf_info("       ");
-
-					// output the hash data
-					hash_collection hashes(ROM_GETHASHDATA(rom));
-					if (!hashes.flag(hash_collection::FLAG_NO_DUMP))
-					{
-						if (hashes.flag(hash_collection::FLAG_BAD_DUMP))
-							osd_printf_info(" BAD");
-						osd_printf_info(" %s", hashes.macro_string().c_str());
-					}
-					else
-						osd_printf_info(" NO GOOD DUMP KNOWN");
+		for (const driver_summary::rom_info &rom : drivlist.summary().roms())
+		{
+			// start with the name
+			osd_printf_info("%-20s ", rom.name.c_str());
 
-					// end with a CR
-					osd_printf_info("\n");
-				}
+			// output the length next
+			if (rom.length >= 0)
+				osd_printf_info("%7d", rom.length);
+			else
+				osd_printf_info("       ");
+
+			// output the hash data
+			hash_collection hashes(rom.hashdata.c_str());
+			if (!hashes.flag(hash_collection::FLAG_NO_DUMP))
+			{
+				if (hashes.flag(hash_collection::FLAG_BAD_DUMP))
+					osd_printf_info(" BAD");
+				osd_printf_info(" %s", hashes.macro_string().c_str());
+			}
+			else
+				osd_printf_info(" NO GOOD DUMP KNOWN");
+
+			// end with a CR
+			osd_printf_info("\n");
+		}
 	}
 }
 
@@ -618,9 +616,9 @@ void cli_frontend::listsamples(const char *gamename)
 
 int cli_frontend::compare_devices(const void *i1, const void *i2)
 {
-	device_t *dev1 = *(device_t **)i1;
-	device_t *dev2 = *(device_t **)i2;
-	return strcmp(dev1->tag(), dev2->tag());
+	auto dev1 = *(const driver_summary::device_info **)i1;
+	auto dev2 = *(const driver_summary::device_info **)i2;
+	return strcmp(dev1->tag.c_str(), dev2->tag.c_str());
 }
 
 void cli_frontend::listdevices(const char *gamename)
@@ -641,8 +639,8 @@ void cli_frontend::listdevices(const char *gamename)
 		printf("Driver %s (%s):\n", drivlist.driver().name, drivlist.driver().description);
 
 		// build a list of devices
-		std::vector<device_t *> device_list;
-		for (device_t &device : device_iterator(drivlist.config().root_device()))
+		std::vector<const driver_summary::device_info *> device_list;
+		for (const driver_summary::device_info &device : drivlist.summary().devices())
 			device_list.push_back(&device);
 
 		// sort them by tag
@@ -652,7 +650,7 @@ void cli_frontend::listdevices(const char *gamename)
 		for (auto device : device_list)
 		{
 			// extract the tag, stripping the leading colon
-			const char *tag = device->tag();
+			const char *tag = device->tag.c_str();
 			if (*tag == ':')
 				tag++;
 
@@ -672,10 +670,10 @@ void cli_frontend::listdevices(const char *gamename)
 						depth++;
 					}
 			}
-			printf("   %*s%-*s %s", depth * 2, "", 30 - depth * 2, tag, device->name());
+			printf("   %*s%-*s %s", depth * 2, "", 30 - depth * 2, tag, device->name.c_str());
 
 			// add more information
-			UINT32 clock = device->clock();
+			UINT32 clock = device->clock;
 			if (clock >= 1000000000)
 				printf(" @ %d.%02d GHz\n", clock / 1000000000, (clock / 10000000) % 100);
 			else if (clock >= 1000000)
@@ -712,27 +710,24 @@ void cli_frontend::listslots(const char *gamename)
 	{
 		// iterate
 		bool first = true;
-		for (const device_slot_interface &slot : slot_interface_iterator(drivlist.config().root_device()))
+		for (const driver_summary::slot_info &slot : drivlist.summary().slots())
 		{
-			if (slot.fixed()) continue;
+			if (slot.fixed) continue;
 			// output the line, up to the list of extensions
-			printf("%-13s%-10s   ", first ? drivlist.driver().name : "", slot.device().tag()+1);
+			printf("%-13s%-10s   ", first ? drivlist.driver().name : "", slot.tag.c_str()+1);
 
 			bool first_option = true;
 
 			// get the options and print them
-			for (const device_slot_option &option : slot.option_list())
+			for (const driver_summary::slot_option_info &option : slot.options)
 			{
-				if (option.selectable())
+				if (option.selectable)
 				{
-					device_t *dev = (*option.devtype())(drivlist.config(), "dummy", &drivlist.config().root_device(), 0);
-					dev->config_complete();
 					if (first_option) {
-						printf("%-15s %s\n", option.name(),dev->name());
+						printf("%-15s %s\n", option.name.c_str(),option.devname.c_str());
 					} else {
-						printf("%-23s   %-15s %s\n", "",option.name(),dev->name());
+						printf("%-23s   %-15s %s\n", "",option.name.c_str(),option.devname.c_str());
 					}
-					global_free(dev);
 
 					first_option = false;
 				}
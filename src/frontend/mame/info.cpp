@@ -19,6 +19,8 @@
 #include "softlist.h"
 
 #include <ctype.h>
+#include <mutex>
+#include <sstream>
 
 #define XML_ROOT                "mame"
 #define XML_TOP                 "machine"
@@ -173,17 +175,79 @@ const char info_xml_creator::s_dtd_string[] =
 "]>";
 
 
+//**************************************************************************
+//  INFO XML CREATOR
+//**************************************************************************
+
+// drivers are generated in chunks of this many on the work queue
+static const int DRIVERS_PER_CHUNK = 64;
+
+// at most this many chunks are queued ahead of the one being written
+static const int CHUNKS_IN_FLIGHT = 64;
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> info_xml_creator::output_chunk
+
+// a run of consecutive drivers generated as one work item
+struct info_xml_creator::output_chunk
+{
+	output_chunk(info_xml_creator &owner, int index, bool devices)
+		: m_owner(owner),
+			m_index(index),
+			m_devices(devices),
+			m_item(nullptr),
+			m_exitcode(0) { }
+
+	info_xml_creator &  m_owner;            // creator that owns the shared device claims
+	int                 m_index;            // position of this chunk in the output
+	bool                m_devices;          // whether to collect devices as well
+	std::vector<int>    m_drivers;          // indexes of the drivers to generate
+	osd_work_item *     m_item;             // work item generating this chunk
+	std::string         m_machines;         // generated <machine> elements
+	std::vector<std::pair<std::string, std::string>> m_devicelist; // device shortname and element
+	std::string         m_error;            // fatal error raised while generating
+	int                 m_exitcode;         // exit code for the fatal error
+};
+
+
+
 //**************************************************************************
 //  INFO XML CREATOR
 //**************************************************************************
 
+//-------------------------------------------------
+//  normalize_string - escape a string for XML
+//  output; unlike xml_normalize_string this is
+//  safe to use from worker threads
+//-------------------------------------------------
+
+static std::string normalize_string(const char *string)
+{
+	std::string result;
+	if (string != nullptr)
+		for ( ; *string; string++)
+			switch (*string)
+			{
+				case '\"' : result.append("&quot;"); break;
+				case '&'  : result.append("&amp;"); break;
+				case '<'  : result.append("&lt;"); break;
+				case '>'  : result.append("&gt;"); break;
+				default   : result.push_back(*string); break;
+			}
+	return result;
+}
+
+
 //-------------------------------------------------
 //  info_xml_creator - constructor
 //-------------------------------------------------
 
 info_xml_creator::info_xml_creator(driver_enumerator &drivlist)
-	: m_output(nullptr),
-		m_drivlist(drivlist),
+	: m_drivlist(drivlist),
 		m_lookup_options(m_drivlist.options())
 {
 	mame_options::remove_device_options(m_lookup_options);
@@ -197,39 +261,217 @@ info_xml_creator::info_xml_creator(driver_enumerator &drivlist)
 
 void info_xml_creator::output(FILE *out, bool nodevices)
 {
-	m_output = out;
-
 	// output the DTD
-	fprintf(m_output, "<?xml version=\"1.0\"?>\n");
+	fprintf(out, "<?xml version=\"1.0\"?>\n");
 	std::string dtd(s_dtd_string);
 	strreplace(dtd, "__XML_ROOT__", XML_ROOT);
 	strreplace(dtd, "__XML_TOP__", XML_TOP);
 
-	fprintf(m_output, "%s\n\n", dtd.c_str());
+	fprintf(out, "%s\n\n", dtd.c_str());
 
 	// top-level tag
-	fprintf(m_output, "<%s build=\"%s\" debug=\""
+	fprintf(out, "%s\n", root_tag().c_str());
+
+	// split the drivers into chunks that can be generated independently
+	std::vector<std::unique_ptr<output_chunk>> chunks;
+	m_drivlist.reset();
+	while (m_drivlist.next())
+	{
+		if (chunks.empty() || chunks.back()->m_drivers.size() == DRIVERS_PER_CHUNK)
+			chunks.push_back(std::make_unique<output_chunk>(*this, chunks.size(), !nodevices));
+		chunks.back()->m_drivers.push_back(m_drivlist.current());
+	}
+	m_drivlist.reset();
+	m_device_owner.clear();
+
+	// generate them on the work queue, writing each one out in order as soon as
+	// it is ready while keeping a bounded number queued ahead
+	osd_work_queue *queue = osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI);
+	size_t queued = 0;
+	for (size_t index = 0; index < chunks.size(); index++)
+	{
+		for ( ; queued < chunks.size() && queued < index + CHUNKS_IN_FLIGHT; queued++)
+		{
+			if (queue != nullptr)
+				chunks[queued]->m_item = osd_work_item_queue(queue, generate_chunk, chunks[queued].get(), 0);
+			if (chunks[queued]->m_item == nullptr)
+				generate_chunk(chunks[queued].get(), 0);
+		}
+
+		output_chunk &chunk = *chunks[index];
+		if (chunk.m_item != nullptr)
+		{
+			while (!osd_work_item_wait(chunk.m_item, 10 * osd_ticks_per_second())) { }
+			osd_work_item_release(chunk.m_item);
+			chunk.m_item = nullptr;
+		}
+
+		// on error, let the queued work drain before reporting it
+		if (!chunk.m_error.empty())
+		{
+			for (auto &pending : chunks)
+				if (pending->m_item != nullptr)
+				{
+					while (!osd_work_item_wait(pending->m_item, 10 * osd_ticks_per_second())) { }
+					osd_work_item_release(pending->m_item);
+					pending->m_item = nullptr;
+				}
+			if (queue != nullptr)
+				osd_work_queue_free(queue);
+			throw emu_fatalerror(chunk.m_exitcode, "%s", chunk.m_error.c_str());
+		}
+
+		fwrite(chunk.m_machines.c_str(), 1, chunk.m_machines.length(), out);
+		std::string().swap(chunk.m_machines);
+	}
+	if (queue != nullptr)
+		osd_work_queue_free(queue);
+
+	// output devices (both devices with roms and slot devices) from the chunk
+	// that first referenced them
+	if (!nodevices)
+		for (auto &chunk : chunks)
+			for (auto &device : chunk->m_devicelist)
+				if (m_device_owner[device.first] == chunk->m_index)
+					fwrite(device.second.c_str(), 1, device.second.length(), out);
+
+	// close the top level tag
+	fprintf(out, "</%s>\n",XML_ROOT);
+}
+
+
+//-------------------------------------------------
+//  output_cached - print the XML information,
+//  reusing the copy in the cache directory if it
+//  was generated by this build
+//-------------------------------------------------
+
+void info_xml_creator::output_cached(FILE *out, const char *cachepath)
+{
+	std::vector<char> buffer(64 * 1024);
+	UINT32 length;
+
+	// a complete cache has our root tag near the start and the closing tag at the end
+	emu_file cache(cachepath, OPEN_FLAG_READ);
+	if (cache.open("listxml.xml") == osd_file::error::NONE)
+	{
+		static const char closing[] = "</" XML_ROOT ">\n";
+		char tail[sizeof(closing) - 1];
+		bool complete = cache.size() > sizeof(tail) && cache.seek(-INT64(sizeof(tail)), SEEK_END) == 0 &&
+				cache.read(tail, sizeof(tail)) == sizeof(tail) && memcmp(tail, closing, sizeof(tail)) == 0;
+
+		cache.seek(0, SEEK_SET);
+		length = cache.read(&buffer[0], buffer.size());
+		if (complete && std::string(&buffer[0], length).find(root_tag()) != std::string::npos)
+		{
+			do
+				fwrite(&buffer[0], 1, length, out);
+			while ((length = cache.read(&buffer[0], buffer.size())) != 0);
+			return;
+		}
+		cache.close();
+	}
+
+	// generate into a temporary file so it can be both cached and printed
+	FILE *temp = tmpfile();
+	if (temp == nullptr)
+	{
+		output(out);
+		return;
+	}
+	output(temp);
+	rewind(temp);
+
+	emu_file newcache(cachepath, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS);
+	bool caching = (newcache.open("listxml.xml") == osd_file::error::NONE);
+	while ((length = fread(&buffer[0], 1, buffer.size(), temp)) != 0)
+	{
+		fwrite(&buffer[0], 1, length, out);
+		if (caching && newcache.write(&buffer[0], length) != length)
+		{
+			newcache.remove_on_close();
+			caching = false;
+		}
+	}
+	fclose(temp);
+}
+
+
+//-------------------------------------------------
+//  root_tag - return the opening root tag, which
+//  identifies the build that generated the list
+//-------------------------------------------------
+
+std::string info_xml_creator::root_tag()
+{
+	return string_format("<%s build=\"%s\" debug=\""
 #ifdef MAME_DEBUG
 		"yes"
 #else
 		"no"
 #endif
-		"\" mameconfig=\"%d\">\n",
+		"\" mameconfig=\"%d\">",
 		XML_ROOT,
-		xml_normalize_string(emulator_info::get_build_version()),
+		normalize_string(emulator_info::get_build_version()),
 		CONFIG_VERSION
 	);
+}
 
-	// iterate through the drivers, outputting one at a time
-	while (m_drivlist.next())
-		output_one();
 
-	// output devices (both devices with roms and slot devices)
-	if (!nodevices)
-		output_devices();
+//-------------------------------------------------
+//  generate_chunk - work item callback that
+//  generates the XML for a chunk of drivers
+//-------------------------------------------------
 
-	// close the top level tag
-	fprintf(m_output, "</%s>\n",XML_ROOT);
+void *info_xml_creator::generate_chunk(void *param, int threadid)
+{
+	output_chunk &chunk = *reinterpret_cast<output_chunk *>(param);
+
+	try
+	{
+		// use private options, enumerator and creator so nothing is shared between threads
+		emu_options options(chunk.m_owner.m_drivlist.options());
+		driver_enumerator drivlist(options);
+		drivlist.exclude_all();
+		for (int index : chunk.m_drivers)
+			drivlist.include(index);
+
+		info_xml_creator creator(drivlist);
+		while (drivlist.next())
+		{
+			creator.output_one();
+			chunk.m_machines.append(creator.m_output.str());
+			creator.m_output.str("");
+
+			if (chunk.m_devices)
+				creator.collect_devices(chunk);
+		}
+	}
+	catch (emu_fatalerror &fatal)
+	{
+		chunk.m_error.assign(fatal.string());
+		chunk.m_exitcode = fatal.exitcode();
+	}
+	return nullptr;
+}
+
+
+//-------------------------------------------------
+//  claim_device - record that a chunk references
+//  a device; returns true if no earlier chunk
+//  has claimed it yet
+//-------------------------------------------------
+
+bool info_xml_creator::claim_device(const char *shortname, int chunk)
+{
+	std::lock_guard<std::mutex> lock(m_device_lock);
+	auto claim = m_device_owner.emplace(shortname, chunk);
+	if (claim.second)
+		return true;
+	if (claim.first->second <= chunk)
+		return false;
+	claim.first->second = chunk;
+	return true;
 }
 
 
@@ -282,8 +524,8 @@ void info_xml_creator::output_one()
 	}
 
 	// print the header and the game name
-	fprintf(m_output, "\t<%s",XML_TOP);
-	fprintf(m_output, " name=\"%s\"", xml_normalize_string(driver.name));
+	util::stream_format(m_output, "\t<%s",XML_TOP);
+	util::stream_format(m_output, " name=\"%s\"", normalize_string(driver.name));
 
 	// strip away any path information from the source_file and output it
 	const char *start = strrchr(driver.source_file, '/');
@@ -291,38 +533,38 @@ void info_xml_creator::output_one()
 		start = strrchr(driver.source_file, '\\');
 	if (start == nullptr)
 		start = driver.source_file - 1;
-	fprintf(m_output, " sourcefile=\"%s\"", xml_normalize_string(start + 1));
+	util::stream_format(m_output, " sourcefile=\"%s\"", normalize_string(start + 1));
 
 	// append bios and runnable flags
 	if (driver.flags & MACHINE_IS_BIOS_ROOT)
-		fprintf(m_output, " isbios=\"yes\"");
+		util::stream_format(m_output, " isbios=\"yes\"");
 	if (driver.flags & MACHINE_NO_STANDALONE)
-		fprintf(m_output, " runnable=\"no\"");
+		util::stream_format(m_output, " runnable=\"no\"");
 	if (driver.flags & MACHINE_MECHANICAL)
-		fprintf(m_output, " ismechanical=\"yes\"");
+		util::stream_format(m_output, " ismechanical=\"yes\"");
 
 	// display clone information
 	int clone_of = m_drivlist.find(driver.parent);
 	if (clone_of != -1 && !(m_drivlist.driver(clone_of).flags & MACHINE_IS_BIOS_ROOT))
-		fprintf(m_output, " cloneof=\"%s\"", xml_normalize_string(m_drivlist.driver(clone_of).name));
+		util::stream_format(m_output, " cloneof=\"%s\"", normalize_string(m_drivlist.driver(clone_of).name));
 	if (clone_of != -1)
-		fprintf(m_output, " romof=\"%s\"", xml_normalize_string(m_drivlist.driver(clone_of).name));
+		util::stream_format(m_output, " romof=\"%s\"", normalize_string(m_drivlist.driver(clone_of).name));
 
 	// display sample information and close the game tag
 	output_sampleof();
-	fprintf(m_output, ">\n");
+	util::stream_format(m_output, ">\n");
 
 	// output game description
 	if (driver.description != nullptr)
-		fprintf(m_output, "\t\t<description>%s</description>\n", xml_normalize_string(driver.description));
+		util::stream_format(m_output, "\t\t<description>%s</description>\n", normalize_string(driver.description));
 
 	// print the year only if is a number or another allowed character (? or +)
 	if (driver.year != nullptr && strspn(driver.year, "0123456789?+") == strlen(driver.year))
-		fprintf(m_output, "\t\t<year>%s</year>\n", xml_normalize_string(driver.year));
+		util::stream_format(m_output, "\t\t<year>%s</year>\n", normalize_string(driver.year));
 
 	// print the manufacturer information
 	if (driver.manufacturer != nullptr)
-		fprintf(m_output, "\t\t<manufacturer>%s</manufacturer>\n", xml_normalize_string(driver.manufacturer));
+		util::stream_format(m_output, "\t\t<manufacturer>%s</manufacturer>\n", normalize_string(driver.manufacturer));
 
 	// now print various additional information
 	output_bios();
@@ -344,7 +586,7 @@ void info_xml_creator::output_one()
 	output_ramoptions();
 
 	// close the topmost tag
-	fprintf(m_output, "\t</%s>\n",XML_TOP);
+	util::stream_format(m_output, "\t</%s>\n",XML_TOP);
 }
 
 
@@ -375,16 +617,16 @@ void info_xml_creator::output_one_device(device_t &device, const char *devtag)
 			}
 
 	// start to output info
-	fprintf(m_output, "\t<%s", XML_TOP);
-	fprintf(m_output, " name=\"%s\"", xml_normalize_string(device.shortname()));
+	util::stream_format(m_output, "\t<%s", XML_TOP);
+	util::stream_format(m_output, " name=\"%s\"", normalize_string(device.shortname()));
 	std::string src(device.source());
 	strreplace(src,"../", "");
-	fprintf(m_output, " sourcefile=\"%s\"", xml_normalize_string(src.c_str()));
-	fprintf(m_output, " isdevice=\"yes\"");
-	fprintf(m_output, " runnable=\"no\"");
+	util::stream_format(m_output, " sourcefile=\"%s\"", normalize_string(src.c_str()));
+	util::stream_format(m_output, " isdevice=\"yes\"");
+	util::stream_format(m_output, " runnable=\"no\"");
 	output_sampleof();
-	fprintf(m_output, ">\n");
-	fprintf(m_output, "\t\t<description>%s</description>\n", xml_normalize_string(device.name()));
+	util::stream_format(m_output, ">\n");
+	util::stream_format(m_output, "\t\t<description>%s</description>\n", normalize_string(device.name()));
 
 	output_rom(device);
 
@@ -402,14 +644,15 @@ void info_xml_creator::output_one_device(device_t &device, const char *devtag)
 	output_adjusters(portlist);
 	output_images(device, devtag);
 	output_slots(device, devtag);
-	fprintf(m_output, "\t</%s>\n", XML_TOP);
+	util::stream_format(m_output, "\t</%s>\n", XML_TOP);
 }
 
 
 //-------------------------------------------------
-//  output_devices - print the XML info for devices
-//  with roms and for devices that can be mounted
-//  in slots
+//  collect_devices - generate the XML info for
+//  devices with roms and for devices that can be
+//  mounted in slots of the current driver, for
+//  those not already claimed by an earlier chunk
 //  The current solution works to some extent, but
 //  it is limited by the fact that devices are only
 //  acknowledged when attached to a driver (so that
@@ -418,52 +661,49 @@ void info_xml_creator::output_one_device(device_t &device, const char *devtag)
 //  directly to a driver as device or sub-device)
 //-------------------------------------------------
 
-void info_xml_creator::output_devices()
+void info_xml_creator::collect_devices(output_chunk &chunk)
 {
-	m_drivlist.reset();
-	std::unordered_set<std::string> shortnames;
-
-	while (m_drivlist.next())
+	auto collect = [this, &chunk] (device_t &device, const char *devtag)
 	{
-		// first, run through devices with roms which belongs to the default configuration
-		for (device_t &device : device_iterator(m_drivlist.config().root_device()))
+		if (chunk.m_owner.claim_device(device.shortname(), chunk.m_index))
 		{
-			if (device.owner() != nullptr && device.shortname() != nullptr && device.shortname()[0]!='\0')
-			{
-				if (shortnames.insert(device.shortname()).second)
-					output_one_device(device, device.tag());
-			}
+			output_one_device(device, devtag);
+			chunk.m_devicelist.emplace_back(device.shortname(), m_output.str());
+			m_output.str("");
 		}
+	};
 
-		// then, run through slot devices
-		for (const device_slot_interface &slot : slot_interface_iterator(m_drivlist.config().root_device()))
-		{
-			for (const device_slot_option &option : slot.option_list())
-			{
-				std::string temptag("_");
-				temptag.append(option.name());
-				device_t *dev = const_cast<machine_config &>(m_drivlist.config()).device_add(&m_drivlist.config().root_device(), temptag.c_str(), option.devtype(), 0);
+	// first, run through devices with roms which belongs to the default configuration
+	for (device_t &device : device_iterator(m_drivlist.config().root_device()))
+	{
+		if (device.owner() != nullptr && device.shortname() != nullptr && device.shortname()[0]!='\0')
+			collect(device, device.tag());
+	}
 
-				// notify this device and all its subdevices that they are now configured
-				for (device_t &device : device_iterator(*dev))
-					if (!device.configured())
-						device.config_complete();
+	// then, run through slot devices
+	for (const device_slot_interface &slot : slot_interface_iterator(m_drivlist.config().root_device()))
+	{
+		for (const device_slot_option &option : slot.option_list())
+		{
+			std::string temptag("_");
+			temptag.append(option.name());
+			device_t *dev = const_cast<machine_config &>(m_drivlist.config()).device_add(&m_drivlist.config().root_device(), temptag.c_str(), option.devtype(), 0);
 
-				if (shortnames.insert(dev->shortname()).second)
-					output_one_device(*dev, temptag.c_str());
+			// notify this device and all its subdevices that they are now configured
+			for (device_t &device : device_iterator(*dev))
+				if (!device.configured())
+					device.config_complete();
 
-				// also, check for subdevices with ROMs (a few devices are missed otherwise, e.g. MPU401)
-				for (device_t &device : device_iterator(*dev))
-				{
-					if (device.owner() == dev && device.shortname() != nullptr && device.shortname()[0]!='\0')
-					{
-						if (shortnames.insert(device.shortname()).second)
-							output_one_device(device, device.tag());
-					}
-				}
+			collect(*dev, temptag.c_str());
 
-				const_cast<machine_config &>(m_drivlist.config()).device_remove(&m_drivlist.config().root_device(), temptag.c_str());
+			// also, check for subdevices with ROMs (a few devices are missed otherwise, e.g. MPU401)
+			for (device_t &device : device_iterator(*dev))
+			{
+				if (device.owner() == dev && device.shortname() != nullptr && device.shortname()[0]!='\0')
+					collect(device, device.tag());
 			}
+
+			const_cast<machine_config &>(m_drivlist.config()).device_remove(&m_drivlist.config().root_device(), temptag.c_str());
 		}
 	}
 }
@@ -478,7 +718,7 @@ void info_xml_creator::output_device_roms()
 {
 	for (device_t &device : device_iterator(m_drivlist.config().root_device()))
 		if (device.owner() != nullptr && device.shortname() != nullptr && device.shortname()[0] != '\0')
-			fprintf(m_output, "\t\t<device_ref name=\"%s\"/>\n", xml_normalize_string(device.shortname()));
+			util::stream_format(m_output, "\t\t<device_ref name=\"%s\"/>\n", normalize_string(device.shortname()));
 }
 
 
@@ -495,7 +735,7 @@ void info_xml_creator::output_sampleof()
 		samples_iterator sampiter(device);
 		if (sampiter.altbasename() != nullptr)
 		{
-			fprintf(m_output, " sampleof=\"%s\"", xml_normalize_string(sampiter.altbasename()));
+			util::stream_format(m_output, " sampleof=\"%s\"", normalize_string(sampiter.altbasename()));
 
 			// must stop here, as there can only be one attribute of the same name
 			return;
@@ -526,12 +766,12 @@ void info_xml_creator::output_bios()
 		if (ROMENTRY_ISSYSTEM_BIOS(rom))
 		{
 			// output extracted name and descriptions
-			fprintf(m_output, "\t\t<biosset");
-			fprintf(m_output, " name=\"%s\"", xml_normalize_string(ROM_GETNAME(rom)));
-			fprintf(m_output, " description=\"%s\"", xml_normalize_string(ROM_GETHASHDATA(rom)));
+			util::stream_format(m_output, "\t\t<biosset");
+			util::stream_format(m_output, " name=\"%s\"", normalize_string(ROM_GETNAME(rom)));
+			util::stream_format(m_output, " description=\"%s\"", normalize_string(ROM_GETHASHDATA(rom)));
 			if (defaultname == ROM_GETNAME(rom))
-				fprintf(m_output, " default=\"yes\"");
-			fprintf(m_output, "/>\n");
+				util::stream_format(m_output, " default=\"yes\"");
+			util::stream_format(m_output, "/>\n");
 		}
 }
 
@@ -595,11 +835,11 @@ void info_xml_creator::output_rom(device_t &device)
 
 				// add name, merge, bios, and size tags */
 				if (name != nullptr && name[0] != 0)
-					util::stream_format(output, " name=\"%s\"", xml_normalize_string(name));
+					util::stream_format(output, " name=\"%s\"", normalize_string(name));
 				if (merge_name != nullptr)
-					util::stream_format(output, " merge=\"%s\"", xml_normalize_string(merge_name));
+					util::stream_format(output, " merge=\"%s\"", normalize_string(merge_name));
 				if (bios_name[0] != 0)
-					util::stream_format(output, " bios=\"%s\"", xml_normalize_string(bios_name));
+					util::stream_format(output, " bios=\"%s\"", normalize_string(bios_name));
 				if (!is_disk)
 					util::stream_format(output, " size=\"%d\"", rom_file_size(rom));
 
@@ -632,7 +872,7 @@ void info_xml_creator::output_rom(device_t &device)
 
 				output << "/>\n";
 
-				fprintf(m_output, "%s", output.str().c_str());
+				util::stream_format(m_output, "%s", output.str().c_str());
 			}
 		}
 }
@@ -657,7 +897,7 @@ void info_xml_creator::output_sample(device_t &device)
 				continue;
 
 			// output the sample name
-			fprintf(m_output, "\t\t<sample name=\"%s\"/>\n", xml_normalize_string(samplename));
+			util::stream_format(m_output, "\t\t<sample name=\"%s\"/>\n", normalize_string(samplename));
 		}
 	}
 }
@@ -678,12 +918,12 @@ void info_xml_creator::output_chips(device_t &device, const char *root_tag)
 			std::string newtag(exec.device().tag()), oldtag(":");
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
-			fprintf(m_output, "\t\t<chip");
-			fprintf(m_output, " type=\"cpu\"");
-			fprintf(m_output, " tag=\"%s\"", xml_normalize_string(newtag.c_str()));
-			fprintf(m_output, " name=\"%s\"", xml_normalize_string(exec.device().name()));
-			fprintf(m_output, " clock=\"%d\"", exec.device().clock());
-			fprintf(m_output, "/>\n");
+			util::stream_format(m_output, "\t\t<chip");
+			util::stream_format(m_output, " type=\"cpu\"");
+			util::stream_format(m_output, " tag=\"%s\"", normalize_string(newtag.c_str()));
+			util::stream_format(m_output, " name=\"%s\"", normalize_string(exec.device().name()));
+			util::stream_format(m_output, " clock=\"%d\"", exec.device().clock());
+			util::stream_format(m_output, "/>\n");
 		}
 	}
 
@@ -695,13 +935,13 @@ void info_xml_creator::output_chips(device_t &device, const char *root_tag)
 			std::string newtag(sound.device().tag()), oldtag(":");
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
-			fprintf(m_output, "\t\t<chip");
-			fprintf(m_output, " type=\"audio\"");
-			fprintf(m_output, " tag=\"%s\"", xml_normalize_string(newtag.c_str()));
-			fprintf(m_output, " name=\"%s\"", xml_normalize_string(sound.device().name()));
+			util::stream_format(m_output, "\t\t<chip");
+			util::stream_format(m_output, " type=\"audio\"");
+			util::stream_format(m_output, " tag=\"%s\"", normalize_string(newtag.c_str()));
+			util::stream_format(m_output, " name=\"%s\"", normalize_string(sound.device().name()));
 			if (sound.device().clock() != 0)
-				fprintf(m_output, " clock=\"%d\"", sound.device().clock());
-			fprintf(m_output, "/>\n");
+				util::stream_format(m_output, " clock=\"%d\"", sound.device().clock());
+			util::stream_format(m_output, "/>\n");
 		}
 	}
 }
@@ -722,43 +962,43 @@ void info_xml_creator::output_display(device_t &device, const char *root_tag)
 			std::string newtag(screendev.tag()), oldtag(":");
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
-			fprintf(m_output, "\t\t<display");
-			fprintf(m_output, " tag=\"%s\"", xml_normalize_string(newtag.c_str()));
+			util::stream_format(m_output, "\t\t<display");
+			util::stream_format(m_output, " tag=\"%s\"", normalize_string(newtag.c_str()));
 
 			switch (screendev.screen_type())
 			{
-				case SCREEN_TYPE_RASTER:    fprintf(m_output, " type=\"raster\"");  break;
-				case SCREEN_TYPE_VECTOR:    fprintf(m_output, " type=\"vector\"");  break;
-				case SCREEN_TYPE_LCD:       fprintf(m_output, " type=\"lcd\"");     break;
-				default:                    fprintf(m_output, " type=\"unknown\""); break;
+				case SCREEN_TYPE_RASTER:    util::stream_format(m_output, " type=\"raster\"");  break;
+				case SCREEN_TYPE_VECTOR:    util::stream_format(m_output, " type=\"vector\"");  break;
+				case SCREEN_TYPE_LCD:       util::stream_format(m_output, " type=\"lcd\"");     break;
+				default:                    util::stream_format(m_output, " type=\"unknown\""); break;
 			}
 
 			// output the orientation as a string
 			switch (m_drivlist.driver().flags & ORIENTATION_MASK)
 			{
 				case ORIENTATION_FLIP_X:
-					fprintf(m_output, " rotate=\"0\" flipx=\"yes\"");
+					util::stream_format(m_output, " rotate=\"0\" flipx=\"yes\"");
 					break;
 				case ORIENTATION_FLIP_Y:
-					fprintf(m_output, " rotate=\"180\" flipx=\"yes\"");
+					util::stream_format(m_output, " rotate=\"180\" flipx=\"yes\"");
 					break;
 				case ORIENTATION_FLIP_X|ORIENTATION_FLIP_Y:
-					fprintf(m_output, " rotate=\"180\"");
+					util::stream_format(m_output, " rotate=\"180\"");
 					break;
 				case ORIENTATION_SWAP_XY:
-					fprintf(m_output, " rotate=\"90\" flipx=\"yes\"");
+					util::stream_format(m_output, " rotate=\"90\" flipx=\"yes\"");
 					break;
 				case ORIENTATION_SWAP_XY|ORIENTATION_FLIP_X:
-					fprintf(m_output, " rotate=\"90\"");
+					util::stream_format(m_output, " rotate=\"90\"");
 					break;
 				case ORIENTATION_SWAP_XY|ORIENTATION_FLIP_Y:
-					fprintf(m_output, " rotate=\"270\"");
+					util::stream_format(m_output, " rotate=\"270\"");
 					break;
 				case ORIENTATION_SWAP_XY|ORIENTATION_FLIP_X|ORIENTATION_FLIP_Y:
-					fprintf(m_output, " rotate=\"270\" flipx=\"yes\"");
+					util::stream_format(m_output, " rotate=\"270\" flipx=\"yes\"");
 					break;
 				default:
-					fprintf(m_output, " rotate=\"0\"");
+					util::stream_format(m_output, " rotate=\"0\"");
 					break;
 			}
 
@@ -766,12 +1006,12 @@ void info_xml_creator::output_display(device_t &device, const char *root_tag)
 			if (screendev.screen_type() != SCREEN_TYPE_VECTOR)
 			{
 				const rectangle &visarea = screendev.visible_area();
-				fprintf(m_output, " width=\"%d\"", visarea.width());
-				fprintf(m_output, " height=\"%d\"", visarea.height());
+				util::stream_format(m_output, " width=\"%d\"", visarea.width());
+				util::stream_format(m_output, " height=\"%d\"", visarea.height());
 			}
 
 			// output refresh rate
-			fprintf(m_output, " refresh=\"%f\"", ATTOSECONDS_TO_HZ(screendev.refresh_attoseconds()));
+			util::stream_format(m_output, " refresh=\"%f\"", ATTOSECONDS_TO_HZ(screendev.refresh_attoseconds()));
 
 			// output raw video parameters only for games that are not vector
 			// and had raw parameters specified
@@ -779,15 +1019,15 @@ void info_xml_creator::output_display(device_t &device, const char *root_tag)
 			{
 				int pixclock = screendev.width() * screendev.height() * ATTOSECONDS_TO_HZ(screendev.refresh_attoseconds());
 
-				fprintf(m_output, " pixclock=\"%d\"", pixclock);
-				fprintf(m_output, " htotal=\"%d\"", screendev.width());
-				fprintf(m_output, " hbend=\"%d\"", screendev.visible_area().min_x);
-				fprintf(m_output, " hbstart=\"%d\"", screendev.visible_area().max_x+1);
-				fprintf(m_output, " vtotal=\"%d\"", screendev.height());
-				fprintf(m_output, " vbend=\"%d\"", screendev.visible_area().min_y);
-				fprintf(m_output, " vbstart=\"%d\"", screendev.visible_area().max_y+1);
+				util::stream_format(m_output, " pixclock=\"%d\"", pixclock);
+				util::stream_format(m_output, " htotal=\"%d\"", screendev.width());
+				util::stream_format(m_output, " hbend=\"%d\"", screendev.visible_area().min_x);
+				util::stream_format(m_output, " hbstart=\"%d\"", screendev.visible_area().max_x+1);
+				util::stream_format(m_output, " vtotal=\"%d\"", screendev.height());
+				util::stream_format(m_output, " vbend=\"%d\"", screendev.visible_area().min_y);
+				util::stream_format(m_output, " vbstart=\"%d\"", screendev.visible_area().max_y+1);
 			}
-			fprintf(m_output, " />\n");
+			util::stream_format(m_output, " />\n");
 		}
 	}
 }
@@ -808,7 +1048,7 @@ void info_xml_creator::output_sound(device_t &device)
 	if (snditer.first() == nullptr)
 		speakers = 0;
 
-	fprintf(m_output, "\t\t<sound channels=\"%d\"/>\n", speakers);
+	util::stream_format(m_output, "\t\t<sound channels=\"%d\"/>\n", speakers);
 }
 
 
@@ -1211,15 +1451,15 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 
 	// Output the input info
 	// First basic info
-	fprintf(m_output, "\t\t<input");
-	fprintf(m_output, " players=\"%d\"", nplayer);
+	util::stream_format(m_output, "\t\t<input");
+	util::stream_format(m_output, " players=\"%d\"", nplayer);
 	if (ncoin != 0)
-		fprintf(m_output, " coins=\"%d\"", ncoin);
+		util::stream_format(m_output, " coins=\"%d\"", ncoin);
 	if (service)
-		fprintf(m_output, " service=\"yes\"");
+		util::stream_format(m_output, " service=\"yes\"");
 	if (tilt)
-		fprintf(m_output, " tilt=\"yes\"");
-	fprintf(m_output, ">\n");
+		util::stream_format(m_output, " tilt=\"yes\"");
+	util::stream_format(m_output, ">\n");
 
 	// Then controller specific ones
 	for (auto & elem : control_info)
@@ -1228,28 +1468,28 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 			//printf("type %s - player %d - buttons %d\n", elem.type, elem.player, elem.nbuttons);
 			if (elem.analog)
 			{
-				fprintf(m_output, "\t\t\t<control type=\"%s\"", xml_normalize_string(elem.type));
+				util::stream_format(m_output, "\t\t\t<control type=\"%s\"", normalize_string(elem.type));
 				if (nplayer > 1)
-					fprintf(m_output, " player=\"%d\"", elem.player);
+					util::stream_format(m_output, " player=\"%d\"", elem.player);
 				if (elem.nbuttons > 0)
 				{
-					fprintf(m_output, " buttons=\"%d\"", strcmp(elem.type, "stick") ? elem.nbuttons : elem.maxbuttons);
+					util::stream_format(m_output, " buttons=\"%d\"", strcmp(elem.type, "stick") ? elem.nbuttons : elem.maxbuttons);
 					if (elem.reqbuttons < elem.nbuttons)
-						fprintf(m_output, " reqbuttons=\"%d\"", elem.reqbuttons);
+						util::stream_format(m_output, " reqbuttons=\"%d\"", elem.reqbuttons);
 				}
 				if (elem.min != 0 || elem.max != 0)
 				{
-					fprintf(m_output, " minimum=\"%d\"", elem.min);
-					fprintf(m_output, " maximum=\"%d\"", elem.max);
+					util::stream_format(m_output, " minimum=\"%d\"", elem.min);
+					util::stream_format(m_output, " maximum=\"%d\"", elem.max);
 				}
 				if (elem.sensitivity != 0)
-					fprintf(m_output, " sensitivity=\"%d\"", elem.sensitivity);
+					util::stream_format(m_output, " sensitivity=\"%d\"", elem.sensitivity);
 				if (elem.keydelta != 0)
-					fprintf(m_output, " keydelta=\"%d\"", elem.keydelta);
+					util::stream_format(m_output, " keydelta=\"%d\"", elem.keydelta);
 				if (elem.reverse)
-					fprintf(m_output, " reverse=\"yes\"");
+					util::stream_format(m_output, " reverse=\"yes\"");
 
-				fprintf(m_output, "/>\n");
+				util::stream_format(m_output, "/>\n");
 			}
 			else
 			{
@@ -1257,14 +1497,14 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 				if (elem.helper[0] == 0 && elem.helper[1] != 0) { elem.helper[0] = elem.helper[1]; elem.helper[1] = 0; }
 				if (elem.helper[1] == 0 && elem.helper[2] != 0) { elem.helper[1] = elem.helper[2]; elem.helper[2] = 0; }
 				const char *joys = (elem.helper[2] != 0) ? "triple" : (elem.helper[1] != 0) ? "double" : "";
-				fprintf(m_output, "\t\t\t<control type=\"%s%s\"", joys, xml_normalize_string(elem.type));
+				util::stream_format(m_output, "\t\t\t<control type=\"%s%s\"", joys, normalize_string(elem.type));
 				if (nplayer > 1)
-					fprintf(m_output, " player=\"%d\"", elem.player);
+					util::stream_format(m_output, " player=\"%d\"", elem.player);
 				if (elem.nbuttons > 0)
 				{
-					fprintf(m_output, " buttons=\"%d\"", strcmp(elem.type, "joy") ? elem.nbuttons : elem.maxbuttons);
+					util::stream_format(m_output, " buttons=\"%d\"", strcmp(elem.type, "joy") ? elem.nbuttons : elem.maxbuttons);
 					if (elem.reqbuttons < elem.nbuttons)
-						fprintf(m_output, " reqbuttons=\"%d\"", elem.reqbuttons);
+						util::stream_format(m_output, " reqbuttons=\"%d\"", elem.reqbuttons);
 				}
 				for (int lp = 0; lp < 3 && elem.helper[lp] != 0; lp++)
 				{
@@ -1299,13 +1539,13 @@ void info_xml_creator::output_input(const ioport_list &portlist)
 							ways = "strange2";
 							break;
 					}
-					fprintf(m_output, " ways%s=\"%s\"", plural, ways);
+					util::stream_format(m_output, " ways%s=\"%s\"", plural, ways);
 				}
-				fprintf(m_output, "/>\n");
+				util::stream_format(m_output, "/>\n");
 			}
 		}
 
-	fprintf(m_output, "\t\t</input>\n");
+	util::stream_format(m_output, "\t\t</input>\n");
 }
 
 
@@ -1327,20 +1567,20 @@ void info_xml_creator::output_switches(const ioport_list &portlist, const char *
 				newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
 				// output the switch name information
-				std::string normalized_field_name(xml_normalize_string(field.name()));
-				std::string normalized_newtag(xml_normalize_string(newtag.c_str()));
+				std::string normalized_field_name(normalize_string(field.name()));
+				std::string normalized_newtag(normalize_string(newtag.c_str()));
 				util::stream_format(output,"\t\t<%s name=\"%s\" tag=\"%s\" mask=\"%u\">\n", outertag, normalized_field_name.c_str(), normalized_newtag.c_str(), field.mask());
 
 				// loop over settings
 				for (ioport_setting &setting : field.settings())
 				{
-					util::stream_format(output,"\t\t\t<%s name=\"%s\" value=\"%u\"%s/>\n", innertag, xml_normalize_string(setting.name()), setting.value(), setting.value() == field.defvalue() ? " default=\"yes\"" : "");
+					util::stream_format(output,"\t\t\t<%s name=\"%s\" value=\"%u\"%s/>\n", innertag, normalize_string(setting.name()), setting.value(), setting.value() == field.defvalue() ? " default=\"yes\"" : "");
 				}
 
 				// terminate the switch entry
 				util::stream_format(output,"\t\t</%s>\n", outertag);
 
-				fprintf(m_output, "%s", output.str().c_str());
+				util::stream_format(m_output, "%s", output.str().c_str());
 			}
 }
 
@@ -1353,14 +1593,14 @@ void info_xml_creator::output_ports(const ioport_list &portlist)
 	// cycle through ports
 	for (ioport_port &port : portlist)
 	{
-		fprintf(m_output,"\t\t<port tag=\"%s\">\n", xml_normalize_string(port.tag()));
+		util::stream_format(m_output, "\t\t<port tag=\"%s\">\n", normalize_string(port.tag()));
 		for (ioport_field &field : port.fields())
 		{
 			if(field.is_analog())
-				fprintf(m_output,"\t\t\t<analog mask=\"%u\"/>\n", field.mask());
+				util::stream_format(m_output, "\t\t\t<analog mask=\"%u\"/>\n", field.mask());
 		}
 		// close element
-		fprintf(m_output,"\t\t</port>\n");
+		util::stream_format(m_output, "\t\t</port>\n");
 	}
 
 }
@@ -1376,7 +1616,7 @@ void info_xml_creator::output_adjusters(const ioport_list &portlist)
 	for (ioport_port &port : portlist)
 		for (ioport_field &field : port.fields())
 			if (field.type() == IPT_ADJUSTER)
-				fprintf(m_output, "\t\t<adjuster name=\"%s\" default=\"%d\"/>\n", xml_normalize_string(field.name()), field.defvalue());
+				util::stream_format(m_output, "\t\t<adjuster name=\"%s\" default=\"%d\"/>\n", normalize_string(field.name()), field.defvalue());
 }
 
 
@@ -1386,7 +1626,7 @@ void info_xml_creator::output_adjusters(const ioport_list &portlist)
 
 void info_xml_creator::output_driver()
 {
-	fprintf(m_output, "\t\t<driver");
+	util::stream_format(m_output, "\t\t<driver");
 
 	/* The status entry is an hint for frontend authors */
 	/* to select working and not working games without */
@@ -1397,48 +1637,48 @@ void info_xml_creator::output_driver()
 	/* don't work or have major emulation problems. */
 
 	if (m_drivlist.driver().flags & (MACHINE_NOT_WORKING | MACHINE_UNEMULATED_PROTECTION | MACHINE_NO_SOUND | MACHINE_WRONG_COLORS | MACHINE_MECHANICAL))
-		fprintf(m_output, " status=\"preliminary\"");
+		util::stream_format(m_output, " status=\"preliminary\"");
 	else if (m_drivlist.driver().flags & (MACHINE_IMPERFECT_COLORS | MACHINE_IMPERFECT_SOUND | MACHINE_IMPERFECT_GRAPHICS))
-		fprintf(m_output, " status=\"imperfect\"");
+		util::stream_format(m_output, " status=\"imperfect\"");
 	else
-		fprintf(m_output, " status=\"good\"");
+		util::stream_format(m_output, " status=\"good\"");
 
 	if (m_drivlist.driver().flags & MACHINE_NOT_WORKING)
-		fprintf(m_output, " emulation=\"preliminary\"");
+		util::stream_format(m_output, " emulation=\"preliminary\"");
 	else
-		fprintf(m_output, " emulation=\"good\"");
+		util::stream_format(m_output, " emulation=\"good\"");
 
 	if (m_drivlist.driver().flags & MACHINE_WRONG_COLORS)
-		fprintf(m_output, " color=\"preliminary\"");
+		util::stream_format(m_output, " color=\"preliminary\"");
 	else if (m_drivlist.driver().flags & MACHINE_IMPERFECT_COLORS)
-		fprintf(m_output, " color=\"imperfect\"");
+		util::stream_format(m_output, " color=\"imperfect\"");
 	else
-		fprintf(m_output, " color=\"good\"");
+		util::stream_format(m_output, " color=\"good\"");
 
 	if (m_drivlist.driver().flags & MACHINE_NO_SOUND)
-		fprintf(m_output, " sound=\"preliminary\"");
+		util::stream_format(m_output, " sound=\"preliminary\"");
 	else if (m_drivlist.driver().flags & MACHINE_IMPERFECT_SOUND)
-		fprintf(m_output, " sound=\"imperfect\"");
+		util::stream_format(m_output, " sound=\"imperfect\"");
 	else
-		fprintf(m_output, " sound=\"good\"");
+		util::stream_format(m_output, " sound=\"good\"");
 
 	if (m_drivlist.driver().flags & MACHINE_IMPERFECT_GRAPHICS)
-		fprintf(m_output, " graphic=\"imperfect\"");
+		util::stream_format(m_output, " graphic=\"imperfect\"");
 	else
-		fprintf(m_output, " graphic=\"good\"");
+		util::stream_format(m_output, " graphic=\"good\"");
 
 	if (m_drivlist.driver().flags & MACHINE_NO_COCKTAIL)
-		fprintf(m_output, " cocktail=\"preliminary\"");
+		util::stream_format(m_output, " cocktail=\"preliminary\"");
 
 	if (m_drivlist.driver().flags & MACHINE_UNEMULATED_PROTECTION)
-		fprintf(m_output, " protection=\"preliminary\"");
+		util::stream_format(m_output, " protection=\"preliminary\"");
 
 	if (m_drivlist.driver().flags & MACHINE_SUPPORTS_SAVE)
-		fprintf(m_output, " savestate=\"supported\"");
+		util::stream_format(m_output, " savestate=\"supported\"");
 	else
-		fprintf(m_output, " savestate=\"unsupported\"");
+		util::stream_format(m_output, " savestate=\"unsupported\"");
 
-	fprintf(m_output, "/>\n");
+	util::stream_format(m_output, "/>\n");
 }
 
 
@@ -1458,48 +1698,48 @@ void info_xml_creator::output_images(device_t &device, const char *root_tag)
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
 			// print m_output device type
-			fprintf(m_output, "\t\t<device type=\"%s\"", xml_normalize_string(imagedev.image_type_name()));
+			util::stream_format(m_output, "\t\t<device type=\"%s\"", normalize_string(imagedev.image_type_name()));
 
 			// does this device have a tag?
 			if (imagedev.device().tag())
-				fprintf(m_output, " tag=\"%s\"", xml_normalize_string(newtag.c_str()));
+				util::stream_format(m_output, " tag=\"%s\"", normalize_string(newtag.c_str()));
 
 			// is this device available as media switch?
 			if (!loadable)
-				fprintf(m_output, " fixed_image=\"1\"");
+				util::stream_format(m_output, " fixed_image=\"1\"");
 
 			// is this device mandatory?
 			if (imagedev.must_be_loaded())
-				fprintf(m_output, " mandatory=\"1\"");
+				util::stream_format(m_output, " mandatory=\"1\"");
 
 			if (imagedev.image_interface() && imagedev.image_interface()[0])
-				fprintf(m_output, " interface=\"%s\"", xml_normalize_string(imagedev.image_interface()));
+				util::stream_format(m_output, " interface=\"%s\"", normalize_string(imagedev.image_interface()));
 
 			// close the XML tag
-			fprintf(m_output, ">\n");
+			util::stream_format(m_output, ">\n");
 
 			if (loadable)
 			{
 				const char *name = imagedev.instance_name();
 				const char *shortname = imagedev.brief_instance_name();
 
-				fprintf(m_output, "\t\t\t<instance");
-				fprintf(m_output, " name=\"%s\"", xml_normalize_string(name));
-				fprintf(m_output, " briefname=\"%s\"", xml_normalize_string(shortname));
-				fprintf(m_output, "/>\n");
+				util::stream_format(m_output, "\t\t\t<instance");
+				util::stream_format(m_output, " name=\"%s\"", normalize_string(name));
+				util::stream_format(m_output, " briefname=\"%s\"", normalize_string(shortname));
+				util::stream_format(m_output, "/>\n");
 
 				std::string extensions(imagedev.file_extensions());
 
 				char *ext = strtok((char *)extensions.c_str(), ",");
 				while (ext != nullptr)
 				{
-					fprintf(m_output, "\t\t\t<extension");
-					fprintf(m_output, " name=\"%s\"", xml_normalize_string(ext));
-					fprintf(m_output, "/>\n");
+					util::stream_format(m_output, "\t\t\t<extension");
+					util::stream_format(m_output, " name=\"%s\"", normalize_string(ext));
+					util::stream_format(m_output, "/>\n");
 					ext = strtok(nullptr, ",");
 				}
 			}
-			fprintf(m_output, "\t\t</device>\n");
+			util::stream_format(m_output, "\t\t</device>\n");
 		}
 	}
 }
@@ -1521,11 +1761,11 @@ void info_xml_creator::output_slots(device_t &device, const char *root_tag)
 			newtag = newtag.substr(newtag.find(oldtag.append(root_tag)) + oldtag.length());
 
 			// print m_output device type
-			fprintf(m_output, "\t\t<slot name=\"%s\">\n", xml_normalize_string(newtag.c_str()));
+			util::stream_format(m_output, "\t\t<slot name=\"%s\">\n", normalize_string(newtag.c_str()));
 
 			/*
 			 if (slot.slot_interface()[0])
-			 fprintf(m_output, " interface=\"%s\"", xml_normalize_string(slot.slot_interface()));
+			 util::stream_format(m_output, " interface=\"%s\"", normalize_string(slot.slot_interface()));
 			 */
 
 			for (const device_slot_option &option : slot.option_list())
@@ -1536,17 +1776,17 @@ void info_xml_creator::output_slots(device_t &device, const char *root_tag)
 					if (!dev->configured())
 						dev->config_complete();
 
-					fprintf(m_output, "\t\t\t<slotoption");
-					fprintf(m_output, " name=\"%s\"", xml_normalize_string(option.name()));
-					fprintf(m_output, " devname=\"%s\"", xml_normalize_string(dev->shortname()));
+					util::stream_format(m_output, "\t\t\t<slotoption");
+					util::stream_format(m_output, " name=\"%s\"", normalize_string(option.name()));
+					util::stream_format(m_output, " devname=\"%s\"", normalize_string(dev->shortname()));
 					if (slot.default_option() != nullptr && strcmp(slot.default_option(),option.name())==0)
-						fprintf(m_output, " default=\"yes\"");
-					fprintf(m_output, "/>\n");
+						util::stream_format(m_output, " default=\"yes\"");
+					util::stream_format(m_output, "/>\n");
 					const_cast<machine_config &>(m_drivlist.config()).device_remove(&m_drivlist.config().root_device(), "dummy");
 				}
 			}
 
-			fprintf(m_output, "\t\t</slot>\n");
+			util::stream_format(m_output, "\t\t</slot>\n");
 		}
 	}
 }
@@ -1561,11 +1801,11 @@ void info_xml_creator::output_software_list()
 {
 	for (const software_list_device &swlist : software_list_device_iterator(m_drivlist.config().root_device()))
 	{
-		fprintf(m_output, "\t\t<softwarelist name=\"%s\" ", swlist.list_name());
-		fprintf(m_output, "status=\"%s\" ", (swlist.list_type() == SOFTWARE_LIST_ORIGINAL_SYSTEM) ? "original" : "compatible");
+		util::stream_format(m_output, "\t\t<softwarelist name=\"%s\" ", swlist.list_name());
+		util::stream_format(m_output, "status=\"%s\" ", (swlist.list_type() == SOFTWARE_LIST_ORIGINAL_SYSTEM) ? "original" : "compatible");
 		if (swlist.filter())
-			fprintf(m_output, "filter=\"%s\" ", swlist.filter());
-		fprintf(m_output, "/>\n");
+			util::stream_format(m_output, "filter=\"%s\" ", swlist.filter());
+		util::stream_format(m_output, "/>\n");
 	}
 }
 
@@ -1580,7 +1820,7 @@ void info_xml_creator::output_ramoptions()
 {
 	for (const ram_device &ram : ram_device_iterator(m_drivlist.config().root_device()))
 	{
-		fprintf(m_output, "\t\t<ramoption default=\"1\">%u</ramoption>\n", ram.default_size());
+		util::stream_format(m_output, "\t\t<ramoption default=\"1\">%u</ramoption>\n", ram.default_size());
 
 		if (ram.extra_options() != nullptr)
 		{
@@ -1589,7 +1829,7 @@ void info_xml_creator::output_ramoptions()
 			{
 				std::string option;
 				option.assign(options.substr(start, (end == -1) ? -1 : end - start));
-				fprintf(m_output, "\t\t<ramoption>%u</ramoption>\n", ram_device::parse_string(option.c_str()));
+				util::stream_format(m_output, "\t\t<ramoption>%u</ramoption>\n", ram_device::parse_string(option.c_str()));
 				if (end == -1)
 					break;
 			}
@@ -13,6 +13,9 @@
 #ifndef __INFO_H__
 #define __INFO_H__
 
+#include <mutex>
+#include <sstream>
+
 class driver_enumerator;
 
 
@@ -29,8 +32,16 @@ public:
 
 	// output
 	void output(FILE *out, bool nodevices = false);
+	void output_cached(FILE *out, const char *cachepath);
 
 private:
+	struct output_chunk;
+
+	// parallel generation
+	static std::string root_tag();
+	static void *generate_chunk(void *param, int threadid);
+	bool claim_device(const char *shortname, int chunk);
+
 	// internal helper
 	void output_one();
 	void output_sampleof();
@@ -52,15 +63,19 @@ private:
 	void output_ramoptions();
 
 	void output_one_device(device_t &device, const char *devtag);
-	void output_devices();
+	void collect_devices(output_chunk &chunk);
 
 	const char *get_merge_name(const hash_collection &romhashes);
 
 	// internal state
-	FILE *                  m_output;
+	std::ostringstream      m_output;
 	driver_enumerator &     m_drivlist;
 	emu_options             m_lookup_options;
 
+	// devices claimed by the earliest chunk referencing them
+	std::mutex              m_device_lock;
+	std::unordered_map<std::string, int> m_device_owner;
+
 	static const char s_dtd_string[];
 };
 
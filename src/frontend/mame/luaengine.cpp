@@ -530,11 +530,24 @@ luabridge::LuaRef lua_engine::l_machine_get_devices(const running_machine *r)
 {
 	running_machine *m = const_cast<running_machine *>(r);
 	lua_State *L = luaThis->m_lua_state;
-	luabridge::LuaRef devs_table = luabridge::LuaRef::newTable(L);
 
+	// the set of started devices is fixed once the machine is running, so the
+	// table is only built once rather than walking the tree on every access
+	lua_getfield(L, LUA_REGISTRYINDEX, "LUA_DEVICES");
+	luabridge::LuaRef devs_table = luabridge::LuaRef::fromStack(L, -1);
+	lua_pop(L, 1);
+	if (devs_table.isTable())
+		return devs_table;
+
+	devs_table = luabridge::LuaRef::newTable(L);
 	device_t *root = &(m->root_device());
 	devs_table = devtree_dfs(root, devs_table);
 
+	if (m->phase() == MACHINE_PHASE_RUNNING)
+	{
+		devs_table.push(L);
+		lua_setfield(L, LUA_REGISTRYINDEX, "LUA_DEVICES");
+	}
 	return devs_table;
 }
 
@@ -651,6 +664,41 @@ luabridge::LuaRef lua_engine::l_ioport_get_ports(const ioport_manager *m)
 	return port_table;
 }
 
+//-------------------------------------------------
+//  ioport_read_ports - read a list of ports by tag in one call;
+//  unknown tags read as nil
+//  -> manager:machine():ioport():read_ports({":IN0", ":IN1"})
+//-------------------------------------------------
+
+int lua_engine::lua_ioport::l_read_ports(lua_State *L)
+{
+	ioport_manager &im = luabridge::Stack<ioport_manager &>::get(L, 1);
+	luaL_checktype(L, 2, LUA_TTABLE);
+	int const count = lua_rawlen(L, 2);
+	if (lua_istable(L, 3))
+		lua_settop(L, 3);
+	else
+	{
+		lua_settop(L, 2);
+		lua_createtable(L, count, 0);
+	}
+
+	for (int i = 1; i <= count; i++)
+	{
+		lua_rawgeti(L, 2, i);
+		const char *tag = lua_tostring(L, -1);
+		ioport_port *port = (tag != nullptr) ? im.ports().find(tag) : nullptr;
+		lua_pop(L, 1);
+
+		if (port != nullptr)
+			lua_pushunsigned(L, port->read());
+		else
+			lua_pushnil(L);
+		lua_rawseti(L, -2, i);
+	}
+	return 1;
+}
+
 //-------------------------------------------------
 //  ioport_fields - return table of ioport fields
 //  -> manager:machine().ioport().ports[':P1'].fields[':']
@@ -869,6 +917,401 @@ int lua_engine::lua_item::l_item_read_block(lua_State *L)
 	return 1;
 }
 
+int lua_engine::lua_item::l_item_snapshot(lua_State *L)
+{
+	luaL_argcheck(L, lua_isnumber(L, 2), 2, "offset (integer) expected");
+	luaL_argcheck(L, lua_isnumber(L, 3), 3, "length (integer) expected");
+	UINT32 offset = lua_tounsigned(L, 2);
+	UINT32 len = lua_tounsigned(L, 3);
+	if(!l_item_base || (UINT64(offset) + len > UINT64(l_item_size) * l_item_count))
+	{
+		lua_pushnil(L);
+		return 1;
+	}
+	lua_mem_snapshot *snap = new (luabridge::UserdataValue<lua_mem_snapshot>::place(L)) lua_mem_snapshot(offset, len);
+	if(len)
+		memcpy(&(*snap->l_data)[0], (UINT8 *)l_item_base + offset, len);
+	return 1;
+}
+
+//-------------------------------------------------
+//  memory snapshots - capture a range of memory
+//  and compare it against an earlier capture in
+//  native code, for the cheat finder
+//-------------------------------------------------
+
+namespace {
+
+enum mem_compare_op
+{
+	MEMCMP_LT, MEMCMP_GT, MEMCMP_EQ, MEMCMP_NE, MEMCMP_BEQ, MEMCMP_BNE,
+	MEMCMP_LTV, MEMCMP_GTV, MEMCMP_EQV, MEMCMP_NEV
+};
+
+struct mem_compare_params
+{
+	mem_compare_op op;
+	INT64 value;
+	bool bcd;
+};
+
+// load a value of Width bytes from an arbitrary offset
+template <int Width, bool Big>
+inline UINT64 mem_load(const UINT8 *p)
+{
+	UINT64 result = 0;
+	for (int i = 0; i < Width; i++)
+		result |= UINT64(p[Big ? (Width - 1 - i) : i]) << (8 * i);
+	return result;
+}
+
+template <int Width, bool Signed>
+inline UINT64 mem_extend(UINT64 raw)
+{
+	if (Signed && (Width < 8))
+		return UINT64(INT64(raw << (64 - 8 * Width)) >> (64 - 8 * Width));
+	return raw;
+}
+
+inline bool mem_is_bcd(UINT64 val)
+{
+	return (((val + 0x0666666666666666U) ^ val) & 0x1111111111111110U) == 0;
+}
+
+inline UINT64 mem_from_bcd(UINT64 val)
+{
+	UINT64 result = 0, mul = 1;
+	for ( ; val != 0; val >>= 4, mul *= 10)
+		result += (val & 0x0f) * mul;
+	return result;
+}
+
+template <int Width, bool Big, bool Signed>
+inline bool mem_test(const mem_compare_params &p, const UINT8 *newp, const UINT8 *oldp, UINT64 &mask)
+{
+	UINT64 const widthmask = (Width == 8) ? ~UINT64(0) : ((UINT64(1) << (8 * Width)) - 1);
+	UINT64 a = mem_load<Width, Big>(newp);
+	UINT64 b = mem_load<Width, Big>(oldp);
+
+	// bitmask comparisons narrow the bits carried over from the last search
+	if (p.op == MEMCMP_BNE || p.op == MEMCMP_BEQ)
+	{
+		mask &= ((p.op == MEMCMP_BNE) ? (a ^ b) : ~(a ^ b)) & widthmask;
+		return mask != 0;
+	}
+
+	if (p.bcd)
+	{
+		if (!mem_is_bcd(a) || !mem_is_bcd(b))
+			return false;
+		a = mem_from_bcd(a);
+		b = mem_from_bcd(b);
+	}
+	else
+	{
+		a = mem_extend<Width, Signed>(a);
+		b = mem_extend<Width, Signed>(b);
+	}
+
+	UINT64 const v = UINT64(p.value);
+	auto const less = [] (UINT64 x, UINT64 y) { return Signed ? (INT64(x) < INT64(y)) : (x < y); };
+	switch (p.op)
+	{
+	// a non-zero value asks for an exact difference
+	case MEMCMP_LT:     return (p.value == 0) ? less(a, b) : ((p.value > 0) && ((a + v) == b));
+	case MEMCMP_GT:     return (p.value == 0) ? less(b, a) : ((p.value > 0) && ((a - v) == b));
+	case MEMCMP_EQ:     return a == b;
+	case MEMCMP_NE:     return (p.value == 0) ? (a != b) : ((p.value > 0) && (((a - v) == b) || ((a + v) == b)));
+	case MEMCMP_LTV:    return less(a, v);
+	case MEMCMP_GTV:    return less(v, a);
+	case MEMCMP_EQV:    return a == v;
+	case MEMCMP_NEV:    return a != v;
+	default:            return false;
+	}
+}
+
+// first byte at or after start where the snapshots differ
+inline size_t mem_next_difference(const UINT8 *newp, const UINT8 *oldp, size_t start, size_t size)
+{
+	while ((start + 8) <= size)
+	{
+		UINT64 x, y;
+		memcpy(&x, newp + start, 8);
+		memcpy(&y, oldp + start, 8);
+		if (x != y)
+			break;
+		start += 8;
+	}
+	while ((start < size) && (newp[start] == oldp[start]))
+		start++;
+	return start;
+}
+
+template <int Width, bool Big, bool Signed>
+void mem_scan(const mem_compare_params &p, const std::vector<UINT8> &newdata, const std::vector<UINT8> &olddata, const std::vector<UINT32> *prev_offsets, const std::vector<UINT64> *prev_masks, std::vector<UINT32> &offsets, std::vector<UINT64> &masks)
+{
+	UINT64 const widthmask = (Width == 8) ? ~UINT64(0) : ((UINT64(1) << (8 * Width)) - 1);
+	bool const keep_masks = (p.op == MEMCMP_BEQ) || (p.op == MEMCMP_BNE);
+	size_t const size = newdata.size();
+	size_t const limit = (size >= Width) ? (size - Width + 1) : 0;
+	if (limit == 0)
+		return;
+	const UINT8 *const newp = &newdata[0];
+	const UINT8 *const oldp = &olddata[0];
+
+	auto const check = [&] (UINT32 offset, UINT64 mask)
+	{
+		if (mem_test<Width, Big, Signed>(p, newp + offset, oldp + offset, mask))
+		{
+			offsets.push_back(offset);
+			if (keep_masks)
+				masks.push_back(mask);
+		}
+	};
+
+	if (prev_offsets)
+	{
+		// successive searches only revisit the surviving candidates
+		for (size_t n = 0; n < prev_offsets->size(); n++)
+			if ((*prev_offsets)[n] < limit)
+				check((*prev_offsets)[n], prev_masks->empty() ? widthmask : (*prev_masks)[n]);
+	}
+	else if ((p.op == MEMCMP_LT) || (p.op == MEMCMP_GT) || (p.op == MEMCMP_NE) || (p.op == MEMCMP_BNE))
+	{
+		// these can only match where something changed, so skip identical stretches a word at a time
+		size_t start = 0;
+		while (start < limit)
+		{
+			size_t const diff = mem_next_difference(newp, oldp, start, size);
+			if (diff >= size)
+				break;
+			size_t const first = (diff >= (Width - 1)) ? std::max(start, diff - (Width - 1)) : start;
+			size_t const last = std::min(diff, limit - 1);
+			for (size_t offset = first; offset <= last; offset++)
+				check(offset, widthmask);
+			start = diff + 1;
+		}
+	}
+	else
+	{
+		for (size_t offset = 0; offset < limit; offset++)
+			check(offset, widthmask);
+	}
+}
+
+template <int Width>
+void mem_scan(const mem_compare_params &p, bool big, bool is_signed, const std::vector<UINT8> &newdata, const std::vector<UINT8> &olddata, const std::vector<UINT32> *prev_offsets, const std::vector<UINT64> *prev_masks, std::vector<UINT32> &offsets, std::vector<UINT64> &masks)
+{
+	if (big)
+		is_signed ? mem_scan<Width, true, true>(p, newdata, olddata, prev_offsets, prev_masks, offsets, masks) : mem_scan<Width, true, false>(p, newdata, olddata, prev_offsets, prev_masks, offsets, masks);
+	else
+		is_signed ? mem_scan<Width, false, true>(p, newdata, olddata, prev_offsets, prev_masks, offsets, masks) : mem_scan<Width, false, false>(p, newdata, olddata, prev_offsets, prev_masks, offsets, masks);
+}
+
+// parse a string.pack style format: optional < or >, then b/h/l/j (signed) or B/H/L/J (unsigned)
+bool mem_parse_format(const char *format, UINT8 &width, bool &big, bool &is_signed)
+{
+#ifdef LSB_FIRST
+	big = false;
+#else
+	big = true;
+#endif
+	if (*format == '<' || *format == '>' || *format == '=')
+	{
+		if (*format != '=')
+			big = (*format == '>');
+		format++;
+	}
+	is_signed = islower(UINT8(*format));
+	switch (tolower(UINT8(*format)))
+	{
+	case 'b':   width = 1; break;
+	case 'h':   width = 2; break;
+	case 'i':
+	case 'l':   width = 4; break;
+	case 'j':   width = 8; break;
+	default:    return false;
+	}
+	return format[1] == 0;
+}
+
+// read a value the way the read_* functions do
+template <typename T>
+T mem_read_value(address_space &sp, offs_t address)
+{
+	switch(sizeof(T) * 8) {
+		case 8:
+			return sp.read_byte(address);
+		case 16:
+			return WORD_ALIGNED(address) ? sp.read_word(address) : sp.read_word_unaligned(address);
+		case 32:
+			return DWORD_ALIGNED(address) ? sp.read_dword(address) : sp.read_dword_unaligned(address);
+		case 64:
+			return QWORD_ALIGNED(address) ? sp.read_qword(address) : sp.read_qword_unaligned(address);
+		default:
+			return 0;
+	}
+}
+
+// read every address in the table at index 2 into the table on top of the stack
+template <typename T>
+void mem_read_list(lua_State *L, address_space &sp, int count)
+{
+	for (int i = 1; i <= count; i++)
+	{
+		lua_rawgeti(L, 2, i);
+		if (!lua_isnumber(L, -1))
+			luaL_argerror(L, 2, "addresses (integers) expected");
+		offs_t const address = lua_tounsigned(L, -1);
+		lua_pop(L, 1);
+
+		T const value = mem_read_value<T>(sp, address);
+		if (std::numeric_limits<T>::is_signed)
+			lua_pushinteger(L, value);
+		else
+			lua_pushunsigned(L, value);
+		lua_rawseti(L, -2, i);
+	}
+}
+
+} // anonymous namespace
+
+//-------------------------------------------------
+//  mem_snapshot - copy a range of an address space
+//  -> manager:machine().devices[":maincpu"].spaces["program"]:snapshot(0xC000, 0x2000)
+//-------------------------------------------------
+
+int lua_engine::lua_addr_space::l_mem_snapshot(lua_State *L)
+{
+	address_space &sp = luabridge::Stack<address_space &>::get(L, 1);
+	luaL_argcheck(L, lua_isnumber(L, 2), 2, "address (integer) expected");
+	luaL_argcheck(L, lua_isnumber(L, 3), 3, "length (integer) expected");
+	offs_t address = lua_tounsigned(L, 2);
+	UINT32 len = lua_tounsigned(L, 3);
+	lua_mem_snapshot *snap = new (luabridge::UserdataValue<lua_mem_snapshot>::place(L)) lua_mem_snapshot(address, len);
+	UINT8 *dest = len ? &(*snap->l_data)[0] : nullptr;
+	for(UINT32 i = 0; i < len; i++)
+		dest[i] = sp.read_byte(address + i);
+	return 1;
+}
+
+//-------------------------------------------------
+//  region_snapshot - copy a range of a region
+//  -> manager:machine():memory().region[":maincpu"]:snapshot(0, 0x1000)
+//-------------------------------------------------
+
+int lua_engine::lua_memory_region::l_region_snapshot(lua_State *L)
+{
+	memory_region &region = luabridge::Stack<memory_region &>::get(L, 1);
+	luaL_argcheck(L, lua_isnumber(L, 2), 2, "offset (integer) expected");
+	luaL_argcheck(L, lua_isnumber(L, 3), 3, "length (integer) expected");
+	UINT32 offset = lua_tounsigned(L, 2);
+	UINT32 len = lua_tounsigned(L, 3);
+	if(UINT64(offset) + len > region.bytes())
+	{
+		lua_pushnil(L);
+		return 1;
+	}
+	lua_mem_snapshot *snap = new (luabridge::UserdataValue<lua_mem_snapshot>::place(L)) lua_mem_snapshot(offset, len);
+	if(len)
+		memcpy(&(*snap->l_data)[0], region.base() + offset, len);
+	return 1;
+}
+
+//-------------------------------------------------
+//  snapshot_compare - compare a snapshot (left
+//  operand) with an older one of the same range
+//  (right operand), optionally only at the
+//  addresses that matched a previous search
+//  -> new:compare(old, "ne", "<H", 0, false, lastmatches)
+//-------------------------------------------------
+
+int lua_engine::lua_mem_snapshot::l_compare(lua_State *L)
+{
+	static const char *const opnames[] = { "lt", "gt", "eq", "ne", "beq", "bne", "ltv", "gtv", "eqv", "nev", nullptr };
+
+	lua_mem_snapshot &self = luabridge::Stack<lua_mem_snapshot &>::get(L, 1);
+	lua_mem_snapshot *old = lua_isnoneornil(L, 2) ? &self : luabridge::Stack<lua_mem_snapshot *>::get(L, 2);
+	mem_compare_params params;
+	params.op = mem_compare_op(luaL_checkoption(L, 3, nullptr, opnames));
+	const char *format = luaL_optstring(L, 4, "B");
+	params.value = luaL_optinteger(L, 5, 0);
+	params.bcd = lua_toboolean(L, 6);
+	lua_mem_matches *prev = lua_isnoneornil(L, 7) ? nullptr : luabridge::Stack<lua_mem_matches *>::get(L, 7);
+
+	// comparisons against another snapshot need one
+	bool const against_value = (params.op >= MEMCMP_LTV);
+	luaL_argcheck(L, against_value || (old != &self), 2, "snapshot expected");
+
+	lua_mem_matches *result = new (luabridge::UserdataValue<lua_mem_matches>::place(L)) lua_mem_matches();
+	result->l_start = self.l_start;
+	result->l_new = self.l_data;
+	result->l_old = prev ? prev->l_old : old->l_data;
+	if (!mem_parse_format(format, result->l_width, result->l_big, result->l_signed))
+		return luaL_argerror(L, 4, "invalid format");
+
+	// searches only make sense over the same range
+	if ((old->l_start != self.l_start) || (old->size() != self.size()))
+		return 1;
+	if (prev && ((prev->l_start != self.l_start) || (prev->l_new->size() != self.size())))
+		return 1;
+
+	const std::vector<UINT32> *prev_offsets = prev ? &prev->l_offsets : nullptr;
+	const std::vector<UINT64> *prev_masks = prev ? &prev->l_masks : nullptr;
+	switch (result->l_width)
+	{
+	case 1: mem_scan<1>(params, result->l_big, result->l_signed, *self.l_data, *old->l_data, prev_offsets, prev_masks, result->l_offsets, result->l_masks); break;
+	case 2: mem_scan<2>(params, result->l_big, result->l_signed, *self.l_data, *old->l_data, prev_offsets, prev_masks, result->l_offsets, result->l_masks); break;
+	case 4: mem_scan<4>(params, result->l_big, result->l_signed, *self.l_data, *old->l_data, prev_offsets, prev_masks, result->l_offsets, result->l_masks); break;
+	case 8: mem_scan<8>(params, result->l_big, result->l_signed, *self.l_data, *old->l_data, prev_offsets, prev_masks, result->l_offsets, result->l_masks); break;
+	}
+	result->l_offsets.shrink_to_fit();
+	result->l_masks.shrink_to_fit();
+	return 1;
+}
+
+//-------------------------------------------------
+//  matches_get - return a table describing one
+//  match (1-based)
+//  -> matches:get(1).addr
+//-------------------------------------------------
+
+int lua_engine::lua_mem_matches::l_get(lua_State *L)
+{
+	lua_mem_matches &self = luabridge::Stack<lua_mem_matches &>::get(L, 1);
+	lua_Integer index = luaL_checkinteger(L, 2);
+	if((index < 1) || (index > self.l_offsets.size()))
+	{
+		lua_pushnil(L);
+		return 1;
+	}
+
+	UINT32 const offset = self.l_offsets[index - 1];
+	auto const value = [&self, offset] (const std::vector<UINT8> &data)
+	{
+		UINT64 result = 0;
+		for (int i = 0; i < self.l_width; i++)
+			result |= UINT64(data[offset + (self.l_big ? (self.l_width - 1 - i) : i)]) << (8 * i);
+		if (self.l_signed && (self.l_width < 8))
+			result = UINT64(INT64(result << (64 - 8 * self.l_width)) >> (64 - 8 * self.l_width));
+		return result;
+	};
+
+	lua_createtable(L, 0, 4);
+	lua_pushunsigned(L, self.l_start + offset);
+	lua_setfield(L, -2, "addr");
+	lua_pushinteger(L, lua_Integer(value(*self.l_old)));
+	lua_setfield(L, -2, "oldval");
+	lua_pushinteger(L, lua_Integer(value(*self.l_new)));
+	lua_setfield(L, -2, "newval");
+	if(!self.l_masks.empty())
+	{
+		lua_pushinteger(L, lua_Integer(self.l_masks[index - 1]));
+		lua_setfield(L, -2, "bitmask");
+	}
+	return 1;
+}
+
 //-------------------------------------------------
 //  state_get_value - return value of a device state entry
 //  -> manager:machine().devices[":maincpu"].state["PC"].value
@@ -910,35 +1353,7 @@ int lua_engine::lua_addr_space::l_mem_read(lua_State *L)
 	address_space &sp = luabridge::Stack<address_space &>::get(L, 1);
 	luaL_argcheck(L, lua_isnumber(L, 2), 2, "address (integer) expected");
 	offs_t address = lua_tounsigned(L, 2);
-	T mem_content = 0;
-	switch(sizeof(mem_content) * 8) {
-		case 8:
-			mem_content = sp.read_byte(address);
-			break;
-		case 16:
-			if (WORD_ALIGNED(address)) {
-				mem_content = sp.read_word(address);
-			} else {
-				mem_content = sp.read_word_unaligned(address);
-			}
-			break;
-		case 32:
-			if (DWORD_ALIGNED(address)) {
-				mem_content = sp.read_dword(address);
-			} else {
-				mem_content = sp.read_dword_unaligned(address);
-			}
-			break;
-		case 64:
-			if (QWORD_ALIGNED(address)) {
-				mem_content = sp.read_qword(address);
-			} else {
-				mem_content = sp.read_qword_unaligned(address);
-			}
-			break;
-		default:
-			break;
-	}
+	T mem_content = mem_read_value<T>(sp, address);
 
 	if (std::numeric_limits<T>::is_signed) {
 		lua_pushinteger(L, mem_content);
@@ -950,6 +1365,40 @@ int lua_engine::lua_addr_space::l_mem_read(lua_State *L)
 
 }
 
+//-------------------------------------------------
+//  mem_read_batch - read a list of addresses in one call; the
+//  result can be written into an existing table to avoid
+//  creating one every frame
+//  -> manager:machine().devices[":maincpu"].spaces["program"]:read_batch({0xC000, 0xC010}, "u16")
+//-------------------------------------------------
+
+int lua_engine::lua_addr_space::l_mem_read_batch(lua_State *L)
+{
+	address_space &sp = luabridge::Stack<address_space &>::get(L, 1);
+	luaL_checktype(L, 2, LUA_TTABLE);
+	std::string type = luaL_optstring(L, 3, "u8");
+	int const count = lua_rawlen(L, 2);
+	if (lua_istable(L, 4))
+		lua_settop(L, 4);
+	else
+	{
+		lua_settop(L, 3);
+		lua_createtable(L, count, 0);
+	}
+
+	if (type == "i8") mem_read_list<INT8>(L, sp, count);
+	else if (type == "u8") mem_read_list<UINT8>(L, sp, count);
+	else if (type == "i16") mem_read_list<INT16>(L, sp, count);
+	else if (type == "u16") mem_read_list<UINT16>(L, sp, count);
+	else if (type == "i32") mem_read_list<INT32>(L, sp, count);
+	else if (type == "u32") mem_read_list<UINT32>(L, sp, count);
+	else if (type == "i64") mem_read_list<INT64>(L, sp, count);
+	else if (type == "u64") mem_read_list<UINT64>(L, sp, count);
+	else
+		return luaL_argerror(L, 3, "invalid type");
+	return 1;
+}
+
 //-------------------------------------------------
 //  mem_write - templated memory writer for <sign>,<size>
 //  -> manager:machine().devices[":maincpu"].spaces["program"]:write_u16(0xC000, 0xF00D)
@@ -1694,6 +2143,8 @@ static void *serve_lua(void *param)
 lua_engine::lua_engine()
 {
 	m_machine = nullptr;
+	m_lua_ticks = 0;
+	m_lua_frames = 0;
 	luaThis = this;
 	m_lua_state = luaL_newstate();  /* create state */
 	output_notifier_set = false;
@@ -1949,6 +2400,11 @@ void lua_engine::on_machine_start()
 void lua_engine::on_machine_stop()
 {
 	execute_function("LUA_ON_STOP");
+
+	// report the per-frame cost of scripts alongside the average speed
+	if (m_lua_frames != 0 && m_lua_ticks != 0)
+		osd_printf_info("Lua scripts: %.3f ms per frame (%u frames)\n",
+			1000.0 * double(m_lua_ticks) / double(osd_ticks_per_second()) / double(m_lua_frames), m_lua_frames);
 }
 
 void lua_engine::on_machine_pause()
@@ -1963,16 +2419,25 @@ void lua_engine::on_machine_resume()
 
 void lua_engine::on_machine_frame()
 {
+	m_lua_frames++;
+	lua_timer timer(*this);
 	execute_function("LUA_ON_FRAME");
 }
 
 void lua_engine::on_frame_done()
 {
+	lua_timer timer(*this);
 	execute_function("LUA_ON_FRAME_DONE");
 }
 
 void lua_engine::update_machine()
 {
+	// forget anything cached from the previous machine
+	lua_pushnil(m_lua_state);
+	lua_setfield(m_lua_state, LUA_REGISTRYINDEX, "LUA_DEVICES");
+	m_lua_ticks = 0;
+	m_lua_frames = 0;
+
 	lua_newtable(m_lua_state);
 	if (m_machine!=nullptr)
 	{
@@ -2182,7 +2647,10 @@ void lua_engine::initialize()
 				.addFunction ("select_previous_state", &cheat_entry::select_previous_state)
 				.addFunction ("select_next_state", &cheat_entry::select_next_state)
 			.endClass()
-			.beginClass <ioport_manager> ("ioport")
+			.beginClass <lua_ioport> ("lua_ioport")
+				.addCFunction ("read_ports", &lua_ioport::l_read_ports)
+			.endClass()
+			.deriveClass <ioport_manager, lua_ioport> ("ioport")
 				.addFunction ("has_configs", &ioport_manager::has_configs)
 				.addFunction ("has_analog", &ioport_manager::has_analog)
 				.addFunction ("has_dips", &ioport_manager::has_dips)
@@ -2273,6 +2741,7 @@ void lua_engine::initialize()
 				.addCFunction ("read_u32", &lua_addr_space::l_mem_read<UINT32>)
 				.addCFunction ("read_i64", &lua_addr_space::l_mem_read<INT64>)
 				.addCFunction ("read_u64", &lua_addr_space::l_mem_read<UINT64>)
+				.addCFunction ("read_batch", &lua_addr_space::l_mem_read_batch)
 				.addCFunction ("write_i8", &lua_addr_space::l_mem_write<INT8>)
 				.addCFunction ("write_u8", &lua_addr_space::l_mem_write<UINT8>)
 				.addCFunction ("write_i16", &lua_addr_space::l_mem_write<INT16>)
@@ -2297,6 +2766,7 @@ void lua_engine::initialize()
 				.addCFunction ("write_direct_u32", &lua_addr_space::l_direct_mem_write<UINT32>)
 				.addCFunction ("write_direct_i64", &lua_addr_space::l_direct_mem_write<INT64>)
 				.addCFunction ("write_direct_u64", &lua_addr_space::l_direct_mem_write<UINT64>)
+				.addCFunction ("snapshot", &lua_addr_space::l_mem_snapshot)
 			.endClass()
 			.deriveClass <address_space, lua_addr_space> ("addr_space")
 				.addFunction("name", &address_space::name)
@@ -2393,6 +2863,7 @@ void lua_engine::initialize()
 				.addCFunction ("write_u32", &lua_memory_region::l_region_write<UINT32>)
 				.addCFunction ("write_i64", &lua_memory_region::l_region_write<INT64>)
 				.addCFunction ("write_u64", &lua_memory_region::l_region_write<UINT64>)
+				.addCFunction ("snapshot", &lua_memory_region::l_region_snapshot)
 			.endClass()
 			.beginClass <output_manager> ("output")
 				.addFunction ("set_value", &output_manager::set_value)
@@ -2439,6 +2910,16 @@ void lua_engine::initialize()
 				.addCFunction ("read", &lua_item::l_item_read)
 				.addCFunction ("read_block", &lua_item::l_item_read_block)
 				.addCFunction ("write", &lua_item::l_item_write)
+				.addCFunction ("snapshot", &lua_item::l_item_snapshot)
+			.endClass()
+			.beginClass <lua_mem_snapshot> ("mem_snapshot")
+				.addData ("start", &lua_mem_snapshot::l_start, false)
+				.addProperty <UINT32> ("size", &lua_mem_snapshot::size)
+				.addCFunction ("compare", &lua_mem_snapshot::l_compare)
+			.endClass()
+			.beginClass <lua_mem_matches> ("mem_matches")
+				.addProperty <UINT32> ("count", &lua_mem_matches::count)
+				.addCFunction ("get", &lua_mem_matches::l_get)
 			.endClass()
 		.endNamespace();
 
@@ -2464,6 +2945,7 @@ bool lua_engine::frame_hook()
 		// invoke registered callback (if any)
 		is_cb_hooked = hook_frame_cb.active();
 		if (is_cb_hooked) {
+			lua_timer timer(*this);
 			lua_State *L = hook_frame_cb.precall();
 			hook_frame_cb.call(this, L, 0);
 		}
@@ -89,6 +89,22 @@ private:
 
 	hook hook_frame_cb;
 
+	// time spent in per-frame scripts, reported at exit
+	osd_ticks_t         m_lua_ticks;
+	UINT32              m_lua_frames;
+
+	// accumulates the time until it goes out of scope
+	class lua_timer
+	{
+	public:
+		lua_timer(lua_engine &engine) : m_engine(engine), m_start(osd_ticks()) { g_profiler.start(PROFILER_LUA); }
+		~lua_timer() { g_profiler.stop(); m_engine.m_lua_ticks += osd_ticks() - m_start; }
+
+	private:
+		lua_engine &        m_engine;
+		osd_ticks_t         m_start;
+	};
+
 	static lua_engine*  luaThis;
 
 	std::map<lua_State *, std::pair<lua_State *, int> > thread_registry;
@@ -149,6 +165,9 @@ private:
 	static luabridge::LuaRef l_machine_get_devices(const running_machine *r);
 	static luabridge::LuaRef l_machine_get_images(const running_machine *r);
 	static luabridge::LuaRef l_ioport_get_ports(const ioport_manager *i);
+	struct lua_ioport {
+		int l_read_ports(lua_State *L);
+	};
 	static luabridge::LuaRef l_render_get_targets(const render_manager *r);
 	static luabridge::LuaRef l_ioports_port_get_fields(const ioport_port *i);
 	static luabridge::LuaRef devtree_dfs(device_t *root, luabridge::LuaRef dev_table);
@@ -162,9 +181,11 @@ private:
 	};
 	struct lua_addr_space {
 		template<typename T> int l_mem_read(lua_State *L);
+		int l_mem_read_batch(lua_State *L);
 		template<typename T> int l_mem_write(lua_State *L);
 		template<typename T> int l_direct_mem_read(lua_State *L);
 		template<typename T> int l_direct_mem_write(lua_State *L);
+		int l_mem_snapshot(lua_State *L);
 	};
 	static luabridge::LuaRef l_addr_space_map(const address_space *as);
 
@@ -202,6 +223,7 @@ private:
 	struct lua_memory_region {
 		template<typename T> int l_region_read(lua_State *L);
 		template<typename T> int l_region_write(lua_State *L);
+		int l_region_snapshot(lua_State *L);
 	};
 
 	struct lua_ui_input {
@@ -233,6 +255,30 @@ private:
 		int l_item_read(lua_State *L);
 		int l_item_read_block(lua_State *L);
 		int l_item_write(lua_State *L);
+		int l_item_snapshot(lua_State *L);
+	};
+
+	// copy of a range of memory for cheat searching
+	struct lua_mem_snapshot {
+		lua_mem_snapshot(offs_t start, UINT32 size) : l_start(start), l_data(std::make_shared<std::vector<UINT8>>(size)) {}
+		offs_t l_start;
+		std::shared_ptr<std::vector<UINT8>> l_data;
+		UINT32 size() const { return l_data->size(); }
+		int l_compare(lua_State *L);
+	};
+
+	// addresses that passed a comparison between two snapshots
+	struct lua_mem_matches {
+		offs_t l_start;
+		UINT8 l_width;
+		bool l_big;
+		bool l_signed;
+		std::shared_ptr<std::vector<UINT8>> l_old;      // oldest right operand in the chain
+		std::shared_ptr<std::vector<UINT8>> l_new;      // most recent left operand
+		std::vector<UINT32> l_offsets;                  // byte offsets into the snapshots, ascending
+		std::vector<UINT64> l_masks;                    // differing or equal bits, for bitmask comparisons
+		UINT32 count() const { return l_offsets.size(); }
+		int l_get(lua_State *L);
 	};
 
 	void resume(void *L, INT32 param);
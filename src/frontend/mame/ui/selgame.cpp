@@ -1513,11 +1513,11 @@ void menu_select_game::populate_search()
 	// allocate memory to track the penalty value
 	std::vector<int> penalty(VISIBLE_GAMES_IN_SEARCH, 9999);
 	int index = 0;
-	for (; index < m_displaylist.size(); ++index)
+	auto consider = [&](const game_driver *driver)
 	{
 		// pick the best match between driver name and description
-		int curpenalty = fuzzy_substring(m_search, m_displaylist[index]->description);
-		int tmp = fuzzy_substring(m_search, m_displaylist[index]->name);
+		int curpenalty = fuzzy_substring(m_search, driver->description);
+		int tmp = fuzzy_substring(m_search, driver->name);
 		curpenalty = MIN(curpenalty, tmp);
 
 		// insert into the sorted table of matches
@@ -1534,9 +1534,43 @@ void menu_select_game::populate_search()
 				m_searchlist[matchnum + 1] = m_searchlist[matchnum];
 			}
 
-			m_searchlist[matchnum] = m_displaylist[index];
+			m_searchlist[matchnum] = driver;
 			penalty[matchnum] = curpenalty;
 		}
+		++index;
+	};
+
+	bool shortlisted = false;
+	if (trigram_index::usable(m_search))
+	{
+		// index the display list the first time it is searched
+		if (m_searchindexed != m_displaylist)
+		{
+			m_searchindex.reset();
+			for (int curitem = 0; curitem < m_displaylist.size(); ++curitem)
+			{
+				m_searchindex.add(curitem, m_displaylist[curitem]->name);
+				m_searchindex.add(curitem, m_displaylist[curitem]->description);
+			}
+			m_searchindex.finalize();
+			m_searchindexed = m_displaylist;
+		}
+
+		// only rank the machines sharing the most trigrams with the search; if
+		// too few share any, the search is likely misspelt, so rank everything
+		std::vector<int> candidates;
+		m_searchindex.candidates(m_search, VISIBLE_GAMES_IN_SEARCH * 4, candidates);
+		if (candidates.size() >= VISIBLE_GAMES_IN_SEARCH * 4)
+		{
+			for (int curitem : candidates)
+				consider(m_displaylist[curitem]);
+			shortlisted = true;
+		}
+	}
+	if (!shortlisted)
+	{
+		for (const game_driver *driver : m_displaylist)
+			consider(driver);
 	}
 
 	(index < VISIBLE_GAMES_IN_SEARCH) ? m_searchlist[index] = nullptr : m_searchlist[VISIBLE_GAMES_IN_SEARCH] = nullptr;
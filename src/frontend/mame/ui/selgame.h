@@ -14,6 +14,7 @@
 #define MAME_FRONTEND_UI_SELGAME_H
 
 #include "ui/menu.h"
+#include "trigram.h"
 
 
 namespace ui {
@@ -57,6 +58,8 @@ private:
 	std::vector<const game_driver *> m_displaylist;
 
 	const game_driver *m_searchlist[VISIBLE_GAMES_IN_SEARCH + 1];
+	std::vector<const game_driver *> m_searchindexed;   // m_displaylist as covered by m_searchindex
+	trigram_index m_searchindex;
 
 	// internal methods
 	void build_custom();
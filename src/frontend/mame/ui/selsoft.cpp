@@ -1316,12 +1316,11 @@ void menu_select_software::find_matches(const char *str, int count)
 	// allocate memory to track the penalty value
 	std::vector<int> penalty(count, 9999);
 	int index = 0;
-
-	for (; index < m_displaylist.size(); ++index)
+	auto consider = [&](ui_software_info *swinfo)
 	{
 		// pick the best match between driver name and description
-		int curpenalty = fuzzy_substring(str, m_displaylist[index]->longname);
-		int tmp = fuzzy_substring(str, m_displaylist[index]->shortname);
+		int curpenalty = fuzzy_substring(str, swinfo->longname);
+		int tmp = fuzzy_substring(str, swinfo->shortname);
 		curpenalty = MIN(curpenalty, tmp);
 
 		// insert into the sorted table of matches
@@ -1338,9 +1337,43 @@ void menu_select_software::find_matches(const char *str, int count)
 				m_searchlist[matchnum + 1] = m_searchlist[matchnum];
 			}
 
-			m_searchlist[matchnum] = m_displaylist[index];
+			m_searchlist[matchnum] = swinfo;
 			penalty[matchnum] = curpenalty;
 		}
+		++index;
+	};
+
+	bool shortlisted = false;
+	if (trigram_index::usable(str))
+	{
+		// index the display list the first time it is searched
+		if (m_searchindexed != m_displaylist)
+		{
+			m_searchindex.reset();
+			for (int curitem = 0; curitem < m_displaylist.size(); ++curitem)
+			{
+				m_searchindex.add(curitem, m_displaylist[curitem]->shortname.c_str());
+				m_searchindex.add(curitem, m_displaylist[curitem]->longname.c_str());
+			}
+			m_searchindex.finalize();
+			m_searchindexed = m_displaylist;
+		}
+
+		// only rank the software sharing the most trigrams with the search; if
+		// too few share any, the search is likely misspelt, so rank everything
+		std::vector<int> candidates;
+		m_searchindex.candidates(str, count * 4, candidates);
+		if (candidates.size() >= count * 4)
+		{
+			for (int curitem : candidates)
+				consider(m_displaylist[curitem]);
+			shortlisted = true;
+		}
+	}
+	if (!shortlisted)
+	{
+		for (ui_software_info *swinfo : m_displaylist)
+			consider(swinfo);
 	}
 	(index < count) ? m_searchlist[index] = nullptr : m_searchlist[count] = nullptr;
 }
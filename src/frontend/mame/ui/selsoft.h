@@ -13,6 +13,7 @@
 #define MAME_FRONTEND_UI_SELSOFT_H
 
 #include "ui/custmenu.h"
+#include "trigram.h"
 
 namespace ui {
 
@@ -46,6 +47,8 @@ private:
 	int                 highlight;
 
 	ui_software_info                  *m_searchlist[VISIBLE_GAMES_IN_SEARCH + 1];
+	std::vector<ui_software_info *>   m_searchindexed;    // m_displaylist as covered by m_searchindex
+	trigram_index                     m_searchindex;
 	std::vector<ui_software_info *>   m_displaylist, m_tmp, m_sortedlist;
 	std::vector<ui_software_info>     m_swinfo;
 
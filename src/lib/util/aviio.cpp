@@ -6,12 +6,34 @@
 
     AVI movie format parsing helpers.
 
+    Besides raw RGB and the YUV formats, movies can be written with the
+    MLSC lossless codec.  Each frame is cut into bands of rows (slices)
+    that are compressed independently, so they can be encoded and decoded
+    on worker threads.  Frame layout, all values little-endian:
+
+        1 byte      version (MLSC_VERSION)
+        1 byte      reserved, 0
+        2 bytes     number of slices
+        4 bytes     compressed length, once per slice
+        ...         the slices, each a zlib stream
+
+    Slice i covers rows [height * i / count, height * (i + 1) / count).
+    Each row is stored as three planes of width bytes: green, red minus
+    green and blue minus green.  Every byte is replaced by its difference
+    from the LOCO-I median predictor of its left, upper and upper-left
+    neighbours in the same plane; the first row of a slice only predicts
+    from the left, so slices don't depend on each other.
+
 ***************************************************************************/
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cstdlib>
 #include <cstring>
+#include <vector>
+
+#include <zlib.h>
 
 #include "aviio.h"
 
@@ -112,6 +134,8 @@
 #define HANDLER_DIB             AVI_FOURCC('D','I','B',' ')
 /** @brief  The handler hfyu. */
 #define HANDLER_HFYU            AVI_FOURCC('h','f','y','u')
+/** @brief  The handler mlsc. */
+#define HANDLER_MLSC            AVI_FOURCC('m','l','s','c')
 
 /* main AVI header files */
 
@@ -189,6 +213,15 @@
 
 #define AVI_INDEX_2FIELD        0x01
 
+/* MLSC definitions */
+
+/** @brief  The MLSC frame layout version. */
+#define MLSC_VERSION            1
+/** @brief  Rows per slice we aim for when writing. */
+#define MLSC_SLICE_ROWS         32
+/** @brief  The most slices we write per frame. */
+#define MLSC_MAX_SLICES         32
+
 /* HuffYUV definitions */
 
 /**
@@ -348,6 +381,14 @@ public:
 	// HuffYUV helpers
 	avi_file::error huffyuv_decompress_to_yuy16(const std::uint8_t *data, std::uint32_t numbytes, bitmap_yuy16 &bitmap) const;
 
+	// RGB readback
+	avi_file::error rgb_decompress_to_rgb32(const std::uint8_t *data, std::uint32_t numbytes, bitmap_rgb32 &bitmap) const;
+
+	// MLSC helpers
+	int lossless_slices() const { return (std::max<int>)(1, (std::min<int>)(MLSC_MAX_SLICES, m_height / MLSC_SLICE_ROWS)); }
+	avi_file::error lossless_compress_slice(const bitmap_rgb32 &bitmap, int top, int bottom, std::vector<std::uint8_t> &residual, std::vector<std::uint8_t> &output) const;
+	avi_file::error lossless_decompress_slice(const std::uint8_t *data, std::uint32_t numbytes, int top, int bottom, std::vector<std::uint8_t> &residual, bitmap_rgb32 &bitmap) const;
+
 private:
 	struct huffyuv_table
 	{
@@ -441,6 +482,7 @@ public:
 	virtual std::uint32_t first_sample_in_frame(std::uint32_t framenum) const override;
 
 	virtual error read_video_frame(std::uint32_t framenum, bitmap_yuy16 &bitmap) override;
+	virtual error read_video_frame(std::uint32_t framenum, bitmap_rgb32 &bitmap) override;
 	virtual error read_sound_samples(int channel, std::uint32_t firstsample, std::uint32_t numsamples, std::int16_t *output) override;
 
 	virtual error append_video_frame(bitmap_yuy16 &bitmap) override;
@@ -469,10 +511,29 @@ private:
 		, m_soundbuf_samples(0)
 		, m_soundbuf_chunks(0)
 		, m_soundbuf_frames(0)
+		, m_work_queue()
+		, m_slices()
 	{
 		std::fill(std::begin(m_soundbuf_chansamples), std::end(m_soundbuf_chansamples), 0);
 	}
 
+	/* one band of an MLSC frame, handed to a worker */
+	struct lossless_slice
+	{
+		avi_stream const *          stream;         /* stream the frame belongs to */
+		bitmap_rgb32 const *        source;         /* frame being compressed */
+		bitmap_rgb32 *              dest;           /* frame being decompressed */
+		int                         top;            /* first row */
+		int                         bottom;         /* row after the last */
+		std::uint8_t const *        data;           /* compressed data when decompressing */
+		std::uint32_t               length;         /* compressed length when decompressing */
+		std::vector<std::uint8_t>   residual;       /* prediction residuals */
+		std::vector<std::uint8_t>   output;         /* compressed data when compressing */
+		error                       result;
+	};
+
+	struct work_queue_deleter { void operator()(osd_work_queue *queue) const { osd_work_queue_free(queue); } };
+
 	avi_stream *get_video_stream();
 	avi_stream *get_audio_stream(int channel, int &offset);
 	std::uint32_t compute_idx1_size() const;
@@ -480,6 +541,13 @@ private:
 	std::uint32_t framenum_to_samplenum(std::uint32_t framenum) const;
 	error expand_tempbuffer(std::uint32_t length);
 
+	// MLSC codec
+	error lossless_compress(avi_stream const &stream, bitmap_rgb32 const &bitmap, std::uint32_t &length);
+	error lossless_decompress(avi_stream const &stream, std::uint8_t const *data, std::uint32_t numbytes, bitmap_rgb32 &bitmap);
+	void run_slices(osd_work_callback callback);
+	static void *lossless_compress_work(void *param, int threadid);
+	static void *lossless_decompress_work(void *param, int threadid);
+
 	// core chunk read routines
 	error get_first_chunk(avi_chunk const *parent, avi_chunk &newchunk);
 	error get_next_chunk(avi_chunk const *parent, avi_chunk &newchunk);
@@ -543,6 +611,10 @@ private:
 	std::uint32_t       m_soundbuf_chansamples[MAX_SOUND_CHANNELS]; /* samples in buffer for each channel */
 	std::uint32_t       m_soundbuf_chunks;      /* number of chunks completed so far */
 	std::uint32_t       m_soundbuf_frames;      /* number of frames ahead of the video */
+
+	/* MLSC slices and the workers that process them */
+	std::unique_ptr<osd_work_queue, work_queue_deleter> m_work_queue;
+	std::vector<lossless_slice> m_slices;
 };
 
 
@@ -708,6 +780,30 @@ inline void u64toa(std::uint64_t val, char *output)
 }
 
 
+/**
+ * @fn  static inline std::uint8_t med_predict(std::uint8_t a, std::uint8_t b, std::uint8_t c)
+ *
+ * @brief   LOCO-I median predictor used by MLSC.
+ *
+ * @param   a   The left neighbour.
+ * @param   b   The upper neighbour.
+ * @param   c   The upper-left neighbour.
+ *
+ * @return  The predicted value.
+ */
+
+inline std::uint8_t med_predict(std::uint8_t a, std::uint8_t b, std::uint8_t c)
+{
+	std::uint8_t const lo = (std::min)(a, b);
+	std::uint8_t const hi = (std::max)(a, b);
+	if (c >= hi)
+		return lo;
+	if (c <= lo)
+		return hi;
+	return a + b - c;
+}
+
+
 /*-------------------------------------------------
     set_stream_chunk_info - set the chunk info
     for a given chunk within a stream
@@ -1467,6 +1563,377 @@ avi_file::error avi_stream::huffyuv_decompress_to_yuy16(const std::uint8_t *data
 }
 
 
+/*-------------------------------------------------
+    rgb_decompress_to_rgb32 - read an uncompressed
+    24bpp frame back into an RGB32 bitmap
+-------------------------------------------------*/
+
+/**
+ * @fn  avi_error rgb_decompress_to_rgb32(const std::uint8_t *data, std::uint32_t numbytes, bitmap_rgb32 &bitmap)
+ *
+ * @brief   RGB decompress to RGB 32.
+ *
+ * @param   data            The data.
+ * @param   numbytes        The numbytes.
+ * @param [in,out]  bitmap  The bitmap.
+ *
+ * @return  An avi_error.
+ */
+
+avi_file::error avi_stream::rgb_decompress_to_rgb32(const std::uint8_t *data, std::uint32_t numbytes, bitmap_rgb32 &bitmap) const
+{
+	/* frames are stored bottom-up */
+	if (numbytes < m_width * m_height * 3)
+		return avi_file::error::INVALID_DATA;
+
+	for (int y = 0; y < m_height; y++)
+	{
+		const std::uint8_t *source = data + (m_height - 1 - y) * m_width * 3;
+		std::uint32_t *dest = &bitmap.pix32(y);
+
+		for (int x = 0; x < m_width; x++, source += 3)
+			*dest++ = rgb_t(source[2], source[1], source[0]);
+	}
+
+	return avi_file::error::NONE;
+}
+
+
+/*-------------------------------------------------
+    lossless_compress_slice - compress a band of
+    rows of an RGB32 bitmap as an MLSC slice
+-------------------------------------------------*/
+
+/**
+ * @fn  avi_error lossless_compress_slice(const bitmap_rgb32 &bitmap, int top, int bottom, std::vector<std::uint8_t> &residual, std::vector<std::uint8_t> &output)
+ *
+ * @brief   Lossless compress slice.
+ *
+ * @param   bitmap              The bitmap.
+ * @param   top                 The first row.
+ * @param   bottom              The row after the last.
+ * @param [in,out]  residual    Scratch space for the residuals.
+ * @param [in,out]  output      Receives the compressed slice.
+ *
+ * @return  An avi_error.
+ */
+
+avi_file::error avi_stream::lossless_compress_slice(const bitmap_rgb32 &bitmap, int top, int bottom, std::vector<std::uint8_t> &residual, std::vector<std::uint8_t> &output) const
+{
+	int const width = m_width;
+	int const srcwidth = (std::min<int>)(m_width, bitmap.width());
+	int const srcheight = (std::min<int>)(m_height, bitmap.height());
+	std::uint32_t const rowbytes = 3 * width;
+
+	/* the residuals of the whole slice are gathered and then deflated in one go */
+	try
+	{
+		residual.resize(rowbytes * (bottom - top + 2));
+		output.resize(compressBound(rowbytes * (bottom - top)));
+	}
+	catch (...) { return avi_file::error::NO_MEMORY; }
+
+	/* the two extra rows hold the planes of the current and previous rows */
+	std::uint8_t *dest = &residual[0];
+	std::uint8_t *cur = &residual[rowbytes * (bottom - top)];
+	std::uint8_t *prev = cur + rowbytes;
+
+	for (int y = top; y < bottom; y++)
+	{
+		/* split into green, red - green and blue - green planes */
+		int x = 0;
+		if (y < srcheight)
+		{
+			const std::uint32_t *source = &bitmap.pix32(y);
+			for ( ; x < srcwidth; x++)
+			{
+				rgb_t const pix = source[x];
+				cur[x] = pix.g();
+				cur[width + x] = pix.r() - pix.g();
+				cur[2 * width + x] = pix.b() - pix.g();
+			}
+		}
+
+		/* fill in any blank space on the right or bottom */
+		for ( ; x < width; x++)
+			cur[x] = cur[width + x] = cur[2 * width + x] = 0;
+
+		/* store each byte's difference from its prediction */
+		for (int plane = 0; plane < 3; plane++)
+		{
+			const std::uint8_t *row = cur + plane * width;
+			const std::uint8_t *above = prev + plane * width;
+
+			*dest++ = row[0] - ((y == top) ? 0 : above[0]);
+			if (y == top)
+				for (x = 1; x < width; x++)
+					*dest++ = row[x] - row[x - 1];
+			else
+				for (x = 1; x < width; x++)
+					*dest++ = row[x] - med_predict(row[x - 1], above[x], above[x - 1]);
+		}
+		std::swap(cur, prev);
+	}
+
+	/* residuals are mostly zero for emulated video, so the fastest level is plenty */
+	uLongf destlen = output.size();
+	int const zerr = compress2(&output[0], &destlen, &residual[0], rowbytes * (bottom - top), Z_BEST_SPEED);
+	if (zerr != Z_OK)
+		return (zerr == Z_MEM_ERROR) ? avi_file::error::NO_MEMORY : avi_file::error::INVALID_DATA;
+	output.resize(destlen);
+
+	return avi_file::error::NONE;
+}
+
+
+/*-------------------------------------------------
+    lossless_decompress_slice - decompress an MLSC
+    slice into a band of rows of an RGB32 bitmap
+-------------------------------------------------*/
+
+/**
+ * @fn  avi_error lossless_decompress_slice(const std::uint8_t *data, std::uint32_t numbytes, int top, int bottom, std::vector<std::uint8_t> &residual, bitmap_rgb32 &bitmap)
+ *
+ * @brief   Lossless decompress slice.
+ *
+ * @param   data                The compressed slice.
+ * @param   numbytes            The numbytes.
+ * @param   top                 The first row.
+ * @param   bottom              The row after the last.
+ * @param [in,out]  residual    Scratch space for the residuals.
+ * @param [in,out]  bitmap      The bitmap.
+ *
+ * @return  An avi_error.
+ */
+
+avi_file::error avi_stream::lossless_decompress_slice(const std::uint8_t *data, std::uint32_t numbytes, int top, int bottom, std::vector<std::uint8_t> &residual, bitmap_rgb32 &bitmap) const
+{
+	int const width = m_width;
+	std::uint32_t const rowbytes = 3 * width;
+
+	try { residual.resize(rowbytes * (bottom - top + 2)); }
+	catch (...) { return avi_file::error::NO_MEMORY; }
+
+	/* inflate the residuals; anything but an exact fit is corrupt */
+	uLongf destlen = rowbytes * (bottom - top);
+	int const zerr = uncompress(&residual[0], &destlen, data, numbytes);
+	if (zerr == Z_MEM_ERROR)
+		return avi_file::error::NO_MEMORY;
+	if (zerr != Z_OK || destlen != rowbytes * (bottom - top))
+		return avi_file::error::INVALID_DATA;
+
+	const std::uint8_t *source = &residual[0];
+	std::uint8_t *cur = &residual[rowbytes * (bottom - top)];
+	std::uint8_t *prev = cur + rowbytes;
+
+	for (int y = top; y < bottom; y++)
+	{
+		/* undo the prediction one plane at a time */
+		for (int plane = 0; plane < 3; plane++)
+		{
+			std::uint8_t *row = cur + plane * width;
+			const std::uint8_t *above = prev + plane * width;
+
+			row[0] = *source++ + ((y == top) ? 0 : above[0]);
+			if (y == top)
+				for (int x = 1; x < width; x++)
+					row[x] = *source++ + row[x - 1];
+			else
+				for (int x = 1; x < width; x++)
+					row[x] = *source++ + med_predict(row[x - 1], above[x], above[x - 1]);
+		}
+
+		/* recombine the planes */
+		std::uint32_t *dest = &bitmap.pix32(y);
+		for (int x = 0; x < width; x++)
+		{
+			std::uint8_t const g = cur[x];
+			*dest++ = rgb_t(std::uint8_t(cur[width + x] + g), g, std::uint8_t(cur[2 * width + x] + g));
+		}
+		std::swap(cur, prev);
+	}
+
+	return avi_file::error::NONE;
+}
+
+
+/*-------------------------------------------------
+    lossless_compress - compress an RGB32 bitmap
+    as an MLSC frame into the temp buffer
+-------------------------------------------------*/
+
+/**
+ * @fn  avi_error lossless_compress(avi_stream const &stream, bitmap_rgb32 const &bitmap, std::uint32_t &length)
+ *
+ * @brief   Lossless compress.
+ *
+ * @param   stream          The stream.
+ * @param   bitmap          The bitmap.
+ * @param [out]  length     The length of the frame in the temp buffer.
+ *
+ * @return  An avi_error.
+ */
+
+avi_file::error avi_file_impl::lossless_compress(avi_stream const &stream, bitmap_rgb32 const &bitmap, std::uint32_t &length)
+{
+	/* split the frame into bands and compress them in parallel */
+	int const count = stream.lossless_slices();
+	try { m_slices.resize(count); }
+	catch (...) { return error::NO_MEMORY; }
+	for (int index = 0; index < count; index++)
+	{
+		lossless_slice &slice = m_slices[index];
+		slice.stream = &stream;
+		slice.source = &bitmap;
+		slice.dest = nullptr;
+		slice.top = stream.height() * index / count;
+		slice.bottom = stream.height() * (index + 1) / count;
+		slice.result = error::NONE;
+	}
+	run_slices(&avi_file_impl::lossless_compress_work);
+
+	/* gather the slices behind the frame header */
+	length = 4 + 4 * count;
+	for (lossless_slice const &slice : m_slices)
+	{
+		if (slice.result != error::NONE)
+			return slice.result;
+		length += slice.output.size();
+	}
+
+	error const avierr = expand_tempbuffer(length);
+	if (avierr != error::NONE)
+		return avierr;
+
+	m_tempbuffer[0] = MLSC_VERSION;
+	m_tempbuffer[1] = 0;
+	put_16bits(&m_tempbuffer[2], count);
+	std::uint32_t offset = 4 + 4 * count;
+	for (int index = 0; index < count; index++)
+	{
+		std::vector<std::uint8_t> const &output = m_slices[index].output;
+		put_32bits(&m_tempbuffer[4 + 4 * index], output.size());
+		std::memcpy(&m_tempbuffer[offset], &output[0], output.size());
+		offset += output.size();
+	}
+
+	return error::NONE;
+}
+
+
+/*-------------------------------------------------
+    lossless_decompress - decompress an MLSC frame
+    into an RGB32 bitmap
+-------------------------------------------------*/
+
+/**
+ * @fn  avi_error lossless_decompress(avi_stream const &stream, std::uint8_t const *data, std::uint32_t numbytes, bitmap_rgb32 &bitmap)
+ *
+ * @brief   Lossless decompress.
+ *
+ * @param   stream          The stream.
+ * @param   data            The frame data.
+ * @param   numbytes        The numbytes.
+ * @param [in,out]  bitmap  The bitmap.
+ *
+ * @return  An avi_error.
+ */
+
+avi_file::error avi_file_impl::lossless_decompress(avi_stream const &stream, std::uint8_t const *data, std::uint32_t numbytes, bitmap_rgb32 &bitmap)
+{
+	/* validate the frame header */
+	if (numbytes < 4 || data[0] != MLSC_VERSION)
+		return error::INVALID_DATA;
+	int const count = fetch_16bits(&data[2]);
+	if (count == 0 || count > stream.height() || numbytes < 4 + 4 * count)
+		return error::INVALID_DATA;
+
+	/* locate each slice before handing them out */
+	try { m_slices.resize(count); }
+	catch (...) { return error::NO_MEMORY; }
+	std::uint64_t offset = 4 + 4 * count;
+	for (int index = 0; index < count; index++)
+	{
+		lossless_slice &slice = m_slices[index];
+		slice.stream = &stream;
+		slice.source = nullptr;
+		slice.dest = &bitmap;
+		slice.top = stream.height() * index / count;
+		slice.bottom = stream.height() * (index + 1) / count;
+		slice.data = data + offset;
+		slice.length = fetch_32bits(&data[4 + 4 * index]);
+		slice.result = error::NONE;
+		offset += slice.length;
+		if (offset > numbytes)
+			return error::INVALID_DATA;
+	}
+	run_slices(&avi_file_impl::lossless_decompress_work);
+
+	for (lossless_slice const &slice : m_slices)
+		if (slice.result != error::NONE)
+			return slice.result;
+	return error::NONE;
+}
+
+
+/*-------------------------------------------------
+    run_slices - run a callback over all the
+    slices, on worker threads when available
+-------------------------------------------------*/
+
+/**
+ * @fn  void run_slices(osd_work_callback callback)
+ *
+ * @brief   Runs the slices.
+ *
+ * @param   callback    The work callback.
+ */
+
+void avi_file_impl::run_slices(osd_work_callback callback)
+{
+	/* the workers are only started once a file actually uses MLSC */
+	if (!m_work_queue && m_slices.size() > 1)
+		m_work_queue.reset(osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI));
+
+	if (m_work_queue && m_slices.size() > 1)
+	{
+		osd_work_item_queue_multiple(m_work_queue.get(), callback, m_slices.size(), &m_slices[0], sizeof(m_slices[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		while (!osd_work_queue_wait(m_work_queue.get(), 10 * osd_ticks_per_second())) { }
+	}
+	else
+	{
+		for (lossless_slice &slice : m_slices)
+			(*callback)(&slice, 0);
+	}
+}
+
+
+/*-------------------------------------------------
+    lossless_compress_work - compress one slice
+    on a worker thread
+-------------------------------------------------*/
+
+void *avi_file_impl::lossless_compress_work(void *param, int threadid)
+{
+	lossless_slice &slice = *reinterpret_cast<lossless_slice *>(param);
+	slice.result = slice.stream->lossless_compress_slice(*slice.source, slice.top, slice.bottom, slice.residual, slice.output);
+	return nullptr;
+}
+
+
+/*-------------------------------------------------
+    lossless_decompress_work - decompress one
+    slice on a worker thread
+-------------------------------------------------*/
+
+void *avi_file_impl::lossless_decompress_work(void *param, int threadid)
+{
+	lossless_slice &slice = *reinterpret_cast<lossless_slice *>(param);
+	slice.result = slice.stream->lossless_decompress_slice(slice.data, slice.length, slice.top, slice.bottom, slice.residual, *slice.dest);
+	return nullptr;
+}
+
+
 /*-------------------------------------------------
     avi_close - close an AVI movie file
 -------------------------------------------------*/
@@ -1653,6 +2120,66 @@ avi_file::error avi_file_impl::read_video_frame(std::uint32_t framenum, bitmap_y
 }
 
 
+/*-------------------------------------------------
+    avi_read_video_frame_rgb32 - read video data
+    for a particular frame into an RGB32 bitmap
+-------------------------------------------------*/
+
+/**
+ * @fn  avi_error avi_read_video_frame(avi_file *file, std::uint32_t framenum, bitmap_rgb32 &bitmap)
+ *
+ * @brief   Avi read video frame.
+ *
+ * @param [in,out]  file    If non-null, the file.
+ * @param   framenum        The framenum.
+ * @param [in,out]  bitmap  The bitmap.
+ *
+ * @return  An avi_error.
+ */
+
+avi_file::error avi_file_impl::read_video_frame(std::uint32_t framenum, bitmap_rgb32 &bitmap)
+{
+	/* get the video stream */
+	avi_stream *const stream = get_video_stream();
+	if (!stream)
+		return error::INVALID_STREAM;
+
+	/* validate our ability to handle the data */
+	if (stream->format() != FORMAT_MLSC && (stream->format() != 0 || stream->depth() != 24))
+		return error::UNSUPPORTED_VIDEO_FORMAT;
+
+	/* assume one chunk == one frame */
+	if (framenum >= stream->chunks())
+		return error::INVALID_FRAME;
+
+	/* the bitmap must hold the whole frame */
+	if (bitmap.width() < stream->width() || bitmap.height() < stream->height())
+		return error::INVALID_BITMAP;
+
+	/* expand the tempbuffer to hold the data if necessary */
+	error avierr = expand_tempbuffer(stream->chunk(framenum).length);
+	if (avierr != error::NONE)
+		return avierr;
+
+	/* read in the data */
+	std::uint32_t bytes_read;
+	osd_file::error const filerr = m_file->read(&m_tempbuffer[0], stream->chunk(framenum).offset, stream->chunk(framenum).length, bytes_read);
+	if (filerr != osd_file::error::NONE || bytes_read != stream->chunk(framenum).length || bytes_read < 8)
+		return error::READ_ERROR;
+
+	/* validate this is good data */
+	std::uint32_t const chunkid = fetch_32bits(&m_tempbuffer[0]);
+	if (chunkid != get_chunkid_for_stream(stream))
+		return error::INVALID_DATA;
+
+	if (stream->format() == FORMAT_MLSC)
+		avierr = lossless_decompress(*stream, &m_tempbuffer[8], stream->chunk(framenum).length - 8, bitmap);
+	else
+		avierr = stream->rgb_decompress_to_rgb32(&m_tempbuffer[8], stream->chunk(framenum).length - 8, bitmap);
+	return avierr;
+}
+
+
 /*-------------------------------------------------
     avi_read_sound_samples - read sound sample
     data from an AVI file
@@ -1849,7 +2376,7 @@ avi_file::error avi_file_impl::append_video_frame(bitmap_rgb32 &bitmap)
 	std::uint32_t maxlength;
 
 	/* validate our ability to handle the data */
-	if (stream->format() != 0)
+	if (stream->format() != 0 && stream->format() != FORMAT_MLSC)
 		return error::UNSUPPORTED_VIDEO_FORMAT;
 
 	/* depth must be 24 */
@@ -1861,24 +2388,34 @@ avi_file::error avi_file_impl::append_video_frame(bitmap_rgb32 &bitmap)
 	if (avierr != error::NONE)
 		return avierr;
 
-	/* make sure we have enough room */
-	maxlength = 3 * stream->width() * stream->height();
-	avierr = expand_tempbuffer(maxlength);
-	if (avierr != error::NONE)
-		return avierr;
+	/* MLSC frames vary in size */
+	if (stream->format() == FORMAT_MLSC)
+	{
+		avierr = lossless_compress(*stream, bitmap, maxlength);
+		if (avierr != error::NONE)
+			return avierr;
+	}
+	else
+	{
+		/* make sure we have enough room */
+		maxlength = 3 * stream->width() * stream->height();
+		avierr = expand_tempbuffer(maxlength);
+		if (avierr != error::NONE)
+			return avierr;
 
-	/* copy the RGB data to the destination */
-	avierr = stream->rgb32_compress_to_rgb(bitmap, &m_tempbuffer[0], maxlength);
-	if (avierr != error::NONE)
-		return avierr;
+		/* copy the RGB data to the destination */
+		avierr = stream->rgb32_compress_to_rgb(bitmap, &m_tempbuffer[0], maxlength);
+		if (avierr != error::NONE)
+			return avierr;
+	}
 
 	/* write the data */
 	avierr = chunk_write(get_chunkid_for_stream(stream), &m_tempbuffer[0], maxlength);
 	if (avierr != error::NONE)
 		return avierr;
 
-	/* set the info for this new chunk */
-	avierr = stream->set_chunk_info(stream->chunks(), m_writeoffs - maxlength - 8, maxlength + 8);
+	/* set the info for this new chunk; odd-sized chunks are padded to a word */
+	avierr = stream->set_chunk_info(stream->chunks(), m_writeoffs - (maxlength + (maxlength & 1)) - 8, maxlength + 8);
 	if (avierr != error::NONE)
 		return avierr;
 
@@ -2999,7 +3536,7 @@ avi_file::error avi_file_impl::write_strh_chunk(avi_stream &stream, bool initial
 	if (stream.type() == STREAMTYPE_VIDS)
 	{
 		put_32bits(&buffer[4],                          /* fccHandler */
-					(stream.format() == FORMAT_HFYU) ? HANDLER_HFYU : HANDLER_DIB);
+					(stream.format() == FORMAT_HFYU) ? HANDLER_HFYU : (stream.format() == FORMAT_MLSC) ? HANDLER_MLSC : HANDLER_DIB);
 		put_32bits(&buffer[36],                         /* dwSuggestedBufferSize */
 					stream.width() * stream.height() * 4);
 		put_16bits(&buffer[52], stream.width());        /* rcFrame.right */
@@ -3576,7 +4113,8 @@ avi_file::error avi_file::open(std::string const &filename, ptr &file)
 avi_file::error avi_file::create(std::string const &filename, movie_info const &info, ptr &file)
 {
 	/* validate video info */
-	if ((info.video_format != 0 && info.video_format != FORMAT_UYVY && info.video_format != FORMAT_VYUY && info.video_format != FORMAT_YUY2) ||
+	if ((info.video_format != 0 && info.video_format != FORMAT_UYVY && info.video_format != FORMAT_VYUY && info.video_format != FORMAT_YUY2 && info.video_format != FORMAT_MLSC) ||
+		(info.video_format == FORMAT_MLSC && info.video_depth != 24) ||
 		(info.video_width == 0) ||
 		(info.video_height == 0) ||
 		(info.video_depth == 0) ||
@@ -29,6 +29,7 @@
 #define FORMAT_VYUY             AVI_FOURCC('V','Y','U','Y')
 #define FORMAT_YUY2             AVI_FOURCC('Y','U','Y','2')
 #define FORMAT_HFYU             AVI_FOURCC('H','F','Y','U')
+#define FORMAT_MLSC             AVI_FOURCC('M','L','S','C')     // lossless slice codec; see aviio.cpp
 
 
 
@@ -116,6 +117,7 @@ public:
 	virtual std::uint32_t first_sample_in_frame(std::uint32_t framenum) const = 0;
 
 	virtual error read_video_frame(std::uint32_t framenum, bitmap_yuy16 &bitmap) = 0;
+	virtual error read_video_frame(std::uint32_t framenum, bitmap_rgb32 &bitmap) = 0;
 	virtual error read_sound_samples(int channel, std::uint32_t firstsample, std::uint32_t numsamples, std::int16_t *output) = 0;
 
 	virtual error append_video_frame(bitmap_yuy16 &bitmap) = 0;
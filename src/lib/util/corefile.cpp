@@ -153,6 +153,7 @@ public:
 	virtual int ungetc(int c) override { return m_file.ungetc(c); }
 	virtual char *gets(char *s, int n) override { return m_file.gets(s, n); }
 	virtual const void *buffer() override { return m_file.buffer(); }
+	virtual osd_file::error map(void *dest, std::uint32_t length) override { return m_file.map(dest, length); }
 
 	virtual std::uint32_t write(const void *buffer, std::uint32_t length) override { return m_file.write(buffer, length); }
 	virtual int puts(const char *s) override { return m_file.puts(s); }
@@ -239,6 +240,7 @@ public:
 
 	virtual std::uint32_t read(void *buffer, std::uint32_t length) override;
 	virtual void const *buffer() override { return m_data; }
+	virtual osd_file::error map(void *dest, std::uint32_t length) override { return osd_file::error::FAILURE; }
 
 	virtual std::uint32_t write(void const *buffer, std::uint32_t length) override { return 0; }
 	virtual osd_file::error truncate(std::uint64_t offset) override;
@@ -309,6 +311,7 @@ public:
 
 	virtual std::uint32_t read(void *buffer, std::uint32_t length) override;
 	virtual void const *buffer() override;
+	virtual osd_file::error map(void *dest, std::uint32_t length) override;
 
 	virtual std::uint32_t write(void const *buffer, std::uint32_t length) override;
 	virtual osd_file::error truncate(std::uint64_t offset) override;
@@ -897,6 +900,27 @@ void const *core_osd_file::buffer()
 }
 
 
+/*-------------------------------------------------
+    map - map part of the file over memory
+    allocated with osd_alloc_mappable
+-------------------------------------------------*/
+
+osd_file::error core_osd_file::map(void *dest, std::uint32_t length)
+{
+	// data already in RAM or behind zlib has nothing to map, and pages past the end of the file fault
+	if (!m_file || is_loaded() || m_zdata || (offset() + length) > this->length())
+		return osd_file::error::FAILURE;
+
+	// flush any buffered char
+	clear_putback();
+
+	auto const filerr = m_file->map(dest, offset(), length);
+	if (filerr == osd_file::error::NONE)
+		add_offset(length);
+	return filerr;
+}
+
+
 /*-------------------------------------------------
     write - write to a file
 -------------------------------------------------*/
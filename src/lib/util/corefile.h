@@ -99,6 +99,10 @@ public:
 	// this function may cause the full file data to be read
 	virtual const void *buffer() = 0;
 
+	// map length bytes from the current position over memory allocated with osd_alloc_mappable,
+	// advancing the file pointer as a read would; fails for files that aren't plain OSD files
+	virtual osd_file::error map(void *dest, std::uint32_t length) = 0;
+
 	// open a file with the specified filename, read it into memory, and return a pointer
 	static osd_file::error load(std::string const &filename, void **data, std::uint32_t &length);
 	static osd_file::error load(std::string const &filename, dynamic_buffer &data);
@@ -15,7 +15,10 @@
 #include <zlib.h>
 #include "png.h"
 
+#include <memory>
+#include <mutex>
 #include <new>
+#include <vector>
 
 
 /***************************************************************************
@@ -30,6 +33,23 @@ struct image_data_chunk
 };
 
 
+/* a piece of image data deflated on its own, for parallel compression */
+struct deflate_strip
+{
+	const UINT8 *       data;
+	UINT32              length;
+	UINT32              dictlength;         /* bytes before data to prime the window with */
+	int                 level;
+	bool                last;               /* finishes the stream */
+	std::vector<UINT8>  output;
+	uLong               adler;
+	int                 zerr;
+};
+
+
+struct work_queue_deleter { void operator()(osd_work_queue *queue) const { osd_work_queue_free(queue); } };
+
+
 struct png_private
 {
 	png_info *          pnginfo;
@@ -47,6 +67,15 @@ struct png_private
 
 static const int samples[] = { 1, 0, 3, 1, 2, 0, 4 };
 
+/* image data is deflated in strips of this size on worker threads... */
+static const UINT32 DEFLATE_STRIP_BYTES = 256 * 1024;
+
+/* ...when there are at least this many strips */
+static const UINT32 DEFLATE_MIN_STRIPS = 3;
+
+/* size of the deflate window each strip is primed with */
+static const UINT32 DEFLATE_WINDOW_BYTES = 32768;
+
 
 
 /***************************************************************************
@@ -332,37 +361,111 @@ static png_error process_chunk(png_private *png, UINT8 *data, UINT32 type, UINT3
 }
 
 
+/*-------------------------------------------------
+    swar_add8/swar_sub8/swar_avg8 - add, subtract
+    or floor-average the bytes of two words
+    independently, without carries crossing
+    between bytes
+-------------------------------------------------*/
+
+template <typename T> static inline T swar_high_bits() { return T(~T(0)) / 0xff * 0x80; }
+
+template <typename T> static inline T swar_add8(T a, T b)
+{
+	T const high = swar_high_bits<T>();
+	return ((a & ~high) + (b & ~high)) ^ ((a ^ b) & high);
+}
+
+template <typename T> static inline T swar_sub8(T a, T b)
+{
+	T const high = swar_high_bits<T>();
+	return ((a | high) - (b & ~high)) ^ ((a ^ ~b) & high);
+}
+
+template <typename T> static inline T swar_avg8(T a, T b)
+{
+	T const low = T(~T(0)) / 0xff * 0x7f;
+	return (a & b) + (((a ^ b) >> 1) & low);
+}
+
+
+/*-------------------------------------------------
+    paeth_predict - the Paeth predictor, in the
+    form that avoids a three-way compare
+-------------------------------------------------*/
+
+static inline UINT8 paeth_predict(UINT8 a, UINT8 b, UINT8 c)
+{
+	INT32 const pa = abs(INT32(b) - INT32(c));
+	INT32 const pb = abs(INT32(a) - INT32(c));
+	INT32 const pc = abs(INT32(a) + INT32(b) - 2 * INT32(c));
+	return (pa <= pb && pa <= pc) ? a : (pb <= pc) ? b : c;
+}
+
+
 /*-------------------------------------------------
     unfilter_row - unfilter a single row of pixels
+
+    Rows are unfiltered in place, with src a few
+    bytes ahead of dst, so every word is read
+    before the one overlapping it is written.
+    Up is done eight bytes at a time, and Sub
+    and Average a pixel at a time for 32bpp
+    images, the common case for artwork.
 -------------------------------------------------*/
 
 static png_error unfilter_row(int type, UINT8 *src, UINT8 *dst, UINT8 *dstprev, int bpp, int rowbytes)
 {
 	int x;
 
+	/* without a previous row, the filters that use it see zeroes */
+	if (dstprev == nullptr)
+	{
+		if (type == PNG_PF_Up)
+			type = PNG_PF_None;
+		else if (type == PNG_PF_Paeth)
+			type = PNG_PF_Sub;
+	}
+
 	/* switch off of it */
 	switch (type)
 	{
 		/* no filter, just copy */
 		case PNG_PF_None:
-			for (x = 0; x < rowbytes; x++)
-				*dst++ = *src++;
+			memmove(dst, src, rowbytes);
 			break;
 
 		/* SUB = previous pixel */
 		case PNG_PF_Sub:
-			for (x = 0; x < bpp; x++)
-				*dst++ = *src++;
-			for (x = bpp; x < rowbytes; x++, dst++)
-				*dst = *src++ + dst[-bpp];
+			x = 0;
+			for ( ; x < bpp; x++)
+				dst[x] = src[x];
+			if (bpp == 4)
+				for ( ; x + 4 <= rowbytes; x += 4)
+				{
+					UINT32 raw, left;
+					memcpy(&raw, &src[x], 4);
+					memcpy(&left, &dst[x - 4], 4);
+					raw = swar_add8(raw, left);
+					memcpy(&dst[x], &raw, 4);
+				}
+			for ( ; x < rowbytes; x++)
+				dst[x] = src[x] + dst[x - bpp];
 			break;
 
 		/* UP = pixel above */
 		case PNG_PF_Up:
-			if (dstprev == nullptr)
-				return unfilter_row(PNG_PF_None, src, dst, dstprev, bpp, rowbytes);
-			for (x = 0; x < rowbytes; x++, dst++)
-				*dst = *src++ + *dstprev++;
+			x = 0;
+			for ( ; x + 8 <= rowbytes; x += 8)
+			{
+				UINT64 raw, above;
+				memcpy(&raw, &src[x], 8);
+				memcpy(&above, &dstprev[x], 8);
+				raw = swar_add8(raw, above);
+				memcpy(&dst[x], &raw, 8);
+			}
+			for ( ; x < rowbytes; x++)
+				dst[x] = src[x] + dstprev[x];
 			break;
 
 		/* AVERAGE = average of pixel above and previous pixel */
@@ -370,37 +473,35 @@ static png_error unfilter_row(int type, UINT8 *src, UINT8 *dst, UINT8 *dstprev,
 			if (dstprev == nullptr)
 			{
 				for (x = 0; x < bpp; x++)
-					*dst++ = *src++;
-				for (x = bpp; x < rowbytes; x++, dst++)
-					*dst = *src++ + dst[-bpp] / 2;
+					dst[x] = src[x];
+				for ( ; x < rowbytes; x++)
+					dst[x] = src[x] + dst[x - bpp] / 2;
 			}
 			else
 			{
-				for (x = 0; x < bpp; x++, dst++)
-					*dst = *src++ + *dstprev++ / 2;
-				for (x = bpp; x < rowbytes; x++, dst++)
-					*dst = *src++ + (*dstprev++ + dst[-bpp]) / 2;
+				for (x = 0; x < bpp; x++)
+					dst[x] = src[x] + dstprev[x] / 2;
+				if (bpp == 4)
+					for ( ; x + 4 <= rowbytes; x += 4)
+					{
+						UINT32 raw, left, above;
+						memcpy(&raw, &src[x], 4);
+						memcpy(&left, &dst[x - 4], 4);
+						memcpy(&above, &dstprev[x], 4);
+						raw = swar_add8(raw, swar_avg8(left, above));
+						memcpy(&dst[x], &raw, 4);
+					}
+				for ( ; x < rowbytes; x++)
+					dst[x] = src[x] + (dstprev[x] + dst[x - bpp]) / 2;
 			}
 			break;
 
-		/* PAETH = special filter */
+		/* PAETH = special filter; on the left edge it reduces to Up */
 		case PNG_PF_Paeth:
-			for (x = 0; x < rowbytes; x++)
-			{
-				INT32 pa = (x < bpp) ? 0 : dst[-bpp];
-				INT32 pc = (x < bpp || dstprev == nullptr) ? 0 : dstprev[-bpp];
-				INT32 pb = (dstprev == nullptr) ? 0 : *dstprev++;
-				INT32 prediction = pa + pb - pc;
-				INT32 da = abs(prediction - pa);
-				INT32 db = abs(prediction - pb);
-				INT32 dc = abs(prediction - pc);
-				if (da <= db && da <= dc)
-					*dst++ = *src++ + pa;
-				else if (db <= dc)
-					*dst++ = *src++ + pb;
-				else
-					*dst++ = *src++ + pc;
-			}
+			for (x = 0; x < bpp; x++)
+				dst[x] = src[x] + dstprev[x];
+			for ( ; x < rowbytes; x++)
+				dst[x] = src[x] + paeth_predict(dst[x - bpp], dstprev[x], dstprev[x - bpp]);
 			break;
 
 		/* unknown filter type */
@@ -778,12 +879,145 @@ static png_error write_chunk(util::core_file &fp, const UINT8 *data, UINT32 type
 }
 
 
+/*-------------------------------------------------
+    deflate_strip_work - deflate one strip of a
+    parallel chunk as raw deflate data ending on
+    a byte boundary, so strips can be joined
+-------------------------------------------------*/
+
+static void *deflate_strip_work(void *param, int threadid)
+{
+	deflate_strip &strip = *reinterpret_cast<deflate_strip *>(param);
+	z_stream stream;
+
+	memset(&stream, 0, sizeof(stream));
+	strip.zerr = deflateInit2(&stream, strip.level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+	if (strip.zerr != Z_OK)
+		return nullptr;
+
+	/* prime the window with the end of the previous strip so matches can reach back into it */
+	if (strip.dictlength != 0)
+		deflateSetDictionary(&stream, strip.data - strip.dictlength, strip.dictlength);
+
+	/* a sync flush adds an empty stored block at most */
+	try { strip.output.resize(deflateBound(&stream, strip.length) + 16); }
+	catch (...)
+	{
+		deflateEnd(&stream);
+		strip.zerr = Z_MEM_ERROR;
+		return nullptr;
+	}
+
+	stream.next_in = const_cast<Bytef *>(strip.data);
+	stream.avail_in = strip.length;
+	stream.next_out = &strip.output[0];
+	stream.avail_out = strip.output.size();
+	strip.zerr = deflate(&stream, strip.last ? Z_FINISH : Z_SYNC_FLUSH);
+	if (strip.zerr == (strip.last ? Z_STREAM_END : Z_OK) && stream.avail_in == 0 && stream.avail_out != 0)
+		strip.zerr = Z_OK;
+	else if (strip.zerr == Z_OK || strip.zerr == Z_STREAM_END)
+		strip.zerr = Z_BUF_ERROR;
+	strip.output.resize(strip.output.size() - stream.avail_out);
+	deflateEnd(&stream);
+
+	strip.adler = adler32(adler32(0, nullptr, 0), strip.data, strip.length);
+	return nullptr;
+}
+
+
+/*-------------------------------------------------
+    deflate_work_queue - return the queue used for
+    parallel compression, created on first use and
+    kept so that recording a movie doesn't start
+    a new set of threads for every frame
+-------------------------------------------------*/
+
+static osd_work_queue *deflate_work_queue()
+{
+	static std::unique_ptr<osd_work_queue, work_queue_deleter> const queue(osd_work_queue_alloc(WORK_QUEUE_FLAG_MULTI));
+	return queue.get();
+}
+
+
+/*-------------------------------------------------
+    write_parallel_deflated_chunk - write a large
+    chunk deflated in strips on worker threads;
+    the strips are joined into one zlib stream
+-------------------------------------------------*/
+
+static png_error write_parallel_deflated_chunk(util::core_file &fp, UINT8 *data, UINT32 type, UINT32 length, int level)
+{
+	/* cut the data into strips */
+	UINT32 const count = (length + DEFLATE_STRIP_BYTES - 1) / DEFLATE_STRIP_BYTES;
+	std::vector<deflate_strip> strips(count);
+	for (UINT32 index = 0; index < count; index++)
+	{
+		deflate_strip &strip = strips[index];
+		UINT32 const offset = index * DEFLATE_STRIP_BYTES;
+		strip.data = data + offset;
+		strip.length = std::min(DEFLATE_STRIP_BYTES, length - offset);
+		strip.dictlength = std::min(DEFLATE_WINDOW_BYTES, offset);
+		strip.level = level;
+		strip.last = (index == count - 1);
+		strip.adler = 0;
+		strip.zerr = Z_OK;
+	}
+
+	/* compress them, on this thread if there are no workers; the queue is
+	   shared, so writers on different threads take turns with it */
+	osd_work_queue *const queue = deflate_work_queue();
+	if (queue)
+	{
+		static std::mutex queue_lock;
+		std::lock_guard<std::mutex> lock(queue_lock);
+		osd_work_item_queue_multiple(queue, deflate_strip_work, count, &strips[0], sizeof(strips[0]), WORK_ITEM_FLAG_AUTO_RELEASE);
+		while (!osd_work_queue_wait(queue, 10 * osd_ticks_per_second())) { }
+	}
+	else
+	{
+		for (deflate_strip &strip : strips)
+			deflate_strip_work(&strip, 0);
+	}
+
+	/* the zlib header advertises roughly how hard we tried */
+	int const flevel = (level == PNG_LEVEL_DEFAULT || level == 6) ? 2 : (level <= 1) ? 0 : (level <= 5) ? 1 : 3;
+	UINT8 header[2] = { 0x78, UINT8(flevel << 6) };
+	header[1] += 31 - ((header[0] << 8) | header[1]) % 31;
+
+	/* join the header, the strips and the combined checksum */
+	UINT32 zlength = sizeof(header) + 4;
+	uLong adler = adler32(0, nullptr, 0);
+	for (deflate_strip const &strip : strips)
+	{
+		if (strip.zerr != Z_OK)
+			return (strip.zerr == Z_MEM_ERROR) ? PNGERR_OUT_OF_MEMORY : PNGERR_COMPRESS_ERROR;
+		zlength += strip.output.size();
+		adler = adler32_combine(adler, strip.adler, strip.length);
+	}
+
+	std::unique_ptr<UINT8 []> zdata(new (std::nothrow) UINT8[zlength]);
+	if (!zdata)
+		return PNGERR_OUT_OF_MEMORY;
+	UINT8 *dest = zdata.get();
+	memcpy(dest, header, sizeof(header));
+	dest += sizeof(header);
+	for (deflate_strip const &strip : strips)
+	{
+		memcpy(dest, &strip.output[0], strip.output.size());
+		dest += strip.output.size();
+	}
+	put_32bit(dest, adler);
+
+	return write_chunk(fp, zdata.get(), type, zlength);
+}
+
+
 /*-------------------------------------------------
     write_deflated_chunk - write an in-memory
     chunk to the given file by deflating it
 -------------------------------------------------*/
 
-static png_error write_deflated_chunk(util::core_file &fp, UINT8 *data, UINT32 type, UINT32 length)
+static png_error write_deflated_chunk(util::core_file &fp, UINT8 *data, UINT32 type, UINT32 length, int level)
 {
 	UINT64 lengthpos = fp.tell();
 	UINT8 tempbuff[8192];
@@ -792,6 +1026,10 @@ static png_error write_deflated_chunk(util::core_file &fp, UINT8 *data, UINT32 t
 	UINT32 crc;
 	int zerr;
 
+	/* big images are compressed in parallel */
+	if (length >= DEFLATE_MIN_STRIPS * DEFLATE_STRIP_BYTES)
+		return write_parallel_deflated_chunk(fp, data, type, length, level);
+
 	/* stuff the length/type into the buffer */
 	put_32bit(tempbuff + 0, length);
 	put_32bit(tempbuff + 4, type);
@@ -805,7 +1043,7 @@ static png_error write_deflated_chunk(util::core_file &fp, UINT8 *data, UINT32 t
 	memset(&stream, 0, sizeof(stream));
 	stream.next_in = data;
 	stream.avail_in = length;
-	zerr = deflateInit(&stream, Z_DEFAULT_COMPRESSION);
+	zerr = deflateInit(&stream, (level == PNG_LEVEL_DEFAULT) ? Z_DEFAULT_COMPRESSION : level);
 	if (zerr != Z_OK)
 		return PNGERR_COMPRESS_ERROR;
 
@@ -1001,12 +1239,156 @@ static png_error convert_bitmap_to_image_rgb(png_info *pnginfo, const bitmap_t &
 }
 
 
+/*-------------------------------------------------
+    filter_row - apply a prediction filter to a
+    row, given the unfiltered row above it
+-------------------------------------------------*/
+
+static void filter_row(int filter, const UINT8 *src, const UINT8 *prev, UINT8 *dst, int bpp, int rowbytes)
+{
+	int x = 0;
+
+	/* without a previous row, the filters that use it see zeroes */
+	if (prev == nullptr)
+	{
+		if (filter == PNG_PF_Up)
+			filter = PNG_PF_None;
+		else if (filter == PNG_PF_Paeth)
+			filter = PNG_PF_Sub;
+	}
+
+	switch (filter)
+	{
+		case PNG_PF_None:
+			memcpy(dst, src, rowbytes);
+			break;
+
+		case PNG_PF_Sub:
+			for ( ; x < bpp; x++)
+				dst[x] = src[x];
+			for ( ; x < rowbytes; x++)
+				dst[x] = src[x] - src[x - bpp];
+			break;
+
+		case PNG_PF_Up:
+			for ( ; x + 8 <= rowbytes; x += 8)
+			{
+				UINT64 cur, above;
+				memcpy(&cur, &src[x], 8);
+				memcpy(&above, &prev[x], 8);
+				cur = swar_sub8(cur, above);
+				memcpy(&dst[x], &cur, 8);
+			}
+			for ( ; x < rowbytes; x++)
+				dst[x] = src[x] - prev[x];
+			break;
+
+		case PNG_PF_Average:
+			if (prev == nullptr)
+			{
+				for ( ; x < bpp; x++)
+					dst[x] = src[x];
+				for ( ; x < rowbytes; x++)
+					dst[x] = src[x] - src[x - bpp] / 2;
+			}
+			else
+			{
+				for ( ; x < bpp; x++)
+					dst[x] = src[x] - prev[x] / 2;
+				for ( ; x < rowbytes; x++)
+					dst[x] = src[x] - (src[x - bpp] + prev[x]) / 2;
+			}
+			break;
+
+		case PNG_PF_Paeth:
+			for ( ; x < bpp; x++)
+				dst[x] = src[x] - prev[x];
+			for ( ; x < rowbytes; x++)
+				dst[x] = src[x] - paeth_predict(src[x - bpp], prev[x], prev[x - bpp]);
+			break;
+	}
+}
+
+
+/*-------------------------------------------------
+    filter_cost - estimate how well a filtered
+    row will compress: the sum of its bytes taken
+    as signed distances from zero
+-------------------------------------------------*/
+
+static UINT32 filter_cost(const UINT8 *row, int rowbytes)
+{
+	UINT32 cost = 0;
+	for (int x = 0; x < rowbytes; x++)
+		cost += abs(INT8(row[x]));
+	return cost;
+}
+
+
+/*-------------------------------------------------
+    filter_image - apply a prediction filter to
+    every row of an image converted with a filter
+    byte of 0; rows are done bottom up so the row
+    above is still unfiltered, and PNG_PF_Adaptive
+    tries every filter on each row and keeps the
+    cheapest
+-------------------------------------------------*/
+
+static png_error filter_image(png_info *pnginfo, int filter)
+{
+	int bpp = compute_bpp(pnginfo);
+	int rowbytes = compute_rowbytes(pnginfo);
+	int y;
+
+	if (filter < PNG_PF_None || filter > PNG_PF_Adaptive)
+		return PNGERR_UNKNOWN_FILTER;
+
+	/* palette indexes don't predict well, so those are always left alone */
+	if (filter == PNG_PF_None || pnginfo->color_type == 3)
+		return PNGERR_NONE;
+
+	/* one scratch row per candidate filter */
+	int const first = (filter == PNG_PF_Adaptive) ? PNG_PF_Sub : filter;
+	int const last = (filter == PNG_PF_Adaptive) ? PNG_PF_Paeth : filter;
+	std::unique_ptr<UINT8 []> scratch(new (std::nothrow) UINT8[(last - first + 1) * rowbytes]);
+	if (!scratch)
+		return PNGERR_OUT_OF_MEMORY;
+
+	for (y = pnginfo->height - 1; y >= 0; y--)
+	{
+		UINT8 *dst = pnginfo->image + y * (rowbytes + 1);
+		UINT8 *prev = (y == 0) ? nullptr : &dst[1 - (rowbytes + 1)];
+
+		/* the unfiltered row is the None candidate */
+		int best = PNG_PF_None;
+		UINT32 bestcost = (filter == PNG_PF_Adaptive) ? filter_cost(&dst[1], rowbytes) : ~UINT32(0);
+		for (int candidate = first; candidate <= last; candidate++)
+		{
+			UINT8 *row = &scratch[(candidate - first) * rowbytes];
+			filter_row(candidate, &dst[1], prev, row, bpp, rowbytes);
+			UINT32 const cost = (first == last) ? 0 : filter_cost(row, rowbytes);
+			if (cost < bestcost)
+			{
+				best = candidate;
+				bestcost = cost;
+			}
+		}
+
+		dst[0] = best;
+		if (best != PNG_PF_None)
+			memcpy(&dst[1], &scratch[(best - first) * rowbytes], rowbytes);
+	}
+
+	return PNGERR_NONE;
+}
+
+
 /*-------------------------------------------------
     write_png_stream - stream a series of PNG
     chunks to the given file
 -------------------------------------------------*/
 
-static png_error write_png_stream(util::core_file &fp, png_info *pnginfo, const bitmap_t &bitmap, int palette_length, const rgb_t *palette)
+static png_error write_png_stream(util::core_file &fp, png_info *pnginfo, const bitmap_t &bitmap, int palette_length, const rgb_t *palette, int level, int filter)
 {
 	UINT8 tempbuff[16];
 	png_text *text;
@@ -1020,7 +1402,10 @@ static png_error write_png_stream(util::core_file &fp, png_info *pnginfo, const
 	if (error != PNGERR_NONE)
 		goto handle_error;
 
-	/* if we wanted to get clever and do filtering, we would do it here */
+	/* apply the requested prediction filter */
+	error = filter_image(pnginfo, filter);
+	if (error != PNGERR_NONE)
+		goto handle_error;
 
 	/* write the IHDR chunk */
 	put_32bit(tempbuff + 0, pnginfo->width);
@@ -1041,7 +1426,7 @@ static png_error write_png_stream(util::core_file &fp, png_info *pnginfo, const
 		goto handle_error;
 
 	/* write a single IDAT chunk */
-	error = write_deflated_chunk(fp, pnginfo->image, PNG_CN_IDAT, pnginfo->height * (compute_rowbytes(pnginfo) + 1));
+	error = write_deflated_chunk(fp, pnginfo->image, PNG_CN_IDAT, pnginfo->height * (compute_rowbytes(pnginfo) + 1), level);
 	if (error != PNGERR_NONE)
 		goto handle_error;
 
@@ -1061,7 +1446,7 @@ handle_error:
 }
 
 
-png_error png_write_bitmap(util::core_file &fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette)
+png_error png_write_bitmap(util::core_file &fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette, int level, int filter)
 {
 	png_info pnginfo;
 	png_error error;
@@ -1082,7 +1467,7 @@ png_error png_write_bitmap(util::core_file &fp, png_info *info, bitmap_t &bitmap
 	}
 
 	/* write the rest of the PNG data */
-	error = write_png_stream(fp, info, bitmap, palette_length, palette);
+	error = write_png_stream(fp, info, bitmap, palette_length, palette, level, filter);
 	if (info == &pnginfo)
 		png_free(&pnginfo);
 	return error;
@@ -1131,7 +1516,7 @@ png_error mng_capture_start(util::core_file &fp, bitmap_t &bitmap, double rate)
 }
 
 /**
- * @fn  png_error mng_capture_frame(util::core_file &fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette)
+ * @fn  png_error mng_capture_frame(util::core_file &fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette, int level, int filter)
  *
  * @brief   Mng capture frame.
  *
@@ -1140,13 +1525,15 @@ png_error mng_capture_start(util::core_file &fp, bitmap_t &bitmap, double rate)
  * @param [in,out]  bitmap  The bitmap.
  * @param   palette_length  Length of the palette.
  * @param   palette         The palette.
+ * @param   level           The zlib compression level, or PNG_LEVEL_DEFAULT.
+ * @param   filter          The prediction filter applied to each row.
  *
  * @return  A png_error.
  */
 
-png_error mng_capture_frame(util::core_file &fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette)
+png_error mng_capture_frame(util::core_file &fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette, int level, int filter)
 {
-	return write_png_stream(fp, info, bitmap, palette_length, palette);
+	return write_png_stream(fp, info, bitmap, palette_length, palette, level, filter);
 }
 
 /**
@@ -56,6 +56,10 @@
 #define PNG_PF_Up           2
 #define PNG_PF_Average      3
 #define PNG_PF_Paeth        4
+#define PNG_PF_Adaptive     5       /* encoder only: the best of the above for each row */
+
+/* Compression level meaning zlib's default */
+#define PNG_LEVEL_DEFAULT   -1
 
 /* Error types */
 enum png_error
@@ -124,10 +128,10 @@ png_error png_read_bitmap(util::core_file &fp, bitmap_argb32 &bitmap);
 png_error png_expand_buffer_8bit(png_info *p);
 
 png_error png_add_text(png_info *pnginfo, const char *keyword, const char *text);
-png_error png_write_bitmap(util::core_file &fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette);
+png_error png_write_bitmap(util::core_file &fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette, int level = PNG_LEVEL_DEFAULT, int filter = PNG_PF_None);
 
 png_error mng_capture_start(util::core_file &fp, bitmap_t &bitmap, double rate);
-png_error mng_capture_frame(util::core_file &fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette);
+png_error mng_capture_frame(util::core_file &fp, png_info *info, bitmap_t &bitmap, int palette_length, const rgb_t *palette, int level = PNG_LEVEL_DEFAULT, int filter = PNG_PF_None);
 png_error mng_capture_stop(util::core_file &fp);
 
 #endif  /* __PNG_H__ */
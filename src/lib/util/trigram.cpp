@@ -0,0 +1,189 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    trigram.cpp
+
+    Trigram index for fast approximate name lookups.
+
+***************************************************************************/
+
+#include <assert.h>
+#include <ctype.h>
+#include <algorithm>
+
+#include "trigram.h"
+
+
+//**************************************************************************
+//  TRIGRAM INDEX
+//**************************************************************************
+
+//-------------------------------------------------
+//  trigram_index - constructor
+//-------------------------------------------------
+
+trigram_index::trigram_index()
+	: m_maxid(-1)
+{
+}
+
+
+//-------------------------------------------------
+//  reset - discard the contents of the index
+//-------------------------------------------------
+
+void trigram_index::reset()
+{
+	m_pending.clear();
+	m_keys.clear();
+	m_offsets.clear();
+	m_ids.clear();
+	m_maxid = -1;
+}
+
+
+//-------------------------------------------------
+//  add - index a string under the given id; an
+//  id may be added with several strings
+//-------------------------------------------------
+
+void trigram_index::add(int id, const char *string)
+{
+	assert(id >= 0);
+
+	std::vector<UINT32> trigrams;
+	extract(string, trigrams);
+	for (UINT32 trigram : trigrams)
+		m_pending.emplace_back(trigram, id);
+	m_maxid = std::max(m_maxid, id);
+}
+
+
+//-------------------------------------------------
+//  finalize - build the posting lists from
+//  everything added so far
+//-------------------------------------------------
+
+void trigram_index::finalize()
+{
+	// fold in the existing postings so finalize can be called repeatedly
+	for (size_t keynum = 0; keynum < m_keys.size(); keynum++)
+		for (UINT32 offset = m_offsets[keynum]; offset < m_offsets[keynum + 1]; offset++)
+			m_pending.emplace_back(m_keys[keynum], m_ids[offset]);
+
+	// sort by trigram then id, dropping repeats within an id
+	std::sort(m_pending.begin(), m_pending.end());
+	m_pending.erase(std::unique(m_pending.begin(), m_pending.end()), m_pending.end());
+
+	m_keys.clear();
+	m_offsets.clear();
+	m_ids.clear();
+	m_ids.reserve(m_pending.size());
+	for (const auto &entry : m_pending)
+	{
+		if (m_keys.empty() || m_keys.back() != entry.first)
+		{
+			m_keys.push_back(entry.first);
+			m_offsets.push_back(m_ids.size());
+		}
+		m_ids.push_back(entry.second);
+	}
+	m_offsets.push_back(m_ids.size());
+
+	m_pending.clear();
+	m_pending.shrink_to_fit();
+}
+
+
+//-------------------------------------------------
+//  usable - return true if a search string is
+//  long enough to be looked up in the index
+//-------------------------------------------------
+
+bool trigram_index::usable(const char *string)
+{
+	int alnum = 0;
+	for ( ; *string != 0 && alnum < 2; string++)
+		if (isalnum((UINT8)*string))
+			alnum++;
+	return alnum >= 2;
+}
+
+
+//-------------------------------------------------
+//  candidates - return up to maxcount ids sharing
+//  trigrams with the string, most shared first
+//-------------------------------------------------
+
+void trigram_index::candidates(const char *string, int maxcount, std::vector<int> &results) const
+{
+	assert(m_pending.empty());
+	results.clear();
+
+	std::vector<UINT32> trigrams;
+	extract(string, trigrams);
+	std::sort(trigrams.begin(), trigrams.end());
+	trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+
+	// tally the trigrams each id shares with the string
+	std::vector<UINT16> score(m_maxid + 1);
+	for (UINT32 trigram : trigrams)
+	{
+		auto key = std::lower_bound(m_keys.begin(), m_keys.end(), trigram);
+		if (key == m_keys.end() || *key != trigram)
+			continue;
+		size_t keynum = key - m_keys.begin();
+		for (UINT32 offset = m_offsets[keynum]; offset < m_offsets[keynum + 1]; offset++)
+			if (score[m_ids[offset]]++ == 0)
+				results.push_back(m_ids[offset]);
+	}
+
+	// keep the best, breaking ties by id so results are stable
+	auto better = [&score](int id1, int id2) { return (score[id1] != score[id2]) ? (score[id1] > score[id2]) : (id1 < id2); };
+	if (results.size() > maxcount)
+	{
+		std::nth_element(results.begin(), results.begin() + maxcount, results.end(), better);
+		results.resize(maxcount);
+	}
+	std::sort(results.begin(), results.end(), better);
+}
+
+
+//-------------------------------------------------
+//  extract - break a string into case-folded
+//  trigrams; punctuation separates words and
+//  each word is padded with a space on either
+//  side so that two-character words are found
+//-------------------------------------------------
+
+void trigram_index::extract(const char *string, std::vector<UINT32> &trigrams)
+{
+	UINT32 window = ' ';
+	int length = 1;
+	bool space = true;
+
+	for ( ; ; string++)
+	{
+		UINT8 ch = *string;
+		bool end = (ch == 0);
+		if (end && space)
+			break;
+
+		// fold case and collapse runs of anything else into a single space
+		if (isalnum(ch))
+			ch = tolower(ch);
+		else if (space && !end)
+			continue;
+		else
+			ch = ' ';
+		space = (ch == ' ');
+
+		// shift the character into the window and emit a trigram once it fills
+		window = ((window << 8) | ch) & 0xffffff;
+		if (++length >= 3)
+			trigrams.push_back(window);
+		if (end)
+			break;
+	}
+}
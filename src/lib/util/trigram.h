@@ -0,0 +1,60 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/*********************************************************************
+
+    trigram.h
+
+    Trigram index for fast approximate name lookups.
+
+*********************************************************************/
+
+#pragma once
+
+#ifndef __TRIGRAM_H_
+#define __TRIGRAM_H_
+
+#include "osdcomm.h"
+#include <vector>
+
+
+//**************************************************************************
+//  TYPE DEFINITIONS
+//**************************************************************************
+
+// ======================> trigram_index
+
+// an inverted index from case-folded trigrams to caller-supplied ids; a
+// query returns the ids sharing the most trigrams with the search string,
+// which the caller then ranks precisely with its own comparison
+class trigram_index
+{
+public:
+	// construction
+	trigram_index();
+
+	// getters
+	bool empty() const { return m_ids.empty(); }
+
+	// building
+	void reset();
+	void add(int id, const char *string);
+	void finalize();
+
+	// queries
+	static bool usable(const char *string);
+	void candidates(const char *string, int maxcount, std::vector<int> &results) const;
+
+private:
+	// internal helpers
+	static void extract(const char *string, std::vector<UINT32> &trigrams);
+
+	// internal state
+	std::vector<std::pair<UINT32, int>> m_pending;  // (trigram, id) pairs added since the last finalize
+	std::vector<UINT32>     m_keys;                 // sorted unique trigrams
+	std::vector<UINT32>     m_offsets;              // start of each trigram's ids in m_ids, plus an end marker
+	std::vector<int>        m_ids;                  // posting lists, concatenated
+	int                     m_maxid;                // largest id added
+};
+
+
+#endif  // __TRIGRAM_H_
@@ -26,6 +26,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <memory>
 #include <mutex>
 #include <utility>
 #include <vector>
@@ -103,13 +104,14 @@ public:
 	static ptr find_cached(const std::string &filename)
 	{
 		std::lock_guard<std::mutex> guard(s_cache_mutex);
-		for (std::size_t cachenum = 0; cachenum < s_cache.size(); cachenum++)
+		for (auto it = s_cache.begin(); it != s_cache.end(); ++it)
 		{
 			// if we have a valid entry and it matches our filename, use it and remove from the cache
-			if (s_cache[cachenum] && (filename == s_cache[cachenum]->m_filename))
+			if (filename == (*it)->m_filename)
 			{
-				ptr result;
-				std::swap(s_cache[cachenum], result);
+				ptr result(std::move(*it));
+				s_cache.erase(it);
+				s_cache_bytes -= result->memory_size();
 				osd_printf_verbose("un7z: found %s in cache\n", filename.c_str());
 				return result;
 			}
@@ -120,8 +122,25 @@ public:
 	static void cache_clear()
 	{
 		// clear call cache entries
-		std::lock_guard<std::mutex> guard(s_cache_mutex);
-		for (std::size_t cachenum = 0; cachenum < s_cache.size(); s_cache[cachenum++].reset()) { }
+		{
+			std::lock_guard<std::mutex> guard(s_cache_mutex);
+			s_cache.clear();
+			s_cache_bytes = 0;
+		}
+		std::lock_guard<std::mutex> guard(s_block_mutex);
+		s_blocks.clear();
+		s_block_bytes = 0;
+	}
+	static void set_cache_size(std::size_t bytes)
+	{
+		{
+			std::lock_guard<std::mutex> guard(s_cache_mutex);
+			s_cache_budget = bytes;
+			trim_cache();
+		}
+		std::lock_guard<std::mutex> guard(s_block_mutex);
+		s_block_budget = bytes;
+		trim_blocks();
 	}
 
 	archive_file::error initialize();
@@ -164,11 +183,53 @@ private:
 			bool partialpath);
 	void make_utf8_name(int index);
 
-	static constexpr std::size_t        CACHE_SIZE = 8;
-	static std::array<ptr, CACHE_SIZE>  s_cache;
+	// approximate memory held while sitting in the cache
+	std::size_t memory_size() const
+	{
+		std::size_t result = sizeof(*this) + m_filename.capacity() + m_out_buffer_size;
+		result += m_entries.capacity() * sizeof(entry);
+		for (entry const &e : m_entries)
+			result += e.name.capacity();
+		result += std::size_t(m_db.NumFiles) * 32 + std::size_t(m_db.db.NumPackStreams) * 16 + std::size_t(m_db.db.NumFolders) * 64;
+		return result;
+	}
+	static void trim_cache();
+
+	// decompressed solid blocks, shared between handles
+	typedef std::shared_ptr<Byte const> block_ptr;
+	struct cached_block
+	{
+		std::string     filename;
+		UInt32          index;
+		block_ptr       data;
+		std::size_t     size;
+	};
+	static block_ptr find_block(const std::string &filename, UInt32 index, std::size_t &size);
+	static void add_block(const std::string &filename, UInt32 index, Byte *data, std::size_t size);
+	static void trim_blocks();
+
+	// file information gathered once when the archive is opened
+	struct entry
+	{
+		std::string     name;
+		std::uint64_t   length;
+		std::uint32_t   crc;
+		bool            has_crc;
+		bool            is_dir;
+	};
+
+	static std::vector<ptr>             s_cache;        // closed archives, most recently used first
+	static std::size_t                  s_cache_bytes;  // memory held by cached archives
+	static std::size_t                  s_cache_budget; // limit on s_cache_bytes
 	static std::mutex                   s_cache_mutex;
 
+	static std::vector<cached_block>    s_blocks;       // decompressed blocks, most recently used first
+	static std::size_t                  s_block_bytes;  // memory held by decompressed blocks
+	static std::size_t                  s_block_budget; // limit on s_block_bytes
+	static std::mutex                   s_block_mutex;
+
 	const std::string           m_filename;             // copy of _7Z filename (for caching)
+	std::vector<entry>          m_entries;              // index of contained files
 
 	int                         m_curr_file_idx;        // current file index
 	bool                        m_curr_is_dir;          // current file is directory
@@ -234,9 +295,16 @@ private:
     GLOBAL VARIABLES
 ***************************************************************************/
 
-std::array<m7z_file_impl::ptr, m7z_file_impl::CACHE_SIZE> m7z_file_impl::s_cache;
+std::vector<m7z_file_impl::ptr> m7z_file_impl::s_cache;
+std::size_t m7z_file_impl::s_cache_bytes = 0;
+std::size_t m7z_file_impl::s_cache_budget = archive_file::DEFAULT_CACHE_SIZE;
 std::mutex m7z_file_impl::s_cache_mutex;
 
+std::vector<m7z_file_impl::cached_block> m7z_file_impl::s_blocks;
+std::size_t m7z_file_impl::s_block_bytes = 0;
+std::size_t m7z_file_impl::s_block_budget = archive_file::DEFAULT_CACHE_SIZE;
+std::mutex m7z_file_impl::s_block_mutex;
+
 
 
 /***************************************************************************
@@ -273,6 +341,7 @@ CFileInStream::CFileInStream()
 
 m7z_file_impl::m7z_file_impl(const std::string &filename)
 	: m_filename(filename)
+	, m_entries()
 	, m_curr_file_idx(-1)
 	, m_curr_is_dir(false)
 	, m_curr_name()
@@ -323,6 +392,30 @@ archive_file::error m7z_file_impl::initialize()
 		}
 	}
 
+	// convert the names once rather than on every search
+	try
+	{
+		m_entries.resize(m_db.NumFiles);
+		for (UInt32 i = 0; i < m_db.NumFiles; i++)
+		{
+			make_utf8_name(i);
+			entry &e(m_entries[i]);
+			e.name = &m_utf8_buf[0];
+			e.length = SzArEx_GetFileSize(&m_db, i);
+			e.has_crc = SzBitWithVals_Check(&m_db.CRCs, i);
+			e.crc = e.has_crc ? m_db.CRCs.Vals[i] : 0;
+			e.is_dir = SzArEx_IsDir(&m_db, i);
+		}
+	}
+	catch (...)
+	{
+		osd_printf_error("un7z: %s failed to allocate memory for file index\n", m_filename.c_str());
+		return archive_file::error::OUT_OF_MEMORY;
+	}
+	std::vector<UInt16>().swap(m_utf16_buf);
+	std::vector<unicode_char>().swap(m_uchar_buf);
+	std::vector<char>().swap(m_utf8_buf);
+
 	return archive_file::error::NONE;
 }
 
@@ -340,25 +433,103 @@ void m7z_file_impl::close(ptr &&archive)
 	osd_printf_verbose("un7z: closing archive file %s and sending to cache\n", archive->m_filename.c_str());
 	archive->m_archive_stream.osdfile.reset();
 
-	// find the first nullptr entry in the cache
+	// the same archive may have been opened twice; keep the newer copy
 	std::lock_guard<std::mutex> guard(s_cache_mutex);
-	std::size_t cachenum;
-	for (cachenum = 0; cachenum < s_cache.size(); cachenum++)
-		if (!s_cache[cachenum])
+	for (auto it = s_cache.begin(); it != s_cache.end(); ++it)
+	{
+		if (archive->m_filename == (*it)->m_filename)
+		{
+			s_cache_bytes -= (*it)->memory_size();
+			s_cache.erase(it);
 			break;
+		}
+	}
+
+	// place us at the top and drop whatever no longer fits
+	s_cache_bytes += archive->memory_size();
+	s_cache.insert(s_cache.begin(), std::move(archive));
+	trim_cache();
+}
 
-	// if no room left in the cache, free the bottommost entry
-	if (cachenum == s_cache.size())
+
+/*-------------------------------------------------
+    trim_cache - free least recently used
+    archives until the cache is within budget;
+    called with the cache mutex held
+-------------------------------------------------*/
+
+void m7z_file_impl::trim_cache()
+{
+	// the most recent archive always stays, as it may be holding a block too large to share
+	while ((s_cache.size() > 1) && (s_cache_bytes > s_cache_budget))
 	{
-		cachenum--;
-		osd_printf_verbose("un7z: removing %s from cache to make space\n", s_cache[cachenum]->m_filename.c_str());
-		s_cache[cachenum].reset();
+		osd_printf_verbose("un7z: removing %s from cache to make space\n", s_cache.back()->m_filename.c_str());
+		s_cache_bytes -= s_cache.back()->memory_size();
+		s_cache.pop_back();
 	}
+}
+
+
+/*-------------------------------------------------
+    find_block - look for a decompressed solid
+    block in the shared cache
+-------------------------------------------------*/
 
-	// move everyone else down and place us at the top
-	for ( ; cachenum > 0; cachenum--)
-		s_cache[cachenum] = std::move(s_cache[cachenum - 1]);
-	s_cache[0] = std::move(archive);
+m7z_file_impl::block_ptr m7z_file_impl::find_block(const std::string &filename, UInt32 index, std::size_t &size)
+{
+	std::lock_guard<std::mutex> guard(s_block_mutex);
+	for (auto it = s_blocks.begin(); it != s_blocks.end(); ++it)
+	{
+		if ((index == it->index) && (filename == it->filename))
+		{
+			// move to the front so it's the last to go
+			std::rotate(s_blocks.begin(), it, it + 1);
+			size = s_blocks.front().size;
+			return s_blocks.front().data;
+		}
+	}
+	return block_ptr();
+}
+
+
+/*-------------------------------------------------
+    add_block - take ownership of a decompressed
+    solid block and share it with other handles
+-------------------------------------------------*/
+
+void m7z_file_impl::add_block(const std::string &filename, UInt32 index, Byte *data, std::size_t size)
+{
+	block_ptr block(data, [] (Byte const *p) { SzFree(nullptr, const_cast<Byte *>(p)); });
+
+	std::lock_guard<std::mutex> guard(s_block_mutex);
+	for (auto it = s_blocks.begin(); it != s_blocks.end(); ++it)
+	{
+		if ((index == it->index) && (filename == it->filename))
+		{
+			s_block_bytes -= it->size;
+			s_blocks.erase(it);
+			break;
+		}
+	}
+	s_blocks.insert(s_blocks.begin(), cached_block{ filename, index, std::move(block), size });
+	s_block_bytes += size;
+	trim_blocks();
+}
+
+
+/*-------------------------------------------------
+    trim_blocks - free least recently used blocks
+    until the cache is within budget; called with
+    the block mutex held
+-------------------------------------------------*/
+
+void m7z_file_impl::trim_blocks()
+{
+	while (!s_blocks.empty() && (s_block_bytes > s_block_budget))
+	{
+		s_block_bytes -= s_blocks.back().size;
+		s_blocks.pop_back();
+	}
 }
 
 
@@ -381,6 +552,36 @@ archive_file::error m7z_file_impl::decompress(void *buffer, std::uint32_t length
 		return archive_file::error::BUFFER_TOO_SMALL;
 	}
 
+	// empty files aren't stored in any block
+	UInt32 const block_index(m_db.FileToFolder[m_curr_file_idx]);
+	if (block_index == UInt32(-1))
+		return archive_file::error::NONE;
+
+	// see if another handle has already decompressed this file's solid block
+	if (!m_out_buffer || (m_block_index != block_index))
+	{
+		std::size_t block_size(0);
+		block_ptr const block(find_block(m_filename, block_index, block_size));
+		if (block)
+		{
+			std::uint64_t const start(m_db.UnpackPositions[m_curr_file_idx]);
+			std::size_t const offset(std::size_t(start - m_db.UnpackPositions[m_db.FolderToFile[block_index]]));
+			std::size_t const size(std::size_t(m_db.UnpackPositions[m_curr_file_idx + 1] - start));
+			if ((offset + size) > block_size)
+			{
+				osd_printf_error("un7z: error decompressing %s from %s (cached block too small)\n", m_curr_name.c_str(), m_filename.c_str());
+				return archive_file::error::DECOMPRESS_ERROR;
+			}
+			if (SzBitWithVals_Check(&m_db.CRCs, m_curr_file_idx) && (CrcCalc(block.get() + offset, size) != m_db.CRCs.Vals[m_curr_file_idx]))
+			{
+				osd_printf_error("un7z: error decompressing %s from %s (%d)\n", m_curr_name.c_str(), m_filename.c_str(), int(SZ_ERROR_CRC));
+				return archive_file::error::DECOMPRESS_ERROR;
+			}
+			std::memcpy(buffer, block.get() + offset, (std::min<std::size_t>)(length, size));
+			return archive_file::error::NONE;
+		}
+	}
+
 	// make sure the file is open..
 	if (!m_archive_stream.osdfile)
 	{
@@ -415,6 +616,21 @@ archive_file::error m7z_file_impl::decompress(void *buffer, std::uint32_t length
 
 	// copy to destination buffer
 	std::memcpy(buffer, m_out_buffer + offset, (std::min<std::size_t>)(length, out_size_processed));
+
+	// hand the block over to the shared cache if it fits; otherwise just keep it
+	// for this handle as before
+	bool shared;
+	{
+		std::lock_guard<std::mutex> guard(s_block_mutex);
+		shared = m_out_buffer && (m_out_buffer_size <= s_block_budget);
+	}
+	if (shared)
+	{
+		add_block(m_filename, m_block_index, m_out_buffer, m_out_buffer_size);
+		m_block_index = UInt32(-1);
+		m_out_buffer = nullptr;
+		m_out_buffer_size = 0;
+	}
 	return archive_file::error::NONE;
 }
 
@@ -427,27 +643,28 @@ int m7z_file_impl::search(
 		bool matchname,
 		bool partialpath)
 {
-	for ( ; i < m_db.NumFiles; i++)
-	{
-		make_utf8_name(i);
-		bool const is_dir(SzArEx_IsDir(&m_db, i));
-		const std::uint64_t size(SzArEx_GetFileSize(&m_db, i));
-		const std::uint32_t crc(m_db.CRCs.Vals[i]);
-		const bool crcmatch(SzBitArray_Check(m_db.CRCs.Defs, i) && (crc == search_crc));
-		auto const partialoffset(m_utf8_buf.size() - 1 - search_filename.length());
-		bool const partialpossible((m_utf8_buf.size() > (search_filename.length() + 1)) && (m_utf8_buf[partialoffset - 1] == '/'));
-		const bool namematch(
-				!core_stricmp(search_filename.c_str(), &m_utf8_buf[0]) ||
-				(partialpath && partialpossible && !core_stricmp(search_filename.c_str(), &m_utf8_buf[partialoffset])));
-
-		const bool found = ((!matchcrc && !matchname) || !is_dir) && (!matchcrc || crcmatch) && (!matchname || namematch);
+	for ( ; i < int(m_entries.size()); i++)
+	{
+		entry const &e(m_entries[i]);
+		const bool crcmatch(e.has_crc && (e.crc == search_crc));
+		bool namematch(false);
+		if (matchname)
+		{
+			auto const partialoffset(e.name.length() - search_filename.length());
+			bool const partialpossible((e.name.length() > search_filename.length()) && (e.name[partialoffset - 1] == '/'));
+			namematch =
+					!core_stricmp(search_filename.c_str(), e.name.c_str()) ||
+					(partialpath && partialpossible && !core_stricmp(search_filename.c_str(), e.name.c_str() + partialoffset));
+		}
+
+		const bool found = ((!matchcrc && !matchname) || !e.is_dir) && (!matchcrc || crcmatch) && (!matchname || namematch);
 		if (found)
 		{
 			m_curr_file_idx = i;
-			m_curr_is_dir = is_dir;
-			m_curr_name = &m_utf8_buf[0];
-			m_curr_length = size;
-			m_curr_crc = crc;
+			m_curr_is_dir = e.is_dir;
+			m_curr_name = e.name;
+			m_curr_length = e.length;
+			m_curr_crc = e.crc;
 
 			return i;
 		}
@@ -543,4 +760,11 @@ void m7z_file_cache_clear()
 	m7z_file_impl::cache_clear();
 }
 
+
+void m7z_file_set_cache_size(std::size_t bytes)
+{
+	// also a trampoline called from unzip.cpp
+	m7z_file_impl::set_cache_size(bytes);
+}
+
 } // namespace util
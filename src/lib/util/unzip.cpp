@@ -44,25 +44,25 @@ public:
 		, m_file()
 		, m_length(0)
 		, m_ecd()
-		, m_cd()
+		, m_entries()
 		, m_cd_pos(0)
 		, m_header()
 		, m_curr_is_dir(false)
 		, m_buffer()
 	{
-		std::fill(m_buffer.begin(), m_buffer.end(), 0);
 	}
 
 	static ptr find_cached(const std::string &filename)
 	{
 		std::lock_guard<std::mutex> guard(s_cache_mutex);
-		for (std::size_t cachenum = 0; cachenum < s_cache.size(); cachenum++)
+		for (auto it = s_cache.begin(); it != s_cache.end(); ++it)
 		{
 			// if we have a valid entry and it matches our filename, use it and remove from the cache
-			if (s_cache[cachenum] && (filename == s_cache[cachenum]->m_filename))
+			if (filename == (*it)->m_filename)
 			{
-				ptr result;
-				std::swap(s_cache[cachenum], result);
+				ptr result(std::move(*it));
+				s_cache.erase(it);
+				s_cache_bytes -= result->memory_size();
 				osd_printf_verbose("unzip: found %s in cache\n", filename.c_str());
 				return result;
 			}
@@ -74,7 +74,14 @@ public:
 	{
 		// clear call cache entries
 		std::lock_guard<std::mutex> guard(s_cache_mutex);
-		for (std::size_t cachenum = 0; cachenum < s_cache.size(); s_cache[cachenum++].reset()) { }
+		s_cache.clear();
+		s_cache_bytes = 0;
+	}
+	static void set_cache_size(std::size_t bytes)
+	{
+		std::lock_guard<std::mutex> guard(s_cache_mutex);
+		s_cache_budget = bytes;
+		trim_cache();
 	}
 
 	archive_file::error initialize()
@@ -102,7 +109,8 @@ public:
 		}
 
 		// allocate memory for the central directory
-		try { m_cd.resize(std::size_t(m_ecd.cd_size)); }
+		std::vector<std::uint8_t> cd;
+		try { cd.resize(std::size_t(m_ecd.cd_size)); }
 		catch (...)
 		{
 			osd_printf_error("unzip: %s failed to allocate memory for central directory\n", m_filename.c_str());
@@ -116,7 +124,7 @@ public:
 		{
 			std::uint32_t const chunk(std::uint32_t((std::min<std::uint64_t>)(std::numeric_limits<std::uint32_t>::max(), cd_remaining)));
 			std::uint32_t read_length(0);
-			auto const filerr = m_file->read(&m_cd[cd_offs], m_ecd.cd_start_disk_offset + cd_offs, chunk, read_length);
+			auto const filerr = m_file->read(&cd[cd_offs], m_ecd.cd_start_disk_offset + cd_offs, chunk, read_length);
 			if (filerr != osd_file::error::NONE)
 			{
 				osd_printf_error("unzip: %s error reading central directory (%d)\n", m_filename.c_str(), int(filerr));
@@ -132,7 +140,8 @@ public:
 		}
 		osd_printf_verbose("unzip: read %s central directory\n", m_filename.c_str());
 
-		return archive_file::error::NONE;
+		// parse it once; searches and reopening from the cache only touch the index
+		return parse_cd(cd);
 	}
 
 	int first_file()
@@ -176,8 +185,19 @@ private:
 
 	int search(std::uint32_t search_crc, const std::string &search_filename, bool matchcrc, bool matchname, bool partialpath);
 
+	// approximate memory held while sitting in the cache
+	std::size_t memory_size() const
+	{
+		std::size_t result = sizeof(*this) + m_filename.capacity() + (m_entries.capacity() * sizeof(file_header));
+		for (file_header const &entry : m_entries)
+			result += entry.file_name.capacity();
+		return result;
+	}
+	static void trim_cache();
+
 	archive_file::error reopen()
 	{
+		m_buffer.resize(DECOMPRESS_BUFSIZE);
 		if (!m_file)
 		{
 			auto const filerr = osd_file::open(m_filename, OPEN_FLAG_READ, m_file, m_length);
@@ -197,6 +217,7 @@ private:
 
 	// ZIP file parsing
 	archive_file::error read_ecd();
+	archive_file::error parse_cd(std::vector<std::uint8_t> const &cd);
 	archive_file::error get_compressed_data_offset(std::uint64_t &offset);
 
 	// decompression interfaces
@@ -216,6 +237,7 @@ private:
 		std::uint32_t   start_disk_number;      // disk number start
 		std::uint64_t   local_header_offset;    // relative offset of local header
 		std::string     file_name;              // file name
+		bool            is_dir;                 // entry is a directory
 	};
 
 	// contains extracted end of central directory information
@@ -230,8 +252,9 @@ private:
 	};
 
 	static constexpr std::size_t        DECOMPRESS_BUFSIZE = 16384;
-	static constexpr std::size_t        CACHE_SIZE = 8; // number of open files to cache
-	static std::array<ptr, CACHE_SIZE>  s_cache;
+	static std::vector<ptr>             s_cache;        // closed archives, most recently used first
+	static std::size_t                  s_cache_bytes;  // memory held by cached archives
+	static std::size_t                  s_cache_budget; // limit on s_cache_bytes
 	static std::mutex                   s_cache_mutex;
 
 	const std::string           m_filename;                 // copy of ZIP filename (for caching)
@@ -240,12 +263,12 @@ private:
 
 	ecd                         m_ecd;                      // end of central directory
 
-	std::vector<std::uint8_t>   m_cd;                       // central directory raw data
-	std::uint32_t               m_cd_pos;                   // position in central directory
+	std::vector<file_header>    m_entries;                  // parsed central directory
+	std::size_t                 m_cd_pos;                   // position in central directory
 	file_header                 m_header;                   // current file header
 	bool                        m_curr_is_dir;              // current file is directory
 
-	std::array<std::uint8_t, DECOMPRESS_BUFSIZE> m_buffer;  // buffer for decompression
+	std::vector<std::uint8_t>   m_buffer;                   // buffer for decompression, only kept while open
 };
 
 
@@ -566,8 +589,10 @@ private:
     GLOBAL VARIABLES
 ***************************************************************************/
 
-/** @brief  The zip cache[ zip cache size]. */
-std::array<zip_file_impl::ptr, zip_file_impl::CACHE_SIZE> zip_file_impl::s_cache;
+/** @brief  The zip cache, limited by memory rather than number of archives. */
+std::vector<zip_file_impl::ptr> zip_file_impl::s_cache;
+std::size_t zip_file_impl::s_cache_bytes = 0;
+std::size_t zip_file_impl::s_cache_budget = archive_file::DEFAULT_CACHE_SIZE;
 std::mutex zip_file_impl::s_cache_mutex;
 
 
@@ -584,26 +609,41 @@ void zip_file_impl::close(ptr &&zip)
 	// close the open files
 	osd_printf_verbose("unzip: closing archive file %s and sending to cache\n", zip->m_filename.c_str());
 	zip->m_file.reset();
+	std::vector<std::uint8_t>().swap(zip->m_buffer);
 
-	// find the first nullptr entry in the cache
+	// the same archive may have been opened twice; keep the newer copy
 	std::lock_guard<std::mutex> guard(s_cache_mutex);
-	std::size_t cachenum;
-	for (cachenum = 0; cachenum < s_cache.size(); cachenum++)
-		if (!s_cache[cachenum])
+	for (auto it = s_cache.begin(); it != s_cache.end(); ++it)
+	{
+		if (zip->m_filename == (*it)->m_filename)
+		{
+			s_cache_bytes -= (*it)->memory_size();
+			s_cache.erase(it);
 			break;
+		}
+	}
+
+	// place us at the top and drop whatever no longer fits
+	s_cache_bytes += zip->memory_size();
+	s_cache.insert(s_cache.begin(), std::move(zip));
+	trim_cache();
+}
+
+
+/*-------------------------------------------------
+    trim_cache - free least recently used
+    archives until the cache is within budget;
+    called with the cache mutex held
+-------------------------------------------------*/
 
-	// if no room left in the cache, free the bottommost entry
-	if (cachenum == s_cache.size())
+void zip_file_impl::trim_cache()
+{
+	while (!s_cache.empty() && (s_cache_bytes > s_cache_budget))
 	{
-		cachenum--;
-		osd_printf_verbose("unzip: removing %s from cache to make space\n", s_cache[cachenum]->m_filename.c_str());
-		s_cache[cachenum].reset();
+		osd_printf_verbose("unzip: removing %s from cache to make space\n", s_cache.back()->m_filename.c_str());
+		s_cache_bytes -= s_cache.back()->memory_size();
+		s_cache.pop_back();
 	}
-
-	// move everyone else down and place us at the top
-	for ( ; cachenum > 0; cachenum--)
-		s_cache[cachenum] = std::move(s_cache[cachenum - 1]);
-	s_cache[0] = std::move(zip);
 }
 
 
@@ -619,83 +659,27 @@ void zip_file_impl::close(ptr &&zip)
 int zip_file_impl::search(std::uint32_t search_crc, const std::string &search_filename, bool matchcrc, bool matchname, bool partialpath)
 {
 	// if we're at or past the end, we're done
-	while ((m_cd_pos + central_dir_entry_reader::minimum_length()) <= m_ecd.cd_size)
+	while (m_cd_pos < m_entries.size())
 	{
-		// make sure we have enough data
-		central_dir_entry_reader const reader(&m_cd[0] + m_cd_pos);
-		if (!reader.signature_correct() || ((m_cd_pos + reader.total_length()) > m_ecd.cd_size))
-			break;
-
-		// extract file header info
-		m_header.version_created     = reader.version_created();
-		m_header.version_needed      = reader.version_needed();
-		m_header.bit_flag            = reader.general_flag();
-		m_header.compression         = reader.compression_method();
-		m_header.crc                 = reader.crc32();
-		m_header.compressed_length   = reader.compressed_size();
-		m_header.uncompressed_length = reader.uncompressed_size();
-		m_header.start_disk_number   = reader.start_disk();
-		m_header.local_header_offset = reader.header_offset();
+		file_header const &entry(m_entries[m_cd_pos++]);
 
-		// advance the position
-		m_cd_pos += reader.total_length();
-
-		// copy the filename
-		bool is_utf8(general_flag_reader(m_header.bit_flag).utf8_encoding());
-		reader.file_name(m_header.file_name);
-
-		// walk the extra data
-		for (auto extra = reader.extra_field(); extra.length_sufficient(); extra = extra.next())
+		// check to see if it matches query
+		bool const crcmatch(search_crc == entry.crc);
+		bool namematch(false);
+		if (matchname)
 		{
-			// look for ZIP64 extended info
-			if ((extra.header_id() == 0x0001) && (extra.data_size() >= zip64_ext_info_reader::minimum_length()))
-			{
-				zip64_ext_info_reader const ext64(reader, extra);
-				if (extra.data_size() >= ext64.total_length())
-				{
-					m_header.compressed_length   = ext64.compressed_size();
-					m_header.uncompressed_length = ext64.uncompressed_size();
-					m_header.start_disk_number   = ext64.start_disk();
-					m_header.local_header_offset = ext64.header_offset();
-				}
-			}
-
-			// look for Info-ZIP UTF-8 path
-			if (!is_utf8 && (extra.header_id() == 0x7075) && (extra.data_size() >= utf8_path_reader::minimum_length()))
-			{
-				utf8_path_reader const utf8path(extra);
-				if (utf8path.version() == 1)
-				{
-					auto const addr(m_header.file_name.empty() ? nullptr : &m_header.file_name[0]);
-					auto const length(m_header.file_name.empty() ? 0 : m_header.file_name.length() * sizeof(m_header.file_name[0]));
-					auto const crc(crc32_creator::simple(addr, length));
-					if (utf8path.name_crc32() == crc.m_raw)
-					{
-						utf8path.unicode_name(m_header.file_name);
-						is_utf8 = true;
-					}
-				}
-			}
+			auto const partialoffset(entry.file_name.length() - search_filename.length());
+			bool const partialpossible((entry.file_name.length() > search_filename.length()) && (entry.file_name[partialoffset - 1] == '/'));
+			namematch =
+					!core_stricmp(search_filename.c_str(), entry.file_name.c_str()) ||
+					(partialpath && partialpossible && !core_stricmp(search_filename.c_str(), entry.file_name.c_str() + partialoffset));
 		}
 
-		// FIXME: if (!is_utf8) convert filename to UTF8 (assume CP437 or something)
-
-		// chop off trailing slash for directory entries
-		bool const is_dir(!m_header.file_name.empty() && (m_header.file_name.back() == '/'));
-		if (is_dir) m_header.file_name.resize(m_header.file_name.length() - 1);
-
-		// check to see if it matches query
-		bool const crcmatch(search_crc == m_header.crc);
-		auto const partialoffset(m_header.file_name.length() - search_filename.length());
-		bool const partialpossible((m_header.file_name.length() > search_filename.length()) && (m_header.file_name[partialoffset - 1] == '/'));
-		const bool namematch(
-				!core_stricmp(search_filename.c_str(), m_header.file_name.c_str()) ||
-				(partialpath && partialpossible && !core_stricmp(search_filename.c_str(), m_header.file_name.c_str() + partialoffset)));
-
-		bool const found = ((!matchcrc && !matchname) || !is_dir) && (!matchcrc || crcmatch) && (!matchname || namematch);
+		bool const found = ((!matchcrc && !matchname) || !entry.is_dir) && (!matchcrc || crcmatch) && (!matchname || namematch);
 		if (found)
 		{
-			m_curr_is_dir = is_dir;
+			m_header = entry;
+			m_curr_is_dir = entry.is_dir;
 			return 0;
 		}
 	}
@@ -921,6 +905,96 @@ archive_file::error zip_file_impl::read_ecd()
 }
 
 
+/*-------------------------------------------------
+    parse_cd - build the index of entries from
+    the raw central directory
+-------------------------------------------------*/
+
+archive_file::error zip_file_impl::parse_cd(std::vector<std::uint8_t> const &cd)
+{
+	try { m_entries.reserve(std::size_t(m_ecd.cd_total_entries)); }
+	catch (...) { }
+
+	std::size_t pos(0);
+	while ((pos + central_dir_entry_reader::minimum_length()) <= cd.size())
+	{
+		// make sure we have enough data
+		central_dir_entry_reader const reader(&cd[0] + pos);
+		if (!reader.signature_correct() || ((pos + reader.total_length()) > cd.size()))
+			break;
+
+		// extract file header info
+		file_header header;
+		header.version_created     = reader.version_created();
+		header.version_needed      = reader.version_needed();
+		header.bit_flag            = reader.general_flag();
+		header.compression         = reader.compression_method();
+		header.crc                 = reader.crc32();
+		header.compressed_length   = reader.compressed_size();
+		header.uncompressed_length = reader.uncompressed_size();
+		header.start_disk_number   = reader.start_disk();
+		header.local_header_offset = reader.header_offset();
+
+		// advance the position
+		pos += reader.total_length();
+
+		// copy the filename
+		bool is_utf8(general_flag_reader(header.bit_flag).utf8_encoding());
+		reader.file_name(header.file_name);
+
+		// walk the extra data
+		for (auto extra = reader.extra_field(); extra.length_sufficient(); extra = extra.next())
+		{
+			// look for ZIP64 extended info
+			if ((extra.header_id() == 0x0001) && (extra.data_size() >= zip64_ext_info_reader::minimum_length()))
+			{
+				zip64_ext_info_reader const ext64(reader, extra);
+				if (extra.data_size() >= ext64.total_length())
+				{
+					header.compressed_length   = ext64.compressed_size();
+					header.uncompressed_length = ext64.uncompressed_size();
+					header.start_disk_number   = ext64.start_disk();
+					header.local_header_offset = ext64.header_offset();
+				}
+			}
+
+			// look for Info-ZIP UTF-8 path
+			if (!is_utf8 && (extra.header_id() == 0x7075) && (extra.data_size() >= utf8_path_reader::minimum_length()))
+			{
+				utf8_path_reader const utf8path(extra);
+				if (utf8path.version() == 1)
+				{
+					auto const addr(header.file_name.empty() ? nullptr : &header.file_name[0]);
+					auto const length(header.file_name.empty() ? 0 : header.file_name.length() * sizeof(header.file_name[0]));
+					auto const crc(crc32_creator::simple(addr, length));
+					if (utf8path.name_crc32() == crc.m_raw)
+					{
+						utf8path.unicode_name(header.file_name);
+						is_utf8 = true;
+					}
+				}
+			}
+		}
+
+		// FIXME: if (!is_utf8) convert filename to UTF8 (assume CP437 or something)
+
+		// chop off trailing slash for directory entries
+		header.is_dir = !header.file_name.empty() && (header.file_name.back() == '/');
+		if (header.is_dir) header.file_name.resize(header.file_name.length() - 1);
+
+		try { m_entries.emplace_back(std::move(header)); }
+		catch (...)
+		{
+			osd_printf_error("unzip: %s failed to allocate memory for central directory index\n", m_filename.c_str());
+			return archive_file::error::OUT_OF_MEMORY;
+		}
+	}
+	m_entries.shrink_to_fit();
+
+	return archive_file::error::NONE;
+}
+
+
 /*-------------------------------------------------
     get_compressed_data_offset - return the
     offset of the compressed data
@@ -1321,6 +1395,7 @@ archive_file::error zip_file_impl::decompress_data_type_14(std::uint64_t offset,
 ***************************************************************************/
 
 void m7z_file_cache_clear();
+void m7z_file_set_cache_size(std::size_t bytes);
 
 
 
@@ -1374,6 +1449,18 @@ void archive_file::cache_clear()
 }
 
 
+/*-------------------------------------------------
+    set_cache_size - set the memory budget for
+    the ZIP and 7Z caches
+-------------------------------------------------*/
+
+void archive_file::set_cache_size(std::size_t bytes)
+{
+	zip_file_impl::set_cache_size(bytes);
+	m7z_file_set_cache_size(bytes);
+}
+
+
 archive_file::~archive_file()
 {
 }
@@ -15,6 +15,7 @@
 
 #include "osdcore.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -46,6 +47,9 @@ public:
 
 	typedef std::unique_ptr<archive_file> ptr;
 
+	// default memory budget for each of the archive caches
+	static constexpr std::size_t DEFAULT_CACHE_SIZE = 64 * 1024 * 1024;
+
 
 	/* ----- archive file access ----- */
 
@@ -61,6 +65,9 @@ public:
 	// clear out all open files from the cache
 	static void cache_clear();
 
+	// set the memory budget for cached archive indexes and decompressed 7z blocks
+	static void set_cache_size(std::size_t bytes);
+
 
 	/* ----- contained file access ----- */
 
@@ -0,0 +1,561 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/*************************************************************************
+
+    sndreplay.cpp
+
+    Sound register log replay.
+
+    Plays a register log captured with -soundlog back into a lone sound
+    device, performing the logged writes at their original emulated
+    times, and on exit reports the samples generated per second of host
+    time along with a SHA1 of the device's raw output.  Nothing else is
+    emulated, so this measures the sound core alone.
+
+    These systems are not part of the main driver list; make
+    SUBTARGET=sndreplay builds them into their own mamesndreplay
+    executable.  There is one system per supported device, named after
+    the log extension:
+
+        mamesndreplay srl2151 -soundreplay snap/<system>/<tag>.srl
+                              -video none -sound none -nothrottle
+
+    The hash covers every output at the device's native sample rate and
+    does not depend on -samplerate, so it can be compared across builds
+    to check that an optimization leaves the output unchanged.
+
+    Supported devices are those whose register writes and sample memory
+    are captured in full; chips that play from RAM the host CPU writes
+    directly (SCSP, AICA, ...) can't be replayed from a register log.
+
+**************************************************************************/
+
+#include "emu.h"
+#include "emuopts.h"
+#include "sndlog.h"
+#include "sound/2151intf.h"
+#include "sound/2203intf.h"
+#include "sound/2608intf.h"
+#include "sound/2610intf.h"
+#include "sound/262intf.h"
+#include "sound/3526intf.h"
+#include "sound/3812intf.h"
+#include "sound/8950intf.h"
+#include "sound/es5506.h"
+#include "sound/ymf271.h"
+
+
+
+//**************************************************************************
+//  CONSTANTS
+//**************************************************************************
+
+// how long to keep running after the last write so release tails are included
+static const attotime TAIL_TIME = attotime::from_seconds(1);
+
+
+
+//**************************************************************************
+//  SUPPORTED DEVICES
+//**************************************************************************
+
+struct replay_chip
+{
+	const char *            shortname;
+	const char *            system;         // system that replays it
+	const char *            regions[4];     // region tag for each logged memory index
+	void                  (*configure)(device_t &chip, const sound_log &log);
+	void                  (*write)(device_t &chip, offs_t offset, UINT32 data, UINT32 mem_mask);
+};
+
+template<class _ChipClass>
+static void chip_write(device_t &chip, offs_t offset, UINT32 data, UINT32 mem_mask)
+{
+	downcast<_ChipClass &>(chip).write(chip.machine().driver_data()->generic_space(), offset, data, mem_mask);
+}
+
+static void es5505_configure(device_t &chip, const sound_log &log)
+{
+	es5505_device::set_channels(chip, log.outputs() / 2);
+}
+
+static void es5506_configure(device_t &chip, const sound_log &log)
+{
+	es5506_device::set_channels(chip, log.outputs() / 2);
+}
+
+static const replay_chip s_chips[] =
+{
+	{ "ym2151", "srl2151", { nullptr }, nullptr, chip_write<ym2151_device> },
+	{ "ym2203", "srl2203", { nullptr }, nullptr, chip_write<ym2203_device> },
+	{ "ym2608", "srl2608", { nullptr }, nullptr, chip_write<ym2608_device> },
+	{ "ym2610", "srl2610", { "chip", "chip.deltat" }, nullptr, chip_write<ym2610_device> },
+	{ "ym2610b", "srl2610b", { "chip", "chip.deltat" }, nullptr, chip_write<ym2610_device> },
+	{ "ymf262", "srl262", { nullptr }, nullptr, chip_write<ymf262_device> },
+	{ "ym3526", "srl3526", { nullptr }, nullptr, chip_write<ym3526_device> },
+	{ "ym3812", "srl3812", { nullptr }, nullptr, chip_write<ym3812_device> },
+	{ "y8950", "srl8950", { "chip" }, nullptr, chip_write<y8950_device> },
+	{ "ymf271", "srl271", { "chip" }, nullptr, chip_write<ymf271_device> },
+	{ "es5505", "srl5505", { "rom0", "rom1" }, es5505_configure, chip_write<es5505_device> },
+	{ "es5506", "srl5506", { "rom0", "rom1", "rom2", "rom3" }, es5506_configure, chip_write<es5506_device> }
+};
+
+static const replay_chip *find_chip(const std::string &shortname)
+{
+	for (const replay_chip &chip : s_chips)
+		if (shortname == chip.shortname)
+			return &chip;
+	return nullptr;
+}
+
+
+
+//**************************************************************************
+//  REPLAY DEVICE
+//**************************************************************************
+
+// ======================> sound_replay_device
+
+// reads the log and prepares the chip for it: the clock and channel count,
+// and regions of the right size for its sample memory; it is added ahead of
+// the chip so that this is done before the chip starts, which the driver's
+// own start-up would be too late for
+class sound_replay_device : public device_t
+{
+public:
+	sound_replay_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock);
+
+	// getters
+	const sound_log &log() const { return m_log; }
+	const replay_chip &info() const { return *m_info; }
+
+protected:
+	// device-level overrides
+	virtual void device_start() override;
+
+private:
+	sound_log               m_log;
+	const replay_chip *     m_info;
+};
+
+static const device_type SOUND_REPLAY = &device_creator<sound_replay_device>;
+
+sound_replay_device::sound_replay_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock)
+	: device_t(mconfig, SOUND_REPLAY, "Sound Register Log Replay", tag, owner, clock, "sound_replay", __FILE__),
+		m_info(nullptr)
+{
+}
+
+
+//-------------------------------------------------
+//  device_start - load the log, set the chip's
+//  clock and allocate its sample memory
+//-------------------------------------------------
+
+void sound_replay_device::device_start()
+{
+	const char *filename = machine().options().sound_replay();
+	if (filename[0] == 0)
+		throw emu_fatalerror("sndreplay: no register log specified (use -%s)", OPTION_SOUNDREPLAY);
+	if (!m_log.load(filename))
+		throw emu_fatalerror("sndreplay: unable to read register log %s", filename);
+	m_info = find_chip(m_log.shortname());
+	if (m_info == nullptr)
+		throw emu_fatalerror("sndreplay: %s devices are not supported", m_log.shortname().c_str());
+	if (strcmp(machine().system().name, m_info->system) != 0)
+		throw emu_fatalerror("sndreplay: %s logs are played back with the %s system", m_log.shortname().c_str(), m_info->system);
+
+	device_t *chip = siblingdevice("chip");
+	assert(chip != nullptr && !chip->started());
+	chip->set_unscaled_clock(m_log.clock());
+	if (m_info->configure != nullptr)
+		(*m_info->configure)(*chip, m_log);
+
+	// the contents are copied in by the driver init, as ROMs would be loaded
+	for (const sound_log::memory_block &block : m_log.memory())
+		if (block.index >= 0 && block.index < int(ARRAY_LENGTH(m_info->regions)) && m_info->regions[block.index] != nullptr)
+			machine().memory().region_alloc(machine().root_device().subtag(m_info->regions[block.index]).c_str(), block.data.size(), block.width, block.endian);
+}
+
+
+
+//**************************************************************************
+//  OUTPUT SINK
+//**************************************************************************
+
+// ======================> sound_replay_sink_device
+
+// takes the chip's outputs at its native rate, counting and hashing them
+class sound_replay_sink_device : public device_t,
+									public device_sound_interface
+{
+public:
+	sound_replay_sink_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock);
+
+protected:
+	// device-level overrides
+	virtual void device_start() override;
+	virtual void device_stop() override;
+
+	// sound stream update overrides
+	virtual void sound_stream_update(sound_stream &stream, stream_sample_t **inputs, stream_sample_t **outputs, int samples) override;
+
+private:
+	sha1_creator            m_hash;
+	std::vector<UINT8>      m_bytes;        // one update's samples, serialized for hashing
+	int                     m_rate;
+	UINT64                  m_samples;
+	osd_ticks_t             m_start_ticks;  // host time of the first update
+};
+
+static const device_type SOUND_REPLAY_SINK = &device_creator<sound_replay_sink_device>;
+
+sound_replay_sink_device::sound_replay_sink_device(const machine_config &mconfig, const char *tag, device_t *owner, UINT32 clock)
+	: device_t(mconfig, SOUND_REPLAY_SINK, "Sound Register Log Replay Sink", tag, owner, clock, "sound_replay_sink", __FILE__),
+		device_sound_interface(mconfig, *this),
+		m_rate(0),
+		m_samples(0),
+		m_start_ticks(0)
+{
+}
+
+
+//-------------------------------------------------
+//  device_start - take the chip's outputs at
+//  their own sample rate
+//-------------------------------------------------
+
+void sound_replay_sink_device::device_start()
+{
+	device_t *chip = siblingdevice("chip");
+	device_sound_interface *sound;
+	if (chip == nullptr || !chip->interface(sound) || m_auto_allocated_inputs == 0)
+		return;
+
+	int outputnum;
+	m_rate = sound->output_to_stream_output(0, outputnum)->sample_rate();
+	stream_alloc(m_auto_allocated_inputs, 0, m_rate);
+}
+
+
+//-------------------------------------------------
+//  device_stop - report the results
+//-------------------------------------------------
+
+void sound_replay_sink_device::device_stop()
+{
+	if (m_samples == 0)
+		return;
+
+	double const host = double(osd_ticks() - m_start_ticks) / double(osd_ticks_per_second());
+	double const emulated = double(m_samples) / double(m_rate);
+	osd_printf_info("sndreplay: %u samples x %d outputs (%.3f s emulated) in %.3f s, %.0f samples/s (%.2fx real time)\n",
+		UINT32(m_samples), m_auto_allocated_inputs, emulated, host, (host > 0.0) ? double(m_samples) / host : 0.0, (host > 0.0) ? emulated / host : 0.0);
+	osd_printf_info("sndreplay: output SHA1 %s\n", m_hash.finish().as_string().c_str());
+}
+
+
+//-------------------------------------------------
+//  sound_stream_update - hash the samples, little
+//  endian and interleaved by output
+//-------------------------------------------------
+
+void sound_replay_sink_device::sound_stream_update(sound_stream &stream, stream_sample_t **inputs, stream_sample_t **outputs, int samples)
+{
+	if (m_samples == 0)
+		m_start_ticks = osd_ticks();
+
+	int const channels = m_auto_allocated_inputs;
+	m_bytes.resize(samples * channels * 4);
+	UINT8 *dest = m_bytes.empty() ? nullptr : &m_bytes[0];
+	for (int sampindex = 0; sampindex < samples; sampindex++)
+		for (int ch = 0; ch < channels; ch++)
+		{
+			UINT32 const value = UINT32(inputs[ch][sampindex]);
+			*dest++ = value >> 0;
+			*dest++ = value >> 8;
+			*dest++ = value >> 16;
+			*dest++ = value >> 24;
+		}
+
+	if (!m_bytes.empty())
+		m_hash.append(&m_bytes[0], m_bytes.size());
+	m_samples += samples;
+}
+
+
+
+//**************************************************************************
+//  DRIVER STATE
+//**************************************************************************
+
+class sndreplay_state : public driver_device
+{
+public:
+	sndreplay_state(const machine_config &mconfig, device_type type, const char *tag)
+		: driver_device(mconfig, type, tag),
+			m_replay(*this, "replay"),
+			m_chip(*this, "chip"),
+			m_timer(nullptr),
+			m_next(0),
+			m_finished(false)
+	{
+	}
+
+	DECLARE_DRIVER_INIT(sndreplay);
+
+protected:
+	// driver_device overrides
+	virtual void machine_start() override;
+	virtual void machine_reset() override;
+
+private:
+	TIMER_CALLBACK_MEMBER(perform_writes);
+
+	required_device<sound_replay_device> m_replay;
+	required_device<device_t> m_chip;
+	emu_timer *             m_timer;
+	size_t                  m_next;         // index of the next write to perform
+	bool                    m_finished;     // all writes done, running out the tail
+};
+
+
+//-------------------------------------------------
+//  DRIVER_INIT( sndreplay ) - copy the logged
+//  sample memory into the chip's regions
+//-------------------------------------------------
+
+DRIVER_INIT_MEMBER(sndreplay_state, sndreplay)
+{
+	const replay_chip &info = m_replay->info();
+	for (const sound_log::memory_block &block : m_replay->log().memory())
+	{
+		if (block.data.empty() || block.index < 0 || block.index >= int(ARRAY_LENGTH(info.regions)) || info.regions[block.index] == nullptr)
+			continue;
+		memory_region *region = memregion(info.regions[block.index]);
+		memcpy(region->base(), &block.data[0], block.data.size());
+	}
+}
+
+
+//-------------------------------------------------
+//  machine_start - report what is being played
+//-------------------------------------------------
+
+void sndreplay_state::machine_start()
+{
+	const sound_log &log = m_replay->log();
+	osd_printf_info("sndreplay: %s (%s, %u Hz) from %s, %u writes\n",
+		m_chip->name(), log.tag().c_str(), log.clock(), machine().options().sound_replay(), UINT32(log.writes().size()));
+
+	m_timer = machine().scheduler().timer_alloc(timer_expired_delegate(FUNC(sndreplay_state::perform_writes), this));
+}
+
+
+//-------------------------------------------------
+//  machine_reset - start from the first write
+//  once the chip has been reset too
+//-------------------------------------------------
+
+void sndreplay_state::machine_reset()
+{
+	m_next = 0;
+	m_finished = false;
+	m_timer->adjust(attotime::zero);
+}
+
+
+//-------------------------------------------------
+//  perform_writes - perform all writes that are
+//  due and wait for the next
+//-------------------------------------------------
+
+TIMER_CALLBACK_MEMBER(sndreplay_state::perform_writes)
+{
+	if (m_finished)
+	{
+		machine().schedule_exit();
+		return;
+	}
+
+	const std::vector<sound_log::write_entry> &writes = m_replay->log().writes();
+	attotime const now = machine().time();
+	while (m_next < writes.size() && writes[m_next].time <= now)
+	{
+		const sound_log::write_entry &entry = writes[m_next++];
+		(*m_replay->info().write)(*m_chip, entry.offset, entry.data, entry.mem_mask);
+	}
+
+	if (m_next < writes.size())
+		m_timer->adjust(writes[m_next].time - now);
+	else
+	{
+		m_finished = true;
+		m_timer->adjust(TAIL_TIME);
+	}
+}
+
+
+
+//**************************************************************************
+//  MACHINE DRIVERS
+//**************************************************************************
+
+// the replay device must start before the chip, and the sink after it; chip
+// clocks are placeholders replaced with the logged clock at start-up
+static MACHINE_CONFIG_START( sndreplay, sndreplay_state )
+	MCFG_DEVICE_ADD("replay", SOUND_REPLAY, 0)
+MACHINE_CONFIG_END
+
+
+static MACHINE_CONFIG_DERIVED( srl2151, sndreplay )
+	MCFG_YM2151_ADD("chip", XTAL_3_579545MHz)
+	MCFG_SOUND_ROUTE(ALL_OUTPUTS, "sink", 1.0)
+	MCFG_DEVICE_ADD("sink", SOUND_REPLAY_SINK, 0)
+MACHINE_CONFIG_END
+
+
+static MACHINE_CONFIG_DERIVED( srl2203, sndreplay )
+	MCFG_SOUND_ADD("chip", YM2203, XTAL_3_579545MHz)
+	MCFG_SOUND_ROUTE(ALL_OUTPUTS, "sink", 1.0)
+	MCFG_DEVICE_ADD("sink", SOUND_REPLAY_SINK, 0)
+MACHINE_CONFIG_END
+
+
+// the YM2608 plays its rhythm sounds from its own internal ROM
+static MACHINE_CONFIG_DERIVED( srl2608, sndreplay )
+	MCFG_SOUND_ADD("chip", YM2608, XTAL_8MHz)
+	MCFG_SOUND_ROUTE(ALL_OUTPUTS, "sink", 1.0)
+	MCFG_DEVICE_ADD("sink", SOUND_REPLAY_SINK, 0)
+MACHINE_CONFIG_END
+
+
+static MACHINE_CONFIG_DERIVED( srl2610, sndreplay )
+	MCFG_SOUND_ADD("chip", YM2610, XTAL_8MHz)
+	MCFG_SOUND_ROUTE(ALL_OUTPUTS, "sink", 1.0)
+	MCFG_DEVICE_ADD("sink", SOUND_REPLAY_SINK, 0)
+MACHINE_CONFIG_END
+
+
+static MACHINE_CONFIG_DERIVED( srl2610b, sndreplay )
+	MCFG_SOUND_ADD("chip", YM2610B, XTAL_8MHz)
+	MCFG_SOUND_ROUTE(ALL_OUTPUTS, "sink", 1.0)
+	MCFG_DEVICE_ADD("sink", SOUND_REPLAY_SINK, 0)
+MACHINE_CONFIG_END
+
+
+static MACHINE_CONFIG_DERIVED( srl262, sndreplay )
+	MCFG_SOUND_ADD("chip", YMF262, XTAL_14_31818MHz)
+	MCFG_SOUND_ROUTE(ALL_OUTPUTS, "sink", 1.0)
+	MCFG_DEVICE_ADD("sink", SOUND_REPLAY_SINK, 0)
+MACHINE_CONFIG_END
+
+
+static MACHINE_CONFIG_DERIVED( srl3526, sndreplay )
+	MCFG_SOUND_ADD("chip", YM3526, XTAL_3_579545MHz)
+	MCFG_SOUND_ROUTE(ALL_OUTPUTS, "sink", 1.0)
+	MCFG_DEVICE_ADD("sink", SOUND_REPLAY_SINK, 0)
+MACHINE_CONFIG_END
+
+
+static MACHINE_CONFIG_DERIVED( srl3812, sndreplay )
+	MCFG_SOUND_ADD("chip", YM3812, XTAL_3_579545MHz)
+	MCFG_SOUND_ROUTE(ALL_OUTPUTS, "sink", 1.0)
+	MCFG_DEVICE_ADD("sink", SOUND_REPLAY_SINK, 0)
+MACHINE_CONFIG_END
+
+
+static MACHINE_CONFIG_DERIVED( srl8950, sndreplay )
+	MCFG_SOUND_ADD("chip", Y8950, XTAL_3_579545MHz)
+	MCFG_SOUND_ROUTE(ALL_OUTPUTS, "sink", 1.0)
+	MCFG_DEVICE_ADD("sink", SOUND_REPLAY_SINK, 0)
+MACHINE_CONFIG_END
+
+
+static MACHINE_CONFIG_DERIVED( srl271, sndreplay )
+	MCFG_SOUND_ADD("chip", YMF271, XTAL_16_9344MHz)
+	MCFG_SOUND_ROUTE(ALL_OUTPUTS, "sink", 1.0)
+	MCFG_DEVICE_ADD("sink", SOUND_REPLAY_SINK, 0)
+MACHINE_CONFIG_END
+
+
+static MACHINE_CONFIG_DERIVED( srl5505, sndreplay )
+	MCFG_SOUND_ADD("chip", ES5505, XTAL_30_4761MHz / 2)
+	MCFG_ES5505_REGION0("rom0")
+	MCFG_ES5505_REGION1("rom1")
+	MCFG_SOUND_ROUTE(ALL_OUTPUTS, "sink", 1.0)
+	MCFG_DEVICE_ADD("sink", SOUND_REPLAY_SINK, 0)
+MACHINE_CONFIG_END
+
+
+static MACHINE_CONFIG_DERIVED( srl5506, sndreplay )
+	MCFG_SOUND_ADD("chip", ES5506, XTAL_16MHz)
+	MCFG_ES5506_REGION0("rom0")
+	MCFG_ES5506_REGION1("rom1")
+	MCFG_ES5506_REGION2("rom2")
+	MCFG_ES5506_REGION3("rom3")
+	MCFG_SOUND_ROUTE(ALL_OUTPUTS, "sink", 1.0)
+	MCFG_DEVICE_ADD("sink", SOUND_REPLAY_SINK, 0)
+MACHINE_CONFIG_END
+
+
+
+//**************************************************************************
+//  ROM DEFINITIONS
+//**************************************************************************
+
+ROM_START( srl2151 )
+ROM_END
+
+ROM_START( srl2203 )
+ROM_END
+
+ROM_START( srl2608 )
+ROM_END
+
+ROM_START( srl2610 )
+ROM_END
+
+ROM_START( srl2610b )
+ROM_END
+
+ROM_START( srl262 )
+ROM_END
+
+ROM_START( srl3526 )
+ROM_END
+
+ROM_START( srl3812 )
+ROM_END
+
+ROM_START( srl8950 )
+ROM_END
+
+ROM_START( srl271 )
+ROM_END
+
+ROM_START( srl5505 )
+ROM_END
+
+ROM_START( srl5506 )
+ROM_END
+
+
+
+//**************************************************************************
+//  SYSTEM DRIVERS
+//**************************************************************************
+
+//    YEAR  NAME     PARENT COMPAT MACHINE  INPUT  INIT                        COMPANY FULLNAME                      FLAGS
+SYST( 2016, srl2151, 0,     0,     srl2151, 0,     sndreplay_state, sndreplay, "MAME", "YM2151 register log replay", 0 )
+SYST( 2016, srl2203, 0,     0,     srl2203, 0,     sndreplay_state, sndreplay, "MAME", "YM2203 register log replay", 0 )
+SYST( 2016, srl2608, 0,     0,     srl2608, 0,     sndreplay_state, sndreplay, "MAME", "YM2608 register log replay", 0 )
+SYST( 2016, srl2610, 0,     0,     srl2610, 0,     sndreplay_state, sndreplay, "MAME", "YM2610 register log replay", 0 )
+SYST( 2016, srl2610b, 0,    0,     srl2610b, 0,    sndreplay_state, sndreplay, "MAME", "YM2610B register log replay", 0 )
+SYST( 2016, srl262,  0,     0,     srl262,  0,     sndreplay_state, sndreplay, "MAME", "YMF262 register log replay", 0 )
+SYST( 2016, srl3526, 0,     0,     srl3526, 0,     sndreplay_state, sndreplay, "MAME", "YM3526 register log replay", 0 )
+SYST( 2016, srl3812, 0,     0,     srl3812, 0,     sndreplay_state, sndreplay, "MAME", "YM3812 register log replay", 0 )
+SYST( 2016, srl8950, 0,     0,     srl8950, 0,     sndreplay_state, sndreplay, "MAME", "Y8950 register log replay", 0 )
+SYST( 2016, srl271,  0,     0,     srl271,  0,     sndreplay_state, sndreplay, "MAME", "YMF271 register log replay", 0 )
+SYST( 2016, srl5505, 0,     0,     srl5505, 0,     sndreplay_state, sndreplay, "MAME", "ES5505 register log replay", 0 )
+SYST( 2016, srl5506, 0,     0,     srl5506, 0,     sndreplay_state, sndreplay, "MAME", "ES5506 register log replay", 0 )
@@ -555,6 +555,60 @@ void n64_rdp::set_mul_input_alpha(color_t** input, INT32 code, rdp_span_aux* use
 	}
 }
 
+bool n64_rdp::combiner_reads(const rdp_span_aux* userdata, INT32 cycle, const color_t* input) const
+{
+	const color_inputs_t& in = userdata->m_color_inputs;
+	return in.combiner_rgbsub_a[cycle] == input || in.combiner_rgbsub_b[cycle] == input ||
+			in.combiner_rgbmul[cycle] == input || in.combiner_rgbadd[cycle] == input ||
+			in.combiner_alphasub_a[cycle] == input || in.combiner_alphasub_b[cycle] == input ||
+			in.combiner_alphamul[cycle] == input || in.combiner_alphaadd[cycle] == input;
+}
+
+bool n64_rdp::combiner_constant(const rdp_span_aux* userdata, INT32 cycle) const
+{
+	// true if every input is fixed for the whole primitive, so one result serves the span
+	const color_t* const inputs[8] =
+	{
+		userdata->m_color_inputs.combiner_rgbsub_a[cycle], userdata->m_color_inputs.combiner_rgbsub_b[cycle],
+		userdata->m_color_inputs.combiner_rgbmul[cycle], userdata->m_color_inputs.combiner_rgbadd[cycle],
+		userdata->m_color_inputs.combiner_alphasub_a[cycle], userdata->m_color_inputs.combiner_alphasub_b[cycle],
+		userdata->m_color_inputs.combiner_alphamul[cycle], userdata->m_color_inputs.combiner_alphaadd[cycle]
+	};
+	for (const color_t* input : inputs)
+		if (input != &userdata->m_prim_color && input != &userdata->m_prim_alpha &&
+			input != &userdata->m_env_color && input != &userdata->m_env_alpha &&
+			input != &userdata->m_key_scale && input != &userdata->m_prim_lod_fraction &&
+			input != &userdata->m_k4 && input != &userdata->m_k5 &&
+			input != &m_one && input != &m_zero)
+			return false;
+	return true;
+}
+
+void n64_rdp::color_combine(rgbaint_t& out, const rdp_span_aux* userdata, INT32 cycle) const
+{
+	rgbaint_t rgbsub_b(*userdata->m_color_inputs.combiner_rgbsub_b[cycle]);
+	rgbaint_t rgbmul(*userdata->m_color_inputs.combiner_rgbmul[cycle]);
+	rgbaint_t rgbadd(*userdata->m_color_inputs.combiner_rgbadd[cycle]);
+	out.set(*userdata->m_color_inputs.combiner_rgbsub_a[cycle]);
+
+	out.merge_alpha(*userdata->m_color_inputs.combiner_alphasub_a[cycle]);
+	rgbsub_b.merge_alpha(*userdata->m_color_inputs.combiner_alphasub_b[cycle]);
+	rgbmul.merge_alpha(*userdata->m_color_inputs.combiner_alphamul[cycle]);
+	rgbadd.merge_alpha(*userdata->m_color_inputs.combiner_alphaadd[cycle]);
+
+	out.sign_extend(0x180, 0xfffffe00);
+	rgbsub_b.sign_extend(0x180, 0xfffffe00);
+	rgbadd.sign_extend(0x180, 0xfffffe00);
+
+	rgbadd.shl_imm(8);
+	out.sub(rgbsub_b);
+	out.mul(rgbmul);
+	out.add(rgbadd);
+	out.add_imm(0x0080);
+	out.sra_imm(8);
+	out.clamp_and_clear(0xfffffe00);
+}
+
 void n64_rdp::set_blender_input(INT32 cycle, INT32 which, color_t** input_rgb, color_t** input_a, INT32 a, INT32 b, rdp_span_aux* userdata)
 {
 	switch (a & 0x3)
@@ -3593,6 +3647,13 @@ void n64_rdp::span_draw_1cycle(INT32 scanline, const extent_t &extent, const rdp
 		tc_div_no_perspective(s.w >> 16, t.w >> 16, w.w >> 16, &sss, &sst);
 	}
 
+	// resolve once per span which per-pixel stages the combiner actually consumes
+	const bool uses_texel = combiner_reads(userdata, 1, &userdata->m_texel0_color) || combiner_reads(userdata, 1, &userdata->m_texel0_alpha) || combiner_reads(userdata, 1, &userdata->m_lod_fraction);
+	const bool uses_noise = combiner_reads(userdata, 1, &userdata->m_noise_color);
+	const bool constant_combine = combiner_constant(userdata, 1);
+	bool combine_cached = false;
+	rgbaint_t combined;
+
 	userdata->m_start_span = true;
 	for (INT32 j = 0; j <= length; j++)
 	{
@@ -3608,41 +3669,32 @@ void n64_rdp::span_draw_1cycle(INT32 scanline, const extent_t &extent, const rdp
 			UINT8 offx, offy;
 			lookup_cvmask_derivatives(userdata->m_cvg[x], &offx, &offy, userdata);
 
-			m_tex_pipe.lod_1cycle(&sss, &sst, s.w, t.w, w.w, dsinc, dtinc, dwinc, userdata, object);
+			if (uses_texel)
+				m_tex_pipe.lod_1cycle(&sss, &sst, s.w, t.w, w.w, dsinc, dtinc, dwinc, userdata, object);
 
 			rgbaz_correct_triangle(offx, offy, &sr, &sg, &sb, &sa, &sz, userdata, object);
 			rgbaz_clip(sr, sg, sb, sa, &sz, userdata);
 
-			((m_tex_pipe).*(m_tex_pipe.m_cycle[cycle0]))(&userdata->m_texel0_color, &userdata->m_texel0_color, sss, sst, tilenum, 0, userdata, object);
-			UINT32 t0a = userdata->m_texel0_color.get_a();
-			userdata->m_texel0_alpha.set(t0a, t0a, t0a, t0a);
-
-			const UINT8 noise = rand() << 3; // Not accurate
-			userdata->m_noise_color.set(0, noise, noise, noise);
-
-			rgbaint_t rgbsub_a(*userdata->m_color_inputs.combiner_rgbsub_a[1]);
-			rgbaint_t rgbsub_b(*userdata->m_color_inputs.combiner_rgbsub_b[1]);
-			rgbaint_t rgbmul(*userdata->m_color_inputs.combiner_rgbmul[1]);
-			rgbaint_t rgbadd(*userdata->m_color_inputs.combiner_rgbadd[1]);
-
-			rgbsub_a.merge_alpha(*userdata->m_color_inputs.combiner_alphasub_a[1]);
-			rgbsub_b.merge_alpha(*userdata->m_color_inputs.combiner_alphasub_b[1]);
-			rgbmul.merge_alpha(*userdata->m_color_inputs.combiner_alphamul[1]);
-			rgbadd.merge_alpha(*userdata->m_color_inputs.combiner_alphaadd[1]);
+			if (uses_texel)
+			{
+				((m_tex_pipe).*(m_tex_pipe.m_cycle[cycle0]))(&userdata->m_texel0_color, &userdata->m_texel0_color, sss, sst, tilenum, 0, userdata, object);
+				UINT32 t0a = userdata->m_texel0_color.get_a();
+				userdata->m_texel0_alpha.set(t0a, t0a, t0a, t0a);
+			}
 
-			rgbsub_a.sign_extend(0x180, 0xfffffe00);
-			rgbsub_b.sign_extend(0x180, 0xfffffe00);
-			rgbadd.sign_extend(0x180, 0xfffffe00);
+			if (uses_noise)
+			{
+				const UINT8 noise = rand() << 3; // Not accurate
+				userdata->m_noise_color.set(0, noise, noise, noise);
+			}
 
-			rgbadd.shl_imm(8);
-			rgbsub_a.sub(rgbsub_b);
-			rgbsub_a.mul(rgbmul);
-			rgbsub_a.add(rgbadd);
-			rgbsub_a.add_imm(0x0080);
-			rgbsub_a.sra_imm(8);
-			rgbsub_a.clamp_and_clear(0xfffffe00);
+			if (!combine_cached)
+			{
+				color_combine(combined, userdata, 1);
+				combine_cached = constant_combine;
+			}
 
-			userdata->m_pixel_color = rgbsub_a;
+			userdata->m_pixel_color = combined;
 
 			//Alpha coverage combiner
 			userdata->m_pixel_color.set_a(get_alpha_cvg(userdata->m_pixel_color.get_a(), userdata, object));
@@ -3804,6 +3856,13 @@ void n64_rdp::span_draw_2cycle(INT32 scanline, const extent_t &extent, const rdp
 		tc_div_no_perspective(s.w >> 16, t.w >> 16, w.w >> 16, &sss, &sst);
 	}
 
+	// resolve once per span which per-pixel stages the combiner actually consumes
+	const bool uses_noise = combiner_reads(userdata, 0, &userdata->m_noise_color) || combiner_reads(userdata, 1, &userdata->m_noise_color);
+	const bool constant_combine0 = combiner_constant(userdata, 0);
+	bool combine0_cached = false;
+	rgbaint_t combined0;
+	rgbaint_t combined;
+
 	userdata->m_start_span = true;
 	for (INT32 j = 0; j <= length; j++)
 	{
@@ -3844,33 +3903,19 @@ void n64_rdp::span_draw_2cycle(INT32 scanline, const extent_t &extent, const rdp
 			userdata->m_texel1_alpha.set(t1a, t1a, t1a, t1a);
 			userdata->m_next_texel_alpha.set(tna, tna, tna, tna);
 
-			const UINT8 noise = rand() << 3; // Not accurate
-			userdata->m_noise_color.set(0, noise, noise, noise);
-
-			rgbaint_t rgbsub_a(*userdata->m_color_inputs.combiner_rgbsub_a[0]);
-			rgbaint_t rgbsub_b(*userdata->m_color_inputs.combiner_rgbsub_b[0]);
-			rgbaint_t rgbmul(*userdata->m_color_inputs.combiner_rgbmul[0]);
-			rgbaint_t rgbadd(*userdata->m_color_inputs.combiner_rgbadd[0]);
-
-			rgbsub_a.merge_alpha(*userdata->m_color_inputs.combiner_alphasub_a[0]);
-			rgbsub_b.merge_alpha(*userdata->m_color_inputs.combiner_alphasub_b[0]);
-			rgbmul.merge_alpha(*userdata->m_color_inputs.combiner_alphamul[0]);
-			rgbadd.merge_alpha(*userdata->m_color_inputs.combiner_alphaadd[0]);
-
-			rgbsub_a.sign_extend(0x180, 0xfffffe00);
-			rgbsub_b.sign_extend(0x180, 0xfffffe00);
-			rgbadd.sign_extend(0x180, 0xfffffe00);
-
-			rgbadd.shl_imm(8);
-			rgbsub_a.sub(rgbsub_b);
-			rgbsub_a.mul(rgbmul);
+			if (uses_noise)
+			{
+				const UINT8 noise = rand() << 3; // Not accurate
+				userdata->m_noise_color.set(0, noise, noise, noise);
+			}
 
-			rgbsub_a.add(rgbadd);
-			rgbsub_a.add_imm(0x0080);
-			rgbsub_a.sra_imm(8);
-			rgbsub_a.clamp_and_clear(0xfffffe00);
+			if (!combine0_cached)
+			{
+				color_combine(combined0, userdata, 0);
+				combine0_cached = constant_combine0;
+			}
 
-			userdata->m_combined_color.set(rgbsub_a);
+			userdata->m_combined_color.set(combined0);
 			userdata->m_texel0_color.set(userdata->m_texel1_color);
 			userdata->m_texel1_color.set(userdata->m_next_texel_color);
 
@@ -3879,29 +3924,9 @@ void n64_rdp::span_draw_2cycle(INT32 scanline, const extent_t &extent, const rdp
 			userdata->m_texel0_alpha.set(userdata->m_texel1_alpha);
 			userdata->m_texel1_alpha.set(userdata->m_next_texel_alpha);
 
-			rgbsub_a.set(*userdata->m_color_inputs.combiner_rgbsub_a[1]);
-			rgbsub_b.set(*userdata->m_color_inputs.combiner_rgbsub_b[1]);
-			rgbmul.set(*userdata->m_color_inputs.combiner_rgbmul[1]);
-			rgbadd.set(*userdata->m_color_inputs.combiner_rgbadd[1]);
-
-			rgbsub_a.merge_alpha(*userdata->m_color_inputs.combiner_alphasub_a[1]);
-			rgbsub_b.merge_alpha(*userdata->m_color_inputs.combiner_alphasub_b[1]);
-			rgbmul.merge_alpha(*userdata->m_color_inputs.combiner_alphamul[1]);
-			rgbadd.merge_alpha(*userdata->m_color_inputs.combiner_alphaadd[1]);
-
-			rgbsub_a.sign_extend(0x180, 0xfffffe00);
-			rgbsub_b.sign_extend(0x180, 0xfffffe00);
-			rgbadd.sign_extend(0x180, 0xfffffe00);
-
-			rgbadd.shl_imm(8);
-			rgbsub_a.sub(rgbsub_b);
-			rgbsub_a.mul(rgbmul);
-			rgbsub_a.add(rgbadd);
-			rgbsub_a.add_imm(0x0080);
-			rgbsub_a.sra_imm(8);
-			rgbsub_a.clamp_and_clear(0xfffffe00);
-
-			userdata->m_pixel_color.set(rgbsub_a);
+			color_combine(combined, userdata, 1);
+
+			userdata->m_pixel_color.set(combined);
 
 			//Alpha coverage combiner
 			userdata->m_pixel_color.set_a(get_alpha_cvg(userdata->m_pixel_color.get_a(), userdata, object));
@@ -190,6 +190,9 @@ public:
 	void        set_add_input_rgb(color_t** input, INT32 code, rdp_span_aux* userdata);
 	void        set_sub_input_alpha(color_t** input, INT32 code, rdp_span_aux* userdata);
 	void        set_mul_input_alpha(color_t** input, INT32 code, rdp_span_aux* userdata);
+	bool        combiner_reads(const rdp_span_aux* userdata, INT32 cycle, const color_t* input) const;
+	bool        combiner_constant(const rdp_span_aux* userdata, INT32 cycle) const;
+	void        color_combine(rgbaint_t& out, const rdp_span_aux* userdata, INT32 cycle) const;
 
 	// Texture memory
 	UINT8*      get_tmem8() { return m_tmem.get(); }
@@ -48,6 +48,10 @@
 #include <stdlib.h>
 #include <unistd.h>
 
+#ifndef WIN32
+#include <sys/mman.h>
+#endif
+
 
 
 namespace {
@@ -147,6 +151,16 @@ public:
 		return error::NONE;
 	}
 
+#ifndef WIN32
+	virtual error map(void *dest, std::uint64_t offset, std::uint64_t length) override
+	{
+		// a private fixed mapping replaces whatever was there, and pages are copied on first write
+		if (::mmap(dest, size_t(length), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, m_fd, off_t(std::make_unsigned_t<off_t>(offset))) == MAP_FAILED)
+			return errno_to_file_error(errno);
+		return error::NONE;
+	}
+#endif
+
 private:
 	int m_fd;
 };
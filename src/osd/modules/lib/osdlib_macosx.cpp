@@ -128,6 +128,44 @@ void osd_free_executable(void *ptr, size_t size)
 #endif
 }
 
+//============================================================
+//  osd_alloc_mappable
+//
+//  allocates "size" bytes of anonymous memory that files
+//  can later be mapped over
+//============================================================
+
+void *osd_alloc_mappable(size_t size)
+{
+	void *const result = mmap(nullptr, size, PROT_READ|PROT_WRITE, MAP_ANON|MAP_PRIVATE, -1, 0);
+	return (result != MAP_FAILED) ? result : nullptr;
+}
+
+//============================================================
+//  osd_free_mappable
+//
+//  frees memory allocated with osd_alloc_mappable; this
+//  also drops any file mappings within it
+//============================================================
+
+void osd_free_mappable(void *ptr, size_t size)
+{
+#ifdef SDLMAME_SOLARIS
+	munmap((char *)ptr, size);
+#else
+	munmap(ptr, size);
+#endif
+}
+
+//============================================================
+//  osd_map_granularity
+//============================================================
+
+size_t osd_map_granularity()
+{
+	return size_t(sysconf(_SC_PAGESIZE));
+}
+
 //============================================================
 //  osd_break_into_debugger
 //============================================================
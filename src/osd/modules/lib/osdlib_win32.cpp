@@ -221,6 +221,44 @@ void osd_free_executable(void *ptr, size_t size)
 }
 
 
+//============================================================
+//  osd_alloc_mappable
+//
+//  allocates "size" bytes of memory that files can later
+//  be mapped over
+//============================================================
+
+void *osd_alloc_mappable(size_t size)
+{
+	return VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+}
+
+
+//============================================================
+//  osd_free_mappable
+//
+//  frees memory allocated with osd_alloc_mappable
+//============================================================
+
+void osd_free_mappable(void *ptr, size_t size)
+{
+	VirtualFree(ptr, 0, MEM_RELEASE);
+}
+
+
+//============================================================
+//  osd_map_granularity
+//
+//  a file view can't replace part of an existing
+//  allocation, so nothing is ever mapped here
+//============================================================
+
+size_t osd_map_granularity()
+{
+	return 0;
+}
+
+
 //============================================================
 //  osd_break_into_debugger
 //============================================================
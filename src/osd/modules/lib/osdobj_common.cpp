@@ -124,7 +124,12 @@ const options_entry osd_options::s_option_entries[] =
 
 	{ nullptr,                                nullptr,          OPTION_HEADER,    "OSD SOUND OPTIONS" },
 	{ OSDOPTION_SOUND,                        OSDOPTVAL_AUTO,   OPTION_STRING,    "sound output method: " },
-	{ OSDOPTION_AUDIO_LATENCY "(1-5)",        "2",              OPTION_INTEGER,   "set audio latency (increase to reduce glitches, decrease for responsiveness)" },
+	{ OSDOPTION_AUDIO_LATENCY "(0-5)",        "2",              OPTION_INTEGER,   "set audio latency (increase to reduce glitches, decrease for responsiveness)" },
+
+	{ nullptr,                                nullptr,          OPTION_HEADER,    "FILE SOUND OPTIONS" },
+	{ OSDOPTION_AUDIO_FILE,                   "",               OPTION_STRING,    "output file for -sound file (.wav or .flac); empty paces without writing" },
+	{ OSDOPTION_AUDIO_FILE_PERIOD,            "512",            OPTION_INTEGER,   "samples the simulated device pulls per period" },
+	{ OSDOPTION_AUDIO_FILE_CLOCK,             "1.0",            OPTION_FLOAT,     "simulated device clock relative to the sample rate (e.g. 1.001 runs 0.1% fast)" },
 
 #ifdef SDLMAME_MACOSX
 	{ nullptr,                                nullptr,          OPTION_HEADER,    "CoreAudio-SPECIFIC OPTIONS" },
@@ -211,6 +216,7 @@ void osd_common_t::register_options()
 	REGISTER_MODULE(m_mod_man, SOUND_COREAUDIO);
 	REGISTER_MODULE(m_mod_man, SOUND_JS);
 	REGISTER_MODULE(m_mod_man, SOUND_SDL);
+	REGISTER_MODULE(m_mod_man, SOUND_FILE);
 	REGISTER_MODULE(m_mod_man, SOUND_NONE);
 
 #ifdef SDLMAME_MACOSX
@@ -71,6 +71,9 @@
 
 #define OSDOPTION_SOUND                 "sound"
 #define OSDOPTION_AUDIO_LATENCY         "audio_latency"
+#define OSDOPTION_AUDIO_FILE            "audio_file"
+#define OSDOPTION_AUDIO_FILE_PERIOD     "audio_file_period"
+#define OSDOPTION_AUDIO_FILE_CLOCK      "audio_file_clock"
 
 #define OSDOPTION_AUDIO_OUTPUT          "audio_output"
 #define OSDOPTION_AUDIO_EFFECT          "audio_effect"
@@ -147,6 +150,11 @@ public:
 	const char *sound() const { return value(OSDOPTION_SOUND); }
 	int audio_latency() const { return int_value(OSDOPTION_AUDIO_LATENCY); }
 
+	// file sound options
+	const char *audio_file() const { return value(OSDOPTION_AUDIO_FILE); }
+	int audio_file_period() const { return int_value(OSDOPTION_AUDIO_FILE_PERIOD); }
+	float audio_file_clock() const { return float_value(OSDOPTION_AUDIO_FILE_CLOCK); }
+
 	// CoreAudio specific options
 	const char *audio_output() const { return value(OSDOPTION_AUDIO_OUTPUT); }
 	const char *audio_effect(int index) const { return value(string_format("%s%d", OSDOPTION_AUDIO_EFFECT, index).c_str()); }
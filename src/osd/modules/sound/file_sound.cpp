@@ -0,0 +1,360 @@
+// license:BSD-3-Clause
+// copyright-holders:agent
+/***************************************************************************
+
+    file_sound.cpp
+
+    Headless sound interface: a background thread stands in for an
+    audio device, pulling fixed periods from a sound_ring on a simulated
+    clock and writing them to a WAV or FLAC file.
+
+    Throttled runs are paced by the simulated device exactly as a real
+    one would pace them, so audio timing, underruns and per-frame cost
+    can be measured on machines with no sound hardware. The file holds
+    exactly the samples the emulation produced, independent of host
+    timing, so it can be compared between runs.
+
+***************************************************************************/
+
+#include "sound_module.h"
+#include "modules/osdmodule.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// MAME headers
+#include "emu.h"
+#include "flac.h"
+#include "wavwrite.h"
+#include "modules/lib/osdobj_common.h"
+
+//============================================================
+//  CLASS
+//============================================================
+
+class sound_file : public osd_module, public sound_module
+{
+public:
+	sound_file()
+	: osd_module(OSD_SOUND_PROVIDER, "file"), sound_module(),
+		m_attenuation(0),
+		m_period(0),
+		m_clock(1.0),
+		m_target(0),
+		m_wav(nullptr),
+		m_throttled(true),
+		m_started(false),
+		m_exiting(false),
+		m_updates(0),
+		m_update_ticks(0),
+		m_wait_ticks(0),
+		m_device_underruns(0)
+	{
+	}
+	virtual ~sound_file() { }
+
+	virtual int init(const osd_options &options) override;
+	virtual void exit() override;
+
+	// sound_module
+
+	virtual void update_audio_stream(bool is_throttled, const INT16 *buffer, int samples_this_frame) override;
+	virtual void set_mastervolume(int attenuation) override;
+	virtual bool get_stats(sound_stats &stats) const override;
+
+private:
+	void device_thread();
+	void write_frames(const INT16 *data, UINT32 frames);
+	void wake() { { std::lock_guard<std::mutex> lock(m_lock); } m_wakeup.notify_all(); }
+
+	// configuration
+	int                         m_attenuation;
+	UINT32                      m_period;       // frames the simulated device pulls per tick
+	double                      m_clock;        // device clock relative to the nominal sample rate
+	UINT32                      m_target;       // fill level that throttled updates wait for
+
+	// output
+	std::unique_ptr<sound_ring> m_ring;
+	std::vector<INT16>          m_scratch;      // attenuated samples on their way into the ring
+	util::core_file::ptr        m_flac_file;
+	std::unique_ptr<flac_encoder> m_flac;
+	wav_file *                  m_wav;
+
+	// device thread
+	std::thread                 m_thread;
+	std::mutex                  m_lock;
+	std::condition_variable     m_wakeup;
+	std::atomic<bool>           m_throttled;
+	std::atomic<bool>           m_started;      // set once the ring first reaches its target
+	std::atomic<bool>           m_exiting;
+
+	// statistics
+	UINT32                      m_updates;          // calls to update_audio_stream
+	osd_ticks_t                 m_update_ticks;     // total time spent in update_audio_stream
+	osd_ticks_t                 m_wait_ticks;       // portion of that spent waiting on the device
+	std::atomic<UINT32>         m_device_underruns; // device ticks that found less than a period queued
+};
+
+
+//============================================================
+//  sound_file::init
+//============================================================
+
+int sound_file::init(const osd_options &options)
+{
+	// skip if sound disabled
+	if (sample_rate() == 0)
+		return 0;
+
+	m_period = MAX(options.audio_file_period(), 16);
+	m_clock = (options.audio_file_clock() > 0.0f) ? options.audio_file_clock() : 1.0;
+
+	// same target as the SDL module: one device period plus (1 + latency)/60s
+	int const audio_latency = MAX(MIN(m_audio_latency, 5), 0);
+	m_target = m_period + (sample_rate() * (1 + audio_latency)) / 60;
+	m_ring = std::make_unique<sound_ring>(m_target * 2);
+
+	// open the output; an empty name still paces and measures but writes nothing
+	const char *filename = options.audio_file();
+	if (filename[0] != 0)
+	{
+		std::string name(filename);
+		bool const flac = (name.length() >= 5) && (core_stricmp(name.substr(name.length() - 5).c_str(), ".flac") == 0);
+		if (flac)
+		{
+			osd_file::error const filerr = util::core_file::open(filename, OPEN_FLAG_WRITE | OPEN_FLAG_CREATE | OPEN_FLAG_CREATE_PATHS, m_flac_file);
+			if (filerr == osd_file::error::NONE)
+			{
+				m_flac = std::make_unique<flac_encoder>();
+				m_flac->set_sample_rate(sample_rate());
+				m_flac->set_num_channels(2);
+				if (!m_flac->reset(*m_flac_file))
+				{
+					m_flac = nullptr;
+					m_flac_file.reset();
+				}
+			}
+		}
+		else
+			m_wav = wav_open(filename, sample_rate(), 2);
+
+		if (!m_flac && !m_wav)
+		{
+			osd_printf_error("Audio: unable to create output file %s\n", filename);
+			return -1;
+		}
+	}
+
+	osd_printf_verbose("Audio: file output %s, period %u samples, clock x%.4f, target %u\n",
+		(filename[0] != 0) ? filename : "(none)", m_period, m_clock, m_target);
+
+	m_exiting = false;
+	m_thread = std::thread([this] { device_thread(); });
+	return 0;
+}
+
+
+//============================================================
+//  sound_file::exit
+//============================================================
+
+void sound_file::exit()
+{
+	if (!m_thread.joinable())
+		return;
+
+	m_exiting = true;
+	wake();
+	m_thread.join();
+
+	// whatever the device didn't get to still belongs in the file
+	UINT32 const remaining = m_ring->fill();
+	if (remaining != 0)
+	{
+		std::vector<INT16> tail(remaining * 2);
+		write_frames(&tail[0], m_ring->read(&tail[0], remaining));
+	}
+
+	if (m_flac)
+	{
+		m_flac->finish();
+		m_flac = nullptr;
+		m_flac_file.reset();
+	}
+	if (m_wav)
+	{
+		wav_close(m_wav);
+		m_wav = nullptr;
+	}
+
+	sound_stats stats;
+	if (get_stats(stats) && m_updates != 0)
+	{
+		double const tps = double(osd_ticks_per_second());
+		osd_printf_verbose("Audio: %u updates, %.3f ms/update (%.3f ms waiting on device), underruns=%u overflows=%u\n",
+			m_updates, 1000.0 * m_update_ticks / tps / m_updates, 1000.0 * m_wait_ticks / tps / m_updates,
+			stats.underruns, stats.overruns);
+	}
+}
+
+
+//============================================================
+//  update_audio_stream
+//============================================================
+
+void sound_file::update_audio_stream(bool is_throttled, const INT16 *buffer, int samples_this_frame)
+{
+	if (!m_ring || samples_this_frame <= 0)
+		return;
+
+	osd_ticks_t const start = osd_ticks();
+	m_throttled = is_throttled;
+
+	// apply the master volume the way a device would hear it
+	const INT16 *data = buffer;
+	if (m_attenuation != 0)
+	{
+		int const level = (int) (pow(10.0, (double) m_attenuation / 20.0) * 128.0);
+		m_scratch.resize(samples_this_frame * 2);
+		for (int sampnum = 0; sampnum < samples_this_frame * 2; sampnum++)
+			m_scratch[sampnum] = (buffer[sampnum] * level) >> 7;
+		data = &m_scratch[0];
+	}
+
+	// a throttled run waits for the simulated device to drain back to the target; an
+	// unthrottled one only waits for room, so no samples are ever dropped from the file;
+	// chunks of at most half the ring keep very long frames from waiting forever
+	osd_ticks_t waited = 0;
+	while (samples_this_frame > 0)
+	{
+		UINT32 const chunk = MIN(UINT32(samples_this_frame), m_ring->capacity() / 2);
+		{
+			std::unique_lock<std::mutex> lock(m_lock);
+			auto ready = [this, is_throttled, chunk]
+			{
+				UINT32 const fill = m_ring->fill();
+				if (fill + chunk > m_ring->capacity())
+					return false;
+				return !is_throttled || !m_started || fill <= m_target;
+			};
+			if (!ready())
+			{
+				osd_ticks_t const wait_start = osd_ticks();
+				m_wakeup.wait(lock, ready);
+				waited += osd_ticks() - wait_start;
+			}
+		}
+
+		m_ring->write(data, chunk);
+		if (!m_started && m_ring->fill() >= m_target)
+			m_started = true;
+		wake();
+
+		data += chunk * 2;
+		samples_this_frame -= chunk;
+	}
+
+	m_updates++;
+	m_wait_ticks += waited;
+	m_update_ticks += osd_ticks() - start;
+}
+
+
+//============================================================
+//  set_mastervolume
+//============================================================
+
+void sound_file::set_mastervolume(int attenuation)
+{
+	// clamp the attenuation to 0-32 range
+	m_attenuation = MAX(MIN(attenuation, 0), -32);
+}
+
+
+//============================================================
+//  get_stats
+//============================================================
+
+bool sound_file::get_stats(sound_stats &stats) const
+{
+	if (!m_ring)
+		return false;
+
+	stats.fill = m_ring->fill();
+	stats.target = m_target;
+	stats.capacity = m_ring->capacity();
+	stats.underruns = m_device_underruns.load(std::memory_order_relaxed);
+	stats.overruns = m_ring->overruns();
+	stats.drift = m_clock - 1.0;
+	return true;
+}
+
+
+//============================================================
+//  device_thread - stand in for the audio device,
+//  pulling one period per tick of the simulated
+//  clock while throttled, or as soon as a period
+//  is available while not
+//============================================================
+
+void sound_file::device_thread()
+{
+	typedef std::chrono::steady_clock clock;
+	auto const period = std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(m_period / (sample_rate() * m_clock)));
+	auto next = clock::now();
+	std::vector<INT16> buffer(m_period * 2);
+
+	while (!m_exiting)
+	{
+		bool const throttled = m_throttled;
+		{
+			std::unique_lock<std::mutex> lock(m_lock);
+			if (throttled && m_started)
+			{
+				// resynchronize rather than bursting to catch up after an unthrottled stretch
+				next += period;
+				if (next < clock::now() - period)
+					next = clock::now();
+				m_wakeup.wait_until(lock, next, [this] { return bool(m_exiting); });
+			}
+			else
+				m_wakeup.wait(lock, [this] { return m_exiting || (m_started && (m_throttled || m_ring->fill() >= m_period)); });
+		}
+		if (m_exiting)
+			break;
+
+		// a short read while paced is exactly what a device would hear as an underrun
+		UINT32 const available = m_ring->fill();
+		if (available < m_period && !(throttled && m_started))
+			continue;
+		if (available < m_period)
+			m_device_underruns.fetch_add(1, std::memory_order_relaxed);
+
+		// only real samples go to the file; the silence padding is the device's business
+		UINT32 const count = m_ring->read(&buffer[0], m_period);
+		wake();
+		write_frames(&buffer[0], count);
+	}
+}
+
+
+//============================================================
+//  write_frames - append stereo frames to the
+//  output file
+//============================================================
+
+void sound_file::write_frames(const INT16 *data, UINT32 frames)
+{
+	if (frames == 0)
+		return;
+
+	if (m_flac)
+		m_flac->encode_interleaved(data, frames);
+	else if (m_wav)
+		wav_add_data_16(m_wav, const_cast<INT16 *>(data), frames * 2);
+}
+
+
+MODULE_DEFINITION(SOUND_FILE, sound_file)
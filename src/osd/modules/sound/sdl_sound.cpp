@@ -50,8 +50,7 @@ public:
 	sound_sdl()
 	: osd_module(OSD_SOUND_PROVIDER, "sdl"), sound_module(),
 		stream_in_initialized(0),
-		stream_loop(0),
-		attenuation(0), buf_locked(0), stream_buffer(nullptr), stream_playpos(0), stream_buffer_size(0), stream_buffer_in(0), buffer_underflows(0), buffer_overflows(0)
+		attenuation(0)
 {
 		sdl_xfer_samples = SDL_XFER_SAMPLES;
 	}
@@ -64,33 +63,20 @@ public:
 
 	virtual void update_audio_stream(bool is_throttled, const INT16 *buffer, int samples_this_frame) override;
 	virtual void set_mastervolume(int attenuation) override;
+	virtual bool get_stats(sound_stats &stats) const override;
 
 private:
-	int lock_buffer(bool is_throttled, long offset, long size, void **buffer1, long *length1, void **buffer2, long *length2);
-	void unlock_buffer(void);
-	void att_memcpy(void *dest, const INT16 *data, int bytes_to_copy);
-	void copy_sample_data(bool is_throttled, const INT16 *data, int bytes_to_copy);
 	int sdl_create_buffers(void);
 	void sdl_destroy_buffers(void);
 
 	int sdl_xfer_samples;
 	int stream_in_initialized;
-	int stream_loop;
 	int attenuation;
 
-	int              buf_locked;
-
-	INT8             *stream_buffer;
-	volatile INT32   stream_playpos;
-
-	UINT32           stream_buffer_size;
-	UINT32           stream_buffer_in;
-
-	// buffer over/underflow counts
-	int              buffer_underflows;
-	int              buffer_overflows;
-
-
+	// samples flow emulation -> rate_control -> stream_ring -> sdl_callback
+	std::unique_ptr<sound_ring>         stream_ring;
+	std::unique_ptr<sound_rate_control> rate_control;
+	UINT32                              stream_target;
 };
 
 
@@ -108,139 +94,6 @@ private:
 // debugging
 static FILE *sound_log;
 
-//============================================================
-//  sound_sdl - destructor
-//============================================================
-
-//============================================================
-//  lock_buffer
-//============================================================
-int sound_sdl::lock_buffer(bool is_throttled, long offset, long size, void **buffer1, long *length1, void **buffer2, long *length2)
-{
-	volatile long pstart, pend, lstart, lend;
-
-	if (!buf_locked)
-	{
-		if (is_throttled)
-		{
-			pstart = stream_playpos;
-			pend = (pstart + sdl_xfer_samples);
-			lstart = offset;
-			lend = lstart+size;
-			while (((pstart >= lstart) && (pstart <= lend)) ||
-					((pend >= lstart) && (pend <= lend)))
-			{
-				pstart = stream_playpos;
-				pend = pstart + sdl_xfer_samples;
-			}
-		}
-
-		SDL_LockAudio();
-		buf_locked++;
-	}
-
-	// init lengths
-	*length1 = *length2 = 0;
-
-	if ((offset + size) > stream_buffer_size)
-	{
-		// 2-piece case
-		*length1 = stream_buffer_size - offset;
-		*buffer1 = &stream_buffer[offset];
-		*length2 = size - *length1;
-		*buffer2 = stream_buffer;
-	}
-	else
-	{
-		// normal 1-piece case
-		*length1 = size;
-		*buffer1 = &stream_buffer[offset];
-	}
-
-	if (LOG_SOUND)
-		fprintf(sound_log, "locking %ld bytes at offset %ld (total %d, playpos %d): len1 %ld len2 %ld\n",
-			size, offset, stream_buffer_size, stream_playpos, *length1, *length2);
-
-	return 0;
-}
-
-//============================================================
-//  unlock_buffer
-//============================================================
-void sound_sdl::unlock_buffer(void)
-{
-	buf_locked--;
-	if (!buf_locked)
-		SDL_UnlockAudio();
-
-	if (LOG_SOUND)
-		fprintf(sound_log, "unlocking\n");
-
-}
-
-//============================================================
-//  Apply attenuation
-//============================================================
-
-void sound_sdl::att_memcpy(void *dest, const INT16 *data, int bytes_to_copy)
-{
-	int level= (int) (pow(10.0, (double) attenuation / 20.0) * 128.0);
-	INT16 *d = (INT16 *) dest;
-	int count = bytes_to_copy/2;
-	while (count>0)
-	{
-		*d++ = (*data++ * level) >> 7; /* / 128 */
-		count--;
-	}
-}
-
-//============================================================
-//  copy_sample_data
-//============================================================
-
-void sound_sdl::copy_sample_data(bool is_throttled, const INT16 *data, int bytes_to_copy)
-{
-	void *buffer1, *buffer2 = (void *)nullptr;
-	long length1, length2;
-	int cur_bytes;
-
-	// attempt to lock the stream buffer
-	if (lock_buffer(is_throttled, stream_buffer_in, bytes_to_copy, &buffer1, &length1, &buffer2, &length2) < 0)
-	{
-		buffer_underflows++;
-		return;
-	}
-
-	// adjust the input pointer
-	stream_buffer_in += bytes_to_copy;
-	if (stream_buffer_in >= stream_buffer_size)
-	{
-		stream_buffer_in -= stream_buffer_size;
-		stream_loop = 1;
-
-		if (LOG_SOUND)
-			fprintf(sound_log, "stream_loop set to 1 (stream_buffer_in looped)\n");
-	}
-
-	// copy the first chunk
-	cur_bytes = (bytes_to_copy > length1) ? length1 : bytes_to_copy;
-	att_memcpy(buffer1, data, cur_bytes);
-
-	// adjust for the number of bytes
-	bytes_to_copy -= cur_bytes;
-	data = (INT16 *)((UINT8 *)data + cur_bytes);
-
-	// copy the second chunk
-	if (bytes_to_copy != 0)
-	{
-		cur_bytes = (bytes_to_copy > length2) ? length2 : bytes_to_copy;
-		att_memcpy(buffer2, data, cur_bytes);
-	}
-
-	// unlock
-	unlock_buffer();
-}
-
 
 //============================================================
 //  update_audio_stream
@@ -249,76 +102,21 @@ void sound_sdl::copy_sample_data(bool is_throttled, const INT16 *data, int bytes
 void sound_sdl::update_audio_stream(bool is_throttled, const INT16 *buffer, int samples_this_frame)
 {
 	// if nothing to do, don't do it
-	if (sample_rate() != 0 && stream_buffer)
+	if (sample_rate() != 0 && stream_ring)
 	{
-		int bytes_this_frame = samples_this_frame * sizeof(INT16) * 2;
-		int play_position, write_position, stream_in;
-		int orig_write; // used in LOG
-
-		play_position = stream_playpos;
+		int const level = (int) (pow(10.0, (double) attenuation / 20.0) * 128.0);
+		rate_control->push(*stream_ring, buffer, samples_this_frame, level);
 
-		write_position = stream_playpos + ((sample_rate() / 50) * sizeof(INT16) * 2);
-		orig_write = write_position;
+		if (LOG_SOUND)
+			fprintf(sound_log, "update: %d samples, fill %u/%u, drift %f\n",
+				samples_this_frame, stream_ring->fill(), stream_target, rate_control->drift());
 
-		if (!stream_in_initialized)
+		// hold off playback until the ring has reached its target so we don't start on an underrun
+		if (!stream_in_initialized && stream_ring->fill() >= stream_target)
 		{
-			stream_in = stream_buffer_in = (write_position + stream_buffer_size) / 2;
-
-			if (LOG_SOUND)
-			{
-				fprintf(sound_log, "stream_in = %d\n", (int)stream_in);
-				fprintf(sound_log, "stream_playpos = %d\n", (int)stream_playpos);
-				fprintf(sound_log, "write_position = %d\n", (int)write_position);
-			}
-			// start playing
-			SDL_PauseAudio(0);
-
 			stream_in_initialized = 1;
+			set_mastervolume(attenuation);
 		}
-		else
-		{
-			// normalize the stream in position
-			stream_in = stream_buffer_in;
-			if (stream_in < write_position && stream_loop == 1)
-				stream_in += stream_buffer_size;
-
-			// now we should have, in order:
-			//    <------pp---wp---si--------------->
-
-			// if we're between play and write positions, then bump forward, but only in full chunks
-			while (stream_in < write_position)
-			{
-				if (LOG_SOUND)
-					fprintf(sound_log, "Underflow: PP=%d  WP=%d(%d)  SI=%d(%d)  BTF=%d\n", (int)play_position, (int)write_position, (int)orig_write, (int)stream_in, (int)stream_buffer_in, (int)bytes_this_frame);
-
-				buffer_underflows++;
-				stream_in += bytes_this_frame;
-			}
-
-			// if we're going to overlap the play position, just skip this chunk
-			if (stream_in + bytes_this_frame > play_position + stream_buffer_size)
-			{
-				if (LOG_SOUND)
-					fprintf(sound_log, "Overflow: PP=%d  WP=%d(%d)  SI=%d(%d)  BTF=%d\n", (int)play_position, (int)write_position, (int)orig_write, (int)stream_in, (int)stream_buffer_in, (int)bytes_this_frame);
-
-				buffer_overflows++;
-				return;
-			}
-		}
-
-		if (stream_in >= stream_buffer_size)
-		{
-			stream_in -= stream_buffer_size;
-			stream_loop = 1;
-
-			if (LOG_SOUND)
-				fprintf(sound_log, "stream_loop set to 1 (stream_in looped)\n");
-
-		}
-
-		// now we know where to copy; let's do it
-		stream_buffer_in = stream_in;
-		copy_sample_data(is_throttled, buffer, bytes_this_frame);
 	}
 }
 
@@ -342,59 +140,32 @@ void sound_sdl::set_mastervolume(int _attenuation)
 	}
 }
 
+//============================================================
+//  get_stats
+//============================================================
+
+bool sound_sdl::get_stats(sound_stats &stats) const
+{
+	if (!stream_ring)
+		return false;
+
+	ring_stats(stats, *stream_ring, *rate_control);
+	return true;
+}
+
 //============================================================
 //  sdl_callback
 //============================================================
 static void sdl_callback(void *userdata, Uint8 *stream, int len)
 {
 	sound_sdl *thiz = (sound_sdl *) userdata;
-	int len1, len2, sb_in;
-
-	sb_in = thiz->stream_buffer_in;
-	if (thiz->stream_loop)
-		sb_in += thiz->stream_buffer_size;
-
-	if (sb_in < (thiz->stream_playpos+len))
-	{
-		if (LOG_SOUND)
-			fprintf(sound_log, "Underflow at sdl_callback: SPP=%d SBI=%d(%d) Len=%d\n", (int)thiz->stream_playpos, (int)sb_in, (int)thiz->stream_buffer_in, (int)len);
-
-		return;
-	}
-	else if ((thiz->stream_playpos+len) > thiz->stream_buffer_size)
-	{
-		len1 = thiz->stream_buffer_size - thiz->stream_playpos;
-		len2 = len - len1;
-	}
-	else
-	{
-		len1 = len;
-		len2 = 0;
-	}
-
-	memcpy(stream, thiz->stream_buffer + thiz->stream_playpos, len1);
-	memset(thiz->stream_buffer + thiz->stream_playpos, 0, len1); // no longer needed
-	if (len2)
-	{
-		memcpy(stream+len1, thiz->stream_buffer, len2);
-		memset(thiz->stream_buffer, 0, len2); // no longer needed
-	}
+	int const frames = len / (sizeof(INT16) * 2);
 
+	// never blocks; a short read is padded with silence and counted as an underrun
+	int const count = thiz->stream_ring->read((INT16 *) stream, frames);
 
-	// move the play cursor
-	thiz->stream_playpos += len1 + len2;
-	if (thiz->stream_playpos >= thiz->stream_buffer_size)
-	{
-		thiz->stream_playpos -= thiz->stream_buffer_size;
-		thiz->stream_loop = 0;
-
-		if (LOG_SOUND)
-			fprintf(sound_log, "stream_loop set to 0 (stream_playpos looped)\n");
-	}
-
-	if (LOG_SOUND)
-		fprintf(sound_log, "callback: xfer len1 %d len2 %d, playpos %d\n",
-				len1, len2, thiz->stream_playpos);
+	if (LOG_SOUND && count < frames)
+		fprintf(sound_log, "Underflow at sdl_callback: wanted %d frames, had %d\n", frames, count);
 }
 
 
@@ -426,7 +197,6 @@ int sound_sdl::init(const osd_options &options)
 
 		sdl_xfer_samples = SDL_XFER_SAMPLES;
 		stream_in_initialized = 0;
-		stream_loop = 0;
 
 		// set up the audio specs
 		aspec.freq = sample_rate();
@@ -444,14 +214,12 @@ int sound_sdl::init(const osd_options &options)
 
 		sdl_xfer_samples = obtained.samples;
 
-		// pin audio latency
-		audio_latency = MAX(MIN(m_audio_latency, MAX_AUDIO_LATENCY), 1);
+		// pin audio latency; 0 is usable now that the rate control absorbs drift
+		audio_latency = MAX(MIN(m_audio_latency, MAX_AUDIO_LATENCY), 0);
 
-		// compute the buffer sizes
-		stream_buffer_size = (sample_rate() * 2 * sizeof(INT16) * (2 + audio_latency)) / 30;
-		stream_buffer_size = (stream_buffer_size / 1024) * 1024;
-		if (stream_buffer_size < 1024)
-			stream_buffer_size = 1024;
+		// the ring must ride out one emulated frame of input plus one device period,
+		// and each latency step adds another 1/60s of headroom on top of that
+		stream_target = sdl_xfer_samples + (sample_rate() * (1 + audio_latency)) / 60;
 
 		// create the buffers
 		if (sdl_create_buffers())
@@ -490,33 +258,35 @@ void sound_sdl::exit()
 
 	SDL_QuitSubSystem(SDL_INIT_AUDIO);
 
-	// kill the buffers
-	sdl_destroy_buffers();
-
 	// print out over/underflow stats
-	if (buffer_overflows || buffer_underflows)
-		osd_printf_verbose("Sound buffer: overflows=%d underflows=%d\n", buffer_overflows, buffer_underflows);
+	sound_stats stats;
+	if (get_stats(stats) && (stats.overruns || stats.underruns))
+		osd_printf_verbose("Sound buffer: overflows=%u underflows=%u drift=%+.4f%%\n", stats.overruns, stats.underruns, stats.drift * 100.0);
 
 	if (LOG_SOUND)
 	{
-		fprintf(sound_log, "Sound buffer: overflows=%d underflows=%d\n", buffer_overflows, buffer_underflows);
+		if (get_stats(stats))
+			fprintf(sound_log, "Sound buffer: overflows=%u underflows=%u\n", stats.overruns, stats.underruns);
 		fclose(sound_log);
 	}
+
+	// kill the buffers
+	sdl_destroy_buffers();
 }
 
 
 
 //============================================================
-//  dsound_create_buffers
+//  sdl_create_buffers
 //============================================================
 
 int sound_sdl::sdl_create_buffers(void)
 {
-	osd_printf_verbose("sdl_create_buffers: creating stream buffer of %u bytes\n", stream_buffer_size);
+	// leave plenty of room above the target so an unthrottled burst doesn't overflow at once
+	stream_ring = std::make_unique<sound_ring>(stream_target * 4);
+	rate_control = std::make_unique<sound_rate_control>(stream_target);
 
-	stream_buffer = global_alloc_array_clear<INT8>(stream_buffer_size);
-	stream_playpos = 0;
-	buf_locked = 0;
+	osd_printf_verbose("sdl_create_buffers: creating stream ring of %u frames, target %u\n", stream_ring->capacity(), stream_target);
 	return 0;
 }
 
@@ -527,9 +297,8 @@ int sound_sdl::sdl_create_buffers(void)
 void sound_sdl::sdl_destroy_buffers(void)
 {
 	// release the buffer
-	if (stream_buffer)
-		global_free_array(stream_buffer);
-	stream_buffer = nullptr;
+	stream_ring = nullptr;
+	rate_control = nullptr;
 }
 
 
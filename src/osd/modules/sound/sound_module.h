@@ -8,6 +8,12 @@
 #ifndef SOUND_MODULE_H_
 #define SOUND_MODULE_H_
 
+#include <math.h>
+#include <string.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #include "osdepend.h"
 #include "modules/osdmodule.h"
 
@@ -17,6 +23,179 @@
 
 #define OSD_SOUND_PROVIDER   "sound"
 
+//============================================================
+//  TYPE DEFINITIONS
+//============================================================
+
+// buffer statistics reported by modules that stream through a sound_ring
+struct sound_stats
+{
+	UINT32  fill;           // stereo frames currently queued
+	UINT32  target;         // fill level the rate control aims for
+	UINT32  capacity;       // size of the ring in stereo frames
+	UINT32  underruns;      // device pulls that ran out of data
+	UINT32  overruns;       // frames dropped because the ring was full
+	double  drift;          // current resampling correction (0 = nominal rate)
+};
+
+
+// ======================> sound_ring
+
+// lock-free single-producer/single-consumer queue of stereo INT16 frames;
+// the emulation thread pushes with write() and the device callback pulls
+// with read(), neither ever blocks the other
+class sound_ring
+{
+public:
+	sound_ring(UINT32 frames)
+		: m_size(1),
+			m_head(0),
+			m_tail(0),
+			m_underruns(0),
+			m_overruns(0)
+	{
+		while (m_size < frames)
+			m_size <<= 1;
+		m_buffer = std::make_unique<INT16[]>(m_size * 2);
+	}
+
+	UINT32 capacity() const { return m_size; }
+	UINT32 fill() const { return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire); }
+	UINT32 underruns() const { return m_underruns.load(std::memory_order_relaxed); }
+	UINT32 overruns() const { return m_overruns.load(std::memory_order_relaxed); }
+
+	// producer side: queue up to frames stereo frames, dropping what doesn't fit
+	UINT32 write(const INT16 *data, UINT32 frames)
+	{
+		UINT32 const head = m_head.load(std::memory_order_relaxed);
+		UINT32 const space = m_size - (head - m_tail.load(std::memory_order_acquire));
+		if (frames > space)
+		{
+			m_overruns.fetch_add(frames - space, std::memory_order_relaxed);
+			frames = space;
+		}
+		copy_in(head, data, frames);
+		m_head.store(head + frames, std::memory_order_release);
+		return frames;
+	}
+
+	// consumer side: dequeue frames stereo frames, padding with silence on underrun
+	UINT32 read(INT16 *data, UINT32 frames)
+	{
+		UINT32 const tail = m_tail.load(std::memory_order_relaxed);
+		UINT32 const avail = m_head.load(std::memory_order_acquire) - tail;
+		UINT32 const count = (frames > avail) ? avail : frames;
+		copy_out(tail, data, count);
+		m_tail.store(tail + count, std::memory_order_release);
+		if (count < frames)
+		{
+			memset(data + count * 2, 0, (frames - count) * 2 * sizeof(INT16));
+			m_underruns.fetch_add(1, std::memory_order_relaxed);
+		}
+		return count;
+	}
+
+private:
+	void copy_in(UINT32 pos, const INT16 *data, UINT32 frames)
+	{
+		UINT32 const start = pos & (m_size - 1);
+		UINT32 const first = (frames < m_size - start) ? frames : (m_size - start);
+		memcpy(&m_buffer[start * 2], data, first * 2 * sizeof(INT16));
+		memcpy(&m_buffer[0], data + first * 2, (frames - first) * 2 * sizeof(INT16));
+	}
+
+	void copy_out(UINT32 pos, INT16 *data, UINT32 frames) const
+	{
+		UINT32 const start = pos & (m_size - 1);
+		UINT32 const first = (frames < m_size - start) ? frames : (m_size - start);
+		memcpy(data, &m_buffer[start * 2], first * 2 * sizeof(INT16));
+		memcpy(data + first * 2, &m_buffer[0], (frames - first) * 2 * sizeof(INT16));
+	}
+
+	UINT32                      m_size;         // capacity in frames, a power of 2
+	std::unique_ptr<INT16[]>    m_buffer;       // interleaved stereo samples
+	std::atomic<UINT32>         m_head;         // frames written, only stored by the producer
+	std::atomic<UINT32>         m_tail;         // frames read, only stored by the consumer
+	std::atomic<UINT32>         m_underruns;
+	std::atomic<UINT32>         m_overruns;
+};
+
+
+// ======================> sound_rate_control
+
+// feeds a sound_ring through a linear-interpolating resampler whose ratio
+// is nudged to hold the ring near a target fill; this absorbs the drift
+// between the emulated and device clocks without dropping or repeating
+// whole chunks, so the target can sit just above the device period
+class sound_rate_control
+{
+public:
+	// largest correction applied to the playback rate (0.5%, below audible pitch shift)
+	static constexpr double MAX_DRIFT = 0.005;
+
+	sound_rate_control(UINT32 target)
+		: m_target(target),
+			m_step(1.0),
+			m_phase(0.0),
+			m_error(0.0),
+			m_integral(0.0)
+	{
+		m_prev[0] = m_prev[1] = 0;
+	}
+
+	UINT32 target() const { return m_target; }
+	double drift() const { return m_step - 1.0; }
+
+	// resample frames stereo frames into the ring, scaling by level/128
+	void push(sound_ring &ring, const INT16 *data, int frames, int level)
+	{
+		if (frames <= 0)
+			return;
+
+		// a full ring steps through the input a little faster, an empty one a little slower;
+		// the fill is jittery at device-callback granularity so only follow it slowly
+		double error = (double(ring.fill()) - double(m_target)) / double(m_target);
+		error = (error < -1.0) ? -1.0 : (error > 1.0) ? 1.0 : error;
+		m_error += (error - m_error) * 0.1;
+		m_integral += error * 0.0005;
+		m_integral = (m_integral < -0.5) ? -0.5 : (m_integral > 0.5) ? 0.5 : m_integral;
+		double const control = m_error + m_integral;
+		m_step = 1.0 + MAX_DRIFT * ((control < -1.0) ? -1.0 : (control > 1.0) ? 1.0 : control);
+
+		// interpolate between input frames; position -1 is the last frame of the previous call
+		m_scratch.resize((size_t(frames / m_step) + 2) * 2);
+		INT16 *dest = &m_scratch[0];
+		double pos = m_phase - 1.0;
+		while (pos < frames - 1)
+		{
+			int const index = int(floor(pos));
+			double const frac = pos - index;
+			const INT16 *s0 = (index < 0) ? m_prev : &data[index * 2];
+			const INT16 *s1 = &data[(index + 1) * 2];
+			*dest++ = INT16(((s0[0] + (s1[0] - s0[0]) * frac) * level) / 128);
+			*dest++ = INT16(((s0[1] + (s1[1] - s0[1]) * frac) * level) / 128);
+			pos += m_step;
+		}
+		m_phase = pos - (frames - 1);
+		m_prev[0] = data[(frames - 1) * 2 + 0];
+		m_prev[1] = data[(frames - 1) * 2 + 1];
+
+		ring.write(&m_scratch[0], (dest - &m_scratch[0]) / 2);
+	}
+
+private:
+	UINT32              m_target;       // desired ring fill in frames
+	double              m_step;         // input frames consumed per output frame
+	double              m_phase;        // fractional position carried into the next call
+	double              m_error;        // smoothed relative fill error
+	double              m_integral;     // accumulated error, tracks steady clock drift
+	INT16               m_prev[2];      // last input frame of the previous call
+	std::vector<INT16>  m_scratch;      // resampled output awaiting the ring
+};
+
+
+// ======================> sound_module
+
 class sound_module
 {
 public:
@@ -27,10 +206,25 @@ public:
 	virtual void update_audio_stream(bool is_throttled, const INT16 *buffer, int samples_this_frame) = 0;
 	virtual void set_mastervolume(int attenuation) = 0;
 
+	// modules streaming through a sound_ring report its state here
+	virtual bool get_stats(sound_stats &stats) const { return false; }
+
 	int sample_rate() const { return m_sample_rate; }
 
 	int m_sample_rate;
 	int m_audio_latency;
+
+protected:
+	// fill in stats from a ring and its rate control
+	static void ring_stats(sound_stats &stats, const sound_ring &ring, const sound_rate_control &rate)
+	{
+		stats.fill = ring.fill();
+		stats.target = rate.target();
+		stats.capacity = ring.capacity();
+		stats.underruns = ring.underruns();
+		stats.overruns = ring.overruns();
+		stats.drift = rate.drift();
+	}
 };
 
-#endif /* FONT_MODULE_H_ */
+#endif /* SOUND_MODULE_H_ */
@@ -484,7 +484,8 @@ void sound_xaudio2::create_buffers(const WAVEFORMATEX &format)
 {
 	// Compute the buffer size
 	// buffer size is equal to the bytes we need to hold in memory per X tenths of a second where X is audio_latency
-	float audio_latency_in_seconds = m_audio_latency / 10.0f;
+	// (at least 1, as a latency of 0 would leave no buffers at all)
+	float audio_latency_in_seconds = MAX(m_audio_latency, 1) / 10.0f;
 	UINT32 format_bytes_per_second = format.nSamplesPerSec * format.nBlockAlign;
 	UINT32 total_buffer_size = format_bytes_per_second * audio_latency_in_seconds;
 
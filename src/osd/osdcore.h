@@ -211,6 +211,36 @@ public:
 	virtual error flush() = 0;
 
 
+	/*-----------------------------------------------------------------------------
+	    osd_file::map: map part of an open file over existing memory
+
+	    Parameters:
+
+	        dest - pointer to the memory to replace; must be aligned to
+	            osd_map_granularity() and lie within a block allocated by
+	            osd_alloc_mappable
+
+	        offset - offset within the file to map from; must be a multiple
+	            of osd_map_granularity()
+
+	        length - number of bytes to map; the remainder of the last page
+	            reads as zero
+
+	    Return value:
+
+	        a file_error describing any error that occurred while mapping the
+	        file, or FILERR_NONE if no error occurred
+
+	    Notes:
+
+	        The mapping is private: writes to it are never seen by the file,
+	        and pages are only copied when they are first written.  Files
+	        that cannot be mapped return FILERR_FAILURE, and the caller
+	        should read the data instead.
+	-----------------------------------------------------------------------------*/
+	virtual error map(void *dest, std::uint64_t offset, std::uint64_t length) { return error::FAILURE; }
+
+
 	/*-----------------------------------------------------------------------------
 	    osd_file::remove: deletes a file
 
@@ -754,6 +784,59 @@ void *osd_alloc_executable(size_t size);
 void osd_free_executable(void *ptr, size_t size);
 
 
+/*-----------------------------------------------------------------------------
+    osd_alloc_mappable: allocate memory that files can be mapped over
+
+    Parameters:
+
+        size - the number of bytes to allocate
+
+    Return value:
+
+        a pointer to the allocated memory, aligned to osd_map_granularity()
+        and initially zero, or nullptr on failure
+
+    Notes:
+
+        Pages are only committed when they are first touched, so parts of
+        the block that are later replaced by osd_file::map never cost any
+        memory.
+-----------------------------------------------------------------------------*/
+void *osd_alloc_mappable(size_t size);
+
+
+/*-----------------------------------------------------------------------------
+    osd_free_mappable: free memory allocated by osd_alloc_mappable, along
+    with any files mapped over it
+
+    Parameters:
+
+        ptr - the pointer returned from osd_alloc_mappable
+
+        size - the number of bytes originally requested
+
+    Return value:
+
+        None
+-----------------------------------------------------------------------------*/
+void osd_free_mappable(void *ptr, size_t size);
+
+
+/*-----------------------------------------------------------------------------
+    osd_map_granularity: return the alignment required by osd_file::map
+
+    Parameters:
+
+        None
+
+    Return value:
+
+        the alignment in bytes of addresses and file offsets passed to
+        osd_file::map, or 0 if files can never be mapped
+-----------------------------------------------------------------------------*/
+size_t osd_map_granularity();
+
+
 /*-----------------------------------------------------------------------------
     osd_break_into_debugger: break into the hosting system's debugger if one
         is attached
@@ -0,0 +1,34 @@
+#include "gtest/gtest.h"
+#include "trigram.h"
+
+TEST(trigram,candidates)
+{
+   trigram_index index;
+   index.add(0, "Street Fighter II");
+   index.add(1, "Pac-Man");
+   index.add(2, "Ms. Pac-Man");
+   index.add(2, "mspacman");
+   index.add(3, "Galaxian");
+   index.finalize();
+
+   std::vector<int> results;
+   index.candidates("pacman", 2, results);
+   ASSERT_EQ(2, results.size());
+   EXPECT_EQ(2, results[0]);
+   EXPECT_EQ(1, results[1]);
+
+   index.candidates("GALAX", 10, results);
+   ASSERT_EQ(1, results.size());
+   EXPECT_EQ(3, results[0]);
+
+   index.candidates("zzz", 10, results);
+   EXPECT_TRUE(results.empty());
+}
+
+TEST(trigram,usable)
+{
+   EXPECT_FALSE(trigram_index::usable(""));
+   EXPECT_FALSE(trigram_index::usable("a-"));
+   EXPECT_TRUE(trigram_index::usable("sf"));
+   EXPECT_TRUE(trigram_index::usable("a b"));
+}